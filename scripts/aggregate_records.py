@@ -0,0 +1,91 @@
+from __future__ import print_function
+import argparse
+import csv
+import json
+import os
+import sys
+
+# Reads the result records written by `bin/scipdagger --record` or `--batch` (batch.csv/batch.json) and prints the
+# table and the averages of get_stats.sh without parsing the SCIP logs.
+
+def read_records(filename, side):
+   # paired records (--paired) hold the fields of both solves; keep those of one side
+   records = []
+   with open(filename, 'r') as fin:
+      if filename.endswith('.json'):
+         for line in fin:
+            if line.strip():
+               record = json.loads(line)
+               if side in record:
+                  record[side]['instance'] = record['instance']
+                  record = record[side]
+               records.append(record)
+      else:
+         prefix = side + '_'
+         for row in csv.DictReader(fin):
+            row = dict((k, v if v != '' else None) for k, v in row.items())
+            if prefix + 'status' in row:
+               row = dict([(k[len(prefix):], v) for k, v in row.items() if k.startswith(prefix)] + [('instance', row['instance'])])
+            records.append(row)
+   return records
+
+def read_opt(soldir, instance):
+   # first line of a solution file: "objective value:  <opt>"
+   with open(os.path.join(soldir, instance + '.sol'), 'r') as fin:
+      return float(fin.readline().split()[2])
+
+def value(record, key, type=float):
+   return type(record[key]) if record.get(key) is not None else None
+
+
+if __name__ == '__main__':
+   parser = argparse.ArgumentParser()
+   parser.add_argument('records', nargs='+', help='record files (.csv or .json)')
+   parser.add_argument('--soldir', dest='soldir', action='store', type=str, help='directory of the optimal solutions', default=None)
+   parser.add_argument('--side', dest='side', action='store', type=str, help='solve of paired records (policy or baseline)', default='policy')
+   parser.add_argument('--output', dest='output', action='store', type=str, help='file to write the table to', default=None)
+   args = parser.parse_args()
+
+   records = []
+   for filename in args.records:
+      records.extend(read_records(filename, args.side))
+
+   fout = open(args.output, 'w') if args.output else sys.stdout
+   fout.write('%-20s %-6s %-6s %-10s %-10s %-10s %-5s %-5s\n' % ('problem', 'nnodes', 'time', 'DB', 'PB', 'opt', 'ogap', 'igap'))
+
+   rows = []
+   fail = 0
+   for record in records:
+      # unsolved, infeasible and infinite gap count as failures as in get_stats.sh
+      gap = value(record, 'gap')
+      if record['status'] in ('notsolved', 'infeasible') or gap is None:
+         fail += 1
+         continue
+      pb = value(record, 'primalbound')
+      opt = read_opt(args.soldir, record['instance']) if args.soldir else float('nan')
+      # SCIP reports the gap in percent
+      row = [value(record, 'nodes', int), value(record, 'time'), value(record, 'dualbound'), pb, opt, abs(pb - opt), 100.0 * gap]
+      rows.append(row)
+      fout.write('%-20s %-6d %-6.2f %-10.2f %-10.2f %-10.2f %-5.2f %-5.2f\n' % tuple([record['instance']] + row))
+
+   if rows:
+      avg = [sum(col) / len(rows) for col in zip(*rows)]
+      fout.write('%-20s %-6d %-6.2f %-10.2f %-10.2f %-10.2f %-5.2f %-5.2f %-4d\n' % tuple(['average'] + avg + [fail]))
+   else:
+      fout.write('%-20s %-4d\n' % ('average', fail))
+
+   # statistics of the node selector and pruner, where available
+   ncomps = sum(value(r, 'ncomps', int) or 0 for r in records)
+   if ncomps > 0:
+      fout.write('comp error rate: %d/%d\n' % (sum(value(r, 'nerrors', int) or 0 for r in records), ncomps))
+   nprunes = [value(r, 'nprunes', int) for r in records if value(r, 'nprunes', int) is not None]
+   if nprunes:
+      fout.write('average nprunes: %.2f\n' % (float(sum(nprunes)) / len(nprunes)))
+   for key, name in (('effort', 'effort'), ('nodeseltime', 'selection time'), ('nodeprutime', 'pruning time')):
+      times = [value(r, key) for r in records if value(r, key) is not None]
+      if times:
+         fout.write('average %s: %.2f\n' % (name, sum(times) / len(times)))
+
+   if args.output:
+      fout.close()
+      print('saved in %s' % args.output)
@@ -0,0 +1,114 @@
+from __future__ import print_function
+import argparse
+import csv
+import glob
+import os
+import sys
+
+from aggregate_records import read_records, value
+
+# Computes the throughput metrics of the runs of scripts/regress_bench.sh from their result records, trajectory files
+# and peak RSS files, and compares them with a baseline file written by a previous run with --update. Exits with 1 if
+# a metric is worse than the baseline by more than the tolerance.
+
+MODES = ['oracle', 'dagger', 'policy']
+
+# metric, whether larger is better, and the absolute difference below which a change is noise
+METRICS = [('nodespersec', True, 0.0),
+           ('nodeselpct', False, 1.0),
+           ('nodeprupct', False, 1.0),
+           ('trjbytespernode', False, 1.0),
+           ('peakrsskb', False, 1024.0)]
+
+def collect(dirname):
+   rows = []
+   for mode in MODES:
+      filename = os.path.join(dirname, mode + '.csv')
+      if not os.path.exists(filename):
+         continue
+      for record in read_records(filename, 'policy'):
+         instance = record['instance']
+         nnodes = value(record, 'nodes', int)
+         time = value(record, 'time')
+         if record['status'] == 'notsolved' or not nnodes or not time:
+            print('%s %s: not solved' % (instance, mode), file=sys.stderr)
+            continue
+         row = {'instance': instance, 'mode': mode}
+         row['nodespersec'] = nnodes / time
+         row['nodeselpct'] = 100.0 * (value(record, 'nodeseltime') or 0.0) / time
+         row['nodeprupct'] = 100.0 * (value(record, 'nodeprutime') or 0.0) / time
+         trjbytes = sum(os.path.getsize(f) for f in glob.glob(os.path.join(dirname, '%s.%s.*.trj' % (instance, mode))))
+         row['trjbytespernode'] = float(trjbytes) / nnodes
+         # GNU time may write a line about the exit status before the peak RSS
+         with open(os.path.join(dirname, '%s.%s.rss' % (instance, mode)), 'r') as fin:
+            row['peakrsskb'] = float(fin.read().split()[-1])
+         rows.append(row)
+   return rows
+
+def read_baseline(filename):
+   baseline = {}
+   with open(filename, 'r') as fin:
+      for row in csv.DictReader(fin):
+         baseline[(row['instance'], row['mode'])] = dict((m, float(row[m])) for m, _, _ in METRICS)
+   return baseline
+
+def write_rows(filename, rows):
+   with open(filename, 'w') as fout:
+      writer = csv.writer(fout)
+      writer.writerow(['instance', 'mode'] + [m for m, _, _ in METRICS])
+      for row in rows:
+         writer.writerow([row['instance'], row['mode']] + ['%.6g' % row[m] for m, _, _ in METRICS])
+
+
+if __name__ == '__main__':
+   parser = argparse.ArgumentParser()
+   parser.add_argument('--dir', dest='dir', action='store', type=str, help='output directory of regress_bench.sh', default='regress')
+   parser.add_argument('--baseline', dest='baseline', action='store', type=str, help='baseline file', default='scripts/regress_baseline.csv')
+   parser.add_argument('--tolerance', dest='tolerance', action='store', type=float, help='allowed relative degradation of every metric', default=0.1)
+   parser.add_argument('--metric-tolerance', dest='metrictol', action='append', type=str, help='allowed relative degradation of one metric, <metric>=<tolerance>', default=[])
+   parser.add_argument('--update', dest='update', action='store_true', help='write the results to the baseline instead of comparing')
+   args = parser.parse_args()
+
+   tolerances = dict((m, args.tolerance) for m, _, _ in METRICS)
+   for arg in args.metrictol:
+      metric, tol = arg.split('=')
+      if metric not in tolerances:
+         parser.error('unknown metric %s (one of %s)' % (metric, ', '.join(tolerances)))
+      tolerances[metric] = float(tol)
+
+   rows = collect(args.dir)
+   write_rows(os.path.join(args.dir, 'regress.csv'), rows)
+
+   print('%-20s %-7s %-12s %-10s %-10s %-10s %-10s' % ('problem', 'mode', 'nodes/s', 'nodesel%', 'nodepru%', 'trjB/node', 'peakRSSkB'))
+   for row in rows:
+      print('%-20s %-7s %-12.1f %-10.2f %-10.2f %-10.1f %-10d' % tuple([row['instance'], row['mode']] + [row[m] for m, _, _ in METRICS]))
+
+   if args.update:
+      write_rows(args.baseline, rows)
+      print('baseline written to %s' % args.baseline)
+      sys.exit(0)
+
+   if not os.path.exists(args.baseline):
+      print('no baseline %s; run with --update (regress_bench.sh -u) to write it' % args.baseline, file=sys.stderr)
+      sys.exit(1)
+
+   baseline = read_baseline(args.baseline)
+   failures = 0
+   for row in rows:
+      key = (row['instance'], row['mode'])
+      if key not in baseline:
+         print('%s %s: not in the baseline' % key)
+         continue
+      for metric, larger, noise in METRICS:
+         new, old = row[metric], baseline[key][metric]
+         change = new - old if larger else old - new
+         if change < 0 and -change > noise and -change > tolerances[metric] * abs(old):
+            print('REGRESSION %s %s %s: %.6g -> %.6g (tolerance %.0f%%)' % (key + (metric, old, new, 100.0 * tolerances[metric])))
+            failures += 1
+   missing = set(baseline) - set((row['instance'], row['mode']) for row in rows)
+   for key in sorted(missing):
+      print('REGRESSION %s %s: missing run' % key)
+      failures += 1
+
+   print('%d regressions' % failures)
+   sys.exit(1 if failures > 0 else 0)
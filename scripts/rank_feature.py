@@ -46,12 +46,13 @@ feat_id_map = {
 }
 
 def read_model(filename):
+   # the header (which may hold the depth buckets) ends with the line 'w'
    weights = []
    with open(filename, 'r') as fin:
-      count = 0
+      inheader = True
       for line in fin:
-         if count < 6:
-            count += 1
+         if inheader:
+            inheader = (line.strip() != 'w')
             continue
          weights.append(float(line.strip()))
    return weights
@@ -0,0 +1,163 @@
+#!/bin/bash
+set -e
+
+usage() {
+  echo "Usage: $0 [-g <generated_problem_dir>] [-x <suffix>] [-G <nintvars>-<ncontvars>-<nconss> [-c <count>]] [-t <time_limit>] [-o <output_dir>] [-b <baseline>] [-a <tolerance>] [-s <search_policy> -k <kill_policy>] [-u]"
+}
+
+sample=sample-dat/train/mik.250-10-100.1.mps.gz
+sampleSol=sample-solution/train/mik.250-10-100.1.sol
+genDir=""
+suffix=".mps.gz"
+mikSize=""
+mikCount=1
+timeLimit=60
+outDir=regress
+baseline=scripts/regress_baseline.csv
+tolerance=0.1
+searchPolicy=""
+killPolicy=""
+update=""
+
+while getopts ":hg:x:G:c:t:o:b:a:s:k:u" arg; do
+  case $arg in
+    h)
+      usage
+      exit 0
+      ;;
+    g)
+      genDir=${OPTARG%/}
+      echo "generated problems: $genDir"
+      ;;
+    x)
+      suffix=${OPTARG}
+      echo "data suffix: $suffix"
+      ;;
+    G)
+      mikSize=${OPTARG}
+      echo "generated MIK problems: mik.$mikSize"
+      ;;
+    c)
+      mikCount=${OPTARG}
+      echo "number of generated MIK problems: $mikCount"
+      ;;
+    t)
+      timeLimit=${OPTARG}
+      echo "time limit: $timeLimit"
+      ;;
+    o)
+      outDir=${OPTARG%/}
+      echo "output directory: $outDir"
+      ;;
+    b)
+      baseline=${OPTARG}
+      echo "baseline: $baseline"
+      ;;
+    a)
+      tolerance=${OPTARG}
+      echo "tolerance: $tolerance"
+      ;;
+    s)
+      searchPolicy=${OPTARG}
+      echo "search policy: $searchPolicy"
+      ;;
+    k)
+      killPolicy=${OPTARG}
+      echo "kill policy: $killPolicy"
+      ;;
+    u)
+      update="--update"
+      echo "update the baseline"
+      ;;
+    :)
+      echo "ERROR: -${OPTARG} requires an argument"
+      usage
+      exit 1
+      ;;
+    ?)
+      echo "ERROR: unknown option -${OPTARG}"
+      usage
+      exit 1
+      ;;
+  esac
+done
+
+if [[ -z $searchPolicy && -n $killPolicy ]] || [[ -n $searchPolicy && -z $killPolicy ]]; then
+  echo "ERROR: -s and -k must be given together"
+  usage
+  exit 1
+fi
+
+# peak RSS is read from GNU time
+if ! [ -x /usr/bin/time ]; then
+  echo "ERROR: /usr/bin/time (GNU time) is required to measure the peak RSS"
+  exit 1
+fi
+
+rm -rf $outDir
+mkdir -p $outDir/sol
+
+# solves a problem in one mode: writes the record to $outDir/<mode>.csv, the peak RSS in KB to
+# $outDir/<problem>.<mode>.rss and the trajectories to $outDir/<problem>.<mode>.{nodesel,nodepru}.trj
+solve() {
+  local mode=$1 file=$2 base=$3 sol=$4
+  shift 4
+  /usr/bin/time -f %M -o $outDir/$base.$mode.rss \
+    bin/scipdagger -f $file -s scip.set -t $timeLimit --record $outDir/$mode.csv "$@" > $outDir/$base.$mode.log
+}
+
+problems="$sample"
+
+# MIK problems of the family of the sample, e.g. -G 2500-10-1000 for 10x its size, with solutions for the oracle
+if [ -n "$mikSize" ]; then
+  IFS=- read nIntVars nContVars nConss <<< "$mikSize"
+  echo "Generating $mikCount problems mik.$mikSize ..."
+  bin/scipdagger generate -n $nIntVars -m $nContVars -k $nConss -c $mikCount --sol -s scip.set -t 30 $outDir/gen
+  for file in `ls $outDir/gen | grep "\.mps\$"`; do
+    problems="$problems $outDir/gen/$file"
+  done
+fi
+if [ -n "$genDir" ]; then
+  for file in `ls $genDir | grep -- "$suffix\$"`; do
+    problems="$problems $genDir/$file"
+  done
+fi
+
+# the oracle needs an optimal solution; generated problems without one are solved by SCIP first as in run_scip.sh
+for file in $problems; do
+  base=`basename $file`
+  base=${base%.mps.gz}
+  base=${base%.mps}
+  base=${base%$suffix}
+  sol=${file%/*}/$base.sol
+  if [ $file == $sample ]; then
+    sol=$sampleSol
+  elif ! [ -e $sol ]; then
+    sol=$outDir/sol/$base.sol
+    echo "Solving $base for the oracle ..."
+    bin/scipdagger -f $file --sol $sol -s scip.set -t 30 > $outDir/sol/$base.log
+  fi
+
+  echo "Running oracle on $base ..."
+  solve oracle $file $base $sol -o $sol --nodesel oracle --nodepru oracle --trjformat binary \
+    --nodeseltrj $outDir/$base.oracle.nodesel.trj --nodeprutrj $outDir/$base.oracle.nodepru.trj
+
+  # without given policies, policies are trained on the oracle trajectories of the sample problem
+  if [ -z "$searchPolicy" ]; then
+    searchPolicy=$outDir/searchPolicy
+    killPolicy=$outDir/killPolicy
+    bin/scipdagger train $outDir/$base.oracle.nodesel.trj $searchPolicy > $outDir/train.log
+    bin/scipdagger train $outDir/$base.oracle.nodepru.trj $killPolicy >> $outDir/train.log
+  fi
+
+  echo "Running dagger on $base ..."
+  solve dagger $file $base $sol -o $sol --nodesel dagger $searchPolicy --nodepru dagger $killPolicy \
+    --trjformat binary --nodeseltrj $outDir/$base.dagger.nodesel.trj --nodeprutrj $outDir/$base.dagger.nodepru.trj
+
+  echo "Running policy on $base ..."
+  solve policy $file $base $sol --nodesel policy $searchPolicy --nodepru policy $killPolicy
+done
+
+# Nodes per second, node selection and pruning time in percent of the solving time, trajectory bytes per node and
+# peak RSS per problem and mode; compared with the baseline, or written to it with -u
+python scripts/check_regress.py --dir $outDir --baseline $baseline --tolerance $tolerance $update
@@ -2,14 +2,16 @@
 set -e
 
 usage() {
-  echo "Usage: $0 -d <data_path_under_dat> -s <search_policy> -k <kill_policy> -e <experiment> -x <suffix> -m <problem> -r <restriced_level> -g <dagger>"
+  echo "Usage: $0 -d <data_path_under_dat> -s <search_policy> -k <kill_policy> -e <experiment> -x <suffix> -m <problem> -r <restriced_level> -g <dagger> -j <num_workers> -a <paired_limits>"
 }
 
 suffix=".lp.gz"
 freq=1
 dagger=0
+workers=1
+paired=""
 
-while getopts ":hd:s:k:e:x:m:r:g:" arg; do
+while getopts ":hd:s:k:e:x:m:r:g:j:a:" arg; do
   case $arg in
     h)
       usage
@@ -47,6 +49,14 @@ while getopts ":hd:s:k:e:x:m:r:g:" arg; do
       dagger=${OPTARG}
       echo "run dagger: $dagger"
       ;;
+    j)
+      workers=${OPTARG}
+      echo "number of parallel solves: $workers"
+      ;;
+    a)
+      paired="--paired ${OPTARG}"
+      echo "paired default SCIP solves limited by: ${OPTARG}"
+      ;;
     :)
       echo "ERROR: -${OPTARG} requires an argument"
       usage
@@ -65,14 +75,11 @@ dir=dat/$data
 if ! [ -d $resultDir/$data/$experiment ]; then
   mkdir -p $resultDir/$data/$experiment
 fi
-for file in `ls $dir`; do
-  base=`sed "s/$suffix//g" <<< $file`
-  echo $base
-  if [[ $dagger -eq 0 ]]; then
-    bin/scipdagger -r $freq -s scip.set -f $dir/$file --nodesel policy $searchPolicy --nodepru policy $killPolicy &> $resultDir/$data/$experiment/$base.log
-  else
-    sol=solution/$data/$base.sol
-    bin/scipdagger -r $freq -s scip.set -f $dir/$file -o $sol --nodesel dagger $searchPolicy --nodepru dagger $killPolicy &> $resultDir/$data/$experiment/$base.log
-  fi
-done
-
+# Solve the whole directory in one process; the log of each problem is written to $base.log
+# and one result record per problem to batch.csv (see scripts/aggregate_records.py); with -a, each problem is solved
+# again with default SCIP under the time and/or node count of the policy solve ($base.baseline.log)
+if [[ $dagger -eq 0 ]]; then
+  bin/scipdagger -r $freq -s scip.set --batch $dir -x $suffix --batchout $resultDir/$data/$experiment --workers $workers $paired --nodesel policy $searchPolicy --nodepru policy $killPolicy
+else
+  bin/scipdagger -r $freq -s scip.set --batch $dir -x $suffix --batchout $resultDir/$data/$experiment --workers $workers $paired -o solution/$data --nodesel dagger $searchPolicy --nodepru dagger $killPolicy
+fi
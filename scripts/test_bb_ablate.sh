@@ -1,14 +1,14 @@
 #!/bin/bash
 
 usage() {
-  echo "Usage: $0 -d <data_path_under_dat> -s <search_policy> -k <kill_policy> -e <experiment> -x <suffix> -r <restriced_level>"
+  echo "Usage: $0 -d <data_path_under_dat> -s <search_policy> -k <kill_policy> -e <experiment> -x <suffix> -r <restriced_level> [-m <search_featmasks>] [-M <kill_featmasks>]"
 }
 
 suffix=".lp.gz"
 freq=1
 time=-1
 
-while getopts ":hd:s:k:e:x:r:t:" arg; do
+while getopts ":hd:s:k:e:x:r:t:m:M:" arg; do
   case $arg in
     h)
       usage
@@ -42,6 +42,14 @@ while getopts ":hd:s:k:e:x:r:t:" arg; do
       time=${OPTARG}
       echo "time limit: $time"
       ;;
+    m)
+      searchMasks=${OPTARG}
+      echo "search feature masks: $searchMasks"
+      ;;
+    M)
+      killMasks=${OPTARG}
+      echo "kill feature masks: $killMasks"
+      ;;
     :)
       echo "ERROR: -${OPTARG} requires an argument"
       usage
@@ -60,14 +68,20 @@ dir=dat/$data
 if ! [ -d $resultDir/$data/$experiment ]; then
   mkdir -p $resultDir/$data/$experiment
 fi
-for file in `ls $dir`; do
-  base=`sed "s/$suffix//g" <<< $file`
-  echo $base
-  if [ -z $searchPolicy ]; then
-   bin/scipdagger -r $freq -s scip.set -t $time -f $dir/$file --nodepru policy $killPolicy &> $resultDir/$data/$experiment/$base.log
-  elif [ -z $killPolicy ]; then
-   bin/scipdagger -r $freq -s scip.set -t $time -f $dir/$file --nodesel policy $searchPolicy &> $resultDir/$data/$experiment/$base.log
-  else
-   bin/scipdagger -r $freq -s scip.set -t $time -f $dir/$file --nodesel policy $searchPolicy --nodepru policy $killPolicy &> $resultDir/$data/$experiment/$base.log
-  fi
-done
+# Solve the whole directory in one process; the log of each problem is written to $base.log
+batch="-r $freq -s scip.set -t $time --batch $dir -x $suffix --batchout $resultDir/$data/$experiment"
+# With feature masks (comma separated, bit i masks feature i), every mask is solved in the same process and written to
+# $resultDir/$data/$experiment/featmask.<search>.<kill>
+if ! [ -z $searchMasks ]; then
+  batch="$batch --nodeselmask $searchMasks"
+fi
+if ! [ -z $killMasks ]; then
+  batch="$batch --nodeprumask $killMasks"
+fi
+if [ -z $searchPolicy ]; then
+  bin/scipdagger $batch --nodepru policy $killPolicy
+elif [ -z $killPolicy ]; then
+  bin/scipdagger $batch --nodesel policy $searchPolicy
+else
+  bin/scipdagger $batch --nodesel policy $searchPolicy --nodepru policy $killPolicy
+fi
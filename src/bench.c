@@ -0,0 +1,863 @@
+/**@file   bench.c
+ * @brief  microbenchmarks of the feature, scoring, comparison and I/O hot paths of the plugins
+ * @author He He
+ *
+ * The benchmarks run on real nodes: a multi-dimensional knapsack problem with random (seeded) coefficients, or a
+ * given problem, is solved with a best-bound node selector until the requested number of nodes is open; the open
+ * nodes are the population on which the following paths are timed:
+ * - selfeat, prufeat: SCIPcalcNodeselFeat(), SCIPcalcNodepruFeat()
+ * - score: SCIPcalcNodeScore() with a random policy of the size the plugins read
+ * - comp/policy, comp/dagger: the comparators of the policy and dagger node selectors, called through SCIP as in the
+ *   node queue, on random pairs of nodes
+ * - write: SCIPfeatDiffLIBSVMPrint() of random pairs to a temporary trajectory file
+ * - readpolicy: SCIPreadLIBSVMPolicy() of the random policy
+ * - readsol: SCIPreadOptSol() of the solution of the problem
+ *
+ * Each benchmark is calibrated to take at least the minimal time per repetition and repeated; the table shows the
+ * median and minimum ns/op, the spread of the repetitions ((max - min) / median), the growth of the memory of SCIP per
+ * op (which is 0 unless a path leaks) and the bytes read or written per op. The latency and effort event handlers are
+ * not included, so the paths are timed without instrumentation. For comparisons between commits, use the same
+ * arguments and seed, keep the machine idle and pin the process (e.g. taskset -c 2), and compare the medians.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "scip/scip.h"
+#include "scip/scipdefplugins.h"
+#include "scip/nodesel.h"
+#include "scip/struct_scip.h"
+
+#include "nodesel_oracle.h"
+#include "nodesel_dagger.h"
+#include "nodesel_policy.h"
+#include "feat.h"
+#include "genmik.h"
+#include "hist.h"
+#include "policy.h"
+#include "struct_feat.h"
+#include "struct_policy.h"
+
+#define NODESEL_NAME            "bench"
+#define NODESEL_DESC            "best bound node selector which runs the microbenchmarks on the open nodes"
+#define NODESEL_STDPRIORITY     10000000
+#define NODESEL_MEMSAVEPRIORITY 0
+
+#define DEFAULT_NVARS           200       /**< number of variables of the synthetic problem */
+#define DEFAULT_NCONSS          10        /**< number of knapsack constraints of the synthetic problem */
+#define DEFAULT_NNODES          1000      /**< number of open nodes to benchmark on */
+#define DEFAULT_NREPS           7         /**< number of timed repetitions of each benchmark */
+#define DEFAULT_MINTIME         100       /**< minimal time of a repetition in milliseconds */
+#define DEFAULT_SEED            1         /**< seed of the problem, the policy and the node pairs */
+
+#define BENCH_MAXREPS           64
+#define BENCH_MAXOPS            (1LL << 32)
+
+/*
+ * Data structures
+ */
+
+/** node selector data, which holds the benchmark setup and the population */
+struct SCIP_NodeselData
+{
+   SCIP_NODE**        nodes;              /**< population of open nodes */
+   SCIP_FEAT**        selfeats;           /**< node selection features of the population */
+   SCIP_FEAT**        prufeats;           /**< node pruning features of the population */
+   int*               pairs;              /**< indices of the compared and written node pairs, two per node */
+   SCIP_POLICY*       policy;             /**< random policy, also written to polfname */
+   SCIP_SOL*          optsol;             /**< solution by which the nodes are labeled like by the oracle */
+   SCIP_NODESEL*      policynodesel;      /**< policy node selector */
+   SCIP_NODESEL*      daggernodesel;      /**< dagger node selector */
+   FILE*              trjfile;            /**< temporary trajectory file of the write benchmark */
+   FILE*              wfile;              /**< temporary weight file of the write benchmark */
+   FILE*              csvfile;            /**< file to write the results to as CSV, or NULL */
+   const char*        solfname;           /**< solution file of the problem */
+   const char*        polfname;           /**< policy file */
+   SCIP_Longint       mintime;            /**< minimal time of a repetition in nanoseconds */
+   SCIP_Longint       iobytes;            /**< bytes read or written in the current repetition */
+   SCIP_Longint       sink;               /**< sum of the comparison results, so that they are used */
+   unsigned int       seed;               /**< seed of the node pairs */
+   int                nnodes;             /**< size of the population */
+   int                targetnodes;        /**< number of open nodes at which the benchmarks run */
+   int                nreps;              /**< number of timed repetitions */
+   SCIP_RETCODE       retcode;            /**< result of the benchmarks */
+   SCIP_Bool          done;               /**< have the benchmarks run? */
+};
+
+/** benchmark of a hot path: performs nops operations on the population */
+#define BENCH_DECL(x) SCIP_RETCODE x (SCIP* scip, SCIP_NODESELDATA* data, SCIP_Longint nops)
+typedef BENCH_DECL((*BENCH_FUNC));
+
+/*
+ * Benchmarks
+ */
+
+/** SCIPcalcNodeselFeat() */
+static
+BENCH_DECL(benchSelFeat)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      int i = (int)(k % data->nnodes);
+      SCIPcalcNodeselFeat(scip, data->nodes[i], data->selfeats[i]);
+   }
+
+   return SCIP_OKAY;
+}
+
+/** SCIPcalcNodepruFeat() */
+static
+BENCH_DECL(benchPruFeat)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      int i = (int)(k % data->nnodes);
+      SCIPcalcNodepruFeat(scip, data->nodes[i], data->prufeats[i]);
+   }
+
+   return SCIP_OKAY;
+}
+
+/** SCIPcalcNodeScore() */
+static
+BENCH_DECL(benchScore)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      int i = (int)(k % data->nnodes);
+      SCIPcalcNodeScore(data->nodes[i], data->selfeats[i], data->policy);
+   }
+
+   return SCIP_OKAY;
+}
+
+/** comparator of the policy node selector */
+static
+BENCH_DECL(benchCompPolicy)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      int i = (int)(k % data->nnodes);
+      data->sink += SCIPnodeselCompare(data->policynodesel, scip->set, data->nodes[data->pairs[2 * i]],
+         data->nodes[data->pairs[2 * i + 1]]);
+   }
+
+   return SCIP_OKAY;
+}
+
+/** comparator of the dagger node selector */
+static
+BENCH_DECL(benchCompDagger)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      int i = (int)(k % data->nnodes);
+      data->sink += SCIPnodeselCompare(data->daggernodesel, scip->set, data->nodes[data->pairs[2 * i]],
+         data->nodes[data->pairs[2 * i + 1]]);
+   }
+
+   return SCIP_OKAY;
+}
+
+/** SCIPfeatDiffLIBSVMPrint(); the files are rewound after each repetition, which flushes them */
+static
+BENCH_DECL(benchWrite)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      int i = (int)(k % data->nnodes);
+      SCIPfeatDiffLIBSVMPrint(scip, data->trjfile, data->wfile, data->selfeats[data->pairs[2 * i]],
+         data->selfeats[data->pairs[2 * i + 1]], 1, (SCIP_Bool)(k & 1));
+   }
+
+   data->iobytes += ftell(data->trjfile) + ftell(data->wfile);
+   rewind(data->trjfile);
+   rewind(data->wfile);
+
+   return SCIP_OKAY;
+}
+
+/** returns the size of a file, or 0 */
+static
+SCIP_Longint fileSize(
+   const char*           fname               /**< file name */
+   )
+{
+   struct stat st;
+
+   if( stat(fname, &st) != 0 )
+      return 0;
+   return (SCIP_Longint)st.st_size;
+}
+
+/** SCIPreadLIBSVMPolicy() */
+static
+BENCH_DECL(benchReadPolicy)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      SCIP_POLICY* policy;
+
+      SCIP_CALL( SCIPpolicyCreate(scip, &policy) );
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, (char*)data->polfname, &policy) );
+      SCIP_CALL( SCIPpolicyFree(scip, &policy) );
+   }
+   data->iobytes += nops * fileSize(data->polfname);
+
+   return SCIP_OKAY;
+}
+
+/** SCIPreadOptSol() */
+static
+BENCH_DECL(benchReadSol)
+{
+   SCIP_Longint k;
+
+   for( k = 0; k < nops; k++ )
+   {
+      SCIP_SOL* sol;
+
+      SCIP_CALL( SCIPreadOptSol(scip, data->solfname, &sol) );
+      SCIP_CALL( SCIPfreeSolSelf(scip, &sol) );
+   }
+   data->iobytes += nops * fileSize(data->solfname);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * Local methods
+ */
+
+/** sorts nanoseconds per op */
+static
+int nsComp(
+   const void*           elem1,              /**< first value */
+   const void*           elem2               /**< second value */
+   )
+{
+   double ns1 = *(const double*)elem1;
+   double ns2 = *(const double*)elem2;
+
+   return ns1 < ns2 ? -1 : (ns1 > ns2 ? 1 : 0);
+}
+
+/** calibrates and runs a benchmark and prints its result */
+static
+SCIP_RETCODE benchRun(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     data,               /**< benchmark data */
+   const char*           name,               /**< name of the benchmark */
+   BENCH_FUNC            func,               /**< benchmark */
+   SCIP_Longint          nops                /**< initial number of operations per repetition */
+   )
+{
+   double nsop[BENCH_MAXREPS];
+   SCIP_Longint memused;
+   SCIP_Longint membytes;
+   SCIP_Longint iobytes;
+   SCIP_Longint start;
+   SCIP_Longint time;
+   int r;
+
+   /* warm up and double the number of operations until a repetition takes the minimal time */
+   for( ;; )
+   {
+      start = SCIPhistGetTime();
+      SCIP_CALL( func(scip, data, nops) );
+      time = SCIPhistGetTime() - start;
+      if( time >= data->mintime || nops >= BENCH_MAXOPS )
+         break;
+      nops *= 2;
+   }
+
+   membytes = 0;
+   iobytes = 0;
+   for( r = 0; r < data->nreps; r++ )
+   {
+      data->iobytes = 0;
+      memused = SCIPgetMemUsed(scip);
+      start = SCIPhistGetTime();
+      SCIP_CALL( func(scip, data, nops) );
+      time = SCIPhistGetTime() - start;
+      membytes += SCIPgetMemUsed(scip) - memused;
+      iobytes += data->iobytes;
+      nsop[r] = (double)time / (double)nops;
+   }
+   qsort(nsop, (size_t)data->nreps, sizeof(double), nsComp);
+
+   printf("%-12s %8d %12"SCIP_LONGINT_FORMAT" %10.1f %10.1f %7.1f%% %10.1f %10.1f\n", name, data->nnodes, nops,
+      nsop[data->nreps / 2], nsop[0], 100.0 * (nsop[data->nreps - 1] - nsop[0]) / nsop[data->nreps / 2],
+      (double)membytes / ((double)nops * data->nreps), (double)iobytes / ((double)nops * data->nreps));
+   if( data->csvfile != NULL )
+      fprintf(data->csvfile, "%s,%d,%"SCIP_LONGINT_FORMAT",%.2f,%.2f,%.4f,%.2f,%.2f\n", name, data->nnodes, nops,
+         nsop[data->nreps / 2], nsop[0], (nsop[data->nreps - 1] - nsop[0]) / nsop[data->nreps / 2],
+         (double)membytes / ((double)nops * data->nreps), (double)iobytes / ((double)nops * data->nreps));
+
+   return SCIP_OKAY;
+}
+
+/** collects the population, computes its features and runs all benchmarks */
+static
+SCIP_RETCODE benchAll(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     data                /**< benchmark data */
+   )
+{
+   SCIP_NODE** leaves;
+   SCIP_NODE** children;
+   SCIP_NODE** siblings;
+   int nleaves;
+   int nchildren;
+   int nsiblings;
+   int maxdepth;
+   int i;
+
+   SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
+   data->nnodes = MIN(nleaves + nchildren + nsiblings, data->targetnodes);
+
+   SCIP_ALLOC( BMSallocMemoryArray(&data->nodes, data->nnodes) );
+   SCIP_ALLOC( BMSallocMemoryArray(&data->selfeats, data->nnodes) );
+   SCIP_ALLOC( BMSallocMemoryArray(&data->prufeats, data->nnodes) );
+   SCIP_ALLOC( BMSallocMemoryArray(&data->pairs, 2 * data->nnodes) );
+
+   maxdepth = SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip);
+   for( i = 0; i < data->nnodes; i++ )
+   {
+      if( i < nleaves )
+         data->nodes[i] = leaves[i];
+      else if( i < nleaves + nchildren )
+         data->nodes[i] = children[i - nleaves];
+      else
+         data->nodes[i] = siblings[i - nleaves - nchildren];
+
+      SCIP_CALL( SCIPfeatCreate(scip, &data->selfeats[i], SCIP_FEATNODESEL_SIZE) );
+      SCIPfeatSetMaxDepth(data->selfeats[i], maxdepth);
+      SCIP_CALL( SCIPfeatCreate(scip, &data->prufeats[i], SCIP_FEATNODEPRU_SIZE) );
+      SCIPfeatSetMaxDepth(data->prufeats[i], maxdepth);
+
+      /* the comparators need the scores the node selectors set */
+      SCIPcalcNodeselFeat(scip, data->nodes[i], data->selfeats[i]);
+      SCIPcalcNodepruFeat(scip, data->nodes[i], data->prufeats[i]);
+      SCIPcalcNodeScore(data->nodes[i], data->selfeats[i], data->policy);
+   }
+
+   /* random pairs of distinct nodes */
+   for( i = 0; i < data->nnodes; i++ )
+   {
+      data->pairs[2 * i] = SCIPgetRandomInt(0, data->nnodes - 1, &data->seed);
+      data->pairs[2 * i + 1] = (data->pairs[2 * i] + SCIPgetRandomInt(1, data->nnodes - 1, &data->seed)) % data->nnodes;
+   }
+
+   data->trjfile = tmpfile();
+   data->wfile = tmpfile();
+   if( data->trjfile == NULL || data->wfile == NULL )
+   {
+      SCIPerrorMessage("cannot create temporary trajectory files\n");
+      return SCIP_FILECREATEERROR;
+   }
+
+   printf("%d open nodes at depth up to %d, maximal depth %d\n", data->nnodes, SCIPgetMaxDepth(scip), maxdepth);
+   printf("%-12s %8s %12s %10s %10s %8s %10s %10s\n", "benchmark", "nodes", "ops", "ns/op", "min ns/op", "spread",
+      "mem B/op", "io B/op");
+   if( data->csvfile != NULL )
+      fprintf(data->csvfile, "benchmark,nodes,ops,nsop,minnsop,spread,membytes,iobytes\n");
+
+   SCIP_CALL( benchRun(scip, data, "selfeat", benchSelFeat, data->nnodes) );
+   SCIP_CALL( benchRun(scip, data, "prufeat", benchPruFeat, data->nnodes) );
+   SCIP_CALL( benchRun(scip, data, "score", benchScore, data->nnodes) );
+   SCIP_CALL( benchRun(scip, data, "comp/policy", benchCompPolicy, data->nnodes) );
+   SCIP_CALL( benchRun(scip, data, "comp/dagger", benchCompDagger, data->nnodes) );
+   SCIP_CALL( benchRun(scip, data, "write", benchWrite, data->nnodes) );
+   SCIP_CALL( benchRun(scip, data, "readpolicy", benchReadPolicy, 1) );
+   SCIP_CALL( benchRun(scip, data, "readsol", benchReadSol, 1) );
+
+   fclose(data->wfile);
+   fclose(data->trjfile);
+   for( i = data->nnodes - 1; i >= 0; i-- )
+   {
+      SCIP_CALL( SCIPfeatFree(scip, &data->prufeats[i]) );
+      SCIP_CALL( SCIPfeatFree(scip, &data->selfeats[i]) );
+   }
+   BMSfreeMemoryArray(&data->pairs);
+   BMSfreeMemoryArray(&data->prufeats);
+   BMSfreeMemoryArray(&data->selfeats);
+   BMSfreeMemoryArray(&data->nodes);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of node selector
+ */
+
+/** solving process initialization method of node selector */
+static
+SCIP_DECL_NODESELINIT(nodeselInitBench)
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIP_CALL( SCIPreadOptSol(scip, nodeseldata->solfname, &nodeseldata->optsol) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of node selector */
+static
+SCIP_DECL_NODESELEXIT(nodeselExitBench)
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIP_CALL( SCIPfreeSolSelf(scip, &nodeseldata->optsol) );
+
+   return SCIP_OKAY;
+}
+
+/** node selection method of node selector: labels the children like the oracle, so that the dagger comparator sees
+ *  labeled nodes, runs the benchmarks once enough nodes are open and selects the node with the best bound
+ */
+static
+SCIP_DECL_NODESELSELECT(nodeselSelectBench)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_NODE** children;
+   int nchildren;
+   int i;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIP_CALL( SCIPgetChildren(scip, &children, &nchildren) );
+   for( i = 0; i < nchildren; i++ )
+   {
+      if( !SCIPnodeIsOptchecked(children[i]) )
+      {
+         SCIP_CALL( SCIPnodeCheckOptimal(scip, children[i], nodeseldata->optsol) );
+         SCIPnodeSetOptchecked(children[i]);
+      }
+   }
+
+   if( !nodeseldata->done && SCIPgetNNodesLeft(scip) >= nodeseldata->targetnodes )
+   {
+      nodeseldata->done = TRUE;
+      nodeseldata->retcode = benchAll(scip, nodeseldata);
+      SCIP_CALL( SCIPinterruptSolve(scip) );
+   }
+
+   *selnode = SCIPgetBestboundNode(scip);
+
+   return SCIP_OKAY;
+}
+
+/** node comparison method of node selector: best bound */
+static
+SCIP_DECL_NODESELCOMP(nodeselCompBench)
+{
+   SCIP_Real lowerbound1;
+   SCIP_Real lowerbound2;
+
+   lowerbound1 = SCIPnodeGetLowerbound(node1);
+   lowerbound2 = SCIPnodeGetLowerbound(node2);
+   if( SCIPisLT(scip, lowerbound1, lowerbound2) )
+      return -1;
+   else if( SCIPisGT(scip, lowerbound1, lowerbound2) )
+      return +1;
+   else
+      return 0;
+}
+
+/*
+ * Problem and files
+ */
+
+/** creates a multi-dimensional knapsack problem with random coefficients, profits correlated with the weights, and
+ *  capacities of half the total weights; writes a greedy solution to the solution file
+ */
+static
+SCIP_RETCODE createKnapsackProb(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   nvars,              /**< number of items */
+   int                   nconss,             /**< number of knapsack constraints */
+   unsigned int          seed,               /**< random seed */
+   const char*           solfname            /**< solution file to write */
+   )
+{
+   SCIP_VAR** vars;
+   int* weights;
+   int* profits;
+   int* capacities;
+   int* loads;
+   char name[SCIP_MAXSTRLEN];
+   FILE* file;
+   int objective;
+   int i;
+   int j;
+
+   SCIP_ALLOC( BMSallocMemoryArray(&vars, nvars) );
+   SCIP_ALLOC( BMSallocMemoryArray(&weights, nconss * nvars) );
+   SCIP_ALLOC( BMSallocMemoryArray(&profits, nvars) );
+   SCIP_ALLOC( BMSallocClearMemoryArray(&capacities, nconss) );
+   SCIP_ALLOC( BMSallocClearMemoryArray(&loads, nconss) );
+
+   for( j = 0; j < nvars; j++ )
+   {
+      int sum = 0;
+
+      for( i = 0; i < nconss; i++ )
+      {
+         weights[i * nvars + j] = SCIPgetRandomInt(1, 100, &seed);
+         capacities[i] += weights[i * nvars + j];
+         sum += weights[i * nvars + j];
+      }
+      profits[j] = sum / nconss + SCIPgetRandomInt(1, 10, &seed);
+   }
+
+   SCIP_CALL( SCIPcreateProbBasic(scip, "bench") );
+   SCIP_CALL( SCIPsetObjsense(scip, SCIP_OBJSENSE_MAXIMIZE) );
+   for( j = 0; j < nvars; j++ )
+   {
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "x%d", j);
+      SCIP_CALL( SCIPcreateVarBasic(scip, &vars[j], name, 0.0, 1.0, (SCIP_Real)profits[j], SCIP_VARTYPE_BINARY) );
+      SCIP_CALL( SCIPaddVar(scip, vars[j]) );
+   }
+   for( i = 0; i < nconss; i++ )
+   {
+      SCIP_CONS* cons;
+
+      capacities[i] /= 2;
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "c%d", i);
+      SCIP_CALL( SCIPcreateConsBasicLinear(scip, &cons, name, 0, NULL, NULL, -SCIPinfinity(scip),
+            (SCIP_Real)capacities[i]) );
+      for( j = 0; j < nvars; j++ )
+      {
+         SCIP_CALL( SCIPaddCoefLinear(scip, cons, vars[j], (SCIP_Real)weights[i * nvars + j]) );
+      }
+      SCIP_CALL( SCIPaddCons(scip, cons) );
+      SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+   }
+
+   file = fopen(solfname, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", solfname);
+      SCIPprintSysError(solfname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   /* greedy solution: take the items in order while they fit */
+   objective = 0;
+   for( j = 0; j < nvars; j++ )
+   {
+      for( i = 0; i < nconss && loads[i] + weights[i * nvars + j] <= capacities[i]; i++ );
+      if( i < nconss )
+         continue;
+      for( i = 0; i < nconss; i++ )
+         loads[i] += weights[i * nvars + j];
+      objective += profits[j];
+   }
+   fprintf(file, "solution status: feasible\nobjective value: %d\n", objective);
+   for( i = 0; i < nconss; i++ )
+      loads[i] = 0;
+   for( j = 0; j < nvars; j++ )
+   {
+      for( i = 0; i < nconss && loads[i] + weights[i * nvars + j] <= capacities[i]; i++ );
+      if( i < nconss )
+         continue;
+      for( i = 0; i < nconss; i++ )
+         loads[i] += weights[i * nvars + j];
+      fprintf(file, "%s 1 \t(obj:%d)\n", SCIPvarGetName(vars[j]), profits[j]);
+   }
+   fclose(file);
+
+   for( j = 0; j < nvars; j++ )
+   {
+      SCIP_CALL( SCIPreleaseVar(scip, &vars[j]) );
+   }
+   BMSfreeMemoryArray(&loads);
+   BMSfreeMemoryArray(&capacities);
+   BMSfreeMemoryArray(&profits);
+   BMSfreeMemoryArray(&weights);
+   BMSfreeMemoryArray(&vars);
+
+   return SCIP_OKAY;
+}
+
+/** writes a solution with all original variables at 0, for problems without a solution file */
+static
+SCIP_RETCODE writeZeroSol(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           solfname            /**< solution file to write */
+   )
+{
+   SCIP_VAR** vars;
+   FILE* file;
+   int nvars;
+   int j;
+
+   file = fopen(solfname, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", solfname);
+      SCIPprintSysError(solfname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   vars = SCIPgetOrigVars(scip);
+   nvars = SCIPgetNOrigVars(scip);
+   fprintf(file, "solution status: feasible\nobjective value: 0\n");
+   for( j = 0; j < nvars; j++ )
+      fprintf(file, "%s 0 \t(obj:0)\n", SCIPvarGetName(vars[j]));
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** creates a policy with random weights in [-1,1] which covers all depths of the problem and writes it */
+static
+SCIP_RETCODE createRandomPolicy(
+   SCIP_POLICY*          policy,             /**< policy with NULL weights */
+   int                   maxdepth,           /**< maximal depth of the features */
+   unsigned int          seed,               /**< random seed */
+   const char*           polfname            /**< policy file to write */
+   )
+{
+   int i;
+
+   policy->size = SCIPfeatCalcOffset(SCIP_FEATNODESEL_SIZE, maxdepth, maxdepth, SCIP_BOUNDTYPE_UPPER)
+      + SCIP_FEATNODESEL_SIZE;
+   SCIP_ALLOC( BMSallocMemoryArray(&policy->weights, policy->size) );
+   for( i = 0; i < policy->size; i++ )
+      policy->weights[i] = SCIPgetRandomReal(-1.0, 1.0, &seed);
+
+   SCIP_CALL( SCIPwriteLIBSVMPolicy(policy, polfname, "bench") );
+
+   return SCIP_OKAY;
+}
+
+/** runs the benchmarks
+ *
+ *  syntax: scipdagger_bench [-n <nvars>] [-m <nconss>] [-g <mik>] [-f <problem> [-s <solfile>]] [-p <nodes>]
+ *                           [-r <reps>] [-t <ms>] [-S <seed>] [-o <csvfile>]
+ */
+static
+SCIP_RETCODE runBench(
+   int                   argc,               /**< number of shell parameters */
+   char**                argv                /**< array with shell parameters */
+   )
+{
+   SCIP* scip;
+   SCIP_NODESEL* nodesel;
+   SCIP_NODESELDATA data;
+   SCIP_POLICY policy;
+   char solfname[SCIP_MAXSTRLEN];
+   char polfname[SCIP_MAXSTRLEN];
+   const char* probfname = NULL;
+   const char* optsolfname = NULL;
+   const char* csvfname = NULL;
+   const char* miksize = NULL;
+   SCIP_Bool paramerror = FALSE;
+   unsigned int seed = DEFAULT_SEED;
+   int nvars = DEFAULT_NVARS;
+   int nconss = DEFAULT_NCONSS;
+   int nmikintvars = 0;
+   int nmikcontvars = 0;
+   int nmikconss = 0;
+   int maxdepth;
+   int i;
+
+   BMSclearMemory(&data);
+   data.targetnodes = DEFAULT_NNODES;
+   data.nreps = DEFAULT_NREPS;
+   data.mintime = DEFAULT_MINTIME * 1000000LL;
+   data.retcode = SCIP_OKAY;
+
+   for( i = 1; i < argc && !paramerror; ++i )
+   {
+      if( i + 1 >= argc || argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' )
+         paramerror = TRUE;
+      else if( argv[i][1] == 'n' )
+         nvars = atoi(argv[++i]);
+      else if( argv[i][1] == 'm' )
+         nconss = atoi(argv[++i]);
+      else if( argv[i][1] == 'g' )
+      {
+         miksize = argv[++i];
+         if( sscanf(miksize, "%d-%d-%d", &nmikintvars, &nmikcontvars, &nmikconss) != 3 )
+            paramerror = TRUE;
+      }
+      else if( argv[i][1] == 'f' )
+         probfname = argv[++i];
+      else if( argv[i][1] == 's' )
+         optsolfname = argv[++i];
+      else if( argv[i][1] == 'p' )
+         data.targetnodes = atoi(argv[++i]);
+      else if( argv[i][1] == 'r' )
+         data.nreps = atoi(argv[++i]);
+      else if( argv[i][1] == 't' )
+         data.mintime = atoll(argv[++i]) * 1000000LL;
+      else if( argv[i][1] == 'S' )
+         seed = (unsigned int)atoi(argv[++i]);
+      else if( argv[i][1] == 'o' )
+         csvfname = argv[++i];
+      else
+         paramerror = TRUE;
+   }
+
+   if( paramerror || nvars < 10 || nconss < 1 || data.targetnodes < 2 || data.nreps < 1
+      || data.nreps > BENCH_MAXREPS || data.mintime <= 0 || (optsolfname != NULL && probfname == NULL) || (miksize != NULL && probfname != NULL)
+      || (miksize != NULL && (nmikconss < 1 || nmikcontvars < 0 || nmikintvars <= 2 * nmikconss)) )
+   {
+      printf("syntax: %s [-n <nvars>] [-m <nconss>] [-g <mik>] [-f <problem> [-s <solfile>]] [-p <nodes>] [-r <reps>]\n"
+         "       [-t <ms>] [-S <seed>] [-o <csvfile>]\n"
+         "  -n <nvars>    : number of variables of the synthetic knapsack problem, at least 10 (default %d)\n"
+         "  -m <nconss>   : number of knapsack constraints (default %d)\n"
+         "  -g <n>-<m>-<k>: benchmark on a synthetic MIK problem mik.<n>-<m>-<k> instead, see genmik.c\n"
+         "  -f <problem>  : benchmark on a problem file instead\n"
+         "  -s <solfile>  : optimal solution of the problem file (default: all variables 0)\n"
+         "  -p <nodes>    : number of open nodes to benchmark on (default %d)\n"
+         "  -r <reps>     : timed repetitions of each benchmark, at most %d (default %d)\n"
+         "  -t <ms>       : minimal time of a repetition (default %d)\n"
+         "  -S <seed>     : seed of the problem, the policy and the node pairs (default %d)\n"
+         "  -o <csvfile>  : also write the results as CSV\n",
+         argv[0], DEFAULT_NVARS, DEFAULT_NCONSS, DEFAULT_NNODES, BENCH_MAXREPS, DEFAULT_NREPS, DEFAULT_MINTIME,
+         DEFAULT_SEED);
+      return SCIP_OKAY;
+   }
+
+   (void) SCIPsnprintf(solfname, SCIP_MAXSTRLEN, "/tmp/scipdagger_bench.%d.sol", (int)getpid());
+   (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "/tmp/scipdagger_bench.%d.pol", (int)getpid());
+   data.solfname = optsolfname != NULL ? optsolfname : solfname;
+   data.polfname = polfname;
+   data.seed = seed;
+
+   if( csvfname != NULL )
+   {
+      data.csvfile = fopen(csvfname, "w");
+      if( data.csvfile == NULL )
+      {
+         SCIPerrorMessage("cannot open file <%s> for writing\n", csvfname);
+         SCIPprintSysError(csvfname);
+         return SCIP_FILECREATEERROR;
+      }
+   }
+
+   SCIP_CALL( SCIPcreate(&scip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
+   SCIP_CALL( SCIPincludeNodeselPolicy(scip) );
+   SCIP_CALL( SCIPincludeNodeselDagger(scip) );
+   SCIP_CALL( SCIPincludeNodeselBasic(scip, &nodesel, NODESEL_NAME, NODESEL_DESC, NODESEL_STDPRIORITY,
+         NODESEL_MEMSAVEPRIORITY, nodeselSelectBench, nodeselCompBench, &data) );
+   SCIP_CALL( SCIPsetNodeselInit(scip, nodesel, nodeselInitBench) );
+   SCIP_CALL( SCIPsetNodeselExit(scip, nodesel, nodeselExitBench) );
+   SCIPsetMessagehdlrQuiet(scip, TRUE);
+
+   if( probfname != NULL )
+   {
+      SCIP_CALL( SCIPreadProb(scip, probfname, NULL) );
+      if( optsolfname == NULL )
+      {
+         SCIP_CALL( writeZeroSol(scip, solfname) );
+      }
+   }
+   else if( miksize != NULL )
+   {
+      SCIP_CALL( SCIPcreateProbMik(scip, nmikintvars, nmikcontvars, nmikconss, seed) );
+      SCIP_CALL( writeZeroSol(scip, solfname) );
+   }
+   else
+   {
+      SCIP_CALL( createKnapsackProb(scip, nvars, nconss, seed, solfname) );
+   }
+
+   /* the policy covers the depths of the problem; the plugins read it, the score benchmark uses it in memory */
+   maxdepth = SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip);
+   if( maxdepth < 10 )
+   {
+      SCIPerrorMessage("problem has only %d integer variables, the features need at least 10\n", maxdepth);
+      return SCIP_INVALIDDATA;
+   }
+   policy.weights = NULL;
+   policy.depthbounds = NULL;
+   policy.depthbuckets = NULL;
+   policy.ndepthbounds = 0;
+   SCIP_CALL( createRandomPolicy(&policy, maxdepth, seed, polfname) );
+   data.policy = &policy;
+
+   data.policynodesel = SCIPfindNodesel(scip, "policy");
+   data.daggernodesel = SCIPfindNodesel(scip, "dagger");
+   SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/policy/polfname", polfname) );
+   SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/polfname", polfname) );
+   SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/solfname", data.solfname) );
+
+   /* grow the tree fast: no presolving and cuts, cheap branching; the heuristics give the features an incumbent */
+   SCIP_CALL( SCIPsetPresolving(scip, SCIP_PARAMSETTING_OFF, TRUE) );
+   SCIP_CALL( SCIPsetSeparating(scip, SCIP_PARAMSETTING_OFF, TRUE) );
+   SCIP_CALL( SCIPsetHeuristics(scip, SCIP_PARAMSETTING_FAST, TRUE) );
+   SCIP_CALL( SCIPsetIntParam(scip, "branching/pscost/priority", 1000000) );
+
+   printf("benchmarking on %s, %d open nodes, %d repetitions of at least %"SCIP_LONGINT_FORMAT" ms\n",
+      probfname != NULL ? probfname : (miksize != NULL ? "a synthetic MIK problem" : "a synthetic knapsack problem"), data.targetnodes, data.nreps,
+      data.mintime / 1000000);
+   SCIP_CALL( SCIPsolve(scip) );
+
+   if( !data.done )
+   {
+      printf("the problem was solved after %"SCIP_LONGINT_FORMAT" nodes before %d nodes were open; use a larger "
+         "problem or fewer nodes\n", SCIPgetNNodes(scip), data.targetnodes);
+      data.retcode = SCIP_INVALIDDATA;
+   }
+
+   SCIP_CALL( SCIPfree(&scip) );
+   BMSfreeMemoryArray(&policy.weights);
+   if( data.csvfile != NULL )
+      fclose(data.csvfile);
+   (void) remove(polfname);
+   if( optsolfname == NULL )
+      (void) remove(solfname);
+
+   BMScheckEmptyMemory();
+
+   return data.retcode;
+}
+
+int
+main(
+   int                        argc,
+   char**                     argv
+   )
+{
+   SCIP_RETCODE retcode;
+
+   retcode = runBench(argc, argv);
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPprintError(retcode);
+      return -1;
+   }
+
+   return 0;
+}
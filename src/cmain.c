@@ -4,6 +4,10 @@
  */
 #include <stdio.h>
 #include <string.h>
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
 
 #include "scip/scip.h"
 #include "scip/scipshell.h"
@@ -12,9 +16,25 @@
 #include "nodesel_oracle.h"
 #include "nodesel_dagger.h"
 #include "nodesel_policy.h"
+#include "nodesel_online.h"
 #include "nodepru_oracle.h"
 #include "nodepru_dagger.h"
 #include "nodepru_policy.h"
+#include "nodepru_online.h"
+#include "eventhdlr_effort.h"
+#include "eventhdlr_latency.h"
+#include "eventhdlr_trace.h"
+#include "eventhdlr_treemem.h"
+#include "eventhdlr_telemetry.h"
+#include "feat.h"
+#include "dataset.h"
+#include "policy.h"
+#include "train.h"
+#include "pool.h"
+#include "record.h"
+#include "replay.h"
+#include "genmik.h"
+#include "struct_policy.h"
 
 /* disable heuristics */
 static
@@ -54,11 +74,127 @@ void disableSepas(
    }
 }
 
+/* restrict the solver: below 1, use most infeasible branching and run heuristics and separators with frequency freq */
+static
+SCIP_RETCODE setRestrictionLevel(
+   SCIP*                 scip,
+   int                   freq
+   )
+{
+   if( freq < 1 )
+   {
+      /* use most infeasible branching */
+      SCIP_BRANCHRULE* branch_rule = NULL;
+      branch_rule = SCIPfindBranchrule( scip, "mostinf" );
+      SCIP_CALL( SCIPsetBranchrulePriority( scip, branch_rule, 9999999 ) );
+      printf("Using most infeasible branching\n");
+
+      disableHeurs(scip, freq);
+      disableSepas(scip, freq);
+      if( freq == 0 )
+         printf("Using heuristics and separators only at root\n");
+      else if( freq == -1 )
+         printf("Disabled heuristics and separators\n");
+   }
+
+   return SCIP_OKAY;
+}
+
+#define FEATMASK_MAXVALS        32           /**< maximum number of feature masks of an ablation batch */
+
+/** parses a comma separated list of feature masks (bit i masks feature i); returns the number of masks or -1 on
+ *  error
+ */
+static
+int parseMaskList(
+   const char*                str,                /**< list to parse */
+   int*                       masks,              /**< array to store the masks */
+   int                        maxmasks            /**< size of the array */
+   )
+{
+   int nmasks = 0;
+
+   while( *str != '\0' )
+   {
+      char* end;
+      long mask;
+
+      if( nmasks >= maxmasks )
+         return -1;
+      mask = strtol(str, &end, 0);
+      if( end == str || mask < 0 || mask > INT_MAX || (*end != ',' && *end != '\0') )
+         return -1;
+      masks[nmasks++] = (int)mask;
+      str = (*end == ',') ? end + 1 : end;
+   }
+
+   return nmasks;
+}
+
+/** compares two strings for sorting */
+static
+int strComp(
+   const void*                elem1,              /**< first string */
+   const void*                elem2               /**< second string */
+   )
+{
+   return strcmp(*(char* const*)elem1, *(char* const*)elem2);
+}
+
+/** lists the files of a directory with the given suffix, sorted by name; the names are allocated */
+static
+SCIP_RETCODE listProblems(
+   const char*                dirname,            /**< directory */
+   const char*                suffix,             /**< suffix of the problem files */
+   char***                    names,              /**< pointer to store the names */
+   int*                       nnames              /**< pointer to store the number of names */
+   )
+{
+   DIR* dir;
+   struct dirent* entry;
+   size_t suffixlen = strlen(suffix);
+   int size = 0;
+
+   *names = NULL;
+   *nnames = 0;
+
+   dir = opendir(dirname);
+   if( dir == NULL )
+   {
+      SCIPerrorMessage("cannot open directory <%s>\n", dirname);
+      SCIPprintSysError(dirname);
+      return SCIP_NOFILE;
+   }
+
+   while( (entry = readdir(dir)) != NULL )
+   {
+      size_t len = strlen(entry->d_name);
+
+      if( entry->d_name[0] == '.' || len <= suffixlen || strcmp(entry->d_name + len - suffixlen, suffix) != 0 )
+         continue;
+      if( *nnames == size )
+      {
+         size = MAX(2 * size, 64);
+         SCIP_ALLOC( BMSreallocMemoryArray(names, size) );
+      }
+      SCIP_ALLOC( BMSduplicateMemoryArray(&(*names)[*nnames], entry->d_name, len + 1) );
+      (*nnames)++;
+   }
+   closedir(dir);
+
+   if( *nnames > 0 )
+      qsort(*names, (size_t)*nnames, sizeof(char*), strComp);
+
+   return SCIP_OKAY;
+}
+
 static
 SCIP_RETCODE fromCommandLine(
    SCIP*                 scip,               /**< SCIP data structure */
    const char*           filename,           /**< input file name */
-   const char*           solfname            /**< input file name */
+   const char*           solfname,           /**< input file name */
+   SCIP_RECORD*          record,             /**< record to fill with the result of the solve, or NULL */
+   const char*           latencyfname        /**< JSON file to write the latency histograms to, or NULL */
    )
 {
    SCIP_RETCODE retcode;
@@ -86,17 +222,25 @@ SCIP_RETCODE fromCommandLine(
    {
    case SCIP_NOFILE:
       SCIPinfoMessage(scip, NULL, "file <%s> not found\n", filename);
-      return SCIP_OKAY;
+      break;
    case SCIP_PLUGINNOTFOUND:
       SCIPinfoMessage(scip, NULL, "no reader for input file <%s> available\n", filename);
-      return SCIP_OKAY;
+      break;
    case SCIP_READERROR:
       SCIPinfoMessage(scip, NULL, "error reading file <%s>\n", filename);
-      return SCIP_OKAY;
+      break;
    default:
       SCIP_CALL( retcode );
    } /*lint !e788*/
 
+   if( retcode != SCIP_OKAY )
+   {
+      /* the record of an unread problem only tells that it was not solved */
+      if( record != NULL )
+         SCIPrecordCollect(scip, filename, record);
+      return SCIP_OKAY;
+   }
+
    /*******************
     * Problem Solving *
     *******************/
@@ -131,6 +275,8 @@ SCIP_RETCODE fromCommandLine(
       SCIPnodeselpolicyPrintStatistics(scip, nodesel, NULL);
    else if( strcmp(nodeselname, "dagger") == 0 )
       SCIPnodeseldaggerPrintStatistics(scip, nodesel, NULL);
+   else if( strcmp(nodeselname, "online") == 0 )
+      SCIPnodeselonlinePrintStatistics(scip, nodesel, NULL);
 
    /* node pruner statistics */
    nodepru = SCIPgetNodepru(scip);
@@ -141,11 +287,508 @@ SCIP_RETCODE fromCommandLine(
          SCIPnodeprupolicyPrintStatistics(scip, nodepru, NULL);
       else if( strcmp(nodepruname, "dagger") == 0 )
          SCIPnodeprudaggerPrintStatistics(scip, nodepru, NULL);
+      else if( strcmp(nodepruname, "online") == 0 )
+         SCIPnodepruonlinePrintStatistics(scip, nodepru, NULL);
+   }
+
+   /* effort statistics */
+   if( SCIPfindEventhdlr(scip, "effort") != NULL )
+      SCIPeventhdlreffortPrintStatistics(scip, SCIPfindEventhdlr(scip, "effort"), NULL);
+
+   /* latency statistics */
+   if( SCIPeventhdlrlatencyFind(scip) != NULL )
+   {
+      SCIPeventhdlrlatencyPrintStatistics(scip, SCIPeventhdlrlatencyFind(scip), NULL);
+      if( latencyfname != NULL )
+      {
+         SCIP_CALL( SCIPeventhdlrlatencyWriteJson(SCIPeventhdlrlatencyFind(scip), filename, latencyfname) );
+      }
+   }
+
+   /* tree memory statistics */
+   if( SCIPeventhdlrtreememFind(scip) != NULL )
+      SCIPeventhdlrtreememPrintStatistics(scip, SCIPeventhdlrtreememFind(scip), NULL);
+
+   if( record != NULL )
+      SCIPrecordCollect(scip, filename, record);
+
+   return SCIP_OKAY;
+}
+
+/** evaluation of a directory of problems in one process */
+struct BatchRun
+{
+   SCIP**                scips;              /**< SCIP environment of each worker, reused for all its problems */
+   char**                probnames;          /**< problem file names */
+   const char*           datadir;            /**< directory of the problems */
+   const char*           soldir;             /**< directory of the optimal solutions, or NULL */
+   const char*           outdir;             /**< directory of the logs and the results */
+   const char*           suffix;             /**< suffix of the problem files */
+   const char*           nodeselname;        /**< name of the node selector, or NULL */
+   const char*           nodepruname;        /**< name of the node pruner, or NULL */
+   SCIP_RECORD*          records;            /**< result record of each problem */
+   SCIP**                baselines;          /**< default SCIP environment of each worker for the paired solves, or NULL */
+   SCIP_RECORD*          baselinerecords;    /**< result record of the paired solve of each problem, or NULL */
+   char                  pairedlimit;        /**< limits of the paired solves, see solveBaseline() */
+   SCIP_Bool             latency;            /**< write the latency histograms of each problem? */
+};
+typedef struct BatchRun BATCHRUN;
+
+/** solves the problem again with default SCIP, limited to the solving time ('t'), the number of nodes ('n'), both
+ *  ('b') or the effort in work units ('e') of the policy solve, such that the two results are directly comparable;
+ *  if the policy solve did not get to solving, the baseline is not solved either and recorded as such
+ */
+static
+SCIP_RETCODE solveBaseline(
+   SCIP*                 baseline,           /**< SCIP environment with default plugins */
+   const char*           probname,           /**< problem file name */
+   char                  pairedlimit,        /**< limits taken from the policy solve ('t', 'n', 'b' or 'e') */
+   SCIP_RECORD*          record,             /**< result of the policy solve */
+   SCIP_RECORD*          baselinerecord      /**< record to fill with the result of the baseline solve */
+   )
+{
+   assert(pairedlimit == 't' || pairedlimit == 'n' || pairedlimit == 'b' || pairedlimit == 'e');
+
+   if( !record->solved )
+   {
+      /* nothing to compare with */
+      SCIPrecordSetNotSolved(baselinerecord, probname);
+      return SCIP_OKAY;
+   }
+
+   if( pairedlimit == 'e' )
+   {
+      SCIP_CALL( SCIPsetRealParam(baseline, "eventhdlr/effort/limit", record->effort) );
+   }
+   else
+   {
+      if( pairedlimit != 'n' )
+      {
+         SCIP_CALL( SCIPsetRealParam(baseline, "limits/time", record->time) );
+      }
+      if( pairedlimit != 't' )
+      {
+         SCIP_CALL( SCIPsetLongintParam(baseline, "limits/nodes", MAX(record->nnodes, 1)) );
+      }
+   }
+
+   SCIP_CALL( fromCommandLine(baseline, probname, NULL, baselinerecord, NULL) );
+   SCIP_CALL( SCIPfreeProb(baseline) );
+
+   return SCIP_OKAY;
+}
+
+/** creates the SCIP environment of a batch worker with the plugins, policies and settings of the shell; without node
+ *  selector and pruner, this is the default SCIP of a paired baseline solve
+ */
+static
+SCIP_RETCODE createBatchScip(
+   SCIP**                scip,               /**< pointer to store the SCIP environment */
+   const char*           nodeselname,        /**< name of the node selector, or NULL */
+   SCIP_POLICY*          searchpolicy,       /**< policy of the node selector, or NULL */
+   const char*           nodepruname,        /**< name of the node pruner, or NULL */
+   SCIP_POLICY*          killpolicy,         /**< policy of the node pruner, or NULL */
+   const char*           settingsname,       /**< settings file, or NULL */
+   int                   freq,               /**< restriction level, see setRestrictionLevel() */
+   SCIP_Longint          nodelimit,          /**< maximum number of nodes, or -1 */
+   SCIP_Real             timelimit,          /**< time limit, or -1 */
+   SCIP_Real             effortlimit,        /**< effort limit in work units, or -1 */
+   SCIP_Bool             latency,            /**< measure the latencies of the plugin callbacks? */
+   SCIP_Bool             perfctr,            /**< also read the hardware performance counters around them? */
+   int                   nodeselmask,        /**< features of the policy node selector which are not computed */
+   int                   nodeprumask         /**< features of the policy node pruner which are not computed */
+   )
+{
+   SCIP_CALL( SCIPcreate(scip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(*scip) );
+   SCIP_CALL( SCIPincludeEventhdlrEffort(*scip) );
+   SCIP_CALL( SCIPincludeEventhdlrLatency(*scip) );
+   SCIP_CALL( SCIPincludeEventhdlrTreemem(*scip) );
+
+   /* the output of each problem goes to its log file only */
+   SCIPsetMessagehdlrQuiet(*scip, TRUE);
+
+   if( nodepruname != NULL )
+   {
+      if( strcmp(nodepruname, "oracle") == 0 )
+      {
+         SCIP_CALL( SCIPincludeNodepruOracle(*scip) );
+      }
+      else if( strcmp(nodepruname, "dagger") == 0 )
+      {
+         SCIP_CALL( SCIPincludeNodepruDagger(*scip) );
+         SCIPnodeprudaggerSetPolicy(SCIPfindNodepru(*scip, nodepruname), killpolicy);
+      }
+      else if( strcmp(nodepruname, "policy") == 0 )
+      {
+         SCIP_CALL( SCIPincludeNodepruPolicy(*scip) );
+         SCIPnodeprupolicySetPolicy(SCIPfindNodepru(*scip, nodepruname), killpolicy);
+      }
+   }
+
+   if( nodeselname != NULL )
+   {
+      SCIP_Bool ignored = FALSE;
+
+      if( strcmp(nodeselname, "oracle") == 0 )
+      {
+         SCIP_CALL( SCIPincludeNodeselOracle(*scip) );
+      }
+      else if( strcmp(nodeselname, "dagger") == 0 )
+      {
+         SCIP_CALL( SCIPincludeNodeselDagger(*scip) );
+         SCIPnodeseldaggerSetPolicy(SCIPfindNodesel(*scip, nodeselname), searchpolicy);
+      }
+      else if( strcmp(nodeselname, "policy") == 0 )
+      {
+         SCIP_CALL( SCIPincludeNodeselPolicy(*scip) );
+         SCIPnodeselpolicySetPolicy(SCIPfindNodesel(*scip, nodeselname), searchpolicy);
+      }
+      else
+         ignored = TRUE;
+      if( !ignored )
+      {
+         SCIP_CALL( SCIPsetNodeselStdPriority(*scip, SCIPfindNodesel(*scip, nodeselname), 9999999) );
+      }
+   }
+
+   if( settingsname != NULL )
+   {
+      SCIP_CALL( SCIPreadParams(*scip, settingsname) );
+   }
+   SCIP_CALL( setRestrictionLevel(*scip, freq) );
+   if( timelimit > -1 )
+   {
+      SCIP_CALL( SCIPsetRealParam(*scip, "limits/time", timelimit) );
+   }
+   if( nodelimit > -1 )
+   {
+      SCIP_CALL( SCIPsetLongintParam(*scip, "limits/nodes", nodelimit) );
+   }
+   if( effortlimit > -1 )
+   {
+      SCIP_CALL( SCIPsetRealParam(*scip, "eventhdlr/effort/limit", effortlimit) );
+   }
+   if( latency )
+   {
+      SCIP_CALL( SCIPsetBoolParam(*scip, "eventhdlr/latency/active", TRUE) );
+   }
+   if( perfctr )
+   {
+      SCIP_CALL( SCIPsetBoolParam(*scip, "eventhdlr/latency/perfctr", TRUE) );
+   }
+   if( nodeselmask != 0 )
+   {
+      SCIP_CALL( SCIPsetIntParam(*scip, "nodeselection/policy/featmask", nodeselmask) );
+   }
+   if( nodeprumask != 0 )
+   {
+      SCIP_CALL( SCIPsetIntParam(*scip, "nodepruning/policy/featmask", nodeprumask) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** solves one problem of the batch with the SCIP environment of the worker */
+static
+SCIP_RETCODE solveBatchProblem(
+   BATCHRUN*             batch,              /**< batch */
+   int                   job,                /**< number of the problem */
+   int                   worker              /**< number of the worker */
+   )
+{
+   SCIP* scip = batch->scips[worker];
+   char probfname[SCIP_MAXSTRLEN];
+   char logfname[SCIP_MAXSTRLEN];
+   int baselen;
+
+   baselen = (int)(strlen(batch->probnames[job]) - strlen(batch->suffix));
+   (void) SCIPsnprintf(probfname, SCIP_MAXSTRLEN, "%s/%s", batch->datadir, batch->probnames[job]);
+   (void) SCIPsnprintf(logfname, SCIP_MAXSTRLEN, "%s/%.*s.log", batch->outdir, baselen, batch->probnames[job]);
+
+   /* the oracle and dagger plugins need the optimal solution of the problem */
+   if( batch->soldir != NULL )
+   {
+      char solfname[SCIP_MAXSTRLEN];
+
+      (void) SCIPsnprintf(solfname, SCIP_MAXSTRLEN, "%s/%.*s.sol", batch->soldir, baselen, batch->probnames[job]);
+      if( batch->nodeselname != NULL && SCIPfindNodesel(scip, batch->nodeselname) != NULL
+         && (strcmp(batch->nodeselname, "oracle") == 0 || strcmp(batch->nodeselname, "dagger") == 0) )
+      {
+         char paramname[SCIP_MAXSTRLEN];
+
+         (void) SCIPsnprintf(paramname, SCIP_MAXSTRLEN, "nodeselection/%s/solfname", batch->nodeselname);
+         SCIP_CALL( SCIPsetStringParam(scip, paramname, solfname) );
+      }
+      if( batch->nodepruname != NULL && SCIPfindNodepru(scip, batch->nodepruname) != NULL
+         && (strcmp(batch->nodepruname, "oracle") == 0 || strcmp(batch->nodepruname, "dagger") == 0) )
+      {
+         char paramname[SCIP_MAXSTRLEN];
+
+         (void) SCIPsnprintf(paramname, SCIP_MAXSTRLEN, "nodepruning/%s/solfname", batch->nodepruname);
+         SCIP_CALL( SCIPsetStringParam(scip, paramname, solfname) );
+      }
+   }
+
+   SCIPsetMessagehdlrLogfile(scip, logfname);
+   if( batch->latency )
+   {
+      char latencyfname[SCIP_MAXSTRLEN];
+
+      (void) SCIPsnprintf(latencyfname, SCIP_MAXSTRLEN, "%s/%.*s.latency.json", batch->outdir, baselen,
+         batch->probnames[job]);
+      SCIP_CALL( fromCommandLine(scip, probfname, NULL, &batch->records[job], latencyfname) );
+   }
+   else
+   {
+      SCIP_CALL( fromCommandLine(scip, probfname, NULL, &batch->records[job], NULL) );
+   }
+
+   /* keep the plugins, policies and settings for the next problem */
+   SCIP_CALL( SCIPfreeProb(scip) );
+   SCIPsetMessagehdlrLogfile(scip, NULL);
+
+   /* the paired default SCIP solve runs on the same worker after the policy solve */
+   if( batch->baselines != NULL )
+   {
+      SCIP* baseline = batch->baselines[worker];
+
+      (void) SCIPsnprintf(logfname, SCIP_MAXSTRLEN, "%s/%.*s.baseline.log", batch->outdir, baselen,
+         batch->probnames[job]);
+      SCIPsetMessagehdlrLogfile(baseline, logfname);
+      SCIP_CALL( solveBaseline(baseline, probfname, batch->pairedlimit, &batch->records[job],
+            &batch->baselinerecords[job]) );
+      SCIPsetMessagehdlrLogfile(baseline, NULL);
    }
 
    return SCIP_OKAY;
 }
 
+/** job of the worker pool: solves one problem of the batch; if this fails, the error is appended to the log of the
+ *  problem and the SCIP environments of the worker are made ready for its next problem
+ */
+static
+SCIP_RETCODE batchJob(
+   void*                 data,               /**< batch */
+   int                   job,                /**< number of the problem */
+   int                   worker              /**< number of the worker */
+   )
+{
+   BATCHRUN* batch = (BATCHRUN*)data;
+   SCIP_RETCODE retcode;
+   char logfname[SCIP_MAXSTRLEN];
+   FILE* logfile;
+
+   retcode = solveBatchProblem(batch, job, worker);
+   if( retcode == SCIP_OKAY )
+      return SCIP_OKAY;
+
+   SCIPsetMessagehdlrLogfile(batch->scips[worker], NULL);
+   (void) SCIPfreeProb(batch->scips[worker]);
+   if( batch->baselines != NULL )
+   {
+      SCIPsetMessagehdlrLogfile(batch->baselines[worker], NULL);
+      (void) SCIPfreeProb(batch->baselines[worker]);
+   }
+
+   (void) SCIPsnprintf(logfname, SCIP_MAXSTRLEN, "%s/%.*s.log", batch->outdir,
+      (int)(strlen(batch->probnames[job]) - strlen(batch->suffix)), batch->probnames[job]);
+   logfile = fopen(logfname, "a");
+   if( logfile != NULL )
+   {
+      fprintf(logfile, "\nsolving failed with return code <%d>\n", retcode);
+      fclose(logfile);
+   }
+   printf("solving <%s> failed with return code <%d>\n", batch->probnames[job], retcode);
+
+   return retcode;
+}
+
+/** solves all problems of a directory with one SCIP environment per worker, writes a log per problem and one result
+ *  record per problem to <outdir>/batch.csv or <outdir>/batch.json
+ */
+static
+SCIP_RETCODE runBatch(
+   SCIP*                 scip,               /**< SCIP data structure, used to read the policies */
+   const char*           datadir,            /**< directory of the problems */
+   const char*           suffix,             /**< suffix of the problem files */
+   const char*           soldir,             /**< directory of the optimal solutions, or NULL */
+   const char*           outdir,             /**< directory of the logs and the results */
+   const char*           settingsname,       /**< settings file, or NULL */
+   const char*           nodeselname,        /**< name of the node selector, or NULL */
+   char*                 nodeselpol,         /**< policy file of the node selector, or NULL */
+   const char*           nodepruname,        /**< name of the node pruner, or NULL */
+   char*                 nodeprupol,         /**< policy file of the node pruner, or NULL */
+   int                   freq,               /**< restriction level, see setRestrictionLevel() */
+   SCIP_Longint          nodelimit,          /**< maximum number of nodes, or -1 */
+   SCIP_Real             timelimit,          /**< time limit, or -1 */
+   SCIP_Real             effortlimit,        /**< effort limit in work units, or -1 */
+   int                   nworkers,           /**< number of problems solved in parallel */
+   SCIP_RECORDFORMAT     format,             /**< format of the result records */
+   char                  pairedlimit,        /**< limits of the paired default SCIP solves (see solveBaseline()), or 0 */
+   SCIP_Bool             latency,            /**< write the latency histograms of each problem? */
+   SCIP_Bool             perfctr,            /**< also read the hardware performance counters of the callbacks? */
+   int                   nodeselmask,        /**< features of the policy node selector which are not computed */
+   int                   nodeprumask         /**< features of the policy node pruner which are not computed */
+   )
+{
+   BATCHRUN batch;
+   SCIP_POLICY* searchpolicy = NULL;
+   SCIP_POLICY* killpolicy = NULL;
+   SCIP_Real* costs;
+   SCIP_RETCODE* retcodes;
+   SCIP_RETCODE retcode;
+   char fname[SCIP_MAXSTRLEN];
+   FILE* resfile;
+   int nprobs;
+   int i;
+
+   SCIP_CALL( listProblems(datadir, suffix, &batch.probnames, &nprobs) );
+   if( nprobs == 0 )
+   {
+      printf("no problems with suffix <%s> in <%s>\n", suffix, datadir);
+      BMSfreeMemoryArrayNull(&batch.probnames);
+      return SCIP_OKAY;
+   }
+   if( mkdir(outdir, 0755) != 0 && errno != EEXIST )
+   {
+      SCIPerrorMessage("cannot create directory <%s>\n", outdir);
+      SCIPprintSysError(outdir);
+      return SCIP_FILECREATEERROR;
+   }
+
+   /* the policies are read once and copied by the plugins of all workers */
+   if( nodeselpol != NULL )
+   {
+      SCIP_CALL( SCIPpolicyCreate(scip, &searchpolicy) );
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeselpol, &searchpolicy) );
+   }
+   if( nodeprupol != NULL )
+   {
+      SCIP_CALL( SCIPpolicyCreate(scip, &killpolicy) );
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeprupol, &killpolicy) );
+   }
+
+   nworkers = MIN(nworkers, nprobs);
+   SCIP_ALLOC( BMSallocMemoryArray(&batch.scips, nworkers) );
+   for( i = 0; i < nworkers; i++ )
+   {
+      SCIP_CALL( createBatchScip(&batch.scips[i], nodeselname, searchpolicy, nodepruname, killpolicy, settingsname, freq,
+            nodelimit, timelimit, effortlimit, latency, perfctr, nodeselmask, nodeprumask) );
+   }
+
+   batch.datadir = datadir;
+   batch.soldir = soldir;
+   batch.outdir = outdir;
+   batch.suffix = suffix;
+   batch.nodeselname = nodeselname;
+   batch.nodepruname = nodepruname;
+   SCIP_ALLOC( BMSallocClearMemoryArray(&batch.records, nprobs) );
+   batch.baselines = NULL;
+   batch.baselinerecords = NULL;
+   batch.pairedlimit = pairedlimit;
+   batch.latency = latency;
+   if( pairedlimit != '\0' )
+   {
+      SCIP_ALLOC( BMSallocMemoryArray(&batch.baselines, nworkers) );
+      for( i = 0; i < nworkers; i++ )
+      {
+         SCIP_CALL( createBatchScip(&batch.baselines[i], NULL, NULL, NULL, NULL, settingsname, freq, nodelimit,
+               timelimit, effortlimit, FALSE, FALSE, 0, 0) );
+      }
+      SCIP_ALLOC( BMSallocClearMemoryArray(&batch.baselinerecords, nprobs) );
+   }
+
+   /* large files first */
+   SCIP_ALLOC( BMSallocMemoryArray(&costs, nprobs) );
+   for( i = 0; i < nprobs; i++ )
+   {
+      struct stat st;
+
+      (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/%s", datadir, batch.probnames[i]);
+      costs[i] = stat(fname, &st) == 0 ? (SCIP_Real)st.st_size : 0.0;
+   }
+
+   /* problems that are not reached are reported as not solved */
+   for( i = 0; i < nprobs; i++ )
+   {
+      SCIPrecordSetNotSolved(&batch.records[i], batch.probnames[i]);
+      if( batch.baselinerecords != NULL )
+         SCIPrecordSetNotSolved(&batch.baselinerecords[i], batch.probnames[i]);
+   }
+
+   printf("solving %d problems of <%s> on %d worker(s)\n", nprobs, datadir, nworkers);
+   SCIP_ALLOC( BMSallocMemoryArray(&retcodes, nprobs) );
+   for( i = 0; i < nprobs; i++ )
+      retcodes[i] = SCIP_OKAY;
+   retcode = SCIPpoolRun(costs, nprobs, nworkers, batchJob, &batch, retcodes);
+
+   /* a problem that failed is reported as not solved; the first error is returned after the results are written */
+   for( i = 0; i < nprobs; i++ )
+   {
+      if( retcodes[i] != SCIP_OKAY )
+      {
+         SCIPrecordSetNotSolved(&batch.records[i], batch.probnames[i]);
+         if( batch.baselinerecords != NULL )
+            SCIPrecordSetNotSolved(&batch.baselinerecords[i], batch.probnames[i]);
+      }
+   }
+
+   /* one record per problem, in the order of the file names */
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/batch.%s", outdir, format == SCIP_RECORDFORMAT_JSON ? "json" : "csv");
+   resfile = fopen(fname, "w");
+   if( resfile == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+   }
+   else
+   {
+      SCIPrecordWriteHeader(resfile, pairedlimit != '\0', format);
+      for( i = 0; i < nprobs; i++ )
+      {
+         /* name the instance as its log and solution files */
+         (void) SCIPsnprintf(batch.records[i].instance, SCIP_RECORD_MAXNAMELEN, "%.*s",
+            (int)(strlen(batch.probnames[i]) - strlen(suffix)), batch.probnames[i]);
+         SCIPrecordWrite(resfile, &batch.records[i], batch.baselinerecords != NULL ? &batch.baselinerecords[i] : NULL,
+            format);
+      }
+      fclose(resfile);
+      printf("results written to <%s>\n", fname);
+   }
+
+   BMSfreeMemoryArray(&retcodes);
+   BMSfreeMemoryArray(&costs);
+   BMSfreeMemoryArray(&batch.records);
+   if( batch.baselines != NULL )
+   {
+      BMSfreeMemoryArray(&batch.baselinerecords);
+      for( i = 0; i < nworkers; i++ )
+      {
+         SCIP_CALL( SCIPfree(&batch.baselines[i]) );
+      }
+      BMSfreeMemoryArray(&batch.baselines);
+   }
+   for( i = 0; i < nworkers; i++ )
+   {
+      SCIP_CALL( SCIPfree(&batch.scips[i]) );
+   }
+   BMSfreeMemoryArray(&batch.scips);
+   if( killpolicy != NULL )
+   {
+      SCIP_CALL( SCIPpolicyFree(scip, &killpolicy) );
+   }
+   if( searchpolicy != NULL )
+   {
+      SCIP_CALL( SCIPpolicyFree(scip, &searchpolicy) );
+   }
+   for( i = 0; i < nprobs; i++ )
+      BMSfreeMemoryArray(&batch.probnames[i]);
+   BMSfreeMemoryArray(&batch.probnames);
+
+   return retcode;
+}
+
 /** evaluates command line parameters */
 static
 SCIP_RETCODE processShellArguments(
@@ -163,15 +806,41 @@ SCIP_RETCODE processShellArguments(
    char* outputsolfname = NULL;              /**< output file to write the solution */
    char* nodeselname = NULL;
    char* nodeseltrj = NULL;
+   char* nodeselbucket = NULL;               /**< CSV file of the dagger node selector statistics per depth bucket */
    char* nodeselpol= NULL;
+   char* nodeselout = NULL;                  /**< output policy file of the online node selector */
    char* nodepruname = NULL;
    char* nodeprutrj = NULL;
+   char* nodeprubucket = NULL;               /**< CSV file of the dagger node pruner statistics per depth bucket */
    char* nodeprupol= NULL;
+   char* nodepruout = NULL;                  /**< output policy file of the online node pruner */
+   char* batchdir = NULL;                    /**< directory of problems to solve in one process */
+   char* batchout = NULL;                    /**< directory of the logs and results of the batch */
+   const char* suffix = ".lp.gz";            /**< suffix of the problems of the batch */
+   int nworkers = 1;                         /**< number of problems of the batch solved in parallel */
+   char* recordfname = NULL;                 /**< file to append the result record of the solve to */
+   char pairedlimit = '\0';                  /**< limits of a paired default SCIP solve (see solveBaseline()), or 0 */
+   SCIP_RECORDFORMAT recordformat = SCIP_RECORDFORMAT_CSV; /**< format of the result records */
+   SCIP_DATASET* nodeseldataset = NULL;      /**< examples of node selection when writing binary trajectories */
+   SCIP_DATASET* nodeprudataset = NULL;      /**< examples of node pruning when writing binary trajectories */
+   SCIP_Bool binarytrj = FALSE;              /**< write trajectories in the binary format of the built-in trainer? */
    SCIP_Bool solrequired = FALSE;
    SCIP_Bool quiet;
    int freq = 1;                             /**< frequency of heuristics and separators */ 
    SCIP_Longint nodelimit = -1;              /**< maximum number of nodes to process */
    SCIP_Real timelimit = -1;                 /**< maximum number of nodes to process */
+   SCIP_Real effortlimit = -1;               /**< maximum effort in work units, see eventhdlr_effort.c */
+   SCIP_Bool latency = FALSE;                /**< measure the latencies of the plugin callbacks? */
+   SCIP_Bool perfctr = FALSE;                /**< also read the hardware performance counters around them? */
+   char* latencyfname = NULL;                /**< JSON file to write the latency histograms of the solve to */
+   char* tracefname = NULL;                  /**< file to write the binary trace of the search to */
+   SCIP_Bool treemem = FALSE;                /**< sample the memory of the open nodes? */
+   char* treememfname = NULL;                /**< CSV file to write the samples of the open nodes to */
+   char* telemetryname = NULL;               /**< Unix domain socket to serve live snapshots of the solve on */
+   int nodeselmasks[FEATMASK_MAXVALS];       /**< feature masks of the policy node selector */
+   int nodeprumasks[FEATMASK_MAXVALS];       /**< feature masks of the policy node pruner */
+   int nnodeselmasks = 0;
+   int nnodeprumasks = 0;
    SCIP_Bool paramerror;
    int i;
 
@@ -205,6 +874,17 @@ SCIP_RETCODE processShellArguments(
             paramerror = TRUE;
          }
       }
+      else if( strcmp(argv[i], "--trace") == 0 )
+      {
+         i++;
+         if( i < argc )
+            tracefname = argv[i];
+         else
+         {
+            printf("missing trace filename after parameter '--trace'\n");
+            paramerror = TRUE;
+         }
+      }
       else if( strcmp(argv[i], "-q") == 0 )
          quiet = TRUE;
       else if( strcmp(argv[i], "-r") == 0 )
@@ -240,18 +920,77 @@ SCIP_RETCODE processShellArguments(
             paramerror = TRUE;
          }
       }
-      else if( strcmp(argv[i], "-s") == 0 )
+      else if( strcmp(argv[i], "--effort") == 0 )
       {
          i++;
          if( i < argc )
-            settingsname = argv[i];
+            effortlimit = atof(argv[i]);
          else
          {
-            printf("missing settings filename after parameter '-s'\n");
+            printf("missing effort limit after parameter '--effort'\n");
             paramerror = TRUE;
          }
       }
-      else if( strcmp(argv[i], "-f") == 0 )
+      else if( strcmp(argv[i], "--latency") == 0 )
+         latency = TRUE;
+      else if( strcmp(argv[i], "--perfctr") == 0 )
+      {
+         latency = TRUE;
+         perfctr = TRUE;
+      }
+      else if( strcmp(argv[i], "--latencyout") == 0 )
+      {
+         i++;
+         if( i < argc )
+         {
+            latencyfname = argv[i];
+            latency = TRUE;
+         }
+         else
+         {
+            printf("missing latency filename after parameter '--latencyout'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--treemem") == 0 )
+         treemem = TRUE;
+      else if( strcmp(argv[i], "--treememout") == 0 )
+      {
+         i++;
+         if( i < argc )
+         {
+            treememfname = argv[i];
+            treemem = TRUE;
+         }
+         else
+         {
+            printf("missing tree memory filename after parameter '--treememout'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--telemetry") == 0 )
+      {
+         i++;
+         if( i < argc )
+            telemetryname = argv[i];
+         else
+         {
+            printf("missing socket path after parameter '--telemetry'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "-s") == 0 )
+      {
+         i++;
+         if( i < argc )
+            settingsname = argv[i];
+         else
+         {
+            printf("missing settings filename after parameter '-s'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "-f") == 0 )
       {
          i++;
          if( i < argc )
@@ -291,7 +1030,7 @@ SCIP_RETCODE processShellArguments(
          {
             nodepruname = argv[i];
 
-            if( strcmp(nodepruname, "oracle") == 0 || strcmp(nodepruname, "dagger") == 0 )
+            if( strcmp(nodepruname, "oracle") == 0 || strcmp(nodepruname, "dagger") == 0 || strcmp(nodepruname, "online") == 0 )
                solrequired = TRUE;
 
             if( strcmp(nodepruname, "policy") == 0 || strcmp(nodepruname, "dagger") == 0 )
@@ -305,6 +1044,12 @@ SCIP_RETCODE processShellArguments(
                   paramerror = TRUE;
                }
             }
+            else if( strcmp(nodepruname, "online") == 0 )
+            {
+               /* the initial policy of the online node pruner is optional */
+               if( i+1 < argc && argv[i+1][0] != '-' )
+                  nodeprupol = argv[++i];
+            }
          }
          else
          {
@@ -323,6 +1068,17 @@ SCIP_RETCODE processShellArguments(
             paramerror = TRUE;
          }
       }
+      else if( strcmp(argv[i], "--nodeprubucket") == 0 )
+      {
+         i++;
+         if( i < argc )
+            nodeprubucket = argv[i];
+         else
+         {
+            printf("missing node pruning bucket filename after parameter '--nodeprubucket'\n");
+            paramerror = TRUE;
+         }
+      }
       else if( strcmp(argv[i], "--nodesel") == 0 )
       {
          i++;
@@ -330,7 +1086,7 @@ SCIP_RETCODE processShellArguments(
          {
             nodeselname = argv[i];
 
-            if( strcmp(nodeselname, "oracle") == 0 || strcmp(nodeselname, "dagger") == 0 )
+            if( strcmp(nodeselname, "oracle") == 0 || strcmp(nodeselname, "dagger") == 0 || strcmp(nodeselname, "online") == 0 )
                solrequired = TRUE;
 
             if( strcmp(nodeselname, "policy") == 0 || strcmp(nodeselname, "dagger") == 0 )
@@ -344,6 +1100,12 @@ SCIP_RETCODE processShellArguments(
                   paramerror = TRUE;
                }
             }
+            else if( strcmp(nodeselname, "online") == 0 )
+            {
+               /* the initial policy of the online node selector is optional */
+               if( i+1 < argc && argv[i+1][0] != '-' )
+                  nodeselpol = argv[++i];
+            }
          }
          else
          {
@@ -362,6 +1124,151 @@ SCIP_RETCODE processShellArguments(
             paramerror = TRUE;
          }
       }
+      else if( strcmp(argv[i], "--nodeselmask") == 0 || strcmp(argv[i], "--nodeprumask") == 0 )
+      {
+         SCIP_Bool isnodesel = (strcmp(argv[i], "--nodeselmask") == 0);
+
+         i++;
+         if( i < argc )
+         {
+            if( isnodesel )
+               nnodeselmasks = parseMaskList(argv[i], nodeselmasks, FEATMASK_MAXVALS);
+            else
+               nnodeprumasks = parseMaskList(argv[i], nodeprumasks, FEATMASK_MAXVALS);
+            if( (isnodesel ? nnodeselmasks : nnodeprumasks) <= 0 )
+            {
+               printf("invalid list of feature masks <%s> after parameter '%s'\n", argv[i], argv[i-1]);
+               paramerror = TRUE;
+            }
+         }
+         else
+         {
+            printf("missing list of feature masks after parameter '%s'\n", argv[i-1]);
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--nodeselbucket") == 0 )
+      {
+         i++;
+         if( i < argc )
+            nodeselbucket = argv[i];
+         else
+         {
+            printf("missing node selection bucket filename after parameter '--nodeselbucket'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--batch") == 0 )
+      {
+         i++;
+         if( i < argc )
+            batchdir = argv[i];
+         else
+         {
+            printf("missing problem directory after parameter '--batch'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--batchout") == 0 )
+      {
+         i++;
+         if( i < argc )
+            batchout = argv[i];
+         else
+         {
+            printf("missing result directory after parameter '--batchout'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "-x") == 0 )
+      {
+         i++;
+         if( i < argc )
+            suffix = argv[i];
+         else
+         {
+            printf("missing problem suffix after parameter '-x'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--workers") == 0 )
+      {
+         i++;
+         if( i < argc && atoi(argv[i]) > 0 )
+            nworkers = atoi(argv[i]);
+         else
+         {
+            printf("missing positive number of workers after parameter '--workers'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--nodeselout") == 0 )
+      {
+         i++;
+         if( i < argc )
+            nodeselout = argv[i];
+         else
+         {
+            printf("missing output policy filename after parameter '--nodeselout'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--nodepruout") == 0 )
+      {
+         i++;
+         if( i < argc )
+            nodepruout = argv[i];
+         else
+         {
+            printf("missing output policy filename after parameter '--nodepruout'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--record") == 0 )
+      {
+         i++;
+         if( i < argc )
+            recordfname = argv[i];
+         else
+         {
+            printf("missing record filename after parameter '--record'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--recordformat") == 0 )
+      {
+         i++;
+         if( i < argc && (strcmp(argv[i], "csv") == 0 || strcmp(argv[i], "json") == 0) )
+            recordformat = (strcmp(argv[i], "json") == 0 ? SCIP_RECORDFORMAT_JSON : SCIP_RECORDFORMAT_CSV);
+         else
+         {
+            printf("missing record format (csv or json) after parameter '--recordformat'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--paired") == 0 )
+      {
+         i++;
+         if( i < argc && (strcmp(argv[i], "time") == 0 || strcmp(argv[i], "nodes") == 0
+               || strcmp(argv[i], "both") == 0 || strcmp(argv[i], "effort") == 0) )
+            pairedlimit = argv[i][0];
+         else
+         {
+            printf("missing limits (time, nodes, both or effort) after parameter '--paired'\n");
+            paramerror = TRUE;
+         }
+      }
+      else if( strcmp(argv[i], "--trjformat") == 0 )
+      {
+         i++;
+         if( i < argc && (strcmp(argv[i], "text") == 0 || strcmp(argv[i], "binary") == 0) )
+            binarytrj = (strcmp(argv[i], "binary") == 0);
+         else
+         {
+            printf("missing trajectory format (text or binary) after parameter '--trjformat'\n");
+            paramerror = TRUE;
+         }
+      }
       else
       {
          printf("invalid parameter <%s>\n", argv[i]);
@@ -375,6 +1282,36 @@ SCIP_RETCODE processShellArguments(
       paramerror = TRUE;
    }
 
+   if( (nnodeselmasks > 0 && (nodeselname == NULL || strcmp(nodeselname, "policy") != 0))
+      || (nnodeprumasks > 0 && (nodepruname == NULL || strcmp(nodepruname, "policy") != 0)) )
+   {
+      printf("feature masks need the policy node selector or pruner\n");
+      paramerror = TRUE;
+   }
+   if( batchdir == NULL && (nnodeselmasks > 1 || nnodeprumasks > 1) )
+   {
+      printf("several feature masks need '--batch'\n");
+      paramerror = TRUE;
+   }
+
+   if( batchdir != NULL && (probname != NULL || nodeseltrj != NULL || nodeprutrj != NULL || outputsolfname != NULL
+         || recordfname != NULL || latencyfname != NULL || tracefname != NULL || treemem
+         || telemetryname != NULL || nodeselbucket != NULL || nodeprubucket != NULL) )
+   {
+      printf("parameter '--batch' cannot be combined with '-f', '--sol', '--record', '--latencyout', '--trace', "
+         "'--treemem', '--telemetry' or trajectory or bucket files\n");
+      paramerror = TRUE;
+   }
+
+#ifdef NPARASCIP
+   /* the workers run their SCIP environments on separate threads */
+   if( nworkers > 1 )
+   {
+      printf("parameter '--workers' with more than one worker needs SCIP built with PARASCIP=true\n");
+      paramerror = TRUE;
+   }
+#endif
+
    if( !paramerror )
    {
       /***********************************
@@ -386,21 +1323,7 @@ SCIP_RETCODE processShellArguments(
          SCIPsetMessagehdlrQuiet(scip, quiet);
       }
 
-      if( freq < 1 )
-      {
-         /* use most infeasible branching */
-         SCIP_BRANCHRULE* branch_rule = NULL;
-         branch_rule = SCIPfindBranchrule( scip, "mostinf" );
-         SCIP_CALL( SCIPsetBranchrulePriority( scip, branch_rule, 9999999 ) );
-         printf("Using most infeasible branching\n");
-
-         disableHeurs(scip, freq);
-         disableSepas(scip, freq);
-         if( freq == 0 )
-            printf("Using heuristics and separators only at root\n");
-         else if( freq == -1 )
-            printf("Disabled heuristics and separators\n");
-      }
+      SCIP_CALL( setRestrictionLevel(scip, freq) );
 
       if( timelimit > -1 )
       {
@@ -414,6 +1337,22 @@ SCIP_RETCODE processShellArguments(
          printf("Maximum number of nodes to explore: %"SCIP_LONGINT_FORMAT"\n", nodelimit);
       }
 
+      if( effortlimit > -1 )
+      {
+         SCIP_CALL( SCIPsetRealParam(scip, "eventhdlr/effort/limit", effortlimit) );
+         printf("Maximum effort in work units: %.2f\n", effortlimit);
+      }
+
+      if( latency )
+      {
+         SCIP_CALL( SCIPsetBoolParam(scip, "eventhdlr/latency/active", TRUE) );
+      }
+
+      if( perfctr )
+      {
+         SCIP_CALL( SCIPsetBoolParam(scip, "eventhdlr/latency/perfctr", TRUE) );
+      }
+
       if( logname != NULL )
       {
          SCIPsetMessagehdlrLogfile(scip, logname);
@@ -424,6 +1363,67 @@ SCIP_RETCODE processShellArguments(
          SCIP_CALL( SCIPsetStringParam(scip, "vbc/filename", vbcname) );
       }
 
+      if( tracefname != NULL )
+      {
+         SCIP_CALL( SCIPsetStringParam(scip, "eventhdlr/trace/filename", tracefname) );
+      }
+
+      if( treemem )
+      {
+         SCIP_CALL( SCIPsetBoolParam(scip, "eventhdlr/treemem/active", TRUE) );
+      }
+
+      if( treememfname != NULL )
+      {
+         SCIP_CALL( SCIPsetStringParam(scip, "eventhdlr/treemem/filename", treememfname) );
+      }
+
+      if( telemetryname != NULL )
+      {
+         SCIP_CALL( SCIPsetStringParam(scip, "eventhdlr/telemetry/socket", telemetryname) );
+      }
+
+      /* with --batch, -o is the directory of the optimal solutions */
+      if( batchdir != NULL && nnodeselmasks == 0 && nnodeprumasks == 0 )
+      {
+         SCIP_CALL( runBatch(scip, batchdir, suffix, solfname, batchout != NULL ? batchout : ".",
+               settingsname != NULL ? settingsname : defaultsetname, nodeselname, nodeselpol, nodepruname, nodeprupol,
+               freq, nodelimit, timelimit, effortlimit, nworkers, recordformat, pairedlimit, latency, perfctr, 0, 0) );
+         return SCIP_OKAY;
+      }
+
+      /* an ablation grid: the batch is solved once for every pair of feature masks, each in its own directory */
+      if( batchdir != NULL )
+      {
+         char outdir[SCIP_MAXSTRLEN];
+         int s;
+         int p;
+
+         if( batchout != NULL && mkdir(batchout, 0755) != 0 && errno != EEXIST )
+         {
+            SCIPerrorMessage("cannot create directory <%s>\n", batchout);
+            SCIPprintSysError(batchout);
+            return SCIP_FILECREATEERROR;
+         }
+         for( s = 0; s < MAX(nnodeselmasks, 1); s++ )
+         {
+            for( p = 0; p < MAX(nnodeprumasks, 1); p++ )
+            {
+               int nodeselmask = nnodeselmasks > 0 ? nodeselmasks[s] : 0;
+               int nodeprumask = nnodeprumasks > 0 ? nodeprumasks[p] : 0;
+
+               (void) SCIPsnprintf(outdir, SCIP_MAXSTRLEN, "%s/featmask.%d.%d", batchout != NULL ? batchout : ".",
+                  nodeselmask, nodeprumask);
+               printf("feature masks %d (node selection) and %d (node pruning)\n", nodeselmask, nodeprumask);
+               SCIP_CALL( runBatch(scip, batchdir, suffix, solfname, outdir,
+                     settingsname != NULL ? settingsname : defaultsetname, nodeselname, nodeselpol, nodepruname,
+                     nodeprupol, freq, nodelimit, timelimit, effortlimit, nworkers, recordformat, pairedlimit, latency,
+                     perfctr, nodeselmask, nodeprumask) );
+            }
+         }
+         return SCIP_OKAY;
+      }
+
       if( nodepruname != NULL )
       {
          printf("include nodepru %s\n", nodepruname);
@@ -431,7 +1431,12 @@ SCIP_RETCODE processShellArguments(
          {
             SCIP_CALL( SCIPincludeNodepruOracle(scip) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/oracle/solfname", solfname) );
-            if( nodeprutrj != NULL )
+            if( nodeprutrj != NULL && binarytrj )
+            {
+               SCIP_CALL( SCIPdatasetCreate(&nodeprudataset, SCIP_FEATNODEPRU_SIZE) );
+               SCIPnodepruoracleSetDataset(SCIPfindNodepru(scip, "oracle"), nodeprudataset);
+            }
+            else if( nodeprutrj != NULL )
                SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/oracle/trjfname", nodeprutrj) );
          }
          else if( strcmp(nodepruname, "dagger") == 0 )
@@ -439,13 +1444,31 @@ SCIP_RETCODE processShellArguments(
             SCIP_CALL( SCIPincludeNodepruDagger(scip) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/dagger/solfname", solfname) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/dagger/polfname", nodeprupol) );
-            if( nodeprutrj != NULL )
+            if( nodeprutrj != NULL && binarytrj )
+            {
+               SCIP_CALL( SCIPdatasetCreate(&nodeprudataset, SCIP_FEATNODEPRU_SIZE) );
+               SCIPnodeprudaggerSetDataset(SCIPfindNodepru(scip, "dagger"), nodeprudataset);
+            }
+            else if( nodeprutrj != NULL )
                SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/dagger/trjfname", nodeprutrj) );
+            if( nodeprubucket != NULL )
+               SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/dagger/bucketfname", nodeprubucket) );
          }
          else if( strcmp(nodepruname, "policy") == 0 )
          {
             SCIP_CALL( SCIPincludeNodepruPolicy(scip) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/policy/polfname", nodeprupol) );
+            if( nnodeprumasks > 0 )
+               SCIP_CALL( SCIPsetIntParam(scip, "nodepruning/policy/featmask", nodeprumasks[0]) );
+         }
+         else if( strcmp(nodepruname, "online") == 0 )
+         {
+            SCIP_CALL( SCIPincludeNodepruOnline(scip) );
+            SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/online/solfname", solfname) );
+            if( nodeprupol != NULL )
+               SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/online/polfname", nodeprupol) );
+            if( nodepruout != NULL )
+               SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/online/outpolfname", nodepruout) );
          }
          else
          {
@@ -461,7 +1484,12 @@ SCIP_RETCODE processShellArguments(
          {
             SCIP_CALL( SCIPincludeNodeselOracle(scip) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/oracle/solfname", solfname) );
-            if( nodeseltrj != NULL )
+            if( nodeseltrj != NULL && binarytrj )
+            {
+               SCIP_CALL( SCIPdatasetCreate(&nodeseldataset, SCIP_FEATNODESEL_SIZE) );
+               SCIPnodeseloracleSetDataset(SCIPfindNodesel(scip, "oracle"), nodeseldataset);
+            }
+            else if( nodeseltrj != NULL )
                SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/oracle/trjfname", nodeseltrj) );
          }
          else if( strcmp(nodeselname, "dagger") == 0 )
@@ -469,13 +1497,31 @@ SCIP_RETCODE processShellArguments(
             SCIP_CALL( SCIPincludeNodeselDagger(scip) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/solfname", solfname) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/polfname", nodeselpol) );
-            if( nodeseltrj != NULL )
+            if( nodeseltrj != NULL && binarytrj )
+            {
+               SCIP_CALL( SCIPdatasetCreate(&nodeseldataset, SCIP_FEATNODESEL_SIZE) );
+               SCIPnodeseldaggerSetDataset(SCIPfindNodesel(scip, "dagger"), nodeseldataset);
+            }
+            else if( nodeseltrj != NULL )
                SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/trjfname", nodeseltrj) );
+            if( nodeselbucket != NULL )
+               SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/bucketfname", nodeselbucket) );
          }
          else if( strcmp(nodeselname, "policy") == 0 )
          {
             SCIP_CALL( SCIPincludeNodeselPolicy(scip) );
             SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/policy/polfname", nodeselpol) );
+            if( nnodeselmasks > 0 )
+               SCIP_CALL( SCIPsetIntParam(scip, "nodeselection/policy/featmask", nodeselmasks[0]) );
+         }
+         else if( strcmp(nodeselname, "online") == 0 )
+         {
+            SCIP_CALL( SCIPincludeNodeselOnline(scip) );
+            SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/online/solfname", solfname) );
+            if( nodeselpol != NULL )
+               SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/online/polfname", nodeselpol) );
+            if( nodeselout != NULL )
+               SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/online/outpolfname", nodeselout) );
          }
          else
          {
@@ -520,13 +1566,64 @@ SCIP_RETCODE processShellArguments(
        * Start SCIP *
        **************/
 
-      if( probname != NULL )
+      if( probname != NULL && pairedlimit != '\0' )
+      {
+         SCIP* baseline;
+         SCIP_RECORD record;
+         SCIP_RECORD baselinerecord;
+
+         SCIP_CALL( fromCommandLine(scip, probname, outputsolfname, &record, latencyfname) );
+
+         /* the same problem with default SCIP under the limits of the policy solve */
+         SCIP_CALL( createBatchScip(&baseline, NULL, NULL, NULL, NULL,
+               settingsname != NULL ? settingsname : defaultsetname, freq, nodelimit, timelimit, effortlimit, FALSE,
+               FALSE, 0, 0) );
+         SCIPsetMessagehdlrQuiet(baseline, quiet);
+         if( logname != NULL )
+         {
+            SCIPsetMessagehdlrLogfile(baseline, logname);
+         }
+         SCIP_CALL( solveBaseline(baseline, probname, pairedlimit, &record, &baselinerecord) );
+         SCIP_CALL( SCIPfree(&baseline) );
+
+         if( recordfname != NULL )
+         {
+            SCIP_CALL( SCIPrecordAppend(recordfname, &record, &baselinerecord, recordformat) );
+         }
+         else
+         {
+            SCIPrecordWriteHeader(stdout, TRUE, recordformat);
+            SCIPrecordWrite(stdout, &record, &baselinerecord, recordformat);
+         }
+      }
+      else if( probname != NULL && recordfname != NULL )
+      {
+         SCIP_RECORD record;
+
+         SCIP_CALL( fromCommandLine(scip, probname, outputsolfname, &record, latencyfname) );
+         SCIP_CALL( SCIPrecordAppend(recordfname, &record, NULL, recordformat) );
+      }
+      else if( probname != NULL )
       {
-         SCIP_CALL( fromCommandLine(scip, probname, outputsolfname) );
+         SCIP_CALL( fromCommandLine(scip, probname, outputsolfname, NULL, latencyfname) );
       }
-      else
+
+      /* append the collected examples to the binary trajectory files */
+      if( nodeseldataset != NULL )
       {
-         return SCIP_OKAY;
+         if( probname != NULL )
+         {
+            SCIP_CALL( SCIPdatasetWrite(nodeseldataset, nodeseltrj, 0, SCIPdatasetGetNExamples(nodeseldataset)) );
+         }
+         SCIP_CALL( SCIPdatasetFree(&nodeseldataset) );
+      }
+      if( nodeprudataset != NULL )
+      {
+         if( probname != NULL )
+         {
+            SCIP_CALL( SCIPdatasetWrite(nodeprudataset, nodeprutrj, 0, SCIPdatasetGetNExamples(nodeprudataset)) );
+         }
+         SCIP_CALL( SCIPdatasetFree(&nodeprudataset) );
       }
 
    }
@@ -537,8 +1634,40 @@ SCIP_RETCODE processShellArguments(
          "  -q            : suppress screen messages\n"
          "  -s <settings> : load parameter settings (.set) file\n"
          "  -f <problem>  : load and solve problem file\n"
-         "  -o <solution> : load optimal solution file\n",
-         argv[0]);
+         "  -o <solution> : load optimal solution file\n"
+         "  --trjformat <text|binary> : format of the trajectory files (binary is read by '%s train')\n"
+         "  --batch <dir> [--batchout <dir>] [-x <suffix>] [--workers <n>] : solve all problems of a directory, with -o\n"
+         "                the directory of their solutions, and write the logs and batch.csv to the output directory\n"
+         "                (more than one worker needs SCIP built with PARASCIP=true)\n"
+         "  --record <file> : append the result record of the solve (status, nodes, time, bounds, gap, plugin statistics)\n"
+         "  --recordformat <csv|json> : format of the result records (default csv)\n"
+         "  --paired <time|nodes|both|effort> : solve the problem again with default SCIP, limited to the time and/or\n"
+         "                the number of nodes, or to the effort of the policy solve, and write the paired result record\n"
+         "  --effort <units> : limit the effort in deterministic work units (LP iterations, nodes, policy evaluations)\n"
+         "  --latency     : print latency histograms of the node selection and pruning callbacks with the statistics\n"
+         "                (with --batch, also write <problem>.latency.json to the output directory)\n"
+         "  --latencyout <file> : as --latency, and write the histograms of the solve to a JSON file\n"
+         "  --perfctr     : as --latency, and read cycles, instructions, cache and branch misses around the callbacks\n"
+         "                (needs a build with PERFCTR=true)\n"
+         "  --trace <file> : write a binary trace of the search (nodes, selections, pruning decisions, oracle labels,\n"
+         "                incumbents) to a file, see eventhdlr_trace.c\n"
+         "  --treemem     : print the open nodes, their estimated memory and the memory freed by pruned nodes per depth\n"
+         "                with the statistics, see eventhdlr_treemem.c\n"
+         "  --treememout <file> : as --treemem, and write the samples of the open nodes to a CSV file\n"
+         "  --telemetry <socket> : serve a JSON snapshot of the solve (nodes, open nodes, gap, prunes, comparison\n"
+         "                errors, selection and pruning time, trajectory bytes) to every connection to a Unix socket\n"
+         "  --nodeselmask <mask>[,<mask>...] : with --nodesel policy, neither compute nor use the features of the\n"
+         "                bits of the mask (bit i: feature i of type_feat.h); with --batch, the batch is solved for\n"
+         "                every mask (and every mask of --nodeprumask), with the results in\n"
+         "                <batchout>/featmask.<sel>.<pru>\n"
+         "  --nodeprumask <mask>[,<mask>...] : the same for --nodepru policy\n"
+         "  --nodeselbucket <file> : with --nodesel dagger, append the comparisons with the optimal node and the ranking\n"
+         "                errors per depth bucket of the policy to a CSV file\n"
+         "  --nodeprubucket <file> : with --nodepru dagger, append the nodes, prunes, false positives and false\n"
+         "                negatives per depth bucket of the policy to a CSV file\n"
+         "  --nodesel online [<policy>] --nodeselout <policy> : update the node selection policy during the solve\n"
+         "  --nodepru online [<policy>] --nodepruout <policy> : update the node pruning policy during the solve\n",
+         argv[0], argv[0]);
    }
 
    return SCIP_OKAY;
@@ -565,6 +1694,11 @@ SCIP_RETCODE runShell(
    
    /* include default SCIP plugins */
    SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
+   SCIP_CALL( SCIPincludeEventhdlrEffort(scip) );
+   SCIP_CALL( SCIPincludeEventhdlrLatency(scip) );
+   SCIP_CALL( SCIPincludeEventhdlrTrace(scip) );
+   SCIP_CALL( SCIPincludeEventhdlrTreemem(scip) );
+   SCIP_CALL( SCIPincludeEventhdlrTelemetry(scip) );
 
    /**********************************
     * Process command line arguments *
@@ -582,15 +1716,1772 @@ SCIP_RETCODE runShell(
    return SCIP_OKAY;
 }
 
-int
-main(
-   int                        argc,
-   char**                     argv
+#define DEPTHBUCKETS_MAXN       64           /**< maximum number of quantile depth buckets of a policy */
+
+/** parses the number of quantile depth buckets; returns -1 on error */
+static
+int parseNDepthBuckets(
+   const char*                str                 /**< string to parse */
    )
 {
-   SCIP_RETCODE retcode;
+   char* end;
+   long nbuckets;
 
-   retcode = runShell(argc, argv, NULL);
+   nbuckets = strtol(str, &end, 10);
+   if( end == str || *end != '\0' || nbuckets < 1 || nbuckets > DEPTHBUCKETS_MAXN )
+   {
+      printf("number of depth buckets <%s> must be between 1 and %d\n", str, DEPTHBUCKETS_MAXN);
+      return -1;
+   }
+
+   return (int)nbuckets;
+}
+
+/** learns depth buckets holding about equally many blocks of the examples of a dataset and sets them in a policy */
+static
+SCIP_RETCODE setQuantileDepthBuckets(
+   SCIP_DATASET*              dataset,            /**< examples whose depths are divided */
+   int                        nbuckets,           /**< number of depth buckets to aim for */
+   SCIP_POLICY*               policy              /**< policy whose depth buckets are replaced */
+   )
+{
+   int bounds[DEPTHBUCKETS_MAXN];
+   int nbounds;
+   int j;
+
+   assert(nbuckets >= 1 && nbuckets <= DEPTHBUCKETS_MAXN);
+
+   SCIP_CALL( SCIPdatasetCalcDepthQuantiles(dataset, nbuckets, bounds, &nbounds) );
+   SCIP_CALL( SCIPpolicySetDepthBuckets(policy, bounds, nbounds) );
+
+   printf("%d quantile depth bucket(s) starting at depth 0", nbounds + 1);
+   for( j = 0; j < nbounds; j++ )
+      printf(", %d", bounds[j]);
+   printf("\n");
+
+   return SCIP_OKAY;
+}
+
+/** trains a linear policy on a binary trajectory file, replacing the LIBLINEAR train-w and predict executables
+ *
+ *  syntax: scipdagger train [-s <solver>] [-c <C>] [-w1 <w>] [-w-1 <w>] [-e <eps>] [-a] [-n <threads>] [-m <method>]
+ *                           [-q <nbuckets>] [--epochs <n>] [--wild] [--state <statefile> [--newonly]]
+ *                           <trjfile> <modelfile>
+ */
+static
+SCIP_RETCODE runTrain(
+   int                        argc,               /**< number of shell parameters */
+   char**                     argv                /**< array with shell parameters */
+   )
+{
+   SCIP_TRAINPARAM param;
+   SCIP_DATASET* dataset;
+   SCIP_TRAINPROB* prob;
+   SCIP_TRAINSTATE* state = NULL;
+   SCIP_POLICY policy;
+   char* trjfname = NULL;
+   char* modelfname = NULL;
+   char* statefname = NULL;                  /**< dual state of the previous iteration to warm-start from */
+   SCIP_Bool newonly = FALSE;                /**< train only on the examples appended since the state was written? */
+   SCIP_Bool normalize = FALSE;              /**< divide C by the mean instance weight? */
+   SCIP_Bool paramerror = FALSE;
+   SCIP_Real meanweight;
+   int ndepthbuckets = 0;                    /**< number of quantile depth buckets, or 0 for buckets of equal width */
+   int nexamples;
+   int first;
+   int featsize;
+   int i;
+
+   SCIPtrainparamSetDefault(&param);
+
+   for( i = 2; i < argc && !paramerror; ++i )
+   {
+      if( argv[i][0] == '-' && argv[i][1] != '\0' )
+      {
+         if( strcmp(argv[i], "-a") == 0 )
+            normalize = TRUE;
+         else if( strcmp(argv[i], "--wild") == 0 )
+            param.deterministic = FALSE;
+         else if( strcmp(argv[i], "--newonly") == 0 )
+            newonly = TRUE;
+         else if( i + 1 >= argc )
+         {
+            printf("missing value after parameter '%s'\n", argv[i]);
+            paramerror = TRUE;
+         }
+         else if( strcmp(argv[i], "-s") == 0 )
+         {
+            param.solver = (SCIP_TRAINSOLVER)atoi(argv[++i]);
+            if( param.solver != SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL && param.solver != SCIP_TRAINSOLVER_L2R_L1LOSS_SVC_DUAL
+               && param.solver != SCIP_TRAINSOLVER_L2R_LR_DUAL )
+            {
+               printf("unsupported solver %d (use 1, 3 or 7)\n", (int)param.solver);
+               paramerror = TRUE;
+            }
+         }
+         else if( strcmp(argv[i], "-c") == 0 )
+            param.C = atof(argv[++i]);
+         else if( strcmp(argv[i], "-w1") == 0 )
+            param.weightpos = atof(argv[++i]);
+         else if( strcmp(argv[i], "-w-1") == 0 )
+            param.weightneg = atof(argv[++i]);
+         else if( strcmp(argv[i], "-e") == 0 )
+            param.eps = atof(argv[++i]);
+         else if( strcmp(argv[i], "-n") == 0 )
+         {
+            param.nthreads = atoi(argv[++i]);
+            if( param.nthreads < 1 )
+            {
+               printf("number of threads must be positive\n");
+               paramerror = TRUE;
+            }
+         }
+         else if( strcmp(argv[i], "-m") == 0 )
+         {
+            i++;
+            if( strcmp(argv[i], "dcd") == 0 )
+               param.method = SCIP_TRAINMETHOD_DCD;
+            else if( strcmp(argv[i], "sgd") == 0 )
+               param.method = SCIP_TRAINMETHOD_SGD;
+            else
+            {
+               printf("unknown method <%s> (use dcd or sgd)\n", argv[i]);
+               paramerror = TRUE;
+            }
+         }
+         else if( strcmp(argv[i], "-q") == 0 )
+         {
+            ndepthbuckets = parseNDepthBuckets(argv[++i]);
+            paramerror = (ndepthbuckets < 0);
+         }
+         else if( strcmp(argv[i], "--epochs") == 0 )
+            param.nepochs = atoi(argv[++i]);
+         else if( strcmp(argv[i], "--state") == 0 )
+            statefname = argv[++i];
+         else
+         {
+            printf("invalid parameter <%s>\n", argv[i]);
+            paramerror = TRUE;
+         }
+      }
+      else if( trjfname == NULL )
+         trjfname = argv[i];
+      else if( modelfname == NULL )
+         modelfname = argv[i];
+      else
+      {
+         printf("invalid parameter <%s>\n", argv[i]);
+         paramerror = TRUE;
+      }
+   }
+
+   if( newonly && statefname == NULL )
+   {
+      printf("parameter '--newonly' requires '--state'\n");
+      paramerror = TRUE;
+   }
+
+   /* the weights of the dual state are laid out by the buckets it was trained with */
+   if( ndepthbuckets > 0 && statefname != NULL )
+   {
+      printf("parameter '-q' cannot be combined with '--state'\n");
+      paramerror = TRUE;
+   }
+
+   if( paramerror || trjfname == NULL || modelfname == NULL )
+   {
+      printf("\nsyntax: %s train [-s <solver>] [-c <C>] [-w1 <w>] [-w-1 <w>] [-e <eps>] [-a] [-n <threads>] [-m <method>]\n"
+         "       [-q <nbuckets>] [--epochs <n>] [--wild] [--state <statefile> [--newonly]] <trjfile> <modelfile>\n"
+         "  -s <solver>   : 1 L2-loss SVM (dual, default), 3 L1-loss SVM (dual), 7 logistic regression (dual)\n"
+         "  -c <C>        : cost of constraint violation\n"
+         "  -w1, -w-1 <w> : cost multiplier of the positive/negative class\n"
+         "  -e <eps>      : tolerance of the stopping criterion\n"
+         "  -a            : divide C by the mean instance weight\n"
+         "  -n <threads>  : number of threads\n"
+         "  -m <method>   : dcd (dual coordinate descent, default) or sgd (stochastic gradient descent)\n"
+         "  -q <nbuckets> : divide the depths into buckets of about equally many examples, stored in the model\n"
+         "                  (default: ten buckets of equal width)\n"
+         "  --epochs <n>  : number of passes of sgd\n"
+         "  --wild        : let the threads update the shared weight vector without locks (not reproducible; by\n"
+         "                  default the result depends only on -n, but takes more passes if -n exceeds the buckets)\n"
+         "  --state <file>: warm-start from the dual state in the file (if it exists) and write the new state to it\n"
+         "  --newonly     : optimize only the examples appended since the state was written\n",
+         argv[0]);
+      return SCIP_OKAY;
+   }
+
+   featsize = SCIPdatasetReadFeatSize(trjfname);
+   if( featsize <= 0 )
+   {
+      printf("file <%s> is not a binary trajectory file\n", trjfname);
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( SCIPdatasetCreate(&dataset, featsize) );
+   SCIP_CALL( SCIPdatasetRead(dataset, trjfname) );
+
+   nexamples = SCIPdatasetGetNExamples(dataset);
+   meanweight = SCIPdatasetGetMeanWeight(dataset, 0, nexamples);
+   if( normalize )
+      param.C /= meanweight;
+
+   first = 0;
+   if( statefname != NULL )
+   {
+      FILE* file;
+
+      SCIP_CALL( SCIPtrainstateCreate(&state) );
+      file = fopen(statefname, "rb");
+      if( file != NULL )
+      {
+         fclose(file);
+         SCIP_CALL( SCIPtrainstateRead(state, statefname) );
+         printf("warm start from <%s> with %d examples\n", statefname, state->nexamples);
+      }
+
+      /* without new examples the whole set is trained, which converges immediately from the state */
+      if( newonly && state->solver == param.solver && state->nexamples < nexamples )
+         first = state->nexamples;
+   }
+
+   policy.weights = NULL;
+   policy.size = 0;
+   policy.depthbounds = NULL;
+   policy.depthbuckets = NULL;
+   policy.ndepthbounds = 0;
+   if( ndepthbuckets > 0 )
+   {
+      SCIP_CALL( setQuantileDepthBuckets(dataset, ndepthbuckets, &policy) );
+   }
+
+   SCIP_CALL( SCIPtrainprobCreate(&prob, dataset, first, nexamples, &policy) );
+
+   printf("training %s on %d examples (%d features, mean weight %g) with c=%g, w1=%g, w-1=%g, %s on %d thread(s)\n",
+      SCIPtrainsolverGetName(param.solver), prob->nrows, prob->ncols, meanweight, param.C, param.weightpos,
+      param.weightneg, param.method == SCIP_TRAINMETHOD_SGD ? "sgd" : "dcd", param.nthreads);
+
+   SCIP_CALL( SCIPtrainPolicy(prob, &param, state, &policy) );
+   SCIP_CALL( SCIPwriteLIBSVMPolicy(&policy, modelfname, SCIPtrainsolverGetName(param.solver)) );
+
+   printf("Accuracy = %g%% (training)\n", 100.0 * SCIPtrainprobGetAccuracy(prob, &policy));
+
+   BMSfreeMemoryArrayNull(&policy.weights);
+   SCIPpolicyFreeDepthBuckets(&policy);
+   if( state != NULL )
+   {
+      SCIP_CALL( SCIPtrainstateWrite(state, statefname) );
+      SCIP_CALL( SCIPtrainstateFree(&state) );
+   }
+   SCIP_CALL( SCIPtrainprobFree(&prob) );
+   SCIP_CALL( SCIPdatasetFree(&dataset) );
+
+   BMScheckEmptyMemory();
+
+   return SCIP_OKAY;
+}
+
+#define GRID_MAXVALS            32           /**< maximum number of values of a hyperparameter of the grid search */
+
+/** parses a comma separated list of reals; returns the number of values or -1 on error */
+static
+int parseRealList(
+   const char*                str,                /**< list to parse */
+   SCIP_Real*                 vals,               /**< array to store the values */
+   int                        maxvals,            /**< size of the array */
+   SCIP_Bool                  positive            /**< must the values be positive? */
+   )
+{
+   int nvals = 0;
+
+   while( *str != '\0' )
+   {
+      char* end;
+
+      if( nvals >= maxvals )
+         return -1;
+      vals[nvals] = strtod(str, &end);
+      if( end == str || (positive && vals[nvals] <= 0) || (*end != ',' && *end != '\0') )
+         return -1;
+      nvals++;
+      str = (*end == ',') ? end + 1 : end;
+   }
+
+   return nvals;
+}
+
+/** held-out score of a grid point by which the points are ranked: the mean of the accuracies on both classes, since
+ *  the oracle labels are highly imbalanced
+ */
+static
+SCIP_Real gridPointScore(
+   SCIP_TRAINGRIDPOINT*       point               /**< grid point */
+   )
+{
+   if( point->retcode != SCIP_OKAY )
+      return -1.0;
+   return (point->accpos + point->accneg) / 2.0;
+}
+
+/** grid points for sorting */
+static SCIP_TRAINGRIDPOINT* sortpoints = NULL;
+
+/** compares two grid points by decreasing score, then decreasing accuracy */
+static
+int gridPointComp(
+   const void*                elem1,              /**< index of first point */
+   const void*                elem2               /**< index of second point */
+   )
+{
+   SCIP_TRAINGRIDPOINT* point1 = &sortpoints[*(const int*)elem1];
+   SCIP_TRAINGRIDPOINT* point2 = &sortpoints[*(const int*)elem2];
+   SCIP_Real score1 = gridPointScore(point1);
+   SCIP_Real score2 = gridPointScore(point2);
+
+   if( score1 != score2 )
+      return score1 > score2 ? -1 : 1;
+   if( point1->accuracy != point2->accuracy )
+      return point1->accuracy > point2->accuracy ? -1 : 1;
+   return *(const int*)elem1 - *(const int*)elem2;
+}
+
+/** trains policies for all combinations of C and the class weights on one trajectory file, scores them on a held-out
+ *  trajectory file and writes all models and a ranking table <modelprefix>.rank
+ *
+ *  syntax: scipdagger gridsearch [-s <solver>] [-c <list>] [-w1 <list>] [-w-1 <list>] [-e <eps>] [-a] [-n <threads>]
+ *                                [-q <nbuckets>] <trjfile> <heldoutfile> <modelprefix>
+ */
+static
+SCIP_RETCODE runGridSearch(
+   int                        argc,               /**< number of shell parameters */
+   char**                     argv                /**< array with shell parameters */
+   )
+{
+   SCIP_TRAINPARAM param;
+   SCIP_DATASET* dataset;
+   SCIP_DATASET* heldoutset;
+   SCIP_TRAINPROB* prob;
+   SCIP_TRAINPROB* heldout;
+   SCIP_TRAINGRIDPOINT* points;
+   SCIP_POLICY layout;                       /**< holds the depth buckets of the training and held-out problems */
+   SCIP_Real cs[GRID_MAXVALS] = {0.25, 0.5, 1.0, 2.0, 4.0, 8.0};
+   SCIP_Real wposs[GRID_MAXVALS] = {1.0, 2.0, 4.0, 8.0};
+   SCIP_Real wnegs[GRID_MAXVALS] = {1.0};
+   int ncs = 6;
+   int nwposs = 4;
+   int nwnegs = 1;
+   char* trjfname = NULL;
+   char* heldoutfname = NULL;
+   char* modelprefix = NULL;
+   char fname[SCIP_MAXSTRLEN];
+   FILE* rankfile;
+   SCIP_Bool normalize = FALSE;              /**< divide C by the mean instance weight? */
+   SCIP_Bool paramerror = FALSE;
+   SCIP_Real meanweight;
+   int* order;
+   int npoints;
+   int nthreads = 1;
+   int ndepthbuckets = 0;                    /**< number of quantile depth buckets, or 0 for buckets of equal width */
+   int featsize;
+   int p;
+   int i;
+
+   SCIPtrainparamSetDefault(&param);
+
+   for( i = 2; i < argc && !paramerror; ++i )
+   {
+      if( argv[i][0] == '-' && argv[i][1] != '\0' )
+      {
+         if( strcmp(argv[i], "-a") == 0 )
+            normalize = TRUE;
+         else if( i + 1 >= argc )
+         {
+            printf("missing value after parameter '%s'\n", argv[i]);
+            paramerror = TRUE;
+         }
+         else if( strcmp(argv[i], "-s") == 0 )
+         {
+            param.solver = (SCIP_TRAINSOLVER)atoi(argv[++i]);
+            if( param.solver != SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL && param.solver != SCIP_TRAINSOLVER_L2R_L1LOSS_SVC_DUAL
+               && param.solver != SCIP_TRAINSOLVER_L2R_LR_DUAL )
+            {
+               printf("unsupported solver %d (use 1, 3 or 7)\n", (int)param.solver);
+               paramerror = TRUE;
+            }
+         }
+         else if( strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "-w1") == 0 || strcmp(argv[i], "-w-1") == 0 )
+         {
+            int nvals;
+
+            if( argv[i][1] == 'c' )
+               nvals = ncs = parseRealList(argv[i + 1], cs, GRID_MAXVALS, TRUE);
+            else if( argv[i][2] == '1' )
+               nvals = nwposs = parseRealList(argv[i + 1], wposs, GRID_MAXVALS, TRUE);
+            else
+               nvals = nwnegs = parseRealList(argv[i + 1], wnegs, GRID_MAXVALS, TRUE);
+            if( nvals <= 0 )
+            {
+               printf("invalid list of at most %d positive values <%s> after parameter '%s'\n", GRID_MAXVALS, argv[i + 1],
+                  argv[i]);
+               paramerror = TRUE;
+            }
+            i++;
+         }
+         else if( strcmp(argv[i], "-e") == 0 )
+            param.eps = atof(argv[++i]);
+         else if( strcmp(argv[i], "-n") == 0 )
+         {
+            nthreads = atoi(argv[++i]);
+            if( nthreads < 1 )
+            {
+               printf("number of threads must be positive\n");
+               paramerror = TRUE;
+            }
+         }
+         else if( strcmp(argv[i], "-q") == 0 )
+         {
+            ndepthbuckets = parseNDepthBuckets(argv[++i]);
+            paramerror = (ndepthbuckets < 0);
+         }
+         else
+         {
+            printf("invalid parameter <%s>\n", argv[i]);
+            paramerror = TRUE;
+         }
+      }
+      else if( trjfname == NULL )
+         trjfname = argv[i];
+      else if( heldoutfname == NULL )
+         heldoutfname = argv[i];
+      else if( modelprefix == NULL )
+         modelprefix = argv[i];
+      else
+      {
+         printf("invalid parameter <%s>\n", argv[i]);
+         paramerror = TRUE;
+      }
+   }
+
+   if( paramerror || trjfname == NULL || heldoutfname == NULL || modelprefix == NULL )
+   {
+      printf("\nsyntax: %s gridsearch [-s <solver>] [-c <list>] [-w1 <list>] [-w-1 <list>] [-e <eps>] [-a] [-n <threads>]\n"
+         "       [-q <nbuckets>] <trjfile> <heldoutfile> <modelprefix>\n"
+         "  -s <solver>      : 1 L2-loss SVM (dual, default), 3 L1-loss SVM (dual), 7 logistic regression (dual)\n"
+         "  -c <list>        : comma separated costs of constraint violation (default 0.25,0.5,1,2,4,8)\n"
+         "  -w1, -w-1 <list> : comma separated cost multipliers of the positive (default 1,2,4,8)/negative (default 1) class\n"
+         "  -e <eps>         : tolerance of the stopping criterion\n"
+         "  -a               : divide C by the mean instance weight\n"
+         "  -n <threads>     : number of threads\n"
+         "  -q <nbuckets>    : divide the depths into buckets of about equally many training examples, stored in the\n"
+         "                     models (default: ten buckets of equal width)\n"
+         "the model of each point is written to <modelprefix>.c<C>.w<w1>.<w-1>, the ranking to <modelprefix>.rank\n",
+         argv[0]);
+      return SCIP_OKAY;
+   }
+
+   /* load both trajectory files once; all points share the training problems */
+   featsize = SCIPdatasetReadFeatSize(trjfname);
+   if( featsize <= 0 || SCIPdatasetReadFeatSize(heldoutfname) != featsize )
+   {
+      printf("files <%s> and <%s> are not binary trajectory files of the same feature size\n", trjfname, heldoutfname);
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( SCIPdatasetCreate(&dataset, featsize) );
+   SCIP_CALL( SCIPdatasetRead(dataset, trjfname) );
+   SCIP_CALL( SCIPdatasetCreate(&heldoutset, featsize) );
+   SCIP_CALL( SCIPdatasetRead(heldoutset, heldoutfname) );
+
+   /* the held-out examples are laid out by the buckets of the training examples, like in the trained models */
+   layout.weights = NULL;
+   layout.size = 0;
+   layout.depthbounds = NULL;
+   layout.depthbuckets = NULL;
+   layout.ndepthbounds = 0;
+   if( ndepthbuckets > 0 )
+   {
+      SCIP_CALL( setQuantileDepthBuckets(dataset, ndepthbuckets, &layout) );
+   }
+
+   SCIP_CALL( SCIPtrainprobCreate(&prob, dataset, 0, SCIPdatasetGetNExamples(dataset), &layout) );
+   SCIP_CALL( SCIPtrainprobCreate(&heldout, heldoutset, 0, SCIPdatasetGetNExamples(heldoutset), &layout) );
+   meanweight = SCIPdatasetGetMeanWeight(dataset, 0, SCIPdatasetGetNExamples(dataset));
+   SCIP_CALL( SCIPdatasetFree(&heldoutset) );
+   SCIP_CALL( SCIPdatasetFree(&dataset) );
+
+   npoints = ncs * nwposs * nwnegs;
+   SCIP_ALLOC( BMSallocMemoryArray(&points, npoints) );
+   SCIP_ALLOC( BMSallocMemoryArray(&order, npoints) );
+   for( p = 0; p < npoints; p++ )
+   {
+      points[p].C = cs[p / (nwposs * nwnegs)];
+      points[p].weightpos = wposs[(p / nwnegs) % nwposs];
+      points[p].weightneg = wnegs[p % nwnegs];
+      points[p].policy.weights = NULL;
+      points[p].policy.size = 0;
+      points[p].policy.depthbounds = NULL;
+      points[p].policy.depthbuckets = NULL;
+      points[p].policy.ndepthbounds = 0;
+      SCIP_CALL( SCIPpolicySetDepthBuckets(&points[p].policy, layout.depthbounds, layout.ndepthbounds) );
+      order[p] = p;
+   }
+
+   printf("training %s on %d examples (%d held out) for %d grid points on %d thread(s)\n",
+      SCIPtrainsolverGetName(param.solver), prob->nrows, heldout->nrows, npoints, nthreads);
+
+   /* the normalization is applied when training, the table shows the C of the command line */
+   if( normalize )
+   {
+      for( p = 0; p < npoints; p++ )
+         points[p].C /= meanweight;
+   }
+   SCIP_CALL( SCIPtrainGridSearch(prob, heldout, &param, points, npoints, nthreads) );
+   if( normalize )
+   {
+      for( p = 0; p < npoints; p++ )
+         points[p].C *= meanweight;
+   }
+
+   for( p = 0; p < npoints; p++ )
+   {
+      if( points[p].retcode != SCIP_OKAY )
+         continue;
+      (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s.c%g.w%g.%g", modelprefix, points[p].C, points[p].weightpos,
+         points[p].weightneg);
+      SCIP_CALL( SCIPwriteLIBSVMPolicy(&points[p].policy, fname, SCIPtrainsolverGetName(param.solver)) );
+   }
+
+   sortpoints = points;
+   qsort(order, (size_t)npoints, sizeof(int), gridPointComp);
+   sortpoints = NULL;
+
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s.rank", modelprefix);
+   rankfile = fopen(fname, "w");
+   if( rankfile == NULL )
+      printf("cannot write ranking to <%s>\n", fname);
+   printf("%4s %8s %8s %8s %10s %10s %10s %10s\n", "rank", "C", "w1", "w-1", "score", "accuracy", "acc(+1)", "acc(-1)");
+   if( rankfile != NULL )
+      fprintf(rankfile, "rank C w1 w-1 score accuracy accpos accneg\n");
+   for( i = 0; i < npoints; i++ )
+   {
+      SCIP_TRAINGRIDPOINT* point = &points[order[i]];
+
+      if( point->retcode != SCIP_OKAY )
+      {
+         printf("%4d %8g %8g %8g   failed (%d)\n", i + 1, point->C, point->weightpos, point->weightneg, point->retcode);
+         continue;
+      }
+      printf("%4d %8g %8g %8g %10.4f %10.4f %10.4f %10.4f\n", i + 1, point->C, point->weightpos, point->weightneg,
+         gridPointScore(point), point->accuracy, point->accpos, point->accneg);
+      if( rankfile != NULL )
+         fprintf(rankfile, "%d %g %g %g %g %g %g %g\n", i + 1, point->C, point->weightpos, point->weightneg,
+            gridPointScore(point), point->accuracy, point->accpos, point->accneg);
+   }
+   if( rankfile != NULL )
+      fclose(rankfile);
+
+   for( p = 0; p < npoints; p++ )
+   {
+      BMSfreeMemoryArrayNull(&points[p].policy.weights);
+      SCIPpolicyFreeDepthBuckets(&points[p].policy);
+   }
+   SCIPpolicyFreeDepthBuckets(&layout);
+   BMSfreeMemoryArray(&order);
+   BMSfreeMemoryArray(&points);
+   SCIP_CALL( SCIPtrainprobFree(&heldout) );
+   SCIP_CALL( SCIPtrainprobFree(&prob) );
+
+   BMScheckEmptyMemory();
+
+   return SCIP_OKAY;
+}
+
+#define REPLAY_MAXPOLICIES      16           /**< maximum number of policies of each kind of a replay */
+
+/** replays node selection and pruning policies on trees recorded by the trace event handler (with
+ *  eventhdlr/trace/features set) and prints one CSV line per trace, policy pair and threshold; the policies are
+ *  evaluated without solving any LP, see replay.c
+ *
+ *  syntax: scipdagger replay [--nodesel <policy>]... [--nodepru <policy>]... [-t <list>] [-n <nodelimit>]
+ *                            <tracefile>...
+ */
+static
+SCIP_RETCODE runReplay(
+   int                        argc,               /**< number of shell parameters */
+   char**                     argv                /**< array with shell parameters */
+   )
+{
+   SCIP* scip;
+   SCIP_POLICY* selpolicies[REPLAY_MAXPOLICIES];
+   SCIP_POLICY* prupolicies[REPLAY_MAXPOLICIES];
+   char* selfnames[REPLAY_MAXPOLICIES];
+   char* prufnames[REPLAY_MAXPOLICIES];
+   SCIP_Real thresholds[GRID_MAXVALS] = {0.0};
+   SCIP_REPLAYRESULT result;
+   SCIP_Longint nodelimit = -1;
+   SCIP_Bool paramerror = FALSE;
+   int nsels = 0;
+   int nprus = 0;
+   int nthresholds = 1;
+   int ntraces = 0;
+   int s;
+   int p;
+   int t;
+   int i;
+
+   for( i = 2; i < argc && !paramerror; ++i )
+   {
+      if( argv[i][0] == '-' && argv[i][1] != '\0' )
+      {
+         if( i + 1 >= argc )
+         {
+            printf("missing value after parameter '%s'\n", argv[i]);
+            paramerror = TRUE;
+         }
+         else if( strcmp(argv[i], "--nodesel") == 0 || strcmp(argv[i], "--nodepru") == 0 )
+         {
+            if( (argv[i][6] == 's' ? nsels : nprus) >= REPLAY_MAXPOLICIES )
+            {
+               printf("at most %d policies of each kind\n", REPLAY_MAXPOLICIES);
+               paramerror = TRUE;
+            }
+            else if( argv[i][6] == 's' )
+               selfnames[nsels++] = argv[++i];
+            else
+               prufnames[nprus++] = argv[++i];
+         }
+         else if( strcmp(argv[i], "-t") == 0 )
+         {
+            nthresholds = parseRealList(argv[++i], thresholds, GRID_MAXVALS, FALSE);
+            if( nthresholds <= 0 )
+            {
+               printf("invalid list of at most %d thresholds <%s>\n", GRID_MAXVALS, argv[i]);
+               paramerror = TRUE;
+            }
+         }
+         else if( strcmp(argv[i], "-n") == 0 )
+            nodelimit = atoll(argv[++i]);
+         else
+         {
+            printf("invalid parameter <%s>\n", argv[i]);
+            paramerror = TRUE;
+         }
+      }
+      else
+         ntraces++;
+   }
+
+   if( paramerror || ntraces == 0 )
+   {
+      printf("\nsyntax: %s replay [--nodesel <policy>]... [--nodepru <policy>]... [-t <list>] [-n <nodelimit>]\n"
+         "       <tracefile>...\n"
+         "  --nodesel <policy> : node selection policy (default: the recorded order)\n"
+         "  --nodepru <policy> : node pruning policy (default: no pruning)\n"
+         "  -t <list>          : comma separated pruning thresholds on the score (default 0)\n"
+         "  -n <nodelimit>     : maximum number of explored nodes\n"
+         "the traces must be recorded with --trace and eventhdlr/trace/features = TRUE\n",
+         argv[0]);
+      return SCIP_OKAY;
+   }
+
+   /* the SCIP instance only holds the policies */
+   SCIP_CALL( SCIPcreate(&scip) );
+   SCIPsetMessagehdlrQuiet(scip, TRUE);
+   for( s = 0; s < nsels; s++ )
+   {
+      SCIP_CALL( SCIPpolicyCreate(scip, &selpolicies[s]) );
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, selfnames[s], &selpolicies[s]) );
+   }
+   for( p = 0; p < nprus; p++ )
+   {
+      SCIP_CALL( SCIPpolicyCreate(scip, &prupolicies[p]) );
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, prufnames[p], &prupolicies[p]) );
+   }
+
+   printf("trace,nodesel,nodepru,threshold,nodes,boundpruned,policypruned,unknown,optnode,optpruned,bestobj,optobj\n");
+   for( i = 2; i < argc; ++i )
+   {
+      SCIP_REPLAY* replay;
+      SCIP_Real* selscores;
+      SCIP_Real* pruscores;
+      int nnodes;
+
+      if( argv[i][0] == '-' && argv[i][1] != '\0' )
+      {
+         i++;
+         continue;
+      }
+
+      SCIP_CALL( SCIPreplayCreate(&replay, argv[i]) );
+      if( (nsels > 0 && !SCIPreplayHasFeatures(replay, 0)) || (nprus > 0 && !SCIPreplayHasFeatures(replay, 1)) )
+      {
+         printf("trace file <%s> has no features, record it with eventhdlr/trace/features = TRUE\n", argv[i]);
+         SCIP_CALL( SCIPreplayFree(&replay) );
+         continue;
+      }
+
+      /* the scores are computed once per trace; an extra slot without scores replays the recorded order and no
+       * pruning
+       */
+      nnodes = SCIPreplayGetNNodes(replay);
+      SCIP_ALLOC( BMSallocMemoryArray(&selscores, (size_t)MAX(nsels, 1) * nnodes) );
+      SCIP_ALLOC( BMSallocMemoryArray(&pruscores, (size_t)MAX(nprus, 1) * nnodes) );
+      for( s = 0; s < nsels; s++ )
+         SCIPreplayCalcScores(replay, selpolicies[s], 0, &selscores[(size_t)s * nnodes]);
+      for( p = 0; p < nprus; p++ )
+         SCIPreplayCalcScores(replay, prupolicies[p], 1, &pruscores[(size_t)p * nnodes]);
+
+      for( s = 0; s < MAX(nsels, 1); s++ )
+      {
+         for( p = 0; p < MAX(nprus, 1); p++ )
+         {
+            for( t = 0; t < (nprus > 0 ? nthresholds : 1); t++ )
+            {
+               SCIP_CALL( SCIPreplayRun(replay, nsels > 0 ? &selscores[(size_t)s * nnodes] : NULL,
+                     nprus > 0 ? &pruscores[(size_t)p * nnodes] : NULL, thresholds[t], nodelimit, &result) );
+               printf("%s,%s,%s,%g,%"SCIP_LONGINT_FORMAT",%"SCIP_LONGINT_FORMAT",%"SCIP_LONGINT_FORMAT",%"
+                  SCIP_LONGINT_FORMAT",%"SCIP_LONGINT_FORMAT",%d,%.15g,%.15g\n", argv[i],
+                  nsels > 0 ? selfnames[s] : "-", nprus > 0 ? prufnames[p] : "-", nprus > 0 ? thresholds[t] : 0.0,
+                  result.nnodes, result.nboundpruned, result.npolicypruned, result.nunknown, result.optnode,
+                  (int)result.optpruned, result.bestobj, replay->optobj);
+            }
+         }
+      }
+
+      BMSfreeMemoryArray(&pruscores);
+      BMSfreeMemoryArray(&selscores);
+      SCIP_CALL( SCIPreplayFree(&replay) );
+   }
+
+   for( p = nprus - 1; p >= 0; p-- )
+   {
+      SCIP_CALL( SCIPpolicyFree(scip, &prupolicies[p]) );
+   }
+   for( s = nsels - 1; s >= 0; s-- )
+   {
+      SCIP_CALL( SCIPpolicyFree(scip, &selpolicies[s]) );
+   }
+   SCIP_CALL( SCIPfree(&scip) );
+
+   BMScheckEmptyMemory();
+
+   return SCIP_OKAY;
+}
+
+/** writes synthetic MIK problems mik.<n>-<m>-<k>.<seed>.mps of the family of sample-dat/train for the seeds
+ *  seed, ..., seed+count-1 to a directory; with --sol, each problem is also solved and its best solution is written to
+ *  mik.<n>-<m>-<k>.<seed>.sol for the oracle
+ *
+ *  syntax: scipdagger generate [-n <nintvars>] [-m <ncontvars>] [-k <nconss>] [-S <seed>] [-c <count>] [--sol]
+ *                              [-s <settings>] [-t <timelimit>] <dir>
+ */
+static
+SCIP_RETCODE runGenerate(
+   int                        argc,               /**< number of shell parameters */
+   char**                     argv                /**< array with shell parameters */
+   )
+{
+   char fname[SCIP_MAXSTRLEN];
+   char* outdir = NULL;
+   char* settingsname = NULL;
+   SCIP_Real timelimit = -1.0;
+   SCIP_Bool solve = FALSE;
+   SCIP_Bool paramerror = FALSE;
+   unsigned int seed = 1;
+   int nintvars = 250;
+   int ncontvars = 10;
+   int nconss = 100;
+   int count = 1;
+   int c;
+   int i;
+
+   for( i = 2; i < argc && !paramerror; ++i )
+   {
+      if( argv[i][0] == '-' && argv[i][1] != '\0' )
+      {
+         if( strcmp(argv[i], "--sol") == 0 )
+            solve = TRUE;
+         else if( i + 1 >= argc )
+         {
+            printf("missing value after parameter '%s'\n", argv[i]);
+            paramerror = TRUE;
+         }
+         else if( strcmp(argv[i], "-n") == 0 )
+            nintvars = atoi(argv[++i]);
+         else if( strcmp(argv[i], "-m") == 0 )
+            ncontvars = atoi(argv[++i]);
+         else if( strcmp(argv[i], "-k") == 0 )
+            nconss = atoi(argv[++i]);
+         else if( strcmp(argv[i], "-S") == 0 )
+            seed = (unsigned int)atoi(argv[++i]);
+         else if( strcmp(argv[i], "-c") == 0 )
+            count = atoi(argv[++i]);
+         else if( strcmp(argv[i], "-s") == 0 )
+            settingsname = argv[++i];
+         else if( strcmp(argv[i], "-t") == 0 )
+            timelimit = atof(argv[++i]);
+         else
+         {
+            printf("invalid parameter <%s>\n", argv[i]);
+            paramerror = TRUE;
+         }
+      }
+      else if( outdir == NULL )
+         outdir = argv[i];
+      else
+      {
+         printf("more than one output directory\n");
+         paramerror = TRUE;
+      }
+   }
+
+   if( paramerror || outdir == NULL || count < 1 || nconss < 1 || ncontvars < 0 || nintvars <= 2 * nconss )
+   {
+      printf("\nsyntax: %s generate [-n <nintvars>] [-m <ncontvars>] [-k <nconss>] [-S <seed>] [-c <count>] [--sol]\n"
+         "       [-s <settings>] [-t <timelimit>] <dir>\n"
+         "  -n <nintvars>  : number of integer variables, more than 2 * nconss (default 250)\n"
+         "  -m <ncontvars> : number of continuous variables (default 10)\n"
+         "  -k <nconss>    : number of knapsack constraints (default 100)\n"
+         "  -S <seed>      : seed of the first problem (default 1)\n"
+         "  -c <count>     : number of problems, with consecutive seeds (default 1)\n"
+         "  --sol          : also solve each problem and write its best solution\n"
+         "  -s <settings>  : settings file of the solves\n"
+         "  -t <timelimit> : time limit of each solve\n"
+         "the problems are written as <dir>/mik.<nintvars>-<ncontvars>-<nconss>.<seed>.mps\n",
+         argv[0]);
+      return SCIP_OKAY;
+   }
+
+   if( mkdir(outdir, 0755) != 0 && errno != EEXIST )
+   {
+      SCIPerrorMessage("cannot create directory <%s>\n", outdir);
+      SCIPprintSysError(outdir);
+      return SCIP_FILECREATEERROR;
+   }
+
+   for( c = 0; c < count; c++ )
+   {
+      SCIP* scip;
+      FILE* file;
+
+      SCIP_CALL( SCIPcreate(&scip) );
+      SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
+      SCIPsetMessagehdlrQuiet(scip, TRUE);
+
+      SCIP_CALL( SCIPcreateProbMik(scip, nintvars, ncontvars, nconss, seed + (unsigned int)c) );
+      (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/%s.mps", outdir, SCIPgetProbName(scip));
+      SCIP_CALL( SCIPwriteOrigProblem(scip, fname, NULL, FALSE) );
+      printf("%s", fname);
+
+      if( solve )
+      {
+         if( settingsname != NULL )
+         {
+            SCIP_CALL( SCIPreadParams(scip, settingsname) );
+         }
+         if( timelimit > -1 )
+         {
+            SCIP_CALL( SCIPsetRealParam(scip, "limits/time", timelimit) );
+         }
+         SCIP_CALL( SCIPsolve(scip) );
+
+         (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/%s.sol", outdir, SCIPgetProbName(scip));
+         file = fopen(fname, "w");
+         if( file == NULL )
+         {
+            SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+            SCIPprintSysError(fname);
+            return SCIP_FILECREATEERROR;
+         }
+         SCIP_CALL( SCIPprintBestSol(scip, file, FALSE) );
+         fclose(file);
+
+         /* the oracle takes the solution as optimal, so say when it is not */
+         printf(" %s (%"SCIP_LONGINT_FORMAT" nodes, %.1fs%s)", fname, SCIPgetNNodes(scip), SCIPgetSolvingTime(scip),
+            SCIPgetStatus(scip) == SCIP_STATUS_OPTIMAL ? "" : ", not proven optimal");
+      }
+      printf("\n");
+
+      SCIP_CALL( SCIPfree(&scip) );
+   }
+
+   BMScheckEmptyMemory();
+
+   return SCIP_OKAY;
+}
+
+/** solves one problem with the oracle (if there is no policy yet) or the current policies and adds the examples of the
+ *  oracle to the datasets
+ */
+static
+SCIP_RETCODE daggerCollect(
+   const char*                probfname,          /**< problem file */
+   const char*                solfname,           /**< optimal solution file of the problem */
+   const char*                settingsname,       /**< settings file, or NULL */
+   int                        freq,               /**< restriction level, see setRestrictionLevel() */
+   SCIP_Bool                  quiet,              /**< suppress the output of SCIP? */
+   SCIP_POLICY*               searchpolicy,       /**< node selection policy (weights are NULL before the first round) */
+   SCIP_POLICY*               killpolicy,         /**< node pruning policy (weights are NULL before the first round) */
+   SCIP_DATASET*              searchset,          /**< dataset of node selection examples */
+   SCIP_DATASET*              killset,            /**< dataset of node pruning examples */
+   SCIP_Real*                 solvetime           /**< pointer to store the solving time */
+   )
+{
+   SCIP* scip = NULL;
+   SCIP_RETCODE retcode;
+
+   SCIP_CALL( SCIPcreate(&scip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
+   if( quiet )
+      SCIPsetMessagehdlrQuiet(scip, quiet);
+
+   if( killpolicy->weights == NULL )
+   {
+      SCIP_CALL( SCIPincludeNodepruOracle(scip) );
+      SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/oracle/solfname", solfname) );
+      SCIPnodepruoracleSetDataset(SCIPfindNodepru(scip, "oracle"), killset);
+   }
+   else
+   {
+      SCIP_CALL( SCIPincludeNodepruDagger(scip) );
+      SCIP_CALL( SCIPsetStringParam(scip, "nodepruning/dagger/solfname", solfname) );
+      SCIPnodeprudaggerSetPolicy(SCIPfindNodepru(scip, "dagger"), killpolicy);
+      SCIPnodeprudaggerSetDataset(SCIPfindNodepru(scip, "dagger"), killset);
+   }
+
+   if( searchpolicy->weights == NULL )
+   {
+      SCIP_CALL( SCIPincludeNodeselOracle(scip) );
+      SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/oracle/solfname", solfname) );
+      SCIPnodeseloracleSetDataset(SCIPfindNodesel(scip, "oracle"), searchset);
+      SCIP_CALL( SCIPsetNodeselStdPriority(scip, SCIPfindNodesel(scip, "oracle"), 9999999) );
+   }
+   else
+   {
+      SCIP_CALL( SCIPincludeNodeselDagger(scip) );
+      SCIP_CALL( SCIPsetStringParam(scip, "nodeselection/dagger/solfname", solfname) );
+      SCIPnodeseldaggerSetPolicy(SCIPfindNodesel(scip, "dagger"), searchpolicy);
+      SCIPnodeseldaggerSetDataset(SCIPfindNodesel(scip, "dagger"), searchset);
+      SCIP_CALL( SCIPsetNodeselStdPriority(scip, SCIPfindNodesel(scip, "dagger"), 9999999) );
+   }
+
+   if( settingsname != NULL )
+   {
+      SCIP_CALL( SCIPreadParams(scip, settingsname) );
+   }
+   SCIP_CALL( setRestrictionLevel(scip, freq) );
+
+   *solvetime = 0.0;
+   retcode = SCIPreadProb(scip, probfname, NULL);
+   if( retcode == SCIP_OKAY )
+   {
+      SCIP_CALL( SCIPsolve(scip) );
+      *solvetime = SCIPgetSolvingTime(scip);
+   }
+   else
+      printf("cannot read problem <%s>, skipped\n", probfname);
+
+   SCIP_CALL( SCIPfree(&scip) );
+
+   return SCIP_OKAY;
+}
+
+#define DAGGER_CKPTVERSION      "scipdagger checkpoint 1" /**< first line of the checkpoint of runDagger() */
+
+/** renames a temporary file to its final name, so that a file with the final name is always complete */
+static
+SCIP_RETCODE daggerCommitFile(
+   const char*                tmpfname,           /**< temporary file */
+   const char*                fname               /**< final name */
+   )
+{
+   if( rename(tmpfname, fname) != 0 )
+   {
+      SCIPerrorMessage("cannot rename <%s> to <%s>\n", tmpfname, fname);
+      SCIPprintSysError(fname);
+      return SCIP_WRITEERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** writes the examples of the datasets, in their order, to a binary trajectory file that replaces the file atomically */
+static
+SCIP_RETCODE daggerSaveDatasets(
+   SCIP_DATASET**             datasets,           /**< datasets */
+   int                        ndatasets,          /**< number of datasets */
+   const char*                fname               /**< trajectory file */
+   )
+{
+   char tmpfname[SCIP_MAXSTRLEN];
+   int i;
+
+   (void) SCIPsnprintf(tmpfname, SCIP_MAXSTRLEN, "%s.tmp", fname);
+
+   /* SCIPdatasetWrite() appends to an existing file */
+   (void) remove(tmpfname);
+   for( i = 0; i < ndatasets; i++ )
+   {
+      SCIP_CALL( SCIPdatasetWrite(datasets[i], tmpfname, 0, SCIPdatasetGetNExamples(datasets[i])) );
+   }
+   SCIP_CALL( daggerCommitFile(tmpfname, fname) );
+
+   return SCIP_OKAY;
+}
+
+/** writes the dual state of the trainer to a file that replaces the file atomically */
+static
+SCIP_RETCODE daggerSaveState(
+   SCIP_TRAINSTATE*           state,              /**< dual state */
+   const char*                fname               /**< state file */
+   )
+{
+   char tmpfname[SCIP_MAXSTRLEN];
+
+   (void) SCIPsnprintf(tmpfname, SCIP_MAXSTRLEN, "%s.tmp", fname);
+   SCIP_CALL( SCIPtrainstateWrite(state, tmpfname) );
+   SCIP_CALL( daggerCommitFile(tmpfname, fname) );
+
+   return SCIP_OKAY;
+}
+
+/** writes the examples and the solving time of a solved problem to the job files <policydir>/{search,kill}Job.<pos> and
+ *  <policydir>/job.<pos>, where pos is the position of the problem in the sequence of all passes; the last one marks the
+ *  job as done
+ */
+static
+SCIP_RETCODE daggerSaveJob(
+   const char*                policydir,          /**< directory of the checkpoint */
+   int                        pos,                /**< position of the problem in the sequence */
+   const char*                probfname,          /**< problem file */
+   SCIP_DATASET*              searchset,          /**< node selection examples of the problem */
+   SCIP_DATASET*              killset,            /**< node pruning examples of the problem */
+   SCIP_Real                  solvetime           /**< solving time of the problem */
+   )
+{
+   char fname[SCIP_MAXSTRLEN];
+   char tmpfname[SCIP_MAXSTRLEN];
+   FILE* file;
+
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/searchJob.%d", policydir, pos);
+   SCIP_CALL( daggerSaveDatasets(&searchset, 1, fname) );
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/killJob.%d", policydir, pos);
+   SCIP_CALL( daggerSaveDatasets(&killset, 1, fname) );
+
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/job.%d", policydir, pos);
+   (void) SCIPsnprintf(tmpfname, SCIP_MAXSTRLEN, "%s.tmp", fname);
+   file = fopen(tmpfname, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", tmpfname);
+      SCIPprintSysError(tmpfname);
+      return SCIP_FILECREATEERROR;
+   }
+   fprintf(file, "%.17g %s\n", solvetime, probfname);
+   if( fclose(file) != 0 )
+   {
+      SCIPerrorMessage("error writing file <%s>\n", tmpfname);
+      return SCIP_WRITEERROR;
+   }
+   SCIP_CALL( daggerCommitFile(tmpfname, fname) );
+
+   return SCIP_OKAY;
+}
+
+/** reads the examples and the solving time of a problem solved before the run was interrupted, if its job files exist */
+static
+SCIP_RETCODE daggerLoadJob(
+   const char*                policydir,          /**< directory of the checkpoint */
+   int                        pos,                /**< position of the problem in the sequence */
+   const char*                probfname,          /**< problem file */
+   SCIP_DATASET*              searchset,          /**< empty dataset to store the node selection examples */
+   SCIP_DATASET*              killset,            /**< empty dataset to store the node pruning examples */
+   SCIP_Real*                 solvetime,          /**< pointer to store the solving time */
+   SCIP_Bool*                 done                /**< pointer to store whether the problem was solved */
+   )
+{
+   char fname[SCIP_MAXSTRLEN];
+   char line[SCIP_MAXSTRLEN];
+   char* name;
+   FILE* file;
+
+   *done = FALSE;
+
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/job.%d", policydir, pos);
+   file = fopen(fname, "r");
+   if( file == NULL )
+      return SCIP_OKAY;
+   if( fgets(line, SCIP_MAXSTRLEN, file) == NULL )
+      line[0] = '\0';
+   fclose(file);
+
+   /* a job file of another problem is left over from a different sequence */
+   *solvetime = strtod(line, &name);
+   if( name == line || *name != ' ' )
+      return SCIP_OKAY;
+   name++;
+   name[strcspn(name, "\n")] = '\0';
+   if( strcmp(name, probfname) != 0 )
+      return SCIP_OKAY;
+
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/searchJob.%d", policydir, pos);
+   SCIP_CALL( SCIPdatasetRead(searchset, fname) );
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/killJob.%d", policydir, pos);
+   SCIP_CALL( SCIPdatasetRead(killset, fname) );
+   *done = TRUE;
+
+   return SCIP_OKAY;
+}
+
+/** removes the job files of a problem */
+static
+void daggerRemoveJob(
+   const char*                policydir,          /**< directory of the checkpoint */
+   int                        pos                 /**< position of the problem in the sequence */
+   )
+{
+   char fname[SCIP_MAXSTRLEN];
+
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/job.%d", policydir, pos);
+   (void) remove(fname);
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/searchJob.%d", policydir, pos);
+   (void) remove(fname);
+   (void) SCIPsnprintf(fname, SCIP_MAXSTRLEN, "%s/killJob.%d", policydir, pos);
+   (void) remove(fname);
+}
+
+/** writes the checkpoint of the DAgger loop, which replaces the file atomically
+ *
+ *  The checkpoint refers to the trajectory files <policydir>/{search,kill}Trj.<r> of the first nrounds rounds and the
+ *  trainer states <policydir>/{search,kill}State.<k> of the last policy. The order of the problems is given by the seed.
+ */
+static
+SCIP_RETCODE daggerWriteCheckpoint(
+   const char*                fname,              /**< checkpoint file */
+   char**                     probnames,          /**< problem files */
+   SCIP_Real*                 probtimes,          /**< solving time of each problem in the last pass, or -1 */
+   int                        nprobs,             /**< number of problems */
+   int                        npasses,            /**< number of passes */
+   int                        nperiter,           /**< number of problems per round */
+   unsigned int               seed,               /**< seed of the order of the problems */
+   int                        nrounds,            /**< number of finished rounds */
+   int                        npolicies,          /**< number of trained policies */
+   int                        nsolved,            /**< number of solved problems in the sequence */
+   int                        nsearchexamples,    /**< number of node selection examples of the finished rounds */
+   int                        nkillexamples       /**< number of node pruning examples of the finished rounds */
+   )
+{
+   char tmpfname[SCIP_MAXSTRLEN];
+   FILE* file;
+   int i;
+
+   (void) SCIPsnprintf(tmpfname, SCIP_MAXSTRLEN, "%s.tmp", fname);
+   file = fopen(tmpfname, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", tmpfname);
+      SCIPprintSysError(tmpfname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   fprintf(file, "%s\n", DAGGER_CKPTVERSION);
+   fprintf(file, "problems %d\npasses %d\nperiter %d\nseed %u\n", nprobs, npasses, nperiter, seed);
+   fprintf(file, "rounds %d\npolicies %d\nsolved %d\n", nrounds, npolicies, nsolved);
+   fprintf(file, "searchexamples %d\nkillexamples %d\n", nsearchexamples, nkillexamples);
+   for( i = 0; i < nprobs; i++ )
+      fprintf(file, "%.17g %s\n", probtimes[i], probnames[i]);
+
+   if( fclose(file) != 0 )
+   {
+      SCIPerrorMessage("error writing file <%s>\n", tmpfname);
+      return SCIP_WRITEERROR;
+   }
+   SCIP_CALL( daggerCommitFile(tmpfname, fname) );
+
+   return SCIP_OKAY;
+}
+
+/** reads a checkpoint written by daggerWriteCheckpoint() and checks that it belongs to the same problems and loop */
+static
+SCIP_RETCODE daggerReadCheckpoint(
+   const char*                fname,              /**< checkpoint file */
+   char**                     probnames,          /**< problem files */
+   SCIP_Real*                 probtimes,          /**< array to store the solving time of each problem */
+   int                        nprobs,             /**< number of problems */
+   int                        npasses,            /**< number of passes */
+   int                        nperiter,           /**< number of problems per round */
+   unsigned int*              seed,               /**< pointer to store the seed of the order of the problems */
+   int*                       nrounds,            /**< pointer to store the number of finished rounds */
+   int*                       npolicies,          /**< pointer to store the number of trained policies */
+   int*                       nsolved,            /**< pointer to store the number of solved problems */
+   int*                       nsearchexamples,    /**< pointer to store the number of node selection examples */
+   int*                       nkillexamples       /**< pointer to store the number of node pruning examples */
+   )
+{
+   char line[SCIP_MAXSTRLEN];
+   FILE* file;
+   int ckptnprobs;
+   int ckptnpasses;
+   int ckptnperiter;
+   int i;
+
+   file = fopen(fname, "r");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for reading\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_NOFILE;
+   }
+
+   if( fgets(line, SCIP_MAXSTRLEN, file) == NULL || strncmp(line, DAGGER_CKPTVERSION, strlen(DAGGER_CKPTVERSION)) != 0
+      || fscanf(file, " problems %d passes %d periter %d seed %u rounds %d policies %d solved %d searchexamples %d"
+         " killexamples %d", &ckptnprobs, &ckptnpasses, &ckptnperiter, seed, nrounds, npolicies, nsolved,
+         nsearchexamples, nkillexamples) != 9
+      || fgets(line, SCIP_MAXSTRLEN, file) == NULL )
+   {
+      SCIPerrorMessage("file <%s> is not a DAgger checkpoint\n", fname);
+      fclose(file);
+      return SCIP_READERROR;
+   }
+
+   if( ckptnprobs != nprobs || ckptnpasses != npasses || ckptnperiter != nperiter )
+   {
+      SCIPerrorMessage("checkpoint <%s> belongs to a run with %d problems, %d passes and %d problems per iteration; "
+         "remove it to start a new run\n", fname, ckptnprobs, ckptnpasses, ckptnperiter);
+      fclose(file);
+      return SCIP_READERROR;
+   }
+
+   for( i = 0; i < nprobs; i++ )
+   {
+      char* name;
+
+      if( fgets(line, SCIP_MAXSTRLEN, file) == NULL )
+         line[0] = '\0';
+      probtimes[i] = strtod(line, &name);
+      if( name != line && *name == ' ' )
+      {
+         name++;
+         name[strcspn(name, "\n")] = '\0';
+      }
+      if( name == line || strcmp(name, probnames[i]) != 0 )
+      {
+         SCIPerrorMessage("checkpoint <%s> belongs to other problems than <%s>; remove it to start a new run\n", fname,
+            probnames[i]);
+         fclose(file);
+         return SCIP_READERROR;
+      }
+   }
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** problems of a round of trajectory collection, i.e., the problems solved with the same policies */
+struct DaggerRound
+{
+   char**                     probfnames;         /**< problem file of each job */
+   char**                     solfnames;          /**< optimal solution file of each job */
+   SCIP_DATASET**             searchsets;         /**< node selection examples of each job */
+   SCIP_DATASET**             killsets;           /**< node pruning examples of each job */
+   SCIP_Real*                 solvetimes;         /**< solving time of each job */
+   SCIP_Bool*                 done;               /**< was the job solved before the run was interrupted? */
+   const char*                policydir;          /**< directory of the checkpoint and the job files */
+   int                        first;              /**< position of the first job in the sequence of all passes */
+   const char*                settingsname;       /**< settings file, or NULL */
+   int                        freq;               /**< restriction level, see setRestrictionLevel() */
+   SCIP_Bool                  quiet;              /**< suppress the output of SCIP? */
+   SCIP_POLICY*               searchpolicy;       /**< node selection policy */
+   SCIP_POLICY*               killpolicy;         /**< node pruning policy */
+};
+typedef struct DaggerRound DAGGERROUND;
+
+/** job of the worker pool: collects the examples of one problem of the round into its own datasets and saves them to
+ *  the job files, unless the job was done before the run was interrupted
+ */
+static
+SCIP_RETCODE daggerJob(
+   void*                      data,               /**< round */
+   int                        job,                /**< number of the job */
+   int                        worker              /**< number of the worker */
+   )
+{
+   DAGGERROUND* round = (DAGGERROUND*)data;
+
+   if( round->done[job] )
+      return SCIP_OKAY;
+
+   SCIP_CALL( daggerCollect(round->probfnames[job], round->solfnames[job], round->settingsname, round->freq,
+         round->quiet, round->searchpolicy, round->killpolicy, round->searchsets[job], round->killsets[job],
+         &round->solvetimes[job]) );
+   SCIP_CALL( daggerSaveJob(round->policydir, round->first + job, round->probfnames[job], round->searchsets[job],
+         round->killsets[job], round->solvetimes[job]) );
+
+   return SCIP_OKAY;
+}
+
+/** trains a policy on the examples of the dataset, warm-started from the dual state, and writes it to a file */
+static
+SCIP_RETCODE daggerTrain(
+   SCIP_DATASET*              dataset,            /**< examples collected so far */
+   SCIP_TRAINPARAM*           param,              /**< trainer parameters; C is divided by the mean instance weight */
+   SCIP_TRAINSTATE*           state,              /**< dual state of the previous policy */
+   SCIP_Bool                  newonly,            /**< train only on the examples collected since the previous policy? */
+   SCIP_POLICY*               policy,             /**< policy whose weights are replaced */
+   const char*                fname               /**< file to write the policy to */
+   )
+{
+   SCIP_TRAINPARAM scaledparam;
+   SCIP_TRAINPROB* prob;
+   int nexamples;
+   int first;
+
+   nexamples = SCIPdatasetGetNExamples(dataset);
+   if( nexamples == 0 )
+   {
+      printf("no examples for <%s>, keeping the previous policy\n", fname);
+      return SCIP_OKAY;
+   }
+
+   scaledparam = *param;
+   scaledparam.C /= SCIPdatasetGetMeanWeight(dataset, 0, nexamples);
+
+   first = 0;
+   if( newonly && state->solver == param->solver && state->nexamples < nexamples )
+      first = state->nexamples;
+
+   SCIP_CALL( SCIPtrainprobCreate(&prob, dataset, first, nexamples, policy) );
+   SCIP_CALL( SCIPtrainPolicy(prob, &scaledparam, state, policy) );
+   SCIP_CALL( SCIPwriteLIBSVMPolicy(policy, fname, SCIPtrainsolverGetName(param->solver)) );
+   printf("trained <%s> on %d examples (c=%g, w-1=%g): accuracy %g%% (training)\n", fname, prob->nrows,
+      scaledparam.C, param->weightneg, 100.0 * SCIPtrainprobGetAccuracy(prob, policy));
+   SCIP_CALL( SCIPtrainprobFree(&prob) );
+
+   return SCIP_OKAY;
+}
+
+/** runs the DAgger loop of scripts/train_bb.sh in one process: the examples of the oracle are aggregated in memory and
+ *  every policy is handed to the solves of the next round directly
+ *
+ *  The problems of a round (solved with the same policies) are distributed over a pool of workers, each solving with its
+ *  own SCIP instance, largest first by the solving time of the previous pass (the file size in the first pass). The
+ *  examples of each problem are kept apart and appended in the order of the problems, so that the datasets and policies
+ *  do not depend on the number of workers.
+ *
+ *  The run can be continued after an interruption: every solved problem saves its examples to job files, and every
+ *  round saves its examples, the dual states of the trainer and the checkpoint <policydir>/dagger.ckpt (the seed of the
+ *  order, the numbers of rounds, policies, solved problems and examples, and the solving times). All files are written
+ *  to a temporary file first and renamed. If the checkpoint exists, the examples and the policies of the finished
+ *  rounds are loaded, the seed of the checkpoint replaces --seed, and the problems with job files are not solved again.
+ *
+ *  syntax: scipdagger dagger -d <datadir> -o <soldir> -e <policydir> -p <passes> -n <problems per iteration> [-c <C>]
+ *                            [-w <w>] [-x <suffix>] [-s <settings>] [-r <freq>] [-j <threads>] [--workers <n>] [-u]
+ *                            [-q] [--seed <seed>]
+ */
+static
+SCIP_RETCODE runDagger(
+   int                        argc,               /**< number of shell parameters */
+   char**                     argv                /**< array with shell parameters */
+   )
+{
+   SCIP_TRAINPARAM param;
+   SCIP_DATASET* searchset;
+   SCIP_DATASET* killset;
+   SCIP_TRAINSTATE* searchstate;
+   SCIP_TRAINSTATE* killstate;
+   SCIP_POLICY searchpolicy;
+   SCIP_POLICY killpolicy;
+   DAGGERROUND round;
+   char** probnames;
+   char* datadir = NULL;
+   char* soldir = NULL;
+   char* policydir = NULL;
+   char* settingsname = NULL;
+   const char* suffix = ".lp.gz";
+   char polfname[SCIP_MAXSTRLEN];
+   char ckptfname[SCIP_MAXSTRLEN];
+   struct stat ckptstat;
+   SCIP_Real* probtimes;                     /**< solving time of each problem in the last pass, or -1 */
+   SCIP_Real* probsizes;                     /**< size of each problem file in MB */
+   SCIP_Real* costs;                         /**< predicted cost of each job of a round */
+   int* sequence;                            /**< problems in the order of all passes */
+   int* roundprobs;                         /**< problem of each job of a round */
+   SCIP_Real svmc = 1.0;
+   SCIP_Real svmw = 1.0;
+   SCIP_Bool newonly = FALSE;
+   SCIP_Bool quiet = FALSE;
+   SCIP_Bool paramerror = FALSE;
+   unsigned int seed = 0;
+   unsigned int randseed;
+   int npasses = 1;
+   int nperiter = 0;
+   int nthreads = 1;
+   int nworkers = 1;
+   int freq = 1;
+   int nprobs;
+   int npolicies;
+   int nrounds;
+   int nsolved;
+   int nsearchexamples;
+   int nkillexamples;
+   int pass;
+   int i;
+
+   for( i = 2; i < argc && !paramerror; ++i )
+   {
+      if( strcmp(argv[i], "-u") == 0 )
+         newonly = TRUE;
+      else if( strcmp(argv[i], "-q") == 0 )
+         quiet = TRUE;
+      else if( i + 1 >= argc )
+      {
+         printf("missing value after parameter '%s'\n", argv[i]);
+         paramerror = TRUE;
+      }
+      else if( strcmp(argv[i], "-d") == 0 )
+         datadir = argv[++i];
+      else if( strcmp(argv[i], "-o") == 0 )
+         soldir = argv[++i];
+      else if( strcmp(argv[i], "-e") == 0 )
+         policydir = argv[++i];
+      else if( strcmp(argv[i], "-p") == 0 )
+         npasses = atoi(argv[++i]);
+      else if( strcmp(argv[i], "-n") == 0 )
+         nperiter = atoi(argv[++i]);
+      else if( strcmp(argv[i], "-c") == 0 )
+         svmc = atof(argv[++i]);
+      else if( strcmp(argv[i], "-w") == 0 )
+         svmw = atof(argv[++i]);
+      else if( strcmp(argv[i], "-x") == 0 )
+         suffix = argv[++i];
+      else if( strcmp(argv[i], "-s") == 0 )
+         settingsname = argv[++i];
+      else if( strcmp(argv[i], "-r") == 0 )
+         freq = atoi(argv[++i]);
+      else if( strcmp(argv[i], "-j") == 0 )
+         nthreads = atoi(argv[++i]);
+      else if( strcmp(argv[i], "--workers") == 0 )
+         nworkers = atoi(argv[++i]);
+      else if( strcmp(argv[i], "--seed") == 0 )
+         seed = (unsigned int)atoi(argv[++i]);
+      else
+      {
+         printf("invalid parameter <%s>\n", argv[i]);
+         paramerror = TRUE;
+      }
+   }
+
+   if( !paramerror && (npasses < 1 || nperiter < 1 || nthreads < 1 || nworkers < 1 || svmc <= 0 || svmw <= 0) )
+   {
+      printf("the numbers of passes, problems per iteration, threads and workers and c and w must be positive\n");
+      paramerror = TRUE;
+   }
+
+#ifdef NPARASCIP
+   /* the workers run their SCIP environments on separate threads */
+   if( nworkers > 1 )
+   {
+      printf("parameter '--workers' with more than one worker needs SCIP built with PARASCIP=true\n");
+      paramerror = TRUE;
+   }
+#endif
+
+   if( paramerror || datadir == NULL || soldir == NULL || policydir == NULL )
+   {
+      printf("\nsyntax: %s dagger -d <datadir> -o <soldir> -e <policydir> -p <passes> -n <problems per iteration>\n"
+         "       [-c <C>] [-w <w>] [-x <suffix>] [-s <settings>] [-r <freq>] [-j <threads>] [--workers <n>] [-u] [-q]\n"
+         "       [--seed <seed>]\n"
+         "  -d <datadir>  : directory of the training problems\n"
+         "  -o <soldir>   : directory of their optimal solutions <problem without suffix>.sol\n"
+         "  -e <policydir>: directory to write the policies searchPolicy.<k> and killPolicy.<k> and the checkpoint\n"
+         "                  dagger.ckpt to; an existing checkpoint is continued\n"
+         "  -p <passes>   : number of passes over the problems\n"
+         "  -n <problems> : number of problems solved between training two policies\n"
+         "  -c <C>        : cost of constraint violation, divided by the mean instance weight\n"
+         "  -w <w>        : cost multiplier of the optimal nodes (-1 class) of the pruning policy after the first round\n"
+         "  -x <suffix>   : suffix of the problem files (default .lp.gz)\n"
+         "  -s <settings> : load parameter settings (.set) file for every solve\n"
+         "  -r <freq>     : restriction level of the solver as for the shell\n"
+         "  -j <threads>  : number of threads of the trainer\n"
+         "  --workers <n> : number of problems solved in parallel (needs SCIP built with PARASCIP=true)\n"
+         "  -u            : train each policy only on the examples collected since the previous one\n"
+         "  -q            : suppress the output of SCIP\n"
+         "  --seed <seed> : seed for the order of the problems\n",
+         argv[0]);
+      return SCIP_OKAY;
+   }
+
+   if( mkdir(policydir, 0755) != 0 && errno != EEXIST )
+   {
+      SCIPerrorMessage("cannot create directory <%s>\n", policydir);
+      SCIPprintSysError(policydir);
+      return SCIP_FILECREATEERROR;
+   }
+
+   SCIP_CALL( listProblems(datadir, suffix, &probnames, &nprobs) );
+   if( nprobs == 0 )
+   {
+      printf("no problems with suffix <%s> in <%s>\n", suffix, datadir);
+      BMSfreeMemoryArrayNull(&probnames);
+      return SCIP_OKAY;
+   }
+
+   SCIPtrainparamSetDefault(&param);
+   param.C = svmc;
+   param.nthreads = nthreads;
+
+   SCIP_CALL( SCIPdatasetCreate(&searchset, SCIP_FEATNODESEL_SIZE) );
+   SCIP_CALL( SCIPdatasetCreate(&killset, SCIP_FEATNODEPRU_SIZE) );
+   SCIP_CALL( SCIPtrainstateCreate(&searchstate) );
+   SCIP_CALL( SCIPtrainstateCreate(&killstate) );
+   /* the dual states carry the weights across the iterations, so the policies keep the buckets of equal width */
+   searchpolicy.weights = NULL;
+   searchpolicy.size = 0;
+   searchpolicy.depthbounds = NULL;
+   searchpolicy.depthbuckets = NULL;
+   searchpolicy.ndepthbounds = 0;
+   killpolicy.weights = NULL;
+   killpolicy.size = 0;
+   killpolicy.depthbounds = NULL;
+   killpolicy.depthbuckets = NULL;
+   killpolicy.ndepthbounds = 0;
+
+   SCIP_ALLOC( BMSallocMemoryArray(&probtimes, nprobs) );
+   for( i = 0; i < nprobs; i++ )
+      probtimes[i] = -1.0;
+   npolicies = 0;
+   nrounds = 0;
+   nsolved = 0;
+
+   /* continue an interrupted run from the examples and the policies of its finished rounds */
+   (void) SCIPsnprintf(ckptfname, SCIP_MAXSTRLEN, "%s/dagger.ckpt", policydir);
+   if( stat(ckptfname, &ckptstat) == 0 )
+   {
+      unsigned int ckptseed;
+      int r;
+
+      SCIP_CALL( daggerReadCheckpoint(ckptfname, probnames, probtimes, nprobs, npasses, nperiter, &ckptseed, &nrounds,
+            &npolicies, &nsolved, &nsearchexamples, &nkillexamples) );
+      if( ckptseed != seed )
+         printf("continuing with the seed %u of the checkpoint\n", ckptseed);
+      seed = ckptseed;
+
+      for( r = 0; r < nrounds; r++ )
+      {
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/searchTrj.%d", policydir, r);
+         SCIP_CALL( SCIPdatasetRead(searchset, polfname) );
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/killTrj.%d", policydir, r);
+         SCIP_CALL( SCIPdatasetRead(killset, polfname) );
+      }
+      if( SCIPdatasetGetNExamples(searchset) != nsearchexamples || SCIPdatasetGetNExamples(killset) != nkillexamples )
+      {
+         SCIPerrorMessage("trajectories of <%s> do not match the checkpoint <%s>\n", policydir, ckptfname);
+         return SCIP_READERROR;
+      }
+
+      /* the weights of a policy are the weight vector of its dual state */
+      if( npolicies > 0 )
+      {
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/searchState.%d", policydir, npolicies - 1);
+         SCIP_CALL( SCIPtrainstateRead(searchstate, polfname) );
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/killState.%d", policydir, npolicies - 1);
+         SCIP_CALL( SCIPtrainstateRead(killstate, polfname) );
+         if( searchstate->nweights > 0 )
+         {
+            SCIP_ALLOC( BMSduplicateMemoryArray(&searchpolicy.weights, searchstate->weights, searchstate->nweights) );
+            searchpolicy.size = searchstate->nweights;
+         }
+         if( killstate->nweights > 0 )
+         {
+            SCIP_ALLOC( BMSduplicateMemoryArray(&killpolicy.weights, killstate->weights, killstate->nweights) );
+            killpolicy.size = killstate->nweights;
+         }
+      }
+
+      printf("continuing <%s> after %d problems and %d policies\n", ckptfname, nsolved, npolicies);
+   }
+   else
+   {
+      SCIP_CALL( daggerWriteCheckpoint(ckptfname, probnames, probtimes, nprobs, npasses, nperiter, seed, 0, 0, 0, 0, 0) );
+   }
+
+   /* a new random order of the problems in each pass */
+   randseed = seed;
+   SCIP_ALLOC( BMSallocMemoryArray(&sequence, npasses * nprobs) );
+   for( pass = 0; pass < npasses; pass++ )
+   {
+      int* order = &sequence[pass * nprobs];
+
+      for( i = 0; i < nprobs; i++ )
+         order[i] = i;
+      for( i = 0; i < nprobs; i++ )
+      {
+         int j = SCIPgetRandomInt(i, nprobs - 1, &randseed);
+         int tmp = order[i];
+         order[i] = order[j];
+         order[j] = tmp;
+      }
+   }
+
+   /* until a problem was solved, its file size predicts the solving time */
+   SCIP_ALLOC( BMSallocMemoryArray(&probsizes, nprobs) );
+   for( i = 0; i < nprobs; i++ )
+   {
+      char probfname[SCIP_MAXSTRLEN];
+      struct stat st;
+
+      (void) SCIPsnprintf(probfname, SCIP_MAXSTRLEN, "%s/%s", datadir, probnames[i]);
+      probsizes[i] = stat(probfname, &st) == 0 ? st.st_size / 1048576.0 : 0.0;
+   }
+
+   SCIP_ALLOC( BMSallocMemoryArray(&round.probfnames, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&round.solfnames, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&round.searchsets, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&round.killsets, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&round.solvetimes, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&round.done, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&costs, nperiter) );
+   SCIP_ALLOC( BMSallocMemoryArray(&roundprobs, nperiter) );
+   for( i = 0; i < nperiter; i++ )
+   {
+      SCIP_ALLOC( BMSallocMemoryArray(&round.probfnames[i], SCIP_MAXSTRLEN) );
+      SCIP_ALLOC( BMSallocMemoryArray(&round.solfnames[i], SCIP_MAXSTRLEN) );
+   }
+   round.policydir = policydir;
+   round.settingsname = settingsname;
+   round.freq = freq;
+   round.quiet = quiet;
+   round.searchpolicy = &searchpolicy;
+   round.killpolicy = &killpolicy;
+
+   while( nsolved < npasses * nprobs )
+   {
+      int njobs = MIN(nperiter, npasses * nprobs - nsolved);
+
+      round.first = nsolved;
+      for( i = 0; i < njobs; i++ )
+      {
+         int prob = sequence[nsolved + i];
+         size_t baselen = strlen(probnames[prob]) - strlen(suffix);
+
+         roundprobs[i] = prob;
+         (void) SCIPsnprintf(round.probfnames[i], SCIP_MAXSTRLEN, "%s/%s", datadir, probnames[prob]);
+         (void) SCIPsnprintf(round.solfnames[i], SCIP_MAXSTRLEN, "%s/%.*s.sol", soldir, (int)baselen, probnames[prob]);
+         SCIP_CALL( SCIPdatasetCreate(&round.searchsets[i], SCIP_FEATNODESEL_SIZE) );
+         SCIP_CALL( SCIPdatasetCreate(&round.killsets[i], SCIP_FEATNODEPRU_SIZE) );
+         SCIP_CALL( daggerLoadJob(policydir, nsolved + i, round.probfnames[i], round.searchsets[i], round.killsets[i],
+               &round.solvetimes[i], &round.done[i]) );
+         costs[i] = round.done[i] ? 0.0 : probtimes[prob] >= 0.0 ? probtimes[prob] : probsizes[prob];
+         printf("pass %d, problem %d: %s %s (%s)\n", (nsolved + i) / nprobs + 1, nsolved + i + 1, round.probfnames[i],
+            round.solfnames[i], round.done[i] ? "solved before" : searchpolicy.weights == NULL ? "oracle" : "policy");
+      }
+
+      SCIP_CALL( SCIPpoolRun(costs, njobs, nworkers, daggerJob, &round, NULL) );
+
+      (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/searchTrj.%d", policydir, nrounds);
+      SCIP_CALL( daggerSaveDatasets(round.searchsets, njobs, polfname) );
+      (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/killTrj.%d", policydir, nrounds);
+      SCIP_CALL( daggerSaveDatasets(round.killsets, njobs, polfname) );
+
+      /* aggregate the examples in the order of the problems */
+      for( i = 0; i < njobs; i++ )
+      {
+         SCIP_CALL( SCIPdatasetAppend(searchset, round.searchsets[i]) );
+         SCIP_CALL( SCIPdatasetAppend(killset, round.killsets[i]) );
+         SCIP_CALL( SCIPdatasetFree(&round.searchsets[i]) );
+         SCIP_CALL( SCIPdatasetFree(&round.killsets[i]) );
+         probtimes[roundprobs[i]] = round.solvetimes[i];
+      }
+      nsolved += njobs;
+      nrounds++;
+
+      /* learn the next policies after a few problems */
+      if( njobs == nperiter )
+      {
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/searchPolicy.%d", policydir, npolicies);
+         param.weightneg = 1.0;
+         SCIP_CALL( daggerTrain(searchset, &param, searchstate, newonly, &searchpolicy, polfname) );
+
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/killPolicy.%d", policydir, npolicies);
+         param.weightneg = npolicies == 0 ? 1.0 : svmw;
+         SCIP_CALL( daggerTrain(killset, &param, killstate, newonly, &killpolicy, polfname) );
+
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/searchState.%d", policydir, npolicies);
+         SCIP_CALL( daggerSaveState(searchstate, polfname) );
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/killState.%d", policydir, npolicies);
+         SCIP_CALL( daggerSaveState(killstate, polfname) );
+
+         npolicies++;
+      }
+
+      SCIP_CALL( daggerWriteCheckpoint(ckptfname, probnames, probtimes, nprobs, npasses, nperiter, seed, nrounds,
+            npolicies, nsolved, SCIPdatasetGetNExamples(searchset), SCIPdatasetGetNExamples(killset)) );
+
+      /* the checkpoint no longer refers to the job files and to the states of the previous policies */
+      for( i = 0; i < njobs; i++ )
+         daggerRemoveJob(policydir, nsolved - njobs + i);
+      if( njobs == nperiter && npolicies >= 2 )
+      {
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/searchState.%d", policydir, npolicies - 2);
+         (void) remove(polfname);
+         (void) SCIPsnprintf(polfname, SCIP_MAXSTRLEN, "%s/killState.%d", policydir, npolicies - 2);
+         (void) remove(polfname);
+      }
+   }
+
+   printf("trained %d policies on %d node selection and %d node pruning examples\n", npolicies,
+      SCIPdatasetGetNExamples(searchset), SCIPdatasetGetNExamples(killset));
+
+   for( i = 0; i < nperiter; i++ )
+   {
+      BMSfreeMemoryArray(&round.solfnames[i]);
+      BMSfreeMemoryArray(&round.probfnames[i]);
+   }
+   BMSfreeMemoryArray(&roundprobs);
+   BMSfreeMemoryArray(&costs);
+   BMSfreeMemoryArray(&round.done);
+   BMSfreeMemoryArray(&round.solvetimes);
+   BMSfreeMemoryArray(&round.killsets);
+   BMSfreeMemoryArray(&round.searchsets);
+   BMSfreeMemoryArray(&round.solfnames);
+   BMSfreeMemoryArray(&round.probfnames);
+   BMSfreeMemoryArray(&probsizes);
+   BMSfreeMemoryArray(&probtimes);
+   BMSfreeMemoryArray(&sequence);
+   BMSfreeMemoryArrayNull(&killpolicy.weights);
+   BMSfreeMemoryArrayNull(&searchpolicy.weights);
+   SCIP_CALL( SCIPtrainstateFree(&killstate) );
+   SCIP_CALL( SCIPtrainstateFree(&searchstate) );
+   SCIP_CALL( SCIPdatasetFree(&killset) );
+   SCIP_CALL( SCIPdatasetFree(&searchset) );
+   for( i = 0; i < nprobs; i++ )
+      BMSfreeMemoryArray(&probnames[i]);
+   BMSfreeMemoryArray(&probnames);
+
+   BMScheckEmptyMemory();
+
+   return SCIP_OKAY;
+}
+
+int
+main(
+   int                        argc,
+   char**                     argv
+   )
+{
+   SCIP_RETCODE retcode;
+
+   if( argc > 1 && strcmp(argv[1], "train") == 0 )
+      retcode = runTrain(argc, argv);
+   else if( argc > 1 && strcmp(argv[1], "gridsearch") == 0 )
+      retcode = runGridSearch(argc, argv);
+   else if( argc > 1 && strcmp(argv[1], "dagger") == 0 )
+      retcode = runDagger(argc, argv);
+   else if( argc > 1 && strcmp(argv[1], "replay") == 0 )
+      retcode = runReplay(argc, argv);
+   else if( argc > 1 && strcmp(argv[1], "generate") == 0 )
+      retcode = runGenerate(argc, argv);
+   else
+      retcode = runShell(argc, argv, NULL);
    if( retcode != SCIP_OKAY )
    {
       SCIPprintError(retcode);
@@ -0,0 +1,597 @@
+/**@file   dataset.c
+ * @brief  methods for trajectory datasets
+ * @author He He
+ *
+ * Examples are kept in memory as raw feature blocks, so that the trainer can read them directly instead of going
+ * through LIBSVM text files. A dataset can be appended to a binary trajectory file with the following layout (native
+ * byte order):
+ *
+ *   header : char magic[8] ("SCIPTRJ1"), int featsize
+ *   example: int label, SCIP_Real weight, int nblocks,
+ *            nblocks times (int depth, int maxdepth, int boundtype, SCIP_Real vals[featsize])
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+#include "scip/def.h"
+#include "feat.h"
+#include "struct_feat.h"
+#include "dataset.h"
+
+#define DATASET_MAGIC           "SCIPTRJ1"
+#define DATASET_MAGICLEN        8
+#define DATASET_MINSIZE         64
+
+/** ensures that there are slots for num examples */
+static
+SCIP_RETCODE datasetEnsureExamples(
+   SCIP_DATASET*        dataset,
+   int                  num
+   )
+{
+   assert(dataset != NULL);
+
+   if( num > dataset->examplessize )
+   {
+      int newsize = MAX(2 * dataset->examplessize, num);
+      newsize = MAX(newsize, DATASET_MINSIZE);
+
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->labels, newsize) );
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->weights, newsize) );
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->blockbegs, newsize + 1) );
+      dataset->examplessize = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** ensures that there are slots for num blocks */
+static
+SCIP_RETCODE datasetEnsureBlocks(
+   SCIP_DATASET*        dataset,
+   int                  num
+   )
+{
+   assert(dataset != NULL);
+
+   if( num > dataset->blockssize )
+   {
+      int newsize = MAX(2 * dataset->blockssize, num);
+      newsize = MAX(newsize, DATASET_MINSIZE);
+
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->depths, newsize) );
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->maxdepths, newsize) );
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->boundtypes, newsize) );
+      SCIP_ALLOC( BMSreallocMemoryArray(&dataset->vals, (size_t)newsize * dataset->featsize) );
+      dataset->blockssize = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** adds a block with the values of the given feature vector to the current example */
+static
+void datasetAddBlock(
+   SCIP_DATASET*        dataset,
+   SCIP_FEAT*           feat
+   )
+{
+   int b;
+
+   assert(dataset != NULL);
+   assert(feat != NULL);
+   assert(feat->size == dataset->featsize);
+   assert(dataset->nblocks < dataset->blockssize);
+
+   b = dataset->nblocks;
+   dataset->depths[b] = feat->depth;
+   dataset->maxdepths[b] = feat->maxdepth;
+   dataset->boundtypes[b] = feat->boundtype;
+   BMScopyMemoryArray(&dataset->vals[(size_t)b * dataset->featsize], feat->vals, dataset->featsize);
+   dataset->nblocks++;
+}
+
+/** create an empty dataset of examples with the given number of feature values per block */
+SCIP_RETCODE SCIPdatasetCreate(
+   SCIP_DATASET**       dataset,
+   int                  featsize
+   )
+{
+   assert(dataset != NULL);
+   assert(featsize > 0);
+
+   SCIP_ALLOC( BMSallocMemory(dataset) );
+
+   (*dataset)->vals = NULL;
+   (*dataset)->depths = NULL;
+   (*dataset)->maxdepths = NULL;
+   (*dataset)->boundtypes = NULL;
+   (*dataset)->blockbegs = NULL;
+   (*dataset)->labels = NULL;
+   (*dataset)->weights = NULL;
+   (*dataset)->featsize = featsize;
+   (*dataset)->nexamples = 0;
+   (*dataset)->examplessize = 0;
+   (*dataset)->nblocks = 0;
+   (*dataset)->blockssize = 0;
+
+   SCIP_CALL( datasetEnsureExamples(*dataset, DATASET_MINSIZE) );
+   SCIP_CALL( datasetEnsureBlocks(*dataset, DATASET_MINSIZE) );
+   (*dataset)->blockbegs[0] = 0;
+
+   return SCIP_OKAY;
+}
+
+/** free dataset */
+SCIP_RETCODE SCIPdatasetFree(
+   SCIP_DATASET**       dataset
+   )
+{
+   assert(dataset != NULL);
+   assert(*dataset != NULL);
+
+   BMSfreeMemoryArrayNull(&(*dataset)->vals);
+   BMSfreeMemoryArrayNull(&(*dataset)->depths);
+   BMSfreeMemoryArrayNull(&(*dataset)->maxdepths);
+   BMSfreeMemoryArrayNull(&(*dataset)->boundtypes);
+   BMSfreeMemoryArrayNull(&(*dataset)->blockbegs);
+   BMSfreeMemoryArrayNull(&(*dataset)->labels);
+   BMSfreeMemoryArrayNull(&(*dataset)->weights);
+   BMSfreeMemory(dataset);
+
+   return SCIP_OKAY;
+}
+
+/** remove all examples but keep the allocated memory */
+void SCIPdatasetClear(
+   SCIP_DATASET*        dataset
+   )
+{
+   assert(dataset != NULL);
+
+   dataset->nexamples = 0;
+   dataset->nblocks = 0;
+   dataset->blockbegs[0] = 0;
+}
+
+/** add an example with the feature vector of a single node (node pruner) */
+SCIP_RETCODE SCIPdatasetAddFeat(
+   SCIP_DATASET*        dataset,
+   SCIP_FEAT*           feat,
+   int                  label
+   )
+{
+   int e;
+
+   assert(dataset != NULL);
+   assert(feat != NULL);
+   assert(feat->depth != 0);
+
+   SCIP_CALL( datasetEnsureExamples(dataset, dataset->nexamples + 1) );
+   SCIP_CALL( datasetEnsureBlocks(dataset, dataset->nblocks + 1) );
+
+   e = dataset->nexamples;
+   dataset->labels[e] = label;
+   dataset->weights[e] = SCIPfeatGetWeight(feat);
+   datasetAddBlock(dataset, feat);
+   dataset->blockbegs[e + 1] = dataset->nblocks;
+   dataset->nexamples++;
+
+   return SCIP_OKAY;
+}
+
+/** add an example with the feature vector diff (feat1 - feat2) of two nodes (node selector) */
+SCIP_RETCODE SCIPdatasetAddFeatDiff(
+   SCIP_DATASET*        dataset,
+   SCIP_FEAT*           feat1,
+   SCIP_FEAT*           feat2,
+   int                  label,
+   SCIP_Bool            negate
+   )
+{
+   int e;
+
+   assert(dataset != NULL);
+   assert(feat1 != NULL);
+   assert(feat2 != NULL);
+   assert(feat1->depth != 0);
+   assert(feat2->depth != 0);
+
+   SCIP_CALL( datasetEnsureExamples(dataset, dataset->nexamples + 1) );
+   SCIP_CALL( datasetEnsureBlocks(dataset, dataset->nblocks + 2) );
+
+   e = dataset->nexamples;
+   /* the weight is always given by the first (optimal) node, see SCIPfeatDiffLIBSVMPrint() */
+   dataset->weights[e] = SCIPfeatGetWeight(feat1);
+
+   if( negate )
+   {
+      SCIP_FEAT* tmp = feat1;
+      feat1 = feat2;
+      feat2 = tmp;
+      label = -1 * label;
+   }
+
+   dataset->labels[e] = label;
+   datasetAddBlock(dataset, feat1);
+   datasetAddBlock(dataset, feat2);
+   dataset->blockbegs[e + 1] = dataset->nblocks;
+   dataset->nexamples++;
+
+   return SCIP_OKAY;
+}
+
+/** append all examples of the source dataset */
+SCIP_RETCODE SCIPdatasetAppend(
+   SCIP_DATASET*        dataset,
+   SCIP_DATASET*        source
+   )
+{
+   int nexamples;
+   int nblocks;
+   int e;
+
+   assert(dataset != NULL);
+   assert(source != NULL);
+   assert(dataset->featsize == source->featsize);
+
+   nexamples = dataset->nexamples;
+   nblocks = dataset->nblocks;
+
+   SCIP_CALL( datasetEnsureExamples(dataset, nexamples + source->nexamples) );
+   SCIP_CALL( datasetEnsureBlocks(dataset, nblocks + source->nblocks) );
+
+   BMScopyMemoryArray(&dataset->labels[nexamples], source->labels, source->nexamples);
+   BMScopyMemoryArray(&dataset->weights[nexamples], source->weights, source->nexamples);
+   for( e = 1; e <= source->nexamples; e++ )
+      dataset->blockbegs[nexamples + e] = nblocks + source->blockbegs[e];
+
+   BMScopyMemoryArray(&dataset->depths[nblocks], source->depths, source->nblocks);
+   BMScopyMemoryArray(&dataset->maxdepths[nblocks], source->maxdepths, source->nblocks);
+   BMScopyMemoryArray(&dataset->boundtypes[nblocks], source->boundtypes, source->nblocks);
+   BMScopyMemoryArray(&dataset->vals[(size_t)nblocks * dataset->featsize], source->vals,
+      (size_t)source->nblocks * source->featsize);
+
+   dataset->nexamples += source->nexamples;
+   dataset->nblocks += source->nblocks;
+
+   return SCIP_OKAY;
+}
+
+/** returns the number of examples */
+int SCIPdatasetGetNExamples(
+   SCIP_DATASET*        dataset
+   )
+{
+   assert(dataset != NULL);
+
+   return dataset->nexamples;
+}
+
+/** returns the number of bytes of the examples in the binary trajectory format, without the header */
+SCIP_Longint SCIPdatasetGetNBytes(
+   SCIP_DATASET*        dataset
+   )
+{
+   assert(dataset != NULL);
+
+   return (SCIP_Longint)dataset->nexamples * (2 * sizeof(int) + sizeof(SCIP_Real))
+      + (SCIP_Longint)dataset->nblocks * (3 * sizeof(int) + dataset->featsize * sizeof(SCIP_Real));
+}
+
+/** returns the bytes written to a text trajectory file and its weight file, which are opened for appending, plus
+ *  the bytes of the examples of a dataset in the binary format
+ */
+SCIP_Longint SCIPdatasetGetTrjBytes(
+   FILE*                trjfile,            /**< text trajectory file, or NULL */
+   FILE*                wfile,              /**< weight file of the text trajectory file */
+   SCIP_DATASET*        dataset             /**< dataset, or NULL */
+   )
+{
+   SCIP_Longint bytes;
+
+   bytes = 0;
+   if( trjfile != NULL )
+   {
+      assert(wfile != NULL);
+      bytes += ftell(trjfile) + ftell(wfile);
+   }
+   if( dataset != NULL )
+      bytes += SCIPdatasetGetNBytes(dataset);
+
+   return bytes;
+}
+
+/** returns the number of feature values per block */
+int SCIPdatasetGetFeatSize(
+   SCIP_DATASET*        dataset
+   )
+{
+   assert(dataset != NULL);
+
+   return dataset->featsize;
+}
+
+/** returns the mean weight of the examples in [first, last) */
+SCIP_Real SCIPdatasetGetMeanWeight(
+   SCIP_DATASET*        dataset,
+   int                  first,
+   int                  last
+   )
+{
+   SCIP_Real sum = 0;
+   int e;
+
+   assert(dataset != NULL);
+   assert(0 <= first && first <= last && last <= dataset->nexamples);
+
+   if( first == last )
+      return 1.0;
+
+   for( e = first; e < last; e++ )
+      sum += dataset->weights[e];
+
+   return sum / (last - first);
+}
+
+/** computes the bounds of depth buckets holding about equally many blocks of the examples: bucket j holds the depths
+ *  from bounds[j-1] (or 0) to bounds[j] - 1 (or the maximum depth); equal quantiles are merged, so that the bounds are
+ *  positive and strictly increasing and there may be fewer than nbuckets - 1 of them
+ */
+SCIP_RETCODE SCIPdatasetCalcDepthQuantiles(
+   SCIP_DATASET*        dataset,            /**< dataset */
+   int                  nbuckets,           /**< number of depth buckets to aim for */
+   int*                 bounds,             /**< array of size nbuckets - 1 to store the bounds */
+   int*                 nbounds             /**< pointer to store the number of bounds */
+   )
+{
+   SCIP_Longint* hist;
+   SCIP_Longint ncum;
+   int maxdepth;
+   int depth;
+   int b;
+   int j;
+
+   assert(dataset != NULL);
+   assert(nbuckets >= 1);
+   assert(bounds != NULL || nbuckets == 1);
+   assert(nbounds != NULL);
+
+   *nbounds = 0;
+   if( dataset->nblocks == 0 )
+      return SCIP_OKAY;
+
+   maxdepth = 0;
+   for( b = 0; b < dataset->nblocks; b++ )
+      maxdepth = MAX(maxdepth, dataset->depths[b]);
+
+   SCIP_ALLOC( BMSallocMemoryArray(&hist, maxdepth + 1) );
+   BMSclearMemoryArray(hist, maxdepth + 1);
+   for( b = 0; b < dataset->nblocks; b++ )
+      hist[dataset->depths[b]]++;
+
+   /* bound j is the smallest depth with at least j/nbuckets of the blocks above less deep nodes */
+   ncum = 0;
+   depth = 0;
+   for( j = 1; j < nbuckets; j++ )
+   {
+      SCIP_Longint target = (SCIP_Longint)j * dataset->nblocks / nbuckets;
+
+      while( depth <= maxdepth && ncum < target )
+         ncum += hist[depth++];
+      if( depth > maxdepth )
+         break;
+      if( depth > 0 && (*nbounds == 0 || depth > bounds[*nbounds - 1]) )
+         bounds[(*nbounds)++] = depth;
+   }
+
+   BMSfreeMemoryArray(&hist);
+
+   return SCIP_OKAY;
+}
+
+/** reads the header of a binary trajectory file; returns the feature size, or -1 if the file is not a trajectory file */
+static
+int readHeader(
+   FILE*                file
+   )
+{
+   char magic[DATASET_MAGICLEN];
+   int featsize;
+
+   if( fread(magic, sizeof(char), DATASET_MAGICLEN, file) != DATASET_MAGICLEN
+      || strncmp(magic, DATASET_MAGIC, DATASET_MAGICLEN) != 0
+      || fread(&featsize, sizeof(int), 1, file) != 1 )
+      return -1;
+
+   return featsize;
+}
+
+/** returns the feature size stored in the header of a binary trajectory file, or -1 if the file cannot be read */
+int SCIPdatasetReadFeatSize(
+   const char*          fname
+   )
+{
+   FILE* file;
+   int featsize;
+
+   assert(fname != NULL);
+
+   file = fopen(fname, "rb");
+   if( file == NULL )
+      return -1;
+
+   featsize = readHeader(file);
+   fclose(file);
+
+   return featsize;
+}
+
+/** append the examples in [first, last) to a binary trajectory file; the file header is written if the file is empty */
+SCIP_RETCODE SCIPdatasetWrite(
+   SCIP_DATASET*        dataset,
+   const char*          fname,
+   int                  first,
+   int                  last
+   )
+{
+   FILE* file;
+   int e;
+   int b;
+
+   assert(dataset != NULL);
+   assert(fname != NULL);
+   assert(0 <= first && first <= last && last <= dataset->nexamples);
+
+   /* check the header of an existing file */
+   file = fopen(fname, "rb");
+   if( file != NULL )
+   {
+      int featsize;
+
+      fseek(file, 0, SEEK_END);
+      if( ftell(file) > 0 )
+      {
+         rewind(file);
+         featsize = readHeader(file);
+         if( featsize != dataset->featsize )
+         {
+            SCIPerrorMessage("trajectory file <%s> does not match the feature size %d\n", fname, dataset->featsize);
+            fclose(file);
+            return SCIP_WRITEERROR;
+         }
+      }
+      fclose(file);
+   }
+
+   file = fopen(fname, "ab");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   fseek(file, 0, SEEK_END);
+   if( ftell(file) == 0 )
+   {
+      fwrite(DATASET_MAGIC, sizeof(char), DATASET_MAGICLEN, file);
+      fwrite(&dataset->featsize, sizeof(int), 1, file);
+   }
+
+   for( e = first; e < last; e++ )
+   {
+      int nblocks = dataset->blockbegs[e + 1] - dataset->blockbegs[e];
+
+      fwrite(&dataset->labels[e], sizeof(int), 1, file);
+      fwrite(&dataset->weights[e], sizeof(SCIP_Real), 1, file);
+      fwrite(&nblocks, sizeof(int), 1, file);
+      for( b = dataset->blockbegs[e]; b < dataset->blockbegs[e + 1]; b++ )
+      {
+         int boundtype = (int)dataset->boundtypes[b];
+
+         fwrite(&dataset->depths[b], sizeof(int), 1, file);
+         fwrite(&dataset->maxdepths[b], sizeof(int), 1, file);
+         fwrite(&boundtype, sizeof(int), 1, file);
+         fwrite(&dataset->vals[(size_t)b * dataset->featsize], sizeof(SCIP_Real), (size_t)dataset->featsize, file);
+      }
+   }
+
+   if( ferror(file) )
+   {
+      SCIPerrorMessage("error writing trajectory file <%s>\n", fname);
+      fclose(file);
+      return SCIP_WRITEERROR;
+   }
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** read all examples of a binary trajectory file and append them to the dataset */
+SCIP_RETCODE SCIPdatasetRead(
+   SCIP_DATASET*        dataset,
+   const char*          fname
+   )
+{
+   FILE* file;
+   SCIP_Bool error;
+   int featsize;
+
+   assert(dataset != NULL);
+   assert(fname != NULL);
+
+   file = fopen(fname, "rb");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for reading\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_NOFILE;
+   }
+
+   featsize = readHeader(file);
+   if( featsize != dataset->featsize )
+   {
+      SCIPerrorMessage("file <%s> is not a trajectory file with feature size %d\n", fname, dataset->featsize);
+      fclose(file);
+      return SCIP_READERROR;
+   }
+
+   error = FALSE;
+   while( !error )
+   {
+      int label;
+      SCIP_Real weight;
+      int nblocks;
+      int e;
+      int b;
+
+      if( fread(&label, sizeof(int), 1, file) != 1 )
+         break;
+      if( fread(&weight, sizeof(SCIP_Real), 1, file) != 1 || fread(&nblocks, sizeof(int), 1, file) != 1
+         || nblocks < 1 || nblocks > 2 )
+      {
+         error = TRUE;
+         break;
+      }
+
+      SCIP_CALL( datasetEnsureExamples(dataset, dataset->nexamples + 1) );
+      SCIP_CALL( datasetEnsureBlocks(dataset, dataset->nblocks + nblocks) );
+
+      e = dataset->nexamples;
+      for( b = dataset->nblocks; b < dataset->nblocks + nblocks; b++ )
+      {
+         int boundtype;
+
+         if( fread(&dataset->depths[b], sizeof(int), 1, file) != 1
+            || fread(&dataset->maxdepths[b], sizeof(int), 1, file) != 1
+            || fread(&boundtype, sizeof(int), 1, file) != 1
+            || fread(&dataset->vals[(size_t)b * featsize], sizeof(SCIP_Real), (size_t)featsize, file) != (size_t)featsize )
+         {
+            error = TRUE;
+            break;
+         }
+         dataset->boundtypes[b] = (SCIP_BOUNDTYPE)boundtype;
+      }
+      if( error )
+         break;
+
+      dataset->labels[e] = label;
+      dataset->weights[e] = weight;
+      dataset->nblocks += nblocks;
+      dataset->blockbegs[e + 1] = dataset->nblocks;
+      dataset->nexamples++;
+   }
+
+   fclose(file);
+
+   if( error )
+   {
+      SCIPerrorMessage("truncated example %d in trajectory file <%s>\n", dataset->nexamples, fname);
+      return SCIP_READERROR;
+   }
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,138 @@
+/**@file   dataset.h
+ * @brief  internal methods for trajectory datasets
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_DATASET_H__
+#define __SCIP_DATASET_H__
+
+#include "scip/def.h"
+#include "scip/scip.h"
+#include "feat.h"
+#include "struct_dataset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** create an empty dataset of examples with the given number of feature values per block */
+extern
+SCIP_RETCODE SCIPdatasetCreate(
+   SCIP_DATASET**       dataset,
+   int                  featsize
+   );
+
+/** free dataset */
+extern
+SCIP_RETCODE SCIPdatasetFree(
+   SCIP_DATASET**       dataset
+   );
+
+/** remove all examples but keep the allocated memory */
+extern
+void SCIPdatasetClear(
+   SCIP_DATASET*        dataset
+   );
+
+/** add an example with the feature vector of a single node (node pruner) */
+extern
+SCIP_RETCODE SCIPdatasetAddFeat(
+   SCIP_DATASET*        dataset,
+   SCIP_FEAT*           feat,
+   int                  label
+   );
+
+/** add an example with the feature vector diff (feat1 - feat2) of two nodes (node selector) */
+extern
+SCIP_RETCODE SCIPdatasetAddFeatDiff(
+   SCIP_DATASET*        dataset,
+   SCIP_FEAT*           feat1,
+   SCIP_FEAT*           feat2,
+   int                  label,
+   SCIP_Bool            negate
+   );
+
+/** append all examples of the source dataset */
+extern
+SCIP_RETCODE SCIPdatasetAppend(
+   SCIP_DATASET*        dataset,
+   SCIP_DATASET*        source
+   );
+
+/** returns the number of examples */
+extern
+int SCIPdatasetGetNExamples(
+   SCIP_DATASET*        dataset
+   );
+
+/** returns the number of bytes of the examples in the binary trajectory format, without the header */
+extern
+SCIP_Longint SCIPdatasetGetNBytes(
+   SCIP_DATASET*        dataset
+   );
+
+/** returns the bytes written to a text trajectory file and its weight file, which are opened for appending, plus
+ *  the bytes of the examples of a dataset in the binary format
+ */
+extern
+SCIP_Longint SCIPdatasetGetTrjBytes(
+   FILE*                trjfile,            /**< text trajectory file, or NULL */
+   FILE*                wfile,              /**< weight file of the text trajectory file */
+   SCIP_DATASET*        dataset             /**< dataset, or NULL */
+   );
+
+/** returns the number of feature values per block */
+extern
+int SCIPdatasetGetFeatSize(
+   SCIP_DATASET*        dataset
+   );
+
+/** returns the mean weight of the examples in [first, last) */
+extern
+SCIP_Real SCIPdatasetGetMeanWeight(
+   SCIP_DATASET*        dataset,
+   int                  first,
+   int                  last
+   );
+
+/** computes the bounds of depth buckets holding about equally many blocks of the examples: bucket j holds the depths
+ *  from bounds[j-1] (or 0) to bounds[j] - 1 (or the maximum depth); equal quantiles are merged, so that the bounds are
+ *  positive and strictly increasing and there may be fewer than nbuckets - 1 of them
+ */
+extern
+SCIP_RETCODE SCIPdatasetCalcDepthQuantiles(
+   SCIP_DATASET*        dataset,            /**< dataset */
+   int                  nbuckets,           /**< number of depth buckets to aim for */
+   int*                 bounds,             /**< array of size nbuckets - 1 to store the bounds */
+   int*                 nbounds             /**< pointer to store the number of bounds */
+   );
+
+/** returns the feature size stored in the header of a binary trajectory file, or -1 if the file cannot be read */
+extern
+int SCIPdatasetReadFeatSize(
+   const char*          fname
+   );
+
+/** append the examples in [first, last) to a binary trajectory file; the file header is written if the file is empty */
+extern
+SCIP_RETCODE SCIPdatasetWrite(
+   SCIP_DATASET*        dataset,
+   const char*          fname,
+   int                  first,
+   int                  last
+   );
+
+/** read all examples of a binary trajectory file and append them to the dataset */
+extern
+SCIP_RETCODE SCIPdatasetRead(
+   SCIP_DATASET*        dataset,
+   const char*          fname
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,278 @@
+/**@file   eventhdlr_effort.c
+ * @brief  event handler which measures the solving effort in deterministic work units
+ * @author He He
+ *
+ * Solving times measured with timing/clocktype depend on the machine and on the load of the other workers, so they
+ * are poor limits and poor measurements when comparing node selection policies. This event handler counts the work
+ * of a solve instead: LP iterations, processed nodes, and the feature values and multiply-adds computed by the
+ * policy plugins (counted by SCIPcalcNodeselFeat(), SCIPcalcNodepruFeat(), SCIPcalcNodeScore() and
+ * SCIPpolicyUpdate()). The effort is their weighted sum; with the default weights one unit is roughly one LP
+ * iteration. It is reproducible on any machine and for any number of workers.
+ *
+ * The event handler features the following parameters:
+ * - eventhdlr/effort/limit: the solve is interrupted (status userinterrupt) after the node at which the effort
+ *   reaches the limit
+ * - eventhdlr/effort/{lpiterweight,nodeweight,featweight}: the weights of the counts
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+#include <assert.h>
+#include <string.h>
+
+#include "eventhdlr_effort.h"
+#include "scip/struct_scip.h"
+
+#define EVENTHDLR_NAME          "effort"
+#define EVENTHDLR_DESC          "event handler which measures the solving effort in deterministic work units"
+
+#define DEFAULT_LIMIT           -1.0      /**< effort limit, -1 for no limit */
+#define DEFAULT_LPITERWEIGHT    1.0       /**< weight of one LP iteration */
+#define DEFAULT_NODEWEIGHT      1.0       /**< weight of one processed node */
+#define DEFAULT_FEATWEIGHT      0.001     /**< weight of one feature value or one multiply-add of a policy */
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   SCIP_Real          limit;              /**< effort limit, or -1 */
+   SCIP_Real          lpiterweight;       /**< weight of one LP iteration */
+   SCIP_Real          nodeweight;         /**< weight of one processed node */
+   SCIP_Real          featweight;         /**< weight of one feature value or one multiply-add of a policy */
+   SCIP_Longint       nfeatvals;          /**< number of feature values computed in the current solve */
+   SCIP_Longint       nscorevals;         /**< number of multiply-adds of policies in the current solve */
+   SCIP_Bool          limitreached;       /**< was the current solve interrupted by the effort limit? */
+   int                filterpos;          /**< position of the node event in the event filter */
+};
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeEffort)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolEffort)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   eventhdlrdata->limitreached = FALSE;
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, &eventhdlrdata->filterpos) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolEffort)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, eventhdlrdata->filterpos) );
+   eventhdlrdata->filterpos = -1;
+
+   return SCIP_OKAY;
+}
+
+/** initialization method of event handler (called after problem was transformed) */
+static
+SCIP_DECL_EVENTINIT(eventInitEffort)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   /* the counts of SCIP start with the transformed problem as well */
+   eventhdlrdata->nfeatvals = 0;
+   eventhdlrdata->nscorevals = 0;
+   eventhdlrdata->limitreached = FALSE;
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler: checks the effort limit after each processed node */
+static
+SCIP_DECL_EVENTEXEC(eventExecEffort)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( eventhdlrdata->limit >= 0.0 && !eventhdlrdata->limitreached
+      && SCIPeventhdlreffortGetEffort(scip, eventhdlr) >= eventhdlrdata->limit )
+   {
+      eventhdlrdata->limitreached = TRUE;
+      SCIP_CALL( SCIPinterruptSolve(scip) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** counts the computation of feature values */
+void SCIPeventhdlreffortAddFeat(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< effort event handler */
+   int                   nvals               /**< number of feature values computed */
+   )
+{
+   assert(eventhdlr != NULL);
+   assert(SCIPeventhdlrGetData(eventhdlr) != NULL);
+
+   SCIPeventhdlrGetData(eventhdlr)->nfeatvals += nvals;
+}
+
+/** counts the multiply-adds of policy scores and updates */
+void SCIPeventhdlreffortAddScore(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< effort event handler */
+   int                   nvals               /**< number of multiply-adds */
+   )
+{
+   assert(eventhdlr != NULL);
+   assert(SCIPeventhdlrGetData(eventhdlr) != NULL);
+
+   SCIPeventhdlrGetData(eventhdlr)->nscorevals += nvals;
+}
+
+/** gets the effort of the current solve in work units */
+SCIP_Real SCIPeventhdlreffortGetEffort(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EVENTHDLR*       eventhdlr           /**< effort event handler */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(scip != NULL);
+   assert(eventhdlr != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_TRANSFORMED )
+      return 0.0;
+
+   return eventhdlrdata->lpiterweight * SCIPgetNLPIterations(scip)
+      + eventhdlrdata->nodeweight * SCIPgetNNodes(scip)
+      + eventhdlrdata->featweight * (eventhdlrdata->nfeatvals + eventhdlrdata->nscorevals);
+}
+
+/** returns whether the current solve was interrupted by the effort limit */
+SCIP_Bool SCIPeventhdlreffortIsLimitReached(
+   SCIP_EVENTHDLR*       eventhdlr           /**< effort event handler */
+   )
+{
+   assert(eventhdlr != NULL);
+   assert(SCIPeventhdlrGetData(eventhdlr) != NULL);
+
+   return SCIPeventhdlrGetData(eventhdlr)->limitreached;
+}
+
+void SCIPeventhdlreffortPrintStatistics(
+   SCIP*                 scip,
+   SCIP_EVENTHDLR*       eventhdlr,
+   FILE*                 file
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(scip != NULL);
+   assert(eventhdlr != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Effort             :\n");
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  work units       : %10.2f%s\n", SCIPeventhdlreffortGetEffort(scip, eventhdlr),
+         eventhdlrdata->limitreached ? " (limit reached)" : "");
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  feature values   : %10"SCIP_LONGINT_FORMAT"\n", eventhdlrdata->nfeatvals);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  score multadds   : %10"SCIP_LONGINT_FORMAT"\n", eventhdlrdata->nscorevals);
+}
+
+/** creates the effort event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrEffort(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+
+   /* create effort event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+
+   eventhdlr = NULL;
+   eventhdlrdata->nfeatvals = 0;
+   eventhdlrdata->nscorevals = 0;
+   eventhdlrdata->limitreached = FALSE;
+   eventhdlrdata->filterpos = -1;
+
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecEffort,
+         eventhdlrdata) );
+
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeEffort) );
+   SCIP_CALL( SCIPsetEventhdlrInit(scip, eventhdlr, eventInitEffort) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolEffort) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolEffort) );
+
+   /* add effort event handler parameters */
+   SCIP_CALL( SCIPaddRealParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/limit",
+         "interrupt the solve when the effort reaches this number of work units (-1: no limit)",
+         &eventhdlrdata->limit, FALSE, DEFAULT_LIMIT, -1.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/lpiterweight",
+         "work units of one LP iteration",
+         &eventhdlrdata->lpiterweight, TRUE, DEFAULT_LPITERWEIGHT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/nodeweight",
+         "work units of one processed node",
+         &eventhdlrdata->nodeweight, TRUE, DEFAULT_NODEWEIGHT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/featweight",
+         "work units of one computed feature value or one multiply-add of a policy",
+         &eventhdlrdata->featweight, TRUE, DEFAULT_FEATWEIGHT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,63 @@
+/**@file   eventhdlr_effort.h
+ * @ingroup EVENTS
+ * @brief  event handler which measures the solving effort in deterministic work units
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENTHDLR_EFFORT_H__
+#define __SCIP_EVENTHDLR_EFFORT_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the effort event handler and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeEventhdlrEffort(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** counts the computation of feature values */
+EXTERN
+void SCIPeventhdlreffortAddFeat(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< effort event handler */
+   int                   nvals               /**< number of feature values computed */
+   );
+
+/** counts the multiply-adds of policy scores and updates */
+EXTERN
+void SCIPeventhdlreffortAddScore(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< effort event handler */
+   int                   nvals               /**< number of multiply-adds */
+   );
+
+/** gets the effort of the current solve in work units */
+EXTERN
+SCIP_Real SCIPeventhdlreffortGetEffort(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EVENTHDLR*       eventhdlr           /**< effort event handler */
+   );
+
+/** returns whether the current solve was interrupted by the effort limit */
+EXTERN
+SCIP_Bool SCIPeventhdlreffortIsLimitReached(
+   SCIP_EVENTHDLR*       eventhdlr           /**< effort event handler */
+   );
+
+EXTERN
+void SCIPeventhdlreffortPrintStatistics(
+   SCIP*                 scip,
+   SCIP_EVENTHDLR*       eventhdlr,
+   FILE*                 file
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,480 @@
+/**@file   eventhdlr_latency.c
+ * @brief  event handler which keeps latency histograms of the callbacks of the node selection and pruning plugins
+ * @author He He
+ *
+ * SCIPnodeselGetTime() and SCIPnodepruGetTime() only give the total time of a plugin. This event handler keeps a
+ * histogram of the latencies and the number of calls of each callback that a learned policy adds to the solve: node
+ * selection, node comparison (called O(log n) times per operation on the node queue), pruning decisions, feature
+ * computation, policy scores and trajectory writes. The plugins look the handler up when the solve starts and time
+ * their callbacks with SCIPhistGetTime() only if it is active, so it costs nothing when switched off. The histograms
+ * are printed with the statistics and can be written to a JSON file.
+ *
+ * Latencies do not tell whether a callback waits for memory or computes. When compiled with WITH_PERFCTR (make
+ * PERFCTR=true, Linux only), the handler can also read hardware performance counters around the same callbacks: CPU
+ * cycles, instructions, cache misses and branch misses of the solving thread, in user space only, as one
+ * perf_event_open() group so that they are read together. The totals and the instructions per cycle of each
+ * callback are printed with the latencies. Every read is a system call of about a microsecond, which is included in
+ * the latencies, so the counters are off even when the latencies are measured.
+ *
+ * The event handler features the following parameters:
+ * - eventhdlr/latency/active: measure the callbacks of the plugins (off by default, since the clock is read twice
+ *   per node comparison)
+ * - eventhdlr/latency/perfctr: also read the hardware performance counters around the callbacks (needs
+ *   eventhdlr/latency/active, WITH_PERFCTR and a kernel.perf_event_paranoid of at most 2)
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+#include <assert.h>
+#include <string.h>
+
+#ifdef WITH_PERFCTR
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "eventhdlr_latency.h"
+#include "scip/struct_scip.h"
+
+#define EVENTHDLR_NAME          "latency"
+#define EVENTHDLR_DESC          "event handler which keeps latency histograms of the node selection and pruning plugins"
+
+#define DEFAULT_ACTIVE          FALSE     /**< measure the callbacks of the plugins? */
+#define DEFAULT_PERFCTR         FALSE     /**< read the hardware performance counters around the callbacks? */
+
+#define PERFCTR_N               4         /**< number of hardware performance counters */
+
+/** names of the callbacks in the statistics and in the JSON file */
+static const char* hooknames[SCIP_LATENCYHOOK_N] = {
+   "select", "comp", "prune", "selfeat", "prufeat", "score", "trjwrite"
+};
+
+/** names of the hardware performance counters in the JSON file */
+static const char* perfctrnames[PERFCTR_N] = {
+   "cycles", "instructions", "cachemisses", "branchmisses"
+};
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   SCIP_HIST          hists[SCIP_LATENCYHOOK_N]; /**< latencies of each callback in the current solve */
+   SCIP_Longint       perfctrs[SCIP_LATENCYHOOK_N][PERFCTR_N]; /**< counter totals of each callback */
+   SCIP_Longint       perfstart[SCIP_LATENCYHOOK_N][PERFCTR_N]; /**< counters at the start of the current call of
+                                                                  *   each callback */
+   int                perffds[PERFCTR_N]; /**< file descriptors of the counters, the group leader first, or -1 */
+   SCIP_Bool          perfvalid;          /**< were the counters read in the current solve? */
+   SCIP_Bool          active;             /**< measure the callbacks of the plugins? */
+   SCIP_Bool          perfctr;            /**< read the hardware performance counters around the callbacks? */
+};
+
+/*
+ * Local methods
+ */
+
+/** opens the counters of the calling thread as one group; returns FALSE if the kernel or the machine does not
+ *  provide them
+ */
+static
+SCIP_Bool perfctrOpen(
+   int*                  fds                 /**< array to store the file descriptors, the group leader first */
+   )
+{
+#ifdef WITH_PERFCTR
+   static const uint64_t configs[PERFCTR_N] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+   };
+   struct perf_event_attr attr;
+   int c;
+
+   for( c = 0; c < PERFCTR_N; c++ )
+   {
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[c];
+      attr.disabled = (c == 0);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+
+      fds[c] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, c == 0 ? -1 : fds[0], 0);
+      if( fds[c] < 0 )
+      {
+         SCIPwarningMessage(NULL, "cannot open hardware performance counters: %s%s\n", strerror(errno),
+            errno == EACCES || errno == EPERM ? " (see kernel.perf_event_paranoid)" : "");
+         while( --c >= 0 )
+         {
+            close(fds[c]);
+            fds[c] = -1;
+         }
+         return FALSE;
+      }
+   }
+
+   (void) ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+   (void) ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+   return TRUE;
+#else
+   SCIPwarningMessage(NULL, "hardware performance counters are not available, compile with PERFCTR=true\n");
+
+   return FALSE;
+#endif
+}
+
+/** closes the counters */
+static
+void perfctrClose(
+   int*                  fds                 /**< file descriptors of the counters, or -1 */
+   )
+{
+   int c;
+
+   for( c = PERFCTR_N - 1; c >= 0; c-- )
+   {
+#ifdef WITH_PERFCTR
+      if( fds[c] >= 0 )
+         close(fds[c]);
+#endif
+      fds[c] = -1;
+   }
+}
+
+/** reads the counters of the group with one system call; leaves vals unchanged on failure */
+static
+void perfctrRead(
+   int                   fd,                 /**< group leader */
+   SCIP_Longint*         vals                /**< array to store the counter values */
+   )
+{
+#ifdef WITH_PERFCTR
+   uint64_t buf[PERFCTR_N + 1];
+   int c;
+
+   /* with PERF_FORMAT_GROUP, the number of counters comes first */
+   if( read(fd, buf, sizeof(buf)) != (ssize_t)sizeof(buf) )
+      return;
+   for( c = 0; c < PERFCTR_N; c++ )
+      vals[c] = (SCIP_Longint)buf[c + 1];
+#endif
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeLatency)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** initialization method of event handler (called after problem was transformed) */
+static
+SCIP_DECL_EVENTINIT(eventInitLatency)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   int h;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   for( h = 0; h < SCIP_LATENCYHOOK_N; h++ )
+      SCIPhistClear(&eventhdlrdata->hists[h]);
+   BMSclearMemoryArray(eventhdlrdata->perfctrs, SCIP_LATENCYHOOK_N);
+   BMSclearMemoryArray(eventhdlrdata->perfstart, SCIP_LATENCYHOOK_N);
+
+   /* the counters follow the thread that solves, which is the one that transforms the problem */
+   eventhdlrdata->perfvalid = eventhdlrdata->active && eventhdlrdata->perfctr
+      && perfctrOpen(eventhdlrdata->perffds);
+
+   return SCIP_OKAY;
+}
+
+/** deinitialization method of event handler (called before transformed problem is freed) */
+static
+SCIP_DECL_EVENTEXIT(eventExitLatency)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   /* the totals stay for the statistics */
+   perfctrClose(eventhdlrdata->perffds);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler: no events are caught, the plugins add their latencies directly */
+static
+SCIP_DECL_EVENTEXEC(eventExecLatency)
+{  /*lint --e{715}*/
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** returns the latency event handler if it is included and active, or NULL; the plugins look it up when the solve
+ *  starts and measure their callbacks only if it is not NULL
+ */
+SCIP_EVENTHDLR* SCIPeventhdlrlatencyFind(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+
+   assert(scip != NULL);
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if( eventhdlr == NULL || !SCIPeventhdlrGetData(eventhdlr)->active )
+      return NULL;
+
+   return eventhdlr;
+}
+
+/** returns the time at the start of a call of a callback, to be passed to SCIPeventhdlrlatencyAdd() at its end;
+ *  also reads the hardware performance counters if they are on
+ */
+SCIP_Longint SCIPeventhdlrlatencyStart(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   SCIP_LATENCYHOOK      hook                /**< callback */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(eventhdlr != NULL);
+   assert(0 <= (int)hook && (int)hook < SCIP_LATENCYHOOK_N);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   /* the callbacks nest (features within pruning), but not in themselves, so one start per callback suffices */
+   if( eventhdlrdata->perffds[0] >= 0 )
+      perfctrRead(eventhdlrdata->perffds[0], eventhdlrdata->perfstart[hook]);
+
+   return SCIPhistGetTime();
+}
+
+/** adds the time since start, taken with SCIPeventhdlrlatencyStart(), to the histogram of a callback, and the counters
+ *  since then to its totals
+ */
+void SCIPeventhdlrlatencyAdd(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   SCIP_LATENCYHOOK      hook,               /**< callback */
+   SCIP_Longint          start               /**< time at the start of the call */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(eventhdlr != NULL);
+   assert(0 <= (int)hook && (int)hook < SCIP_LATENCYHOOK_N);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPhistAdd(&eventhdlrdata->hists[hook], SCIPhistGetTime() - start);
+
+   if( eventhdlrdata->perffds[0] >= 0 )
+   {
+      SCIP_Longint vals[PERFCTR_N];
+      int c;
+
+      BMScopyMemoryArray(vals, eventhdlrdata->perfstart[hook], PERFCTR_N);
+      perfctrRead(eventhdlrdata->perffds[0], vals);
+      for( c = 0; c < PERFCTR_N; c++ )
+         eventhdlrdata->perfctrs[hook][c] += vals[c] - eventhdlrdata->perfstart[hook][c];
+   }
+}
+
+/** gets the histogram of a callback in the current solve */
+SCIP_HIST* SCIPeventhdlrlatencyGetHist(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   SCIP_LATENCYHOOK      hook                /**< callback */
+   )
+{
+   assert(eventhdlr != NULL);
+   assert(SCIPeventhdlrGetData(eventhdlr) != NULL);
+   assert(0 <= (int)hook && (int)hook < SCIP_LATENCYHOOK_N);
+
+   return &SCIPeventhdlrGetData(eventhdlr)->hists[hook];
+}
+
+/** writes the histograms of the current solve to a JSON file */
+SCIP_RETCODE SCIPeventhdlrlatencyWriteJson(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   const char*           instance,           /**< name of the problem */
+   const char*           fname               /**< file to write */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   FILE* file;
+   const char* c;
+   int h;
+
+   assert(eventhdlr != NULL);
+   assert(instance != NULL);
+   assert(fname != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   file = fopen(fname, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   fprintf(file, "{\"instance\":\"");
+   for( c = instance; *c != '\0'; c++ )
+   {
+      if( *c == '"' || *c == '\\' )
+         fputc('\\', file);
+      fputc(*c, file);
+   }
+   fprintf(file, "\",\"unit\":\"ns\",\"hooks\":{");
+   for( h = 0; h < SCIP_LATENCYHOOK_N; h++ )
+   {
+      fprintf(file, "%s\"%s\":", h > 0 ? "," : "", hooknames[h]);
+      SCIPhistWriteJson(&eventhdlrdata->hists[h], file);
+   }
+   fprintf(file, "}");
+   if( eventhdlrdata->perfvalid )
+   {
+      int c;
+
+      fprintf(file, ",\"perfctrs\":{");
+      for( h = 0; h < SCIP_LATENCYHOOK_N; h++ )
+      {
+         fprintf(file, "%s\"%s\":{", h > 0 ? "," : "", hooknames[h]);
+         for( c = 0; c < PERFCTR_N; c++ )
+            fprintf(file, "\"%s\":%"SCIP_LONGINT_FORMAT",", perfctrnames[c], eventhdlrdata->perfctrs[h][c]);
+         fprintf(file, "\"ipc\":%.4g}", eventhdlrdata->perfctrs[h][0] > 0
+            ? (SCIP_Real)eventhdlrdata->perfctrs[h][1] / eventhdlrdata->perfctrs[h][0] : 0.0);
+      }
+      fprintf(file, "}");
+   }
+   fprintf(file, "}\n");
+
+   if( fclose(file) != 0 )
+   {
+      SCIPerrorMessage("error writing file <%s>\n", fname);
+      return SCIP_WRITEERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+void SCIPeventhdlrlatencyPrintStatistics(
+   SCIP*                 scip,
+   SCIP_EVENTHDLR*       eventhdlr,
+   FILE*                 file
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   int h;
+
+   assert(scip != NULL);
+   assert(eventhdlr != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Latency (ns)       :      Calls   Total(s)       Mean        p50        p90        p99        Max\n");
+   for( h = 0; h < SCIP_LATENCYHOOK_N; h++ )
+   {
+      SCIP_HIST* hist = &eventhdlrdata->hists[h];
+
+      SCIPmessageFPrintInfo(scip->messagehdlr, file,
+            "  %-17s: %10"SCIP_LONGINT_FORMAT" %10.2f %10.0f %10"SCIP_LONGINT_FORMAT" %10"SCIP_LONGINT_FORMAT" %10"
+            SCIP_LONGINT_FORMAT" %10"SCIP_LONGINT_FORMAT"\n", hooknames[h], hist->count, hist->total / 1e9,
+            SCIPhistGetMean(hist), MAX(SCIPhistGetQuantile(hist, 0.5), 0), MAX(SCIPhistGetQuantile(hist, 0.9), 0),
+            MAX(SCIPhistGetQuantile(hist, 0.99), 0), MAX(hist->max, 0));
+   }
+
+   if( !eventhdlrdata->perfvalid )
+      return;
+
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Perf counters      :     Cycles     Instrs        IPC CacheMisses BranchMisses Cycles/call\n");
+   for( h = 0; h < SCIP_LATENCYHOOK_N; h++ )
+   {
+      SCIP_Longint* ctrs = eventhdlrdata->perfctrs[h];
+      SCIP_Longint count = eventhdlrdata->hists[h].count;
+
+      SCIPmessageFPrintInfo(scip->messagehdlr, file,
+            "  %-17s: %10"SCIP_LONGINT_FORMAT" %10"SCIP_LONGINT_FORMAT" %10.2f %11"SCIP_LONGINT_FORMAT" %12"
+            SCIP_LONGINT_FORMAT" %11.0f\n", hooknames[h], ctrs[0], ctrs[1],
+            ctrs[0] > 0 ? (SCIP_Real)ctrs[1] / ctrs[0] : 0.0, ctrs[2], ctrs[3],
+            count > 0 ? (SCIP_Real)ctrs[0] / count : 0.0);
+   }
+}
+
+/** creates the latency event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrLatency(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+   int h;
+
+   /* create latency event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+
+   eventhdlr = NULL;
+   for( h = 0; h < SCIP_LATENCYHOOK_N; h++ )
+      SCIPhistClear(&eventhdlrdata->hists[h]);
+   for( h = 0; h < PERFCTR_N; h++ )
+      eventhdlrdata->perffds[h] = -1;
+   eventhdlrdata->perfvalid = FALSE;
+
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecLatency,
+         eventhdlrdata) );
+
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeLatency) );
+   SCIP_CALL( SCIPsetEventhdlrInit(scip, eventhdlr, eventInitLatency) );
+   SCIP_CALL( SCIPsetEventhdlrExit(scip, eventhdlr, eventExitLatency) );
+
+   /* add latency event handler parameters */
+   SCIP_CALL( SCIPaddBoolParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/active",
+         "measure the latencies of the callbacks of the node selection and pruning plugins?",
+         &eventhdlrdata->active, FALSE, DEFAULT_ACTIVE, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/perfctr",
+         "also read hardware performance counters (cycles, instructions, cache and branch misses) of the callbacks?",
+         &eventhdlrdata->perfctr, FALSE, DEFAULT_PERFCTR, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
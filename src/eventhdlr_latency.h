@@ -0,0 +1,94 @@
+/**@file   eventhdlr_latency.h
+ * @ingroup EVENTS
+ * @brief  event handler which keeps latency histograms of the callbacks of the node selection and pruning plugins
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENTHDLR_LATENCY_H__
+#define __SCIP_EVENTHDLR_LATENCY_H__
+
+
+#include "scip/scip.h"
+#include "hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** instrumented callbacks */
+enum SCIP_LatencyHook
+{
+   SCIP_LATENCYHOOK_SELECT             = 0,  /**< node selection (nodeselSelect*) */
+   SCIP_LATENCYHOOK_COMP               = 1,  /**< node comparison (nodeselComp*) */
+   SCIP_LATENCYHOOK_PRUNE              = 2,  /**< node pruning decision (nodepruPrune*) */
+   SCIP_LATENCYHOOK_SELFEAT            = 3,  /**< node selection features (SCIPcalcNodeselFeat()) */
+   SCIP_LATENCYHOOK_PRUFEAT            = 4,  /**< node pruning features (SCIPcalcNodepruFeat()) */
+   SCIP_LATENCYHOOK_SCORE              = 5,  /**< policy score (SCIPcalcNodeScore()) */
+   SCIP_LATENCYHOOK_TRJWRITE           = 6   /**< write of a trajectory example */
+};
+typedef enum SCIP_LatencyHook SCIP_LATENCYHOOK;
+
+#define SCIP_LATENCYHOOK_N          7    /**< number of instrumented callbacks */
+
+/** creates the latency event handler and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeEventhdlrLatency(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** returns the latency event handler if it is included and active, or NULL; the plugins look it up when the solve
+ *  starts and measure their callbacks only if it is not NULL
+ */
+EXTERN
+SCIP_EVENTHDLR* SCIPeventhdlrlatencyFind(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** returns the time at the start of a call of a callback, to be passed to SCIPeventhdlrlatencyAdd() at its end;
+ *  also reads the hardware performance counters if they are on
+ */
+EXTERN
+SCIP_Longint SCIPeventhdlrlatencyStart(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   SCIP_LATENCYHOOK      hook                /**< callback */
+   );
+
+/** adds the time since start, taken with SCIPeventhdlrlatencyStart(), to the histogram of a callback, and the counters
+ *  since then to its totals
+ */
+EXTERN
+void SCIPeventhdlrlatencyAdd(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   SCIP_LATENCYHOOK      hook,               /**< callback */
+   SCIP_Longint          start               /**< time at the start of the call */
+   );
+
+/** gets the histogram of a callback in the current solve */
+EXTERN
+SCIP_HIST* SCIPeventhdlrlatencyGetHist(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   SCIP_LATENCYHOOK      hook                /**< callback */
+   );
+
+/** writes the histograms of the current solve to a JSON file */
+EXTERN
+SCIP_RETCODE SCIPeventhdlrlatencyWriteJson(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< latency event handler */
+   const char*           instance,           /**< name of the problem */
+   const char*           fname               /**< file to write */
+   );
+
+EXTERN
+void SCIPeventhdlrlatencyPrintStatistics(
+   SCIP*                 scip,
+   SCIP_EVENTHDLR*       eventhdlr,
+   FILE*                 file
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
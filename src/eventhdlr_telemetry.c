@@ -0,0 +1,432 @@
+/**@file   eventhdlr_telemetry.c
+ * @brief  event handler which serves a live snapshot of the solve on a Unix domain socket
+ * @author He He
+ *
+ * Long solves are monitored by tailing their logs, which only show what SCIP prints and only as often as it prints.
+ * This event handler listens on a Unix domain socket instead and answers every connection with one JSON object and
+ * closes it, e.g. `socat - UNIX-CONNECT:<socket>`:
+ *
+ *   {"open": <open nodes>, "trjbytes": <trajectory bytes written>, "record": <result record so far>}
+ *
+ * The record is the JSON record of `--record` (record.c) with the nodes, bounds, gap, and the selection and pruning
+ * time, comparisons and comparison errors, and prunes of the node selector and pruner. The trajectory bytes are those
+ * of the examples the oracle and dagger plugins wrote in the current solve.
+ *
+ * The snapshot is refreshed on the branch-and-bound thread from counters that SCIP and the plugins keep anyway, every
+ * eventhdlr/telemetry/freq selected nodes, and copied under a lock. A server thread accepts the connections and
+ * writes the last snapshot, so that a slow or hanging client never blocks the solve.
+ *
+ * The event handler features the following parameters:
+ * - eventhdlr/telemetry/socket: path of the Unix domain socket to serve the snapshots on, or - for no socket
+ * - eventhdlr/telemetry/freq: refresh the snapshot every this number of selected nodes
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+/* fmemopen() and MSG_NOSIGNAL are POSIX.1-2008 */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "eventhdlr_telemetry.h"
+#include "nodesel_oracle.h"
+#include "nodesel_dagger.h"
+#include "nodepru_oracle.h"
+#include "nodepru_dagger.h"
+#include "record.h"
+
+#define EVENTHDLR_NAME          "telemetry"
+#define EVENTHDLR_DESC          "event handler which serves a live snapshot of the solve on a Unix domain socket"
+
+#define DEFAULT_SOCKET          "-"       /**< path of the socket, or - for no socket */
+#define DEFAULT_FREQ            100       /**< refresh the snapshot every this number of selected nodes */
+
+#define TELEMETRY_MAXLEN        4096      /**< maximal length of a snapshot */
+#define TELEMETRY_POLLMS        200       /**< time in ms after which the server thread checks whether to stop */
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   char*              socketname;         /**< path of the socket, or - for no socket */
+   int                freq;               /**< refresh the snapshot every this number of selected nodes */
+   SCIP_Longint       nfocused;           /**< number of nodes selected in the current solve */
+   int                sockfd;             /**< listening socket, or -1 */
+   pthread_t          thread;             /**< server thread */
+   pthread_mutex_t    lock;               /**< lock of snapshot, snapshotlen and stop */
+   char               snapshot[TELEMETRY_MAXLEN]; /**< last snapshot, served to the clients */
+   int                snapshotlen;        /**< length of the last snapshot */
+   SCIP_Bool          stop;               /**< should the server thread stop? */
+   char               staging[TELEMETRY_MAXLEN]; /**< snapshot being written on the branch-and-bound thread */
+   SCIP_RECORD        record;             /**< record of the snapshot being written */
+   int                filterpos;          /**< position of the events in the event filter */
+};
+
+/*
+ * Local methods
+ */
+
+/** gets the bytes of the examples written by the node selector and pruner in the current solve */
+static
+SCIP_Longint getTrjBytes(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_NODESEL* nodesel;
+   SCIP_NODEPRU* nodepru;
+   SCIP_Longint bytes;
+
+   bytes = 0;
+
+   nodesel = SCIPgetNodesel(scip);
+   if( nodesel != NULL && strcmp(SCIPnodeselGetName(nodesel), "oracle") == 0 )
+      bytes += SCIPnodeseloracleGetTrjBytes(nodesel);
+   else if( nodesel != NULL && strcmp(SCIPnodeselGetName(nodesel), "dagger") == 0 )
+      bytes += SCIPnodeseldaggerGetTrjBytes(nodesel);
+
+   nodepru = SCIPgetNodepru(scip);
+   if( nodepru != NULL && strcmp(SCIPnodepruGetName(nodepru), "oracle") == 0 )
+      bytes += SCIPnodepruoracleGetTrjBytes(nodepru);
+   else if( nodepru != NULL && strcmp(SCIPnodepruGetName(nodepru), "dagger") == 0 )
+      bytes += SCIPnodeprudaggerGetTrjBytes(nodepru);
+
+   return bytes;
+}
+
+/** writes a snapshot of the solve and hands it over to the server thread */
+static
+SCIP_RETCODE refreshSnapshot(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EVENTHDLRDATA*   eventhdlrdata       /**< event handler data */
+   )
+{
+   FILE* file;
+   long len;
+
+   assert(eventhdlrdata != NULL);
+
+   SCIPrecordCollect(scip, SCIPgetProbName(scip), &eventhdlrdata->record);
+
+   file = fmemopen(eventhdlrdata->staging, TELEMETRY_MAXLEN, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot write telemetry snapshot\n");
+      return SCIP_NOMEMORY;
+   }
+   fprintf(file, "{\"open\": %d, \"trjbytes\": %"SCIP_LONGINT_FORMAT", \"record\": ", SCIPgetNNodesLeft(scip),
+      getTrjBytes(scip));
+   SCIPrecordWrite(file, &eventhdlrdata->record, NULL, SCIP_RECORDFORMAT_JSON);
+
+   /* the record ends with a newline, which closes the snapshot instead */
+   (void) fseek(file, -1L, SEEK_CUR);
+   fputs("}\n", file);
+   len = ftell(file);
+   fclose(file);
+
+   if( len <= 0 || len >= TELEMETRY_MAXLEN )
+   {
+      SCIPerrorMessage("telemetry snapshot longer than %d bytes\n", TELEMETRY_MAXLEN - 1);
+      return SCIP_WRITEERROR;
+   }
+
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   memcpy(eventhdlrdata->snapshot, eventhdlrdata->staging, (size_t)len);
+   eventhdlrdata->snapshotlen = (int)len;
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+
+   return SCIP_OKAY;
+}
+
+/** server thread: answers every connection with the last snapshot until it is stopped */
+static
+void* serveSnapshots(
+   void*                 arg                 /**< event handler data */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   char buffer[TELEMETRY_MAXLEN];
+
+   eventhdlrdata = (SCIP_EVENTHDLRDATA*)arg;
+   assert(eventhdlrdata != NULL);
+
+   for( ;; )
+   {
+      struct pollfd pfd;
+      SCIP_Bool stop;
+      int len;
+      int off;
+      int fd;
+
+      pthread_mutex_lock(&eventhdlrdata->lock);
+      stop = eventhdlrdata->stop;
+      pthread_mutex_unlock(&eventhdlrdata->lock);
+      if( stop )
+         break;
+
+      pfd.fd = eventhdlrdata->sockfd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if( poll(&pfd, 1, TELEMETRY_POLLMS) <= 0 )
+         continue;
+
+      fd = accept(eventhdlrdata->sockfd, NULL, NULL);
+      if( fd < 0 )
+         continue;
+
+      pthread_mutex_lock(&eventhdlrdata->lock);
+      len = eventhdlrdata->snapshotlen;
+      memcpy(buffer, eventhdlrdata->snapshot, (size_t)len);
+      pthread_mutex_unlock(&eventhdlrdata->lock);
+
+      /* a client that went away must not kill the solve with SIGPIPE */
+      for( off = 0; off < len; )
+      {
+         ssize_t n = send(fd, buffer + off, (size_t)(len - off), MSG_NOSIGNAL);
+         if( n < 0 && errno == EINTR )
+            continue;
+         if( n <= 0 )
+            break;
+         off += (int)n;
+      }
+      close(fd);
+   }
+
+   return NULL;
+}
+
+/** opens the socket and starts the server thread */
+static
+SCIP_RETCODE startServer(
+   SCIP_EVENTHDLRDATA*   eventhdlrdata       /**< event handler data */
+   )
+{
+   struct sockaddr_un addr;
+   struct stat st;
+
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->sockfd == -1);
+
+   if( strlen(eventhdlrdata->socketname) >= sizeof(addr.sun_path) )
+   {
+      SCIPerrorMessage("socket path <%s> is longer than %d characters\n", eventhdlrdata->socketname,
+         (int)sizeof(addr.sun_path) - 1);
+      return SCIP_PARAMETERWRONGVAL;
+   }
+
+   /* a socket left behind by a solve that was killed is replaced, anything else at the path is kept */
+   if( lstat(eventhdlrdata->socketname, &st) == 0 )
+   {
+      if( !S_ISSOCK(st.st_mode) )
+      {
+         SCIPerrorMessage("telemetry socket path <%s> exists and is not a socket\n", eventhdlrdata->socketname);
+         return SCIP_FILECREATEERROR;
+      }
+      (void) unlink(eventhdlrdata->socketname);
+   }
+
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   strcpy(addr.sun_path, eventhdlrdata->socketname);
+
+   eventhdlrdata->sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if( eventhdlrdata->sockfd < 0 )
+   {
+      SCIPerrorMessage("cannot create telemetry socket\n");
+      SCIPprintSysError(eventhdlrdata->socketname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   if( bind(eventhdlrdata->sockfd, (struct sockaddr*)&addr, sizeof(addr)) != 0
+      || listen(eventhdlrdata->sockfd, 8) != 0 )
+   {
+      SCIPerrorMessage("cannot listen on telemetry socket <%s>\n", eventhdlrdata->socketname);
+      SCIPprintSysError(eventhdlrdata->socketname);
+      close(eventhdlrdata->sockfd);
+      eventhdlrdata->sockfd = -1;
+      return SCIP_FILECREATEERROR;
+   }
+
+   eventhdlrdata->stop = FALSE;
+   if( pthread_create(&eventhdlrdata->thread, NULL, serveSnapshots, eventhdlrdata) != 0 )
+   {
+      SCIPerrorMessage("cannot start telemetry thread\n");
+      close(eventhdlrdata->sockfd);
+      eventhdlrdata->sockfd = -1;
+      (void) unlink(eventhdlrdata->socketname);
+      return SCIP_ERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** stops the server thread and removes the socket */
+static
+void stopServer(
+   SCIP_EVENTHDLRDATA*   eventhdlrdata       /**< event handler data */
+   )
+{
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->sockfd >= 0);
+
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   eventhdlrdata->stop = TRUE;
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+   pthread_join(eventhdlrdata->thread, NULL);
+
+   close(eventhdlrdata->sockfd);
+   eventhdlrdata->sockfd = -1;
+   (void) unlink(eventhdlrdata->socketname);
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeTelemetry)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->sockfd == -1);
+
+   pthread_mutex_destroy(&eventhdlrdata->lock);
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolTelemetry)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   eventhdlrdata->nfocused = 0;
+
+   if( strcmp(eventhdlrdata->socketname, "-") == 0 )
+      return SCIP_OKAY;
+
+   /* the first clients get the snapshot of the start of the branch and bound process */
+   SCIP_CALL( refreshSnapshot(scip, eventhdlrdata) );
+   SCIP_CALL( startServer(eventhdlrdata) );
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, &eventhdlrdata->filterpos) );
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "serving telemetry on <%s>\n", eventhdlrdata->socketname);
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolTelemetry)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( eventhdlrdata->sockfd < 0 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, eventhdlrdata->filterpos) );
+   eventhdlrdata->filterpos = -1;
+
+   stopServer(eventhdlrdata);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler: refreshes the snapshot every freq selected nodes */
+static
+SCIP_DECL_EVENTEXEC(eventExecTelemetry)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+   assert(SCIPeventGetType(event) & SCIP_EVENTTYPE_NODEFOCUSED);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( ++eventhdlrdata->nfocused % eventhdlrdata->freq == 0 )
+   {
+      SCIP_CALL( refreshSnapshot(scip, eventhdlrdata) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** creates the telemetry event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrTelemetry(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+
+   /* create telemetry event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+
+   eventhdlr = NULL;
+   eventhdlrdata->socketname = NULL;
+   eventhdlrdata->nfocused = 0;
+   eventhdlrdata->sockfd = -1;
+   eventhdlrdata->snapshotlen = 0;
+   eventhdlrdata->stop = FALSE;
+   eventhdlrdata->filterpos = -1;
+   pthread_mutex_init(&eventhdlrdata->lock, NULL);
+
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecTelemetry,
+         eventhdlrdata) );
+
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeTelemetry) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolTelemetry) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolTelemetry) );
+
+   /* add telemetry event handler parameters */
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/socket",
+         "path of the Unix domain socket to serve live snapshots of the solve on, or - for no socket",
+         &eventhdlrdata->socketname, FALSE, DEFAULT_SOCKET, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/freq",
+         "refresh the snapshot every this number of selected nodes",
+         &eventhdlrdata->freq, FALSE, DEFAULT_FREQ, 1, INT_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
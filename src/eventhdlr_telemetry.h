@@ -0,0 +1,29 @@
+/**@file   eventhdlr_telemetry.h
+ * @ingroup EVENTS
+ * @brief  event handler which serves a live snapshot of the solve on a Unix domain socket
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENTHDLR_TELEMETRY_H__
+#define __SCIP_EVENTHDLR_TELEMETRY_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the telemetry event handler and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeEventhdlrTelemetry(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
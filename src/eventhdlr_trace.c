@@ -0,0 +1,590 @@
+/**@file   eventhdlr_trace.c
+ * @brief  event handler which records a binary trace of the branch-and-bound search
+ * @author He He
+ *
+ * The VBC output of SCIP writes a line of text per node and change of node color, which is too slow and too large
+ * for trees with millions of nodes. This event handler streams the search to a binary file instead: the creation,
+ * selection and solving of each node, the decisions of the node pruners, the labels of the oracle and the incumbent
+ * updates. The records are written through a large stdio buffer, so a node costs a few memcpy() calls.
+ *
+ * Trace file layout (native byte order, no padding):
+ *
+ *   header: char magic[8] ("SCIPBBT1")
+ *   record: unsigned int length (of the rest of the record), unsigned char type, payload
+ *
+ *   NODE      : SCIP_Longint number, SCIP_Longint parent (-1 for the root), int depth, SCIP_Real lowerbound,
+ *               SCIP_Real estimate, int nbranchings, int varindex, SCIP_Real bound, unsigned char boundtype
+ *               (first branching bound change of the node, varindex -1 if there is none)
+ *   FOCUS     : SCIP_Longint number, SCIP_Longint order, SCIP_Real lowerbound
+ *   SOLVED    : SCIP_Longint number, unsigned char result (0 feasible, 1 infeasible, 2 branched),
+ *               unsigned char lpsolstat (SCIP_LPSOLSTAT, 0 if no LP was solved), SCIP_Real lowerbound,
+ *               SCIP_Longint lpiterations (total)
+ *   PRUNE     : SCIP_Longint number, unsigned char prune
+ *   INCUMBENT : SCIP_Longint number (focus node, -1 if none), SCIP_Real objective (original space), SCIP_Real time,
+ *               SCIP_Real transobjective (transformed space, comparable to the lower bounds)
+ *   LABEL     : SCIP_Longint number, unsigned char isoptimal
+ *   FEAT      : SCIP_Longint number, unsigned char kind (0 node selection, 1 node pruning), int depth, int maxdepth,
+ *               unsigned char boundtype, int size, SCIP_Real vals[size]
+ *
+ * Readers skip records of unknown type by their length. The variable index is the position of the variable in the
+ * transformed problem (SCIPvarGetProbindex()).
+ *
+ * With features, the node selection and pruning features of each child are computed when its parent is branched,
+ * which is when the node selectors score them, so that `scipdagger replay` can evaluate policies on the trace.
+ *
+ * The event handler features the following parameters:
+ * - eventhdlr/trace/filename: file to write the trace of each solve to, or - for no trace
+ * - eventhdlr/trace/features: record the feature vectors of the nodes?
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+#include <assert.h>
+#include <string.h>
+
+#include "eventhdlr_trace.h"
+#include "feat.h"
+#include "struct_feat.h"
+
+#define EVENTHDLR_NAME          "trace"
+#define EVENTHDLR_DESC          "event handler which records a binary trace of the branch-and-bound search"
+
+#define DEFAULT_FILENAME        "-"       /**< file to write the trace to, or - for no trace */
+#define DEFAULT_FEATURES        FALSE     /**< record the feature vectors of the nodes? */
+
+#define TRACE_EVENTS            (SCIP_EVENTTYPE_NODEFOCUSED | SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_BESTSOLFOUND)
+#define TRACE_BUFSIZE           (1 << 20) /**< size of the stdio buffer of the trace file */
+#define TRACE_MAXRECORD         64        /**< maximal size of a record */
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   FILE*              file;               /**< trace file of the current solve, or NULL */
+   char*              filename;           /**< file to write the trace to, or - for no trace */
+   SCIP_FEAT*         selfeat;            /**< node selection features if they are recorded, or NULL */
+   SCIP_FEAT*         prufeat;            /**< node pruning features if they are recorded, or NULL */
+   SCIP_Bool          features;           /**< record the feature vectors of the nodes? */
+   SCIP_Longint       nfocused;           /**< number of nodes selected in the current solve */
+   SCIP_Longint       nrecords;           /**< number of records written in the current solve */
+   int                filterpos;          /**< position of the events in the event filter */
+};
+
+/** record being packed */
+struct TraceBuffer
+{
+   unsigned char      data[TRACE_MAXRECORD]; /**< length, type and payload */
+   int                len;                /**< number of bytes used */
+};
+typedef struct TraceBuffer TRACEBUFFER;
+
+/*
+ * Local methods
+ */
+
+/** starts a record of the given type */
+static
+void traceBegin(
+   TRACEBUFFER*          buffer,             /**< record buffer */
+   SCIP_TRACERECORD      type                /**< record type */
+   )
+{
+   assert(buffer != NULL);
+
+   buffer->len = (int)sizeof(unsigned int);
+   buffer->data[buffer->len++] = (unsigned char)type;
+}
+
+/** appends a value to a record */
+static
+void traceAdd(
+   TRACEBUFFER*          buffer,             /**< record buffer */
+   const void*           val,                /**< value */
+   int                   size                /**< size of the value */
+   )
+{
+   assert(buffer != NULL);
+   assert(buffer->len + size <= TRACE_MAXRECORD);
+
+   memcpy(&buffer->data[buffer->len], val, (size_t)size);
+   buffer->len += size;
+}
+
+/** appends a byte to a record */
+static
+void traceAddByte(
+   TRACEBUFFER*          buffer,             /**< record buffer */
+   int                   val                 /**< value */
+   )
+{
+   assert(buffer != NULL);
+   assert(buffer->len < TRACE_MAXRECORD);
+   assert(0 <= val && val <= 255);
+
+   buffer->data[buffer->len++] = (unsigned char)val;
+}
+
+/** writes a record with its length to the trace file */
+static
+SCIP_RETCODE traceEnd(
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /**< event handler data */
+   TRACEBUFFER*          buffer              /**< record buffer */
+   )
+{
+   unsigned int length;
+
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file != NULL);
+   assert(buffer != NULL);
+
+   length = (unsigned int)buffer->len - (unsigned int)sizeof(unsigned int);
+   memcpy(buffer->data, &length, sizeof(unsigned int));
+
+   if( fwrite(buffer->data, 1, (size_t)buffer->len, eventhdlrdata->file) != (size_t)buffer->len )
+   {
+      SCIPerrorMessage("error writing trace file <%s>\n", eventhdlrdata->filename);
+      return SCIP_WRITEERROR;
+   }
+   eventhdlrdata->nrecords++;
+
+   return SCIP_OKAY;
+}
+
+/** writes the record of a created node */
+static
+SCIP_RETCODE traceNode(
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /**< event handler data */
+   SCIP_NODE*            node                /**< node */
+   )
+{
+   TRACEBUFFER buffer;
+   SCIP_VAR* branchvar;
+   SCIP_Real branchbound;
+   SCIP_BOUNDTYPE boundtype;
+   SCIP_Longint number;
+   SCIP_Longint parent;
+   SCIP_Real lowerbound;
+   SCIP_Real estimate;
+   int nbranchings;
+   int varindex;
+   int depth;
+
+   assert(node != NULL);
+
+   number = SCIPnodeGetNumber(node);
+   parent = SCIPnodeGetParent(node) != NULL ? SCIPnodeGetNumber(SCIPnodeGetParent(node)) : -1;
+   depth = SCIPnodeGetDepth(node);
+   lowerbound = SCIPnodeGetLowerbound(node);
+   estimate = SCIPnodeGetEstimate(node);
+
+   /* only the first branching is recorded, the others are counted */
+   nbranchings = 0;
+   varindex = -1;
+   branchbound = 0.0;
+   boundtype = SCIP_BOUNDTYPE_LOWER;
+   if( depth > 0 )
+   {
+      SCIPnodeGetParentBranchings(node, &branchvar, &branchbound, &boundtype, &nbranchings, 1);
+      if( nbranchings > 0 )
+         varindex = SCIPvarGetProbindex(branchvar);
+   }
+
+   traceBegin(&buffer, SCIP_TRACERECORD_NODE);
+   traceAdd(&buffer, &number, sizeof(number));
+   traceAdd(&buffer, &parent, sizeof(parent));
+   traceAdd(&buffer, &depth, sizeof(depth));
+   traceAdd(&buffer, &lowerbound, sizeof(lowerbound));
+   traceAdd(&buffer, &estimate, sizeof(estimate));
+   traceAdd(&buffer, &nbranchings, sizeof(nbranchings));
+   traceAdd(&buffer, &varindex, sizeof(varindex));
+   traceAdd(&buffer, &branchbound, sizeof(branchbound));
+   traceAddByte(&buffer, (int)boundtype);
+   SCIP_CALL( traceEnd(eventhdlrdata, &buffer) );
+
+   return SCIP_OKAY;
+}
+
+/** writes the record of a feature vector of a node */
+static
+SCIP_RETCODE traceFeat(
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /**< event handler data */
+   SCIP_NODE*            node,               /**< node */
+   SCIP_FEAT*            feat,               /**< features of the node */
+   int                   kind                /**< 0 for node selection, 1 for node pruning features */
+   )
+{
+   TRACEBUFFER buffer;
+   SCIP_Longint number;
+   unsigned int length;
+   int size;
+
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file != NULL);
+   assert(feat != NULL);
+
+   number = SCIPnodeGetNumber(node);
+   size = SCIPfeatGetSize(feat);
+
+   traceBegin(&buffer, SCIP_TRACERECORD_FEAT);
+   traceAdd(&buffer, &number, sizeof(number));
+   traceAddByte(&buffer, kind);
+   traceAdd(&buffer, &feat->depth, sizeof(feat->depth));
+   traceAdd(&buffer, &feat->maxdepth, sizeof(feat->maxdepth));
+   traceAddByte(&buffer, (int)feat->boundtype);
+   traceAdd(&buffer, &size, sizeof(size));
+
+   /* the values do not fit into the record buffer and are written behind it */
+   length = (unsigned int)buffer.len - (unsigned int)sizeof(unsigned int) + (unsigned int)(size * sizeof(SCIP_Real));
+   memcpy(buffer.data, &length, sizeof(unsigned int));
+   if( fwrite(buffer.data, 1, (size_t)buffer.len, eventhdlrdata->file) != (size_t)buffer.len
+      || fwrite(SCIPfeatGetVals(feat), sizeof(SCIP_Real), (size_t)size, eventhdlrdata->file) != (size_t)size )
+   {
+      SCIPerrorMessage("error writing trace file <%s>\n", eventhdlrdata->filename);
+      return SCIP_WRITEERROR;
+   }
+   eventhdlrdata->nrecords++;
+
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeTrace)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file == NULL);
+
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolTrace)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file == NULL);
+
+   eventhdlrdata->nfocused = 0;
+   eventhdlrdata->nrecords = 0;
+
+   if( strcmp(eventhdlrdata->filename, "-") == 0 )
+      return SCIP_OKAY;
+
+   eventhdlrdata->file = fopen(eventhdlrdata->filename, "wb");
+   if( eventhdlrdata->file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", eventhdlrdata->filename);
+      SCIPprintSysError(eventhdlrdata->filename);
+      return SCIP_FILECREATEERROR;
+   }
+   (void) setvbuf(eventhdlrdata->file, NULL, _IOFBF, TRACE_BUFSIZE);
+   fwrite(SCIP_TRACE_MAGIC, sizeof(char), SCIP_TRACE_MAGICLEN, eventhdlrdata->file);
+
+   if( eventhdlrdata->features )
+   {
+      SCIP_CALL( SCIPfeatCreate(scip, &eventhdlrdata->selfeat, SCIP_FEATNODESEL_SIZE) );
+      SCIPfeatSetMaxDepth(eventhdlrdata->selfeat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+      SCIP_CALL( SCIPfeatCreate(scip, &eventhdlrdata->prufeat, SCIP_FEATNODEPRU_SIZE) );
+      SCIPfeatSetMaxDepth(eventhdlrdata->prufeat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+   }
+
+   SCIP_CALL( SCIPcatchEvent(scip, TRACE_EVENTS, eventhdlr, NULL, &eventhdlrdata->filterpos) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolTrace)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( eventhdlrdata->file == NULL )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPdropEvent(scip, TRACE_EVENTS, eventhdlr, NULL, eventhdlrdata->filterpos) );
+   eventhdlrdata->filterpos = -1;
+
+   if( eventhdlrdata->selfeat != NULL )
+   {
+      SCIP_CALL( SCIPfeatFree(scip, &eventhdlrdata->selfeat) );
+      SCIP_CALL( SCIPfeatFree(scip, &eventhdlrdata->prufeat) );
+   }
+
+   if( fclose(eventhdlrdata->file) != 0 )
+   {
+      eventhdlrdata->file = NULL;
+      SCIPerrorMessage("error writing trace file <%s>\n", eventhdlrdata->filename);
+      return SCIP_WRITEERROR;
+   }
+   eventhdlrdata->file = NULL;
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "wrote %"SCIP_LONGINT_FORMAT" trace records to <%s>\n",
+      eventhdlrdata->nrecords, eventhdlrdata->filename);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler: records node selections, solved nodes and new incumbents */
+static
+SCIP_DECL_EVENTEXEC(eventExecTrace)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTTYPE eventtype;
+   TRACEBUFFER buffer;
+   SCIP_NODE* node;
+   SCIP_Longint number;
+   SCIP_Real lowerbound;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file != NULL);
+
+   eventtype = SCIPeventGetType(event);
+
+   if( eventtype & SCIP_EVENTTYPE_BESTSOLFOUND )
+   {
+      SCIP_Real objective;
+      SCIP_Real transobjective;
+      SCIP_Real time;
+
+      node = SCIPgetCurrentNode(scip);
+      number = node != NULL ? SCIPnodeGetNumber(node) : -1;
+      objective = SCIPgetSolOrigObj(scip, SCIPeventGetSol(event));
+      transobjective = SCIPgetSolTransObj(scip, SCIPeventGetSol(event));
+      time = SCIPgetSolvingTime(scip);
+
+      traceBegin(&buffer, SCIP_TRACERECORD_INCUMBENT);
+      traceAdd(&buffer, &number, sizeof(number));
+      traceAdd(&buffer, &objective, sizeof(objective));
+      traceAdd(&buffer, &time, sizeof(time));
+      traceAdd(&buffer, &transobjective, sizeof(transobjective));
+      SCIP_CALL( traceEnd(eventhdlrdata, &buffer) );
+
+      return SCIP_OKAY;
+   }
+
+   node = SCIPeventGetNode(event);
+   assert(node != NULL);
+   number = SCIPnodeGetNumber(node);
+   lowerbound = SCIPnodeGetLowerbound(node);
+
+   if( eventtype & SCIP_EVENTTYPE_NODEFOCUSED )
+   {
+      SCIP_Longint order;
+
+      /* the other nodes are recorded when their parent is branched */
+      if( SCIPnodeGetDepth(node) == 0 )
+      {
+         SCIP_CALL( traceNode(eventhdlrdata, node) );
+      }
+
+      order = eventhdlrdata->nfocused++;
+
+      traceBegin(&buffer, SCIP_TRACERECORD_FOCUS);
+      traceAdd(&buffer, &number, sizeof(number));
+      traceAdd(&buffer, &order, sizeof(order));
+      traceAdd(&buffer, &lowerbound, sizeof(lowerbound));
+      SCIP_CALL( traceEnd(eventhdlrdata, &buffer) );
+   }
+   else
+   {
+      SCIP_Longint lpiterations;
+      int result;
+      int lpsolstat;
+
+      assert(eventtype & SCIP_EVENTTYPE_NODESOLVED);
+
+      if( eventtype & SCIP_EVENTTYPE_NODEFEASIBLE )
+         result = 0;
+      else if( eventtype & SCIP_EVENTTYPE_NODEINFEASIBLE )
+         result = 1;
+      else
+         result = 2;
+      lpsolstat = SCIPhasCurrentNodeLP(scip) ? (int)SCIPgetLPSolstat(scip) : 0;
+      lpiterations = SCIPgetNLPIterations(scip);
+
+      traceBegin(&buffer, SCIP_TRACERECORD_SOLVED);
+      traceAdd(&buffer, &number, sizeof(number));
+      traceAddByte(&buffer, result);
+      traceAddByte(&buffer, lpsolstat);
+      traceAdd(&buffer, &lowerbound, sizeof(lowerbound));
+      traceAdd(&buffer, &lpiterations, sizeof(lpiterations));
+      SCIP_CALL( traceEnd(eventhdlrdata, &buffer) );
+
+      /* the children of a branched node exist now */
+      if( eventtype & SCIP_EVENTTYPE_NODEBRANCHED )
+      {
+         SCIP_NODE** children;
+         int nchildren;
+         int i;
+
+         SCIP_CALL( SCIPgetChildren(scip, &children, &nchildren) );
+         for( i = 0; i < nchildren; i++ )
+         {
+            SCIP_CALL( traceNode(eventhdlrdata, children[i]) );
+            if( eventhdlrdata->selfeat != NULL )
+            {
+               SCIPcalcNodeselFeat(scip, children[i], eventhdlrdata->selfeat);
+               SCIP_CALL( traceFeat(eventhdlrdata, children[i], eventhdlrdata->selfeat, 0) );
+               SCIPcalcNodepruFeat(scip, children[i], eventhdlrdata->prufeat);
+               SCIP_CALL( traceFeat(eventhdlrdata, children[i], eventhdlrdata->prufeat, 1) );
+            }
+         }
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** returns the trace event handler if it is included and a trace file is set, or NULL; the plugins look it up when
+ *  the solve starts and report their decisions only if it is not NULL
+ */
+SCIP_EVENTHDLR* SCIPeventhdlrtraceFind(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+
+   assert(scip != NULL);
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if( eventhdlr == NULL || strcmp(SCIPeventhdlrGetData(eventhdlr)->filename, "-") == 0 )
+      return NULL;
+
+   return eventhdlr;
+}
+
+/** records the decision of a node pruner */
+SCIP_RETCODE SCIPeventhdlrtraceAddPrune(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< trace event handler */
+   SCIP_NODE*            node,               /**< node */
+   SCIP_Bool             prune               /**< has the node been pruned? */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   TRACEBUFFER buffer;
+   SCIP_Longint number;
+
+   assert(eventhdlr != NULL);
+   assert(node != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   /* the trace file is opened when the branch and bound process begins */
+   if( eventhdlrdata->file == NULL )
+      return SCIP_OKAY;
+
+   number = SCIPnodeGetNumber(node);
+
+   traceBegin(&buffer, SCIP_TRACERECORD_PRUNE);
+   traceAdd(&buffer, &number, sizeof(number));
+   traceAddByte(&buffer, prune ? 1 : 0);
+   SCIP_CALL( traceEnd(eventhdlrdata, &buffer) );
+
+   return SCIP_OKAY;
+}
+
+/** records the label of a node given by the oracle */
+SCIP_RETCODE SCIPeventhdlrtraceAddLabel(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< trace event handler */
+   SCIP_NODE*            node,               /**< node */
+   SCIP_Bool             isoptimal           /**< is the optimal solution in the subtree of the node? */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   TRACEBUFFER buffer;
+   SCIP_Longint number;
+
+   assert(eventhdlr != NULL);
+   assert(node != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( eventhdlrdata->file == NULL )
+      return SCIP_OKAY;
+
+   number = SCIPnodeGetNumber(node);
+
+   traceBegin(&buffer, SCIP_TRACERECORD_LABEL);
+   traceAdd(&buffer, &number, sizeof(number));
+   traceAddByte(&buffer, isoptimal ? 1 : 0);
+   SCIP_CALL( traceEnd(eventhdlrdata, &buffer) );
+
+   return SCIP_OKAY;
+}
+
+/** creates the trace event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrTrace(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+
+   /* create trace event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+
+   eventhdlr = NULL;
+   eventhdlrdata->file = NULL;
+   eventhdlrdata->filename = NULL;
+   eventhdlrdata->selfeat = NULL;
+   eventhdlrdata->prufeat = NULL;
+   eventhdlrdata->nfocused = 0;
+   eventhdlrdata->nrecords = 0;
+   eventhdlrdata->filterpos = -1;
+
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecTrace,
+         eventhdlrdata) );
+
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeTrace) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolTrace) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolTrace) );
+
+   /* add trace event handler parameters */
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/filename",
+         "file to write the binary trace of each solve to, or - for no trace",
+         &eventhdlrdata->filename, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/features",
+         "record the node selection and pruning features of each node (for scipdagger replay)?",
+         &eventhdlrdata->features, FALSE, DEFAULT_FEATURES, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
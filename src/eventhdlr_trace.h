@@ -0,0 +1,69 @@
+/**@file   eventhdlr_trace.h
+ * @ingroup EVENTS
+ * @brief  event handler which records a binary trace of the branch-and-bound search
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENTHDLR_TRACE_H__
+#define __SCIP_EVENTHDLR_TRACE_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCIP_TRACE_MAGIC            "SCIPBBT1" /**< first bytes of a trace file */
+#define SCIP_TRACE_MAGICLEN         8
+
+/** record types of a trace file */
+enum SCIP_TraceRecord
+{
+   SCIP_TRACERECORD_NODE               = 1,  /**< a node has been created */
+   SCIP_TRACERECORD_FOCUS              = 2,  /**< a node has been selected */
+   SCIP_TRACERECORD_SOLVED             = 3,  /**< a node has been solved */
+   SCIP_TRACERECORD_PRUNE              = 4,  /**< a node pruner has decided on a node */
+   SCIP_TRACERECORD_INCUMBENT          = 5,  /**< a new incumbent has been found */
+   SCIP_TRACERECORD_LABEL              = 6,  /**< the oracle has labeled a node */
+   SCIP_TRACERECORD_FEAT               = 7   /**< feature vector of a node */
+};
+typedef enum SCIP_TraceRecord SCIP_TRACERECORD;
+
+/** creates the trace event handler and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeEventhdlrTrace(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** returns the trace event handler if it is included and a trace file is set, or NULL; the plugins look it up when
+ *  the solve starts and report their decisions only if it is not NULL
+ */
+EXTERN
+SCIP_EVENTHDLR* SCIPeventhdlrtraceFind(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** records the decision of a node pruner */
+EXTERN
+SCIP_RETCODE SCIPeventhdlrtraceAddPrune(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< trace event handler */
+   SCIP_NODE*            node,               /**< node */
+   SCIP_Bool             prune               /**< has the node been pruned? */
+   );
+
+/** records the label of a node given by the oracle */
+EXTERN
+SCIP_RETCODE SCIPeventhdlrtraceAddLabel(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< trace event handler */
+   SCIP_NODE*            node,               /**< node */
+   SCIP_Bool             isoptimal           /**< is the optimal solution in the subtree of the node? */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
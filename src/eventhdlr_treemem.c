@@ -0,0 +1,482 @@
+/**@file   eventhdlr_treemem.c
+ * @brief  event handler which samples the memory of the open nodes and counts the memory freed by pruned nodes
+ * @author He He
+ *
+ * Pruning keeps the tree small on large problems, but SCIP only reports the total memory of the solve. This event
+ * handler samples the open nodes (leaves, children and siblings) every eventhdlr/treemem/freq selected nodes and
+ * estimates their memory: the node itself, its slot in the node queue and its domain changes (the bound changes of
+ * the branching and the propagation at the node). The plugins attach no other data to the nodes: the policy score is a
+ * field of the node in the patched SCIP, and the features are computed again whenever they are needed. The peak
+ * number of open nodes is taken at every selected node, the peak memory of the open nodes and of SCIP
+ * (SCIPgetMemUsed()) at the samples.
+ *
+ * The node pruners report their prunes with SCIPeventhdlrtreememAddPrune(), which counts the pruned nodes and the
+ * memory they free in ten buckets of their depth relative to the number of binary and integer variables, so that a
+ * kill policy can be tuned against a memory limit. The memory saved is that of the pruned node only; the subtree it
+ * would have grown is unknown.
+ *
+ * The event handler features the following parameters:
+ * - eventhdlr/treemem/active: sample the open nodes and count the pruned nodes (off by default, since a sample walks
+ *   over all open nodes)
+ * - eventhdlr/treemem/freq: sample the open nodes every this number of selected nodes
+ * - eventhdlr/treemem/filename: file to write the samples of each solve to as CSV, or - for no file
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+#include <assert.h>
+#include <limits.h>
+#include <string.h>
+
+#include "eventhdlr_treemem.h"
+#include "scip/struct_scip.h"
+#include "scip/struct_tree.h"
+#include "scip/struct_var.h"
+
+#define EVENTHDLR_NAME          "treemem"
+#define EVENTHDLR_DESC          "event handler which samples the memory of the open nodes"
+
+#define DEFAULT_ACTIVE          FALSE     /**< sample the open nodes and count the pruned nodes? */
+#define DEFAULT_FREQ            100       /**< sample the open nodes every this number of selected nodes */
+#define DEFAULT_FILENAME        "-"       /**< file to write the samples to, or - for no file */
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   FILE*              file;               /**< sample file of the current solve, or NULL */
+   char*              filename;           /**< file to write the samples to, or - for no file */
+   SCIP_Bool          active;             /**< sample the open nodes and count the pruned nodes? */
+   int                freq;               /**< sample the open nodes every this number of selected nodes */
+   SCIP_Longint       nfocused;           /**< number of nodes selected in the current solve */
+   SCIP_Longint       nsamples;           /**< number of samples in the current solve */
+   SCIP_Longint       nsampled;           /**< total number of open nodes over the samples */
+   SCIP_Longint       sampledbytes;       /**< total memory of the open nodes over the samples */
+   int                nopen;              /**< number of open nodes at the last selected node */
+   int                peakopen;           /**< peak number of open nodes */
+   SCIP_Longint       bytes;              /**< memory of the open nodes at the last sample */
+   SCIP_Longint       peakbytes;          /**< peak memory of the open nodes */
+   SCIP_Longint       peakmemused;        /**< peak memory used by SCIP at the samples */
+   int                maxdepth;           /**< number of binary and integer variables, the depth of the last bucket */
+   SCIP_Longint       nprunes[SCIP_TREEMEM_NBUCKETS]; /**< number of pruned nodes per depth bucket */
+   SCIP_Longint       prunebytes[SCIP_TREEMEM_NBUCKETS]; /**< memory freed by pruned nodes per depth bucket */
+   int                filterpos;          /**< position of the events in the event filter */
+};
+
+/*
+ * Local methods
+ */
+
+/** gets the depth bucket of a node */
+static
+int getBucket(
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /**< event handler data */
+   int                   depth               /**< depth of the node */
+   )
+{
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->maxdepth >= 1);
+
+   return MIN((SCIP_Longint)depth * SCIP_TREEMEM_NBUCKETS / eventhdlrdata->maxdepth, SCIP_TREEMEM_NBUCKETS - 1);
+}
+
+/** sums the memory of open nodes */
+static
+SCIP_Longint sumNodeBytes(
+   SCIP_NODE**           nodes,              /**< open nodes */
+   int                   nnodes              /**< number of open nodes */
+   )
+{
+   SCIP_Longint bytes;
+   int i;
+
+   bytes = 0;
+   for( i = 0; i < nnodes; i++ )
+      bytes += SCIPeventhdlrtreememGetNodeBytes(nodes[i]);
+
+   return bytes;
+}
+
+/** samples the open nodes and writes the sample to the sample file */
+static
+SCIP_RETCODE sampleOpenNodes(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EVENTHDLRDATA*   eventhdlrdata       /**< event handler data */
+   )
+{
+   SCIP_NODE** leaves;
+   SCIP_NODE** children;
+   SCIP_NODE** siblings;
+   SCIP_Longint memused;
+   int nleaves;
+   int nchildren;
+   int nsiblings;
+   int nopen;
+
+   assert(eventhdlrdata != NULL);
+
+   SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
+   nopen = nleaves + nchildren + nsiblings;
+
+   eventhdlrdata->bytes = sumNodeBytes(leaves, nleaves) + sumNodeBytes(children, nchildren)
+      + sumNodeBytes(siblings, nsiblings);
+   eventhdlrdata->peakbytes = MAX(eventhdlrdata->peakbytes, eventhdlrdata->bytes);
+   eventhdlrdata->nsamples++;
+   eventhdlrdata->nsampled += nopen;
+   eventhdlrdata->sampledbytes += eventhdlrdata->bytes;
+
+   memused = SCIPgetMemUsed(scip);
+   eventhdlrdata->peakmemused = MAX(eventhdlrdata->peakmemused, memused);
+
+   if( eventhdlrdata->file != NULL )
+   {
+      fprintf(eventhdlrdata->file, "%"SCIP_LONGINT_FORMAT",%.3f,%d,%"SCIP_LONGINT_FORMAT",%.1f,%"
+         SCIP_LONGINT_FORMAT"\n", eventhdlrdata->nfocused, SCIPgetSolvingTime(scip), nopen, eventhdlrdata->bytes,
+         nopen > 0 ? (SCIP_Real)eventhdlrdata->bytes / nopen : 0.0, memused);
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeTreemem)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file == NULL);
+
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolTreemem)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   int b;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->file == NULL);
+
+   eventhdlrdata->nfocused = 0;
+   eventhdlrdata->nsamples = 0;
+   eventhdlrdata->nsampled = 0;
+   eventhdlrdata->sampledbytes = 0;
+   eventhdlrdata->nopen = 0;
+   eventhdlrdata->peakopen = 0;
+   eventhdlrdata->bytes = 0;
+   eventhdlrdata->peakbytes = 0;
+   eventhdlrdata->peakmemused = 0;
+   eventhdlrdata->maxdepth = MAX(SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip), 1);
+   for( b = 0; b < SCIP_TREEMEM_NBUCKETS; b++ )
+   {
+      eventhdlrdata->nprunes[b] = 0;
+      eventhdlrdata->prunebytes[b] = 0;
+   }
+
+   if( !eventhdlrdata->active )
+      return SCIP_OKAY;
+
+   if( strcmp(eventhdlrdata->filename, "-") != 0 )
+   {
+      eventhdlrdata->file = fopen(eventhdlrdata->filename, "w");
+      if( eventhdlrdata->file == NULL )
+      {
+         SCIPerrorMessage("cannot open file <%s> for writing\n", eventhdlrdata->filename);
+         SCIPprintSysError(eventhdlrdata->filename);
+         return SCIP_FILECREATEERROR;
+      }
+      fprintf(eventhdlrdata->file, "nodes,time,open,treebytes,bytespernode,memused\n");
+   }
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, &eventhdlrdata->filterpos) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolTreemem)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( eventhdlrdata->filterpos < 0 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, eventhdlrdata->filterpos) );
+   eventhdlrdata->filterpos = -1;
+
+   if( eventhdlrdata->file == NULL )
+      return SCIP_OKAY;
+
+   if( fclose(eventhdlrdata->file) != 0 )
+   {
+      eventhdlrdata->file = NULL;
+      SCIPerrorMessage("error writing tree memory file <%s>\n", eventhdlrdata->filename);
+      return SCIP_WRITEERROR;
+   }
+   eventhdlrdata->file = NULL;
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "wrote %"SCIP_LONGINT_FORMAT" tree memory samples to <%s>\n",
+      eventhdlrdata->nsamples, eventhdlrdata->filename);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler: counts the open nodes and samples them every freq selected nodes */
+static
+SCIP_DECL_EVENTEXEC(eventExecTreemem)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+   assert(SCIPeventGetType(event) & SCIP_EVENTTYPE_NODEFOCUSED);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   eventhdlrdata->nopen = SCIPgetNNodesLeft(scip);
+   eventhdlrdata->peakopen = MAX(eventhdlrdata->peakopen, eventhdlrdata->nopen);
+
+   if( eventhdlrdata->nfocused++ % eventhdlrdata->freq == 0 )
+   {
+      SCIP_CALL( sampleOpenNodes(scip, eventhdlrdata) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** returns the tree memory event handler if it is included and active, or NULL; the node pruners look it up when the
+ *  solve starts and report their prunes only if it is not NULL
+ */
+SCIP_EVENTHDLR* SCIPeventhdlrtreememFind(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+
+   assert(scip != NULL);
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if( eventhdlr == NULL || !SCIPeventhdlrGetData(eventhdlr)->active )
+      return NULL;
+
+   return eventhdlr;
+}
+
+/** gets the estimated memory in bytes of a node while it is open: the node, its slot in the node queue and its
+ *  domain changes
+ */
+SCIP_Longint SCIPeventhdlrtreememGetNodeBytes(
+   SCIP_NODE*            node                /**< node */
+   )
+{
+   SCIP_DOMCHG* domchg;
+   SCIP_Longint bytes;
+
+   assert(node != NULL);
+
+   bytes = (SCIP_Longint)(sizeof(SCIP_NODE) + sizeof(SCIP_NODE*));
+
+   domchg = node->domchg;
+   if( domchg == NULL )
+      return bytes;
+
+   switch( domchg->domchgbound.domchgtype )
+   {
+   case SCIP_DOMCHGTYPE_BOUND:
+      bytes += sizeof(SCIP_DOMCHGBOUND) + domchg->domchgbound.nboundchgs * sizeof(SCIP_BOUNDCHG);
+      break;
+   case SCIP_DOMCHGTYPE_BOTH:
+      bytes += sizeof(SCIP_DOMCHGBOTH) + domchg->domchgboth.nboundchgs * sizeof(SCIP_BOUNDCHG)
+         + domchg->domchgboth.nholechgs * sizeof(SCIP_HOLECHG);
+      break;
+   case SCIP_DOMCHGTYPE_DYNAMIC:
+      bytes += sizeof(SCIP_DOMCHGDYN) + domchg->domchgdyn.boundchgssize * sizeof(SCIP_BOUNDCHG)
+         + domchg->domchgdyn.holechgssize * sizeof(SCIP_HOLECHG);
+      break;
+   default:
+      SCIPerrorMessage("invalid domain change type %d\n", (int)domchg->domchgbound.domchgtype);
+      SCIPABORT();
+   }
+
+   return bytes;
+}
+
+/** counts a node pruned by a node pruner and the memory it frees, in the bucket of its depth */
+void SCIPeventhdlrtreememAddPrune(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< tree memory event handler */
+   SCIP_NODE*            node                /**< pruned node */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   int b;
+
+   assert(eventhdlr != NULL);
+   assert(node != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   b = getBucket(eventhdlrdata, SCIPnodeGetDepth(node));
+   eventhdlrdata->nprunes[b]++;
+   eventhdlrdata->prunebytes[b] += SCIPeventhdlrtreememGetNodeBytes(node);
+}
+
+/** gets the peak estimated memory in bytes of the open nodes in the current solve */
+SCIP_Longint SCIPeventhdlrtreememGetPeakBytes(
+   SCIP_EVENTHDLR*       eventhdlr           /**< tree memory event handler */
+   )
+{
+   assert(eventhdlr != NULL);
+   assert(SCIPeventhdlrGetData(eventhdlr) != NULL);
+
+   return SCIPeventhdlrGetData(eventhdlr)->peakbytes;
+}
+
+/** gets the estimated memory in bytes freed by pruned nodes in the current solve */
+SCIP_Longint SCIPeventhdlrtreememGetSavedBytes(
+   SCIP_EVENTHDLR*       eventhdlr           /**< tree memory event handler */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_Longint bytes;
+   int b;
+
+   assert(eventhdlr != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   bytes = 0;
+   for( b = 0; b < SCIP_TREEMEM_NBUCKETS; b++ )
+      bytes += eventhdlrdata->prunebytes[b];
+
+   return bytes;
+}
+
+void SCIPeventhdlrtreememPrintStatistics(
+   SCIP*                 scip,
+   SCIP_EVENTHDLR*       eventhdlr,
+   FILE*                 file
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   int b;
+
+   assert(scip != NULL);
+   assert(eventhdlr != NULL);
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Tree memory        :\n");
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  open nodes       : %10d (peak %d)\n", eventhdlrdata->nopen, eventhdlrdata->peakopen);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  samples          : %10"SCIP_LONGINT_FORMAT" (every %d nodes)\n", eventhdlrdata->nsamples,
+         eventhdlrdata->freq);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  bytes/open node  : %10.1f\n",
+         eventhdlrdata->nsampled > 0 ? (SCIP_Real)eventhdlrdata->sampledbytes / eventhdlrdata->nsampled : 0.0);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  peak tree (KB)   : %10.1f\n", eventhdlrdata->peakbytes / 1024.0);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  peak SCIP (KB)   : %10.1f\n", eventhdlrdata->peakmemused / 1024.0);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  saved by prunes  : %10.1f KB\n", SCIPeventhdlrtreememGetSavedBytes(eventhdlr) / 1024.0);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Pruned by depth    :     Prunes  Saved(KB)\n");
+   for( b = 0; b < SCIP_TREEMEM_NBUCKETS; b++ )
+   {
+      SCIPmessageFPrintInfo(scip->messagehdlr, file,
+            "  %3d%% - %3d%%     : %10"SCIP_LONGINT_FORMAT" %10.1f\n", 100 * b / SCIP_TREEMEM_NBUCKETS,
+            100 * (b + 1) / SCIP_TREEMEM_NBUCKETS, eventhdlrdata->nprunes[b], eventhdlrdata->prunebytes[b] / 1024.0);
+   }
+}
+
+/** creates the tree memory event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrTreemem(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+   int b;
+
+   /* create tree memory event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+
+   eventhdlr = NULL;
+   eventhdlrdata->file = NULL;
+   eventhdlrdata->filename = NULL;
+   eventhdlrdata->nfocused = 0;
+   eventhdlrdata->nsamples = 0;
+   eventhdlrdata->nsampled = 0;
+   eventhdlrdata->sampledbytes = 0;
+   eventhdlrdata->nopen = 0;
+   eventhdlrdata->peakopen = 0;
+   eventhdlrdata->bytes = 0;
+   eventhdlrdata->peakbytes = 0;
+   eventhdlrdata->peakmemused = 0;
+   eventhdlrdata->maxdepth = 1;
+   for( b = 0; b < SCIP_TREEMEM_NBUCKETS; b++ )
+   {
+      eventhdlrdata->nprunes[b] = 0;
+      eventhdlrdata->prunebytes[b] = 0;
+   }
+   eventhdlrdata->filterpos = -1;
+
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecTreemem,
+         eventhdlrdata) );
+
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeTreemem) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolTreemem) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolTreemem) );
+
+   /* add tree memory event handler parameters */
+   SCIP_CALL( SCIPaddBoolParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/active",
+         "sample the memory of the open nodes and count the memory freed by pruned nodes?",
+         &eventhdlrdata->active, FALSE, DEFAULT_ACTIVE, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/freq",
+         "sample the open nodes every this number of selected nodes",
+         &eventhdlrdata->freq, FALSE, DEFAULT_FREQ, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "eventhdlr/"EVENTHDLR_NAME"/filename",
+         "file to write the samples of each solve to as CSV, or - for no file",
+         &eventhdlrdata->filename, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,73 @@
+/**@file   eventhdlr_treemem.h
+ * @ingroup EVENTS
+ * @brief  event handler which samples the memory of the open nodes and counts the memory freed by pruned nodes
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENTHDLR_TREEMEM_H__
+#define __SCIP_EVENTHDLR_TREEMEM_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCIP_TREEMEM_NBUCKETS       10   /**< number of depth buckets of the pruned nodes */
+
+/** creates the tree memory event handler and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeEventhdlrTreemem(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** returns the tree memory event handler if it is included and active, or NULL; the node pruners look it up when the
+ *  solve starts and report their prunes only if it is not NULL
+ */
+EXTERN
+SCIP_EVENTHDLR* SCIPeventhdlrtreememFind(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** counts a node pruned by a node pruner and the memory it frees, in the bucket of its depth */
+EXTERN
+void SCIPeventhdlrtreememAddPrune(
+   SCIP_EVENTHDLR*       eventhdlr,          /**< tree memory event handler */
+   SCIP_NODE*            node                /**< pruned node */
+   );
+
+/** gets the estimated memory in bytes of a node while it is open: the node, its slot in the node queue and its
+ *  domain changes
+ */
+EXTERN
+SCIP_Longint SCIPeventhdlrtreememGetNodeBytes(
+   SCIP_NODE*            node                /**< node */
+   );
+
+/** gets the peak estimated memory in bytes of the open nodes in the current solve */
+EXTERN
+SCIP_Longint SCIPeventhdlrtreememGetPeakBytes(
+   SCIP_EVENTHDLR*       eventhdlr           /**< tree memory event handler */
+   );
+
+/** gets the estimated memory in bytes freed by pruned nodes in the current solve */
+EXTERN
+SCIP_Longint SCIPeventhdlrtreememGetSavedBytes(
+   SCIP_EVENTHDLR*       eventhdlr           /**< tree memory event handler */
+   );
+
+EXTERN
+void SCIPeventhdlrtreememPrintStatistics(
+   SCIP*                 scip,
+   SCIP_EVENTHDLR*       eventhdlr,
+   FILE*                 file
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
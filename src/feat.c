@@ -8,6 +8,8 @@
 #include "scip/def.h"
 #include "feat.h"
 #include "struct_feat.h"
+#include "eventhdlr_effort.h"
+#include "eventhdlr_latency.h"
 #include "scip/tree.h"
 #include "scip/var.h"
 #include "scip/stat.h"
@@ -15,6 +17,24 @@
 #include "scip/struct_scip.h"
 #include "math.h"
 
+/** is the feature with the given index masked, i.e., neither computed nor used? */
+#define FEATMASKED(feat, i)     (((feat)->mask >> (i)) & 1U)
+
+/** sets the masked features to zero */
+static
+void featZeroMasked(
+   SCIP_FEAT*        feat
+   )
+{
+   int i;
+
+   for( i = 0; i < feat->size; i++ )
+   {
+      if( FEATMASKED(feat, i) )
+         feat->vals[i] = 0.0;
+   }
+}
+
 /** copy feature vector value */
 void SCIPfeatCopy(
    SCIP_FEAT*           feat,
@@ -35,6 +55,8 @@ void SCIPfeatCopy(
    sourcefeat->rootlpobj = feat->rootlpobj;
    sourcefeat->sumobjcoeff = feat->sumobjcoeff;
    sourcefeat->nconstrs = feat->nconstrs;
+   sourcefeat->mask = feat->mask;
+   sourcefeat->nmasked = feat->nmasked;
 
    for( i = 0; i < feat->size; i++ )
       sourcefeat->vals[i] = feat->vals[i];
@@ -65,6 +87,10 @@ SCIP_RETCODE SCIPfeatCreate(
    (*feat)->depth = 0;
    (*feat)->size = size;
    (*feat)->boundtype = 0;
+   (*feat)->mask = 0;
+   (*feat)->nmasked = 0;
+   (*feat)->effort = SCIPfindEventhdlr(scip, "effort");
+   (*feat)->latency = SCIPeventhdlrlatencyFind(scip);
 
    return SCIP_OKAY;
 }
@@ -102,12 +128,17 @@ void SCIPcalcNodepruFeat(
    SCIP_Bool haslp;
    SCIP_Real varsol;
    SCIP_Real varrootsol;
+   SCIP_Longint start;
 
    assert(node != NULL);
    assert(SCIPnodeGetDepth(node) != 0);
    assert(feat != NULL);
    assert(feat->maxdepth != 0);
 
+   start = feat->latency != NULL ? SCIPeventhdlrlatencyStart(feat->latency, SCIP_LATENCYHOOK_PRUFEAT) : 0;
+   if( feat->effort != NULL )
+      SCIPeventhdlreffortAddFeat(feat->effort, feat->size - feat->nmasked);
+
    boundchgs = node->domchg->domchgbound.boundchgs;
    assert(boundchgs != NULL);
    assert(boundchgs[0].boundchgtype == SCIP_BOUNDCHGTYPE_BRANCHING);
@@ -150,41 +181,61 @@ void SCIPcalcNodepruFeat(
    else
       feat->vals[SCIP_FEATNODEPRU_GAP] = (upperbound - lowerbound)/REALABS(lowerbound);
 
-   feat->vals[SCIP_FEATNODEPRU_GLOBALLOWERBOUND] = lowerbound / rootlowerbound;
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_GLOBALLOWERBOUND) )
+      feat->vals[SCIP_FEATNODEPRU_GLOBALLOWERBOUND] = lowerbound / rootlowerbound;
    if( upperboundinf )
       feat->vals[SCIP_FEATNODEPRU_GLOBALUPPERBOUNDINF] = 1;
-   else
+   else if( !FEATMASKED(feat, SCIP_FEATNODEPRU_GLOBALUPPERBOUND) )
       feat->vals[SCIP_FEATNODEPRU_GLOBALUPPERBOUND] = upperbound / rootlowerbound;
 
-   feat->vals[SCIP_FEATNODEPRU_NSOLUTION] = SCIPgetNSolsFound(scip);
-   feat->vals[SCIP_FEATNODEPRU_PLUNGEDEPTH] = SCIPgetPlungeDepth(scip);
-   feat->vals[SCIP_FEATNODEPRU_RELATIVEDEPTH] = (SCIP_Real)feat->depth / (SCIP_Real)feat->maxdepth * 10.0;
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_NSOLUTION) )
+      feat->vals[SCIP_FEATNODEPRU_NSOLUTION] = SCIPgetNSolsFound(scip);
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_PLUNGEDEPTH) )
+      feat->vals[SCIP_FEATNODEPRU_PLUNGEDEPTH] = SCIPgetPlungeDepth(scip);
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_RELATIVEDEPTH) )
+      feat->vals[SCIP_FEATNODEPRU_RELATIVEDEPTH] = (SCIP_Real)feat->depth / (SCIP_Real)feat->maxdepth * 10.0;
 
    /* node features */
    if( upperboundinf )
       upperbound = lowerbound + 0.2 * (upperbound - lowerbound);
    if( !SCIPsetIsEQ(scip->set, upperbound, lowerbound) )
    {
-      feat->vals[SCIP_FEATNODEPRU_RELATIVEBOUND] = (SCIPnodeGetLowerbound(node) - lowerbound) / (upperbound - lowerbound);
-      feat->vals[SCIP_FEATNODEPRU_RELATIVEESTIMATE] = (SCIPnodeGetEstimate(node) - lowerbound)/ (upperbound - lowerbound);
+      if( !FEATMASKED(feat, SCIP_FEATNODEPRU_RELATIVEBOUND) )
+         feat->vals[SCIP_FEATNODEPRU_RELATIVEBOUND] = (SCIPnodeGetLowerbound(node) - lowerbound)
+            / (upperbound - lowerbound);
+      if( !FEATMASKED(feat, SCIP_FEATNODEPRU_RELATIVEESTIMATE) )
+         feat->vals[SCIP_FEATNODEPRU_RELATIVEESTIMATE] = (SCIPnodeGetEstimate(node) - lowerbound)
+            / (upperbound - lowerbound);
    }
 
    /* branch var features */
-   feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_BOUNDLPDIFF] = branchbound - varsol;
-   feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_ROOTLPDIFF] = varrootsol - varsol;
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_BRANCHVAR_BOUNDLPDIFF) )
+      feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_BOUNDLPDIFF] = branchbound - varsol;
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_BRANCHVAR_ROOTLPDIFF) )
+      feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_ROOTLPDIFF] = varrootsol - varsol;
 
    if( branchdirpreferred == SCIP_BRANCHDIR_DOWNWARDS )
       feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_PRIO_DOWN] = 1;
    else if(branchdirpreferred == SCIP_BRANCHDIR_UPWARDS ) 
       feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_PRIO_UP] = 1;
 
-   feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_PSEUDOCOST] = SCIPvarGetPseudocost(branchvar, scip->stat, branchbound - varsol);
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_BRANCHVAR_PSEUDOCOST) )
+      feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_PSEUDOCOST] = SCIPvarGetPseudocost(branchvar, scip->stat,
+         branchbound - varsol);
    /*fprintf(stderr, "%d cost: %f, varobj: %f", (int)SCIP_FEATNODEPRU_BRANCHVAR_PSEUDOCOST, SCIPvarGetPseudocost(branchvar, scip->stat, branchbound - varsol), varobj);*/
 
-   feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_INF] = 
-      feat->boundtype == SCIP_BOUNDTYPE_LOWER ? 
-      SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_UPWARDS) / (SCIP_Real)feat->maxdepth : 
-      SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_DOWNWARDS) / (SCIP_Real)feat->maxdepth;
+   if( !FEATMASKED(feat, SCIP_FEATNODEPRU_BRANCHVAR_INF) )
+      feat->vals[SCIP_FEATNODEPRU_BRANCHVAR_INF] = 
+         feat->boundtype == SCIP_BOUNDTYPE_LOWER ? 
+         SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_UPWARDS) / (SCIP_Real)feat->maxdepth : 
+         SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_DOWNWARDS) / (SCIP_Real)feat->maxdepth;
+
+   /* the gap and indicator features are set without looking at the mask */
+   if( feat->mask != 0 )
+      featZeroMasked(feat);
+
+   if( feat->latency != NULL )
+      SCIPeventhdlrlatencyAdd(feat->latency, SCIP_LATENCYHOOK_PRUFEAT, start);
 }
 
 /** calculate feature values for the node selector of this node */
@@ -207,12 +258,17 @@ void SCIPcalcNodeselFeat(
    SCIP_Bool upperboundinf;
    SCIP_Real varsol;
    SCIP_Real varrootsol;
+   SCIP_Longint start;
 
    assert(node != NULL);
    assert(SCIPnodeGetDepth(node) != 0);
    assert(feat != NULL);
    assert(feat->maxdepth != 0);
 
+   start = feat->latency != NULL ? SCIPeventhdlrlatencyStart(feat->latency, SCIP_LATENCYHOOK_SELFEAT) : 0;
+   if( feat->effort != NULL )
+      SCIPeventhdlreffortAddFeat(feat->effort, feat->size - feat->nmasked);
+
    boundchgs = node->domchg->domchgbound.boundchgs;
    assert(boundchgs != NULL);
    assert(boundchgs[0].boundchgtype == SCIP_BOUNDCHGTYPE_BRANCHING);
@@ -248,11 +304,13 @@ void SCIPcalcNodeselFeat(
       /* use only 20% of the gap as upper bound */
       upperbound = lowerbound + 0.2 * (upperbound - lowerbound);
    }
-   else
+   else if( !FEATMASKED(feat, SCIP_FEATNODESEL_GLOBALUPPERBOUND) )
       feat->vals[SCIP_FEATNODESEL_GLOBALUPPERBOUND] = upperbound / rootlowerbound;
 
-   feat->vals[SCIP_FEATNODESEL_PLUNGEDEPTH] = SCIPgetPlungeDepth(scip);
-   feat->vals[SCIP_FEATNODESEL_RELATIVEDEPTH] = (SCIP_Real)feat->depth / (SCIP_Real)feat->maxdepth * 10.0;
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_PLUNGEDEPTH) )
+      feat->vals[SCIP_FEATNODESEL_PLUNGEDEPTH] = SCIPgetPlungeDepth(scip);
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_RELATIVEDEPTH) )
+      feat->vals[SCIP_FEATNODESEL_RELATIVEDEPTH] = (SCIP_Real)feat->depth / (SCIP_Real)feat->maxdepth * 10.0;
 
 
    /* currently only support branching on one variable */
@@ -267,13 +325,15 @@ void SCIPcalcNodeselFeat(
    feat->boundtype = boundchgs[0].boundtype;
 
    /* calculate features */
-   feat->vals[SCIP_FEATNODESEL_LOWERBOUND] = 
-      nodelowerbound / rootlowerbound;
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_LOWERBOUND) )
+      feat->vals[SCIP_FEATNODESEL_LOWERBOUND] = 
+         nodelowerbound / rootlowerbound;
 
-   feat->vals[SCIP_FEATNODESEL_ESTIMATE] = 
-      SCIPnodeGetEstimate(node) / rootlowerbound;
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_ESTIMATE) )
+      feat->vals[SCIP_FEATNODESEL_ESTIMATE] = 
+         SCIPnodeGetEstimate(node) / rootlowerbound;
 
-   if( !SCIPsetIsEQ(scip->set, upperbound, lowerbound) )
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_RELATIVEBOUND) && !SCIPsetIsEQ(scip->set, upperbound, lowerbound) )
       feat->vals[SCIP_FEATNODESEL_RELATIVEBOUND] = (nodelowerbound - lowerbound) / (upperbound - lowerbound);
 
    if( nodetype == SCIP_NODETYPE_SIBLING )
@@ -283,22 +343,32 @@ void SCIPcalcNodeselFeat(
    else if( nodetype == SCIP_NODETYPE_LEAF )
       feat->vals[SCIP_FEATNODESEL_TYPE_LEAF] = 1;
 
-   feat->vals[SCIP_FEATNODESEL_BRANCHVAR_BOUNDLPDIFF] = branchbound - varsol;
-   feat->vals[SCIP_FEATNODESEL_BRANCHVAR_ROOTLPDIFF] = varrootsol - varsol;
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_BRANCHVAR_BOUNDLPDIFF) )
+      feat->vals[SCIP_FEATNODESEL_BRANCHVAR_BOUNDLPDIFF] = branchbound - varsol;
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_BRANCHVAR_ROOTLPDIFF) )
+      feat->vals[SCIP_FEATNODESEL_BRANCHVAR_ROOTLPDIFF] = varrootsol - varsol;
 
    if( branchdirpreferred == SCIP_BRANCHDIR_DOWNWARDS )
       feat->vals[SCIP_FEATNODESEL_BRANCHVAR_PRIO_DOWN] = 1;
    else if(branchdirpreferred == SCIP_BRANCHDIR_UPWARDS ) 
       feat->vals[SCIP_FEATNODESEL_BRANCHVAR_PRIO_UP] = 1;
 
-   feat->vals[SCIP_FEATNODESEL_BRANCHVAR_PSEUDOCOST] = SCIPvarGetPseudocost(branchvar, scip->stat, branchbound - varsol);
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_BRANCHVAR_PSEUDOCOST) )
+      feat->vals[SCIP_FEATNODESEL_BRANCHVAR_PSEUDOCOST] = SCIPvarGetPseudocost(branchvar, scip->stat,
+         branchbound - varsol);
 
-   feat->vals[SCIP_FEATNODESEL_BRANCHVAR_INF] = 
-      feat->boundtype == SCIP_BOUNDTYPE_LOWER ? 
-      SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_UPWARDS) / (SCIP_Real)feat->maxdepth : 
-      SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_DOWNWARDS) / (SCIP_Real)feat->maxdepth;
+   if( !FEATMASKED(feat, SCIP_FEATNODESEL_BRANCHVAR_INF) )
+      feat->vals[SCIP_FEATNODESEL_BRANCHVAR_INF] = 
+         feat->boundtype == SCIP_BOUNDTYPE_LOWER ? 
+         SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_UPWARDS) / (SCIP_Real)feat->maxdepth : 
+         SCIPvarGetAvgInferences(branchvar, scip->stat, SCIP_BRANCHDIR_DOWNWARDS) / (SCIP_Real)feat->maxdepth;
 
+   /* the gap, type and indicator features are set without looking at the mask */
+   if( feat->mask != 0 )
+      featZeroMasked(feat);
 
+   if( feat->latency != NULL )
+      SCIPeventhdlrlatencyAdd(feat->latency, SCIP_LATENCYHOOK_SELFEAT, start);
 }
 
 /** write feature vector diff (feat1 - feat2) in libsvm format */
@@ -482,6 +552,28 @@ void SCIPfeatSetNConstrs(
    feat->nconstrs = nconstrs;
 }
 
+/** sets the features which are neither computed nor used: bit i of the mask masks the feature with index i, e.g.
+ *  SCIP_FEATNODESEL_GAP; the masked features are zero
+ */
+void SCIPfeatSetMask(
+   SCIP_FEAT*    feat,
+   unsigned int  mask
+   )
+{
+   int i;
+
+   assert(feat != NULL);
+
+   feat->mask = mask;
+   feat->nmasked = 0;
+   for( i = 0; i < feat->size; i++ )
+   {
+      if( FEATMASKED(feat, i) )
+         feat->nmasked++;
+   }
+   featZeroMasked(feat);
+}
+
 /** returns the weight of the example */
 SCIP_Real SCIPfeatGetWeight(
    SCIP_FEAT* feat
@@ -497,6 +589,79 @@ int SCIPfeatGetOffset(
    )
 {
    assert(feat != NULL);
-   return (feat->size * 2) * (feat->depth / (feat->maxdepth / 10)) + (feat->size * (int)feat->boundtype);
+   return feat->size * SCIPfeatCalcBucket(feat->depth, feat->maxdepth, feat->boundtype);
+}
+
+/** returns offset of the feature index of a node with the given depth and bound type */
+int SCIPfeatCalcOffset(
+   int               size,
+   int               depth,
+   int               maxdepth,
+   SCIP_BOUNDTYPE    boundtype
+   )
+{
+   return size * SCIPfeatCalcBucket(depth, maxdepth, boundtype);
+}
+
+/** returns the depth bucket of a node with the given depth and bound type; the policy weights of its features start
+ *  at the feature size times the bucket; problems with a maximum depth below 10 get one bucket per depth
+ *
+ *  Branching on general integers can create nodes deeper than the maximum depth, they are in the last bucket.
+ */
+int SCIPfeatCalcBucket(
+   int               depth,
+   int               maxdepth,
+   SCIP_BOUNDTYPE    boundtype
+   )
+{
+   return 2 * (MIN(depth, maxdepth) / MAX(maxdepth / 10, 1)) + (int)boundtype;
+}
+
+/** returns the number of depth buckets of a problem with the given maximum depth */
+int SCIPfeatCalcNBuckets(
+   int               maxdepth
+   )
+{
+   return SCIPfeatCalcBucket(maxdepth, maxdepth, SCIP_BOUNDTYPE_UPPER) + 1;
+}
+
+/** gets the smallest and the largest depth of the nodes in a depth bucket */
+void SCIPfeatCalcBucketDepths(
+   int               bucket,
+   int               maxdepth,
+   int*              mindepth,
+   int*              lastdepth
+   )
+{
+   int width;
+
+   assert(bucket >= 0);
+   assert(mindepth != NULL);
+   assert(lastdepth != NULL);
+
+   width = MAX(maxdepth / 10, 1);
+   *mindepth = (bucket / 2) * width;
+   *lastdepth = MIN(*mindepth + width - 1, maxdepth);
+}
+
+/** returns the bound type of the branching that created a node, which selects the bucket of its features */
+SCIP_BOUNDTYPE SCIPfeatCalcNodeBoundtype(
+   SCIP_NODE*        node
+   )
+{
+   assert(node != NULL);
+   assert(SCIPnodeGetDepth(node) != 0);
+   assert(node->domchg->domchgbound.boundchgs != NULL);
+
+   return (SCIP_BOUNDTYPE)node->domchg->domchgbound.boundchgs[0].boundtype;
+}
+
+/** returns the depth bucket of the node of the feature vector */
+int SCIPfeatGetBucket(
+   SCIP_FEAT* feat
+   )
+{
+   assert(feat != NULL);
+   return SCIPfeatCalcBucket(feat->depth, feat->maxdepth, feat->boundtype);
 }
 
@@ -65,6 +65,53 @@ int SCIPfeatGetOffset(
    SCIP_FEAT* feat
    );
 
+/** returns offset of the feature index of a node with the given depth and bound type */
+extern
+int SCIPfeatCalcOffset(
+   int               size,
+   int               depth,
+   int               maxdepth,
+   SCIP_BOUNDTYPE    boundtype
+   );
+
+/** returns the depth bucket of a node with the given depth and bound type; the policy weights of its features start
+ *  at the feature size times the bucket; problems with a maximum depth below 10 get one bucket per depth, and nodes
+ *  deeper than the maximum depth are in the last bucket
+ */
+extern
+int SCIPfeatCalcBucket(
+   int               depth,
+   int               maxdepth,
+   SCIP_BOUNDTYPE    boundtype
+   );
+
+/** returns the number of depth buckets of a problem with the given maximum depth */
+extern
+int SCIPfeatCalcNBuckets(
+   int               maxdepth
+   );
+
+/** gets the smallest and the largest depth of the nodes in a depth bucket */
+extern
+void SCIPfeatCalcBucketDepths(
+   int               bucket,
+   int               maxdepth,
+   int*              mindepth,
+   int*              lastdepth
+   );
+
+/** returns the bound type of the branching that created a node, which selects the bucket of its features */
+extern
+SCIP_BOUNDTYPE SCIPfeatCalcNodeBoundtype(
+   SCIP_NODE*        node
+   );
+
+/** returns the depth bucket of the node of the feature vector */
+extern
+int SCIPfeatGetBucket(
+   SCIP_FEAT* feat
+   );
+
 /** returns the weight of the example */
 extern
 SCIP_Real SCIPfeatGetWeight(
@@ -99,7 +146,8 @@ SCIP_RETCODE SCIPfeatFree(
  * speed up the algorithms.
  */
 
-#define SCIPfeatGetOffset(feat)     (feat->size * 2) * (feat->depth / (feat->maxdepth / 10)) + (feat->size * (int)feat->boundtype)
+#define SCIPfeatGetOffset(feat)     ((feat)->size * SCIPfeatCalcBucket((feat)->depth, (feat)->maxdepth, \
+      (feat)->boundtype))
 
 #endif
 
@@ -0,0 +1,155 @@
+/**@file   genmik.c
+ * @brief  generator of synthetic mixed-integer knapsack (MIK) problems
+ * @author He He
+ *
+ * The problems have the structure of mik.250-10-100.1 in sample-dat/train, so that the plugins can be benchmarked on
+ * the same family at larger sizes. A problem mik.N-M-K.<seed> minimizes over N integer and M continuous variables
+ * subject to K knapsack constraints
+ *
+ *    sum_j a_ij x_j + b_i z_i - 100 w_i - sum_k y_k <= r_i,   i = 1..K
+ *
+ * where the N - 2K integer variables x_j in [0,100] appear in all constraints (a_ij in [1,2000]), every constraint has
+ * its own binary z_i (b_i in {1000,1100,...,1800}) and integer w_i in [0,100] (cost 100), and r_i is in [950,1000].
+ * The x_j and the continuous y_k >= 0 are further bounded by constraints x_j <= u_j (u_j in [1,4]) and y_k <= v_k
+ * (v_k in [5,20]), as in the sample. The profits of x_j and z_i are negative costs, those of z_i correlated with b_i;
+ * the y_k have costs in [100,200].
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "genmik.h"
+
+/** creates the problem mik.<nintvars>-<ncontvars>-<nconss>.<seed> of the family of sample-dat/train; nintvars must be
+ *  larger than 2 * nconss
+ */
+SCIP_RETCODE SCIPcreateProbMik(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   nintvars,           /**< number of integer variables */
+   int                   ncontvars,          /**< number of continuous variables */
+   int                   nconss,             /**< number of knapsack constraints */
+   unsigned int          seed                /**< random seed */
+   )
+{
+   SCIP_VAR** xvars;
+   SCIP_VAR** yvars;
+   SCIP_VAR** consvars;
+   SCIP_Real* consvals;
+   SCIP_CONS* cons;
+   char name[SCIP_MAXSTRLEN];
+   int ndense;
+   int nconsvars;
+   int i;
+   int j;
+
+   assert(scip != NULL);
+
+   if( nconss < 1 || ncontvars < 0 || nintvars <= 2 * nconss )
+   {
+      SCIPerrorMessage("invalid size %d-%d-%d of a MIK problem: need at least one constraint and more than two "
+         "integer variables per constraint\n", nintvars, ncontvars, nconss);
+      return SCIP_INVALIDDATA;
+   }
+
+   ndense = nintvars - 2 * nconss;
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "mik.%d-%d-%d.%u", nintvars, ncontvars, nconss, seed);
+   SCIP_CALL( SCIPcreateProbBasic(scip, name) );
+
+   SCIP_ALLOC( BMSallocMemoryArray(&xvars, ndense) );
+   SCIP_ALLOC( BMSallocMemoryArray(&yvars, MAX(ncontvars, 1)) );
+   SCIP_ALLOC( BMSallocMemoryArray(&consvars, ndense + ncontvars + 2) );
+   SCIP_ALLOC( BMSallocMemoryArray(&consvals, ndense + ncontvars + 2) );
+
+   for( j = 0; j < ncontvars; j++ )
+   {
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "y%d", j);
+      SCIP_CALL( SCIPcreateVarBasic(scip, &yvars[j], name, 0.0, SCIPinfinity(scip),
+            (SCIP_Real)SCIPgetRandomInt(100, 200, &seed), SCIP_VARTYPE_CONTINUOUS) );
+      SCIP_CALL( SCIPaddVar(scip, yvars[j]) );
+   }
+   for( j = 0; j < ndense; j++ )
+   {
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "x%d", j);
+      SCIP_CALL( SCIPcreateVarBasic(scip, &xvars[j], name, 0.0, 100.0, (SCIP_Real)-SCIPgetRandomInt(1, 1700, &seed),
+            SCIP_VARTYPE_INTEGER) );
+      SCIP_CALL( SCIPaddVar(scip, xvars[j]) );
+   }
+
+   /* knapsack constraints, each with its own binary and integer variable */
+   for( i = 0; i < nconss; i++ )
+   {
+      SCIP_VAR* zvar;
+      SCIP_VAR* wvar;
+      int weight;
+
+      weight = 100 * SCIPgetRandomInt(10, 18, &seed);
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "z%d", i);
+      SCIP_CALL( SCIPcreateVarBasic(scip, &zvar, name, 0.0, 1.0,
+            -SCIPfloor(scip, weight * SCIPgetRandomReal(0.5, 1.0, &seed)), SCIP_VARTYPE_BINARY) );
+      SCIP_CALL( SCIPaddVar(scip, zvar) );
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "w%d", i);
+      SCIP_CALL( SCIPcreateVarBasic(scip, &wvar, name, 0.0, 100.0, 100.0, SCIP_VARTYPE_INTEGER) );
+      SCIP_CALL( SCIPaddVar(scip, wvar) );
+
+      nconsvars = 0;
+      for( j = 0; j < ncontvars; j++ )
+      {
+         consvars[nconsvars] = yvars[j];
+         consvals[nconsvars++] = -1.0;
+      }
+      consvars[nconsvars] = zvar;
+      consvals[nconsvars++] = (SCIP_Real)weight;
+      for( j = 0; j < ndense; j++ )
+      {
+         consvars[nconsvars] = xvars[j];
+         consvals[nconsvars++] = (SCIP_Real)SCIPgetRandomInt(1, 2000, &seed);
+      }
+      consvars[nconsvars] = wvar;
+      consvals[nconsvars++] = -100.0;
+
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "knap%d", i);
+      SCIP_CALL( SCIPcreateConsBasicLinear(scip, &cons, name, nconsvars, consvars, consvals, -SCIPinfinity(scip),
+            (SCIP_Real)SCIPgetRandomInt(950, 1000, &seed)) );
+      SCIP_CALL( SCIPaddCons(scip, cons) );
+      SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+      SCIP_CALL( SCIPreleaseVar(scip, &wvar) );
+      SCIP_CALL( SCIPreleaseVar(scip, &zvar) );
+   }
+
+   /* the tight bounds are constraints, as in the sample */
+   consvals[0] = 1.0;
+   for( j = 0; j < ndense; j++ )
+   {
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "ubx%d", j);
+      SCIP_CALL( SCIPcreateConsBasicLinear(scip, &cons, name, 1, &xvars[j], consvals, -SCIPinfinity(scip),
+            (SCIP_Real)SCIPgetRandomInt(1, 4, &seed)) );
+      SCIP_CALL( SCIPaddCons(scip, cons) );
+      SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+   }
+   for( j = 0; j < ncontvars; j++ )
+   {
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "uby%d", j);
+      SCIP_CALL( SCIPcreateConsBasicLinear(scip, &cons, name, 1, &yvars[j], consvals, -SCIPinfinity(scip),
+            (SCIP_Real)SCIPgetRandomInt(5, 20, &seed)) );
+      SCIP_CALL( SCIPaddCons(scip, cons) );
+      SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+   }
+
+   for( j = 0; j < ndense; j++ )
+   {
+      SCIP_CALL( SCIPreleaseVar(scip, &xvars[j]) );
+   }
+   for( j = 0; j < ncontvars; j++ )
+   {
+      SCIP_CALL( SCIPreleaseVar(scip, &yvars[j]) );
+   }
+   BMSfreeMemoryArray(&consvals);
+   BMSfreeMemoryArray(&consvars);
+   BMSfreeMemoryArray(&yvars);
+   BMSfreeMemoryArray(&xvars);
+
+   return SCIP_OKAY;
+}
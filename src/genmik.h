@@ -0,0 +1,34 @@
+/**@file   genmik.h
+ * @brief  generator of synthetic mixed-integer knapsack (MIK) problems
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_GENMIK_H__
+#define __SCIP_GENMIK_H__
+
+#include "scip/def.h"
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the problem mik.<nintvars>-<ncontvars>-<nconss>.<seed> of the family of sample-dat/train; nintvars must be
+ *  larger than 2 * nconss
+ */
+extern
+SCIP_RETCODE SCIPcreateProbMik(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   nintvars,           /**< number of integer variables */
+   int                   ncontvars,          /**< number of continuous variables */
+   int                   nconss,             /**< number of knapsack constraints */
+   unsigned int          seed                /**< random seed */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
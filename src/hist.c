@@ -0,0 +1,214 @@
+/**@file   hist.c
+ * @brief  methods for latency histograms
+ * @author He He
+ *
+ * The histograms are meant for callbacks that take tens of nanoseconds, such as node comparisons, so adding a value
+ * only increments a counter: the bucket of a value is its most significant bit plus the SCIP_HIST_SUBBITS bits below
+ * it. Values below 2^SCIP_HIST_SUBBITS have a bucket each. Quantiles are exact up to the bucket width.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "hist.h"
+
+#define SUBMASK                 ((1 << SCIP_HIST_SUBBITS) - 1)
+
+/** returns the position of the most significant bit of a positive value */
+static
+int mostSignificantBit(
+   SCIP_Longint          value               /**< positive value */
+   )
+{
+#ifdef __GNUC__
+   return 63 - __builtin_clzll((unsigned long long)value);
+#else
+   int msb = 0;
+
+   while( (value >> msb) > 1 )
+      msb++;
+   return msb;
+#endif
+}
+
+/** returns the bucket of a value */
+static
+int bucketIndex(
+   SCIP_Longint          value               /**< non-negative value */
+   )
+{
+   int shift;
+
+   if( value <= SUBMASK )
+      return (int)value;
+
+   shift = mostSignificantBit(value) - SCIP_HIST_SUBBITS;
+   return ((shift + 1) << SCIP_HIST_SUBBITS) | (int)((value >> shift) & SUBMASK);
+}
+
+/** returns the smallest value of a bucket */
+static
+SCIP_Longint bucketLowerBound(
+   int                   bucket              /**< bucket */
+   )
+{
+   int shift;
+
+   if( bucket <= SUBMASK )
+      return bucket;
+
+   shift = (bucket >> SCIP_HIST_SUBBITS) - 1;
+   return (SCIP_Longint)((1 << SCIP_HIST_SUBBITS) | (bucket & SUBMASK)) << shift;
+}
+
+/** returns the largest value of a bucket */
+static
+SCIP_Longint bucketUpperBound(
+   int                   bucket              /**< bucket */
+   )
+{
+   SCIP_Longint lower;
+   SCIP_Longint width;
+
+   if( bucket <= SUBMASK )
+      return bucket;
+
+   lower = bucketLowerBound(bucket);
+   width = (SCIP_Longint)1 << ((bucket >> SCIP_HIST_SUBBITS) - 1);
+   return lower + MIN(width - 1, SCIP_LONGINT_MAX - lower);
+}
+
+/** returns the time of a monotonic clock in nanoseconds, to be subtracted from a later call */
+SCIP_Longint SCIPhistGetTime(
+   void
+   )
+{
+#ifdef CLOCK_MONOTONIC
+   struct timespec ts;
+
+   (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (SCIP_Longint)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#else
+   struct timeval tv;
+
+   (void) gettimeofday(&tv, NULL);
+   return (SCIP_Longint)tv.tv_sec * 1000000000LL + tv.tv_usec * 1000LL;
+#endif
+}
+
+/** removes all values from the histogram */
+void SCIPhistClear(
+   SCIP_HIST*           hist
+   )
+{
+   assert(hist != NULL);
+
+   memset(hist->counts, 0, sizeof(hist->counts));
+   hist->count = 0;
+   hist->total = 0;
+   hist->min = -1;
+   hist->max = -1;
+}
+
+/** adds a value to the histogram */
+void SCIPhistAdd(
+   SCIP_HIST*           hist,
+   SCIP_Longint         value
+   )
+{
+   assert(hist != NULL);
+
+   /* a clock that went backwards */
+   if( value < 0 )
+      value = 0;
+
+   hist->counts[bucketIndex(value)]++;
+   hist->count++;
+   hist->total += value;
+   if( hist->min < 0 || value < hist->min )
+      hist->min = value;
+   if( value > hist->max )
+      hist->max = value;
+}
+
+/** returns the smallest value such that at least the fraction q of the values is not larger, up to the bucket width,
+ *  or -1 if the histogram is empty
+ */
+SCIP_Longint SCIPhistGetQuantile(
+   SCIP_HIST*           hist,
+   SCIP_Real            q
+   )
+{
+   SCIP_Longint rank;
+   SCIP_Longint seen;
+   int b;
+
+   assert(hist != NULL);
+   assert(0.0 <= q && q <= 1.0);
+
+   if( hist->count == 0 )
+      return -1;
+
+   rank = (SCIP_Longint)(q * hist->count + 0.5);
+   rank = MAX(rank, 1);
+   seen = 0;
+   for( b = 0; b < SCIP_HIST_NBUCKETS; b++ )
+   {
+      seen += hist->counts[b];
+      if( seen >= rank )
+         return MIN(bucketUpperBound(b), hist->max);
+   }
+
+   return hist->max;
+}
+
+/** returns the mean of the values, or 0 if the histogram is empty */
+SCIP_Real SCIPhistGetMean(
+   SCIP_HIST*           hist
+   )
+{
+   assert(hist != NULL);
+
+   return hist->count == 0 ? 0.0 : (SCIP_Real)hist->total / hist->count;
+}
+
+/** writes the histogram as a JSON object with its count, total, minimum, maximum, mean, quantiles and non-empty
+ *  buckets [lower bound, count]
+ */
+void SCIPhistWriteJson(
+   SCIP_HIST*           hist,
+   FILE*                file
+   )
+{
+   SCIP_Bool first;
+   int b;
+
+   assert(hist != NULL);
+   assert(file != NULL);
+
+   fprintf(file, "{\"count\":%"SCIP_LONGINT_FORMAT",\"total_ns\":%"SCIP_LONGINT_FORMAT, hist->count, hist->total);
+   if( hist->count > 0 )
+   {
+      fprintf(file, ",\"min_ns\":%"SCIP_LONGINT_FORMAT",\"max_ns\":%"SCIP_LONGINT_FORMAT",\"mean_ns\":%.1f",
+         hist->min, hist->max, SCIPhistGetMean(hist));
+      fprintf(file, ",\"p50_ns\":%"SCIP_LONGINT_FORMAT",\"p90_ns\":%"SCIP_LONGINT_FORMAT",\"p99_ns\":%"
+         SCIP_LONGINT_FORMAT",\"p999_ns\":%"SCIP_LONGINT_FORMAT, SCIPhistGetQuantile(hist, 0.5),
+         SCIPhistGetQuantile(hist, 0.9), SCIPhistGetQuantile(hist, 0.99), SCIPhistGetQuantile(hist, 0.999));
+   }
+
+   fprintf(file, ",\"buckets\":[");
+   first = TRUE;
+   for( b = 0; b < SCIP_HIST_NBUCKETS; b++ )
+   {
+      if( hist->counts[b] == 0 )
+         continue;
+      fprintf(file, "%s[%"SCIP_LONGINT_FORMAT",%"SCIP_LONGINT_FORMAT"]", first ? "" : ",", bucketLowerBound(b),
+         hist->counts[b]);
+      first = FALSE;
+   }
+   fprintf(file, "]}");
+}
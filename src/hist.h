@@ -0,0 +1,67 @@
+/**@file   hist.h
+ * @brief  methods for latency histograms
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HIST_H__
+#define __SCIP_HIST_H__
+
+#include <stdio.h>
+
+#include "scip/def.h"
+#include "struct_hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** returns the time of a monotonic clock in nanoseconds, to be subtracted from a later call */
+extern
+SCIP_Longint SCIPhistGetTime(
+   void
+   );
+
+/** removes all values from the histogram */
+extern
+void SCIPhistClear(
+   SCIP_HIST*           hist
+   );
+
+/** adds a value to the histogram */
+extern
+void SCIPhistAdd(
+   SCIP_HIST*           hist,
+   SCIP_Longint         value
+   );
+
+/** returns the smallest value such that at least the fraction q of the values is not larger, up to the bucket width,
+ *  or -1 if the histogram is empty
+ */
+extern
+SCIP_Longint SCIPhistGetQuantile(
+   SCIP_HIST*           hist,
+   SCIP_Real            q
+   );
+
+/** returns the mean of the values, or 0 if the histogram is empty */
+extern
+SCIP_Real SCIPhistGetMean(
+   SCIP_HIST*           hist
+   );
+
+/** writes the histogram as a JSON object with its count, total, minimum, maximum, mean, quantiles and non-empty
+ *  buckets [lower bound, count]
+ */
+extern
+void SCIPhistWriteJson(
+   SCIP_HIST*           hist,
+   FILE*                file
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
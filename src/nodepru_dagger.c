@@ -15,11 +15,16 @@
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 #include <assert.h>
+#include <stdio.h>
 #include <string.h>
 #include "nodepru_dagger.h"
 #include "nodepru_oracle.h"
 #include "nodesel_oracle.h"
 #include "feat.h"
+#include "eventhdlr_latency.h"
+#include "eventhdlr_trace.h"
+#include "probes.h"
+#include "dataset.h"
 #include "policy.h"
 #include "struct_policy.h"
 #include "scip/sol.h"
@@ -35,6 +40,12 @@
 
 #define DEFAULT_FILENAME        ""
 
+#define BUCKET_NCOUNTS          4        /**< number of counts per depth bucket */
+#define BUCKET_NNODES           0        /**< index of the nodes checked in the counts of a bucket */
+#define BUCKET_NPRUNES          1        /**< index of the nodes pruned in the counts of a bucket */
+#define BUCKET_NFALSEPOS        2        /**< index of the optimal nodes pruned in the counts of a bucket */
+#define BUCKET_NFALSENEG        3        /**< index of the non-optimal nodes not pruned in the counts of a bucket */
+
 /*
  * Data structures
  */
@@ -49,14 +60,24 @@ struct SCIP_NodepruData
    char*              trjfname;           /**< name of the trajectory file */
    FILE*              wfile;
    FILE*              trjfile;
+   SCIP_DATASET*      dataset;            /**< in-memory trajectory store, or NULL */
+   SCIP_Longint       trjstart;           /**< trajectory bytes when the solve started */
+   SCIP_POLICY*       inpolicy;           /**< policy to use instead of reading polfname, or NULL */
    SCIP_FEAT*         feat;
    SCIP_Bool          checkopt;           /**< need to check node optimality? (don't need to if node selector is oracle or dagger */
    int                nprunes;            /**< number of nodes pruned */
    int                nnodes;             /**< number of nodes checked */
    int                nfalsepos;           /**< number of optimal nodes pruned */
    int                nfalseneg;           /**< number of non-optimal nodes not pruned */
+   char*              bucketfname;        /**< name of the file to append the statistics per depth bucket to */
+   int*               bucketcounts;       /**< nodes checked, nodes pruned, optimal nodes pruned and non-optimal nodes
+                                           *   not pruned (BUCKET_NCOUNTS) per depth bucket */
+   int                nbuckets;           /**< number of depth buckets */
+   int                maxdepth;           /**< maximum depth of the depth buckets */
    unsigned int       randseed;
 
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
+   SCIP_EVENTHDLR*    trace;              /**< trace event handler with a trace file, or NULL */
 };
 
 void SCIPnodeprudaggerPrintStatistics(
@@ -66,6 +87,7 @@ void SCIPnodeprudaggerPrintStatistics(
    )
 {
    SCIP_NODEPRUDATA* nodeprudata;
+   int b;
 
    assert(scip != NULL);
    assert(nodepru != NULL);
@@ -83,6 +105,87 @@ void SCIPnodeprudaggerPrintStatistics(
          "  FN pruned        : %d/%d\n", nodeprudata->nfalseneg, nodeprudata->nnodes);
    SCIPmessageFPrintInfo(scip->messagehdlr, file,
          "  pruning time     : %10.2f\n", SCIPnodepruGetTime(nodepru));
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  by depth bucket  :      nodes     pruned         FP         FN\n");
+   for( b = 0; b < nodeprudata->nbuckets; b++ )
+   {
+      int* counts;
+      int mindepth;
+      int lastdepth;
+
+      counts = &nodeprudata->bucketcounts[b * BUCKET_NCOUNTS];
+      if( counts[BUCKET_NNODES] == 0 )
+         continue;
+      SCIPpolicyCalcBucketDepths(nodeprudata->policy, b, nodeprudata->maxdepth, &mindepth, &lastdepth);
+      SCIPmessageFPrintInfo(scip->messagehdlr, file,
+            "  %2d %5d-%-5d %c : %10d %10d %10d %10d\n", b, mindepth, lastdepth,
+            b % 2 == SCIP_BOUNDTYPE_LOWER ? 'L' : 'U', counts[BUCKET_NNODES], counts[BUCKET_NPRUNES],
+            counts[BUCKET_NFALSEPOS], counts[BUCKET_NFALSENEG]);
+   }
+}
+
+/** gets the pruning statistics of the node pruner in the current solve */
+void SCIPnodeprudaggerGetStatistics(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   int*                  nprunes,            /**< pointer to store the number of nodes pruned */
+   int*                  nnodes,             /**< pointer to store the number of nodes checked */
+   int*                  nfalsepos,          /**< pointer to store the number of optimal nodes pruned */
+   int*                  nfalseneg           /**< pointer to store the number of non-optimal nodes not pruned */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   *nprunes = nodeprudata->nprunes;
+   *nnodes = nodeprudata->nnodes;
+   *nfalsepos = nodeprudata->nfalsepos;
+   *nfalseneg = nodeprudata->nfalseneg;
+}
+
+/** appends the pruning statistics per depth bucket to a CSV file, one line per non-empty bucket, with a header if the
+ *  file is empty
+ */
+static
+SCIP_RETCODE nodepruWriteBuckets(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODEPRUDATA*     nodeprudata,        /**< node pruner data */
+   const char*           fname               /**< file name */
+   )
+{
+   FILE* file;
+   int b;
+
+   file = fopen(fname, "a");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   if( fseek(file, 0L, SEEK_END) == 0 && ftell(file) == 0 )
+      fprintf(file, "instance,bucket,mindepth,maxdepth,boundtype,nnodes,nprunes,nfalsepos,nfalseneg\n");
+   for( b = 0; b < nodeprudata->nbuckets; b++ )
+   {
+      int* counts;
+      int mindepth;
+      int lastdepth;
+
+      counts = &nodeprudata->bucketcounts[b * BUCKET_NCOUNTS];
+      if( counts[BUCKET_NNODES] == 0 )
+         continue;
+      SCIPpolicyCalcBucketDepths(nodeprudata->policy, b, nodeprudata->maxdepth, &mindepth, &lastdepth);
+      fprintf(file, "%s,%d,%d,%d,%s,%d,%d,%d,%d\n", SCIPgetProbName(scip), b, mindepth, lastdepth,
+         b % 2 == SCIP_BOUNDTYPE_LOWER ? "lower" : "upper", counts[BUCKET_NNODES], counts[BUCKET_NPRUNES],
+         counts[BUCKET_NFALSEPOS], counts[BUCKET_NFALSENEG]);
+   }
+   fclose(file);
+
+   return SCIP_OKAY;
 }
 
 /** solving process initialization method of node pruner (called when branch and bound process is about to begin) */
@@ -105,15 +208,23 @@ SCIP_DECL_NODEPRUINIT(nodepruInitDagger)
    SCIP_CALL( SCIPprintSol(scip, nodeprudata->optsol, NULL, FALSE) );
 #endif
 
-   /* read policy */
+   /* read policy, unless it was handed over in memory */
    SCIP_CALL( SCIPpolicyCreate(scip, &nodeprudata->policy) );
-   assert(nodeprudata->polfname != NULL);
-   SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeprudata->polfname, &nodeprudata->policy) );
+   if( nodeprudata->inpolicy != NULL )
+   {
+      SCIP_CALL( SCIPpolicyCopy(scip, nodeprudata->inpolicy, nodeprudata->policy) );
+   }
+   else
+   {
+      assert(nodeprudata->polfname != NULL);
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeprudata->polfname, &nodeprudata->policy) );
+   }
    assert(nodeprudata->policy->weights != NULL);
 
    /* open trajectory file for writing */
    /* open in appending mode for writing training file from multiple problems */
    nodeprudata->trjfile = NULL;
+   nodeprudata->wfile = NULL;
    if( nodeprudata->trjfname != NULL )
    {
       char wfname[SCIP_MAXSTRLEN];
@@ -122,6 +233,13 @@ SCIP_DECL_NODEPRUINIT(nodepruInitDagger)
       nodeprudata->wfile = fopen(wfname, "a");
       nodeprudata->trjfile = fopen(nodeprudata->trjfname, "a");
    }
+   nodeprudata->trjstart = SCIPdatasetGetTrjBytes(nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->dataset);
+
+   /* time the callbacks if the latency event handler is active */
+   nodeprudata->latency = SCIPeventhdlrlatencyFind(scip);
+
+   /* record the decisions if the search is traced */
+   nodeprudata->trace = SCIPeventhdlrtraceFind(scip);
 
    /* create feat */
    nodeprudata->feat = NULL;
@@ -141,6 +259,13 @@ SCIP_DECL_NODEPRUINIT(nodepruInitDagger)
    nodeprudata->nfalseneg = 0;
    nodeprudata->randseed = 0;
 
+   /* count the decisions per depth bucket of the policy weights */
+   nodeprudata->maxdepth = SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip);
+   nodeprudata->nbuckets = SCIPpolicyCalcNBuckets(nodeprudata->policy, nodeprudata->maxdepth);
+   SCIP_CALL( SCIPallocBlockMemoryArray(scip, &nodeprudata->bucketcounts,
+         nodeprudata->nbuckets * BUCKET_NCOUNTS) );
+   BMSclearMemoryArray(nodeprudata->bucketcounts, nodeprudata->nbuckets * BUCKET_NCOUNTS);
+
    return SCIP_OKAY;
 }
 
@@ -166,6 +291,14 @@ SCIP_DECL_NODEPRUEXIT(nodepruExitDagger)
    assert(nodeprudata->feat != NULL);
    SCIP_CALL( SCIPfeatFree(scip, &nodeprudata->feat) );
 
+   /* the depths of the buckets are those of the policy */
+   if( nodeprudata->bucketfname != NULL && nodeprudata->bucketfname[0] != '\0' )
+   {
+      SCIP_CALL( nodepruWriteBuckets(scip, nodeprudata, nodeprudata->bucketfname) );
+   }
+   SCIPfreeBlockMemoryArray(scip, &nodeprudata->bucketcounts, nodeprudata->nbuckets * BUCKET_NCOUNTS);
+   nodeprudata->nbuckets = 0;
+
    assert(nodeprudata->policy != NULL);
    SCIP_CALL( SCIPpolicyFree(scip, &nodeprudata->policy) );
 
@@ -190,10 +323,12 @@ SCIP_DECL_NODEPRUFREE(nodepruFreeDagger)
 
 /** node pruning method of node pruner */
 static
-SCIP_DECL_NODEPRUPRUNE(nodepruPruneDagger)
+SCIP_DECL_NODEPRUPRUNE(pruneNodeDagger)
 {
    SCIP_NODEPRUDATA* nodeprudata;
    SCIP_Bool isoptimal;
+   SCIP_Longint start;
+   int* counts;
 
    assert(nodepru != NULL);
    assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
@@ -250,14 +385,37 @@ SCIP_DECL_NODEPRUPRUNE(nodepruPruneDagger)
       else if( (!isoptimal) && (!*prune) )
          nodeprudata->nfalseneg++;
 
+      /* the same counts in the depth bucket of the node */
+      assert(SCIPpolicyGetBucket(nodeprudata->policy, nodeprudata->feat) < nodeprudata->nbuckets);
+      counts = &nodeprudata->bucketcounts[SCIPpolicyGetBucket(nodeprudata->policy, nodeprudata->feat) * BUCKET_NCOUNTS];
+      counts[BUCKET_NNODES]++;
+      if( *prune )
+         counts[BUCKET_NPRUNES]++;
+      if( isoptimal && *prune )
+         counts[BUCKET_NFALSEPOS]++;
+      else if( (!isoptimal) && (!*prune) )
+         counts[BUCKET_NFALSENEG]++;
+
 /* write feature vector to stdout in debug mode */
 #ifndef SCIP_DEBUG
       /* write examples */
-      if( nodeprudata->trjfile != NULL )
+      if( nodeprudata->trjfile != NULL || nodeprudata->dataset != NULL )
       {
 #endif
          SCIPdebugMessage("node pruning feature of node #%"SCIP_LONGINT_FORMAT"\n", SCIPnodeGetNumber(node));
-         SCIPfeatLIBSVMPrint(scip, nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->feat, isoptimal ? -1 : 1);
+         start = nodeprudata->latency != NULL
+            ? SCIPeventhdlrlatencyStart(nodeprudata->latency, SCIP_LATENCYHOOK_TRJWRITE) : 0;
+#ifndef SCIP_DEBUG
+         if( nodeprudata->trjfile != NULL )
+#endif
+            SCIPfeatLIBSVMPrint(scip, nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->feat, isoptimal ? -1 : 1);
+         if( nodeprudata->dataset != NULL )
+         {
+            SCIP_CALL( SCIPdatasetAddFeat(nodeprudata->dataset, nodeprudata->feat, isoptimal ? -1 : 1) );
+         }
+         if( nodeprudata->latency != NULL )
+            SCIPeventhdlrlatencyAdd(nodeprudata->latency, SCIP_LATENCYHOOK_TRJWRITE, start);
+         SCIP_PROBE_TRJ_WRITE("nodepru/"NODEPRU_NAME, isoptimal ? -1 : 1, SCIPfeatGetSize(nodeprudata->feat));
 #ifndef SCIP_DEBUG
       }
 #endif
@@ -267,10 +425,87 @@ SCIP_DECL_NODEPRUPRUNE(nodepruPruneDagger)
 }
 
 
+/** node pruning method of node pruner, timed by the latency event handler, traced by the probes and recorded by the
+ *  trace event handler
+ */
+static
+SCIP_DECL_NODEPRUPRUNE(nodepruPruneDagger)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   SCIP_Longint start;
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   start = nodeprudata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE) : 0;
+   SCIP_CALL( pruneNodeDagger(scip, nodepru, node, prune) );
+   if( nodeprudata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE, start);
+   if( nodeprudata->trace != NULL )
+   {
+      SCIP_CALL( SCIPeventhdlrtraceAddPrune(nodeprudata->trace, node, *prune) );
+   }
+
+   SCIP_PROBE_NODE_PRUNE(NODEPRU_NAME, node, *prune);
+
+   return SCIP_OKAY;
+}
+
 /*
  * node pruner specific interface methods
  */
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+SCIP_Longint SCIPnodeprudaggerGetTrjBytes(
+   SCIP_NODEPRU*         nodepru             /**< node pruner */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   return SCIPdatasetGetTrjBytes(nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->dataset)
+      - nodeprudata->trjstart;
+}
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+void SCIPnodeprudaggerSetDataset(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   nodeprudata->dataset = dataset;
+}
+
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+void SCIPnodeprudaggerSetPolicy(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   nodeprudata->inpolicy = policy;
+}
+
 /** creates the uct node pruner and includes it in SCIP */
 SCIP_RETCODE SCIPincludeNodepruDagger(
    SCIP*                 scip                /**< SCIP data structure */
@@ -283,10 +518,18 @@ SCIP_RETCODE SCIPincludeNodepruDagger(
    SCIP_CALL( SCIPallocBlockMemory(scip, &nodeprudata) );
 
    nodepru = NULL;
+   nodeprudata->latency = NULL;
+   nodeprudata->trace = NULL;
    nodeprudata->optsol = NULL;
    nodeprudata->solfname = NULL;
    nodeprudata->trjfname = NULL;
+   nodeprudata->dataset = NULL;
+   nodeprudata->inpolicy = NULL;
    nodeprudata->polfname = NULL;
+   nodeprudata->bucketfname = NULL;
+   nodeprudata->bucketcounts = NULL;
+   nodeprudata->nbuckets = 0;
+   nodeprudata->maxdepth = 0;
 
    /* use SCIPincludeNodepruBasic() plus setter functions if you want to set callbacks one-by-one and your code should
     * compile independent of new callbacks being added in future SCIP versions
@@ -315,6 +558,10 @@ SCIP_RETCODE SCIPincludeNodepruDagger(
          "nodepruning/"NODEPRU_NAME"/polfname",
          "name of the policy model file",
          &nodeprudata->polfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodepruning/"NODEPRU_NAME"/bucketfname",
+         "name of the CSV file to append the pruning decisions per depth bucket to (empty: none)",
+         &nodeprudata->bucketfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
 
    return SCIP_OKAY;
 }
@@ -22,6 +22,8 @@
 
 
 #include "scip/scip.h"
+#include "struct_dataset.h"
+#include "struct_policy.h"
 #include "feat.h"
 
 #ifdef __cplusplus
@@ -41,6 +43,36 @@ void SCIPnodeprudaggerPrintStatistics(
    FILE*                 file
    );
 
+/** gets the pruning statistics of the node pruner in the current solve */
+EXTERN
+void SCIPnodeprudaggerGetStatistics(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   int*                  nprunes,            /**< pointer to store the number of nodes pruned */
+   int*                  nnodes,             /**< pointer to store the number of nodes checked */
+   int*                  nfalsepos,          /**< pointer to store the number of optimal nodes pruned */
+   int*                  nfalseneg           /**< pointer to store the number of non-optimal nodes not pruned */
+   );
+
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+EXTERN
+SCIP_Longint SCIPnodeprudaggerGetTrjBytes(
+   SCIP_NODEPRU*         nodepru             /**< node pruner */
+   );
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+EXTERN
+void SCIPnodeprudaggerSetDataset(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   );
+
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+EXTERN
+void SCIPnodeprudaggerSetPolicy(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,352 @@
+/**@file   nodepru_online.c
+ * @brief  node pruner which prunes nodes according to a policy and updates the policy online with the oracle
+ * @author He He
+ *
+ * The node pruner scores each node with the policy like the dagger node pruner and prunes it if the score is positive.
+ * Instead of writing the example of the oracle (prune all nodes that are not optimal) to a trajectory file, it updates
+ * the policy with the example immediately. The policy is read from polfname (or starts from zero if no file is given)
+ * and written to outpolfname when the solve ends.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+#include <assert.h>
+#include <string.h>
+#include "nodepru_online.h"
+#include "nodepru_oracle.h"
+#include "nodesel_oracle.h"
+#include "feat.h"
+#include "eventhdlr_latency.h"
+#include "eventhdlr_trace.h"
+#include "probes.h"
+#include "policy.h"
+#include "struct_policy.h"
+#include "scip/sol.h"
+#include "scip/tree.h"
+#include "scip/set.h"
+#include "scip/struct_set.h"
+#include "scip/struct_scip.h"
+
+#define NODEPRU_NAME            "online"
+#define NODEPRU_DESC            "node pruner which prunes node according to a policy and updates it online with the oracle"
+#define NODEPRU_STDPRIORITY     10
+#define NODEPRU_MEMSAVEPRIORITY 0
+
+#define DEFAULT_FILENAME        ""
+#define DEFAULT_UPDATERULE      'p'      /**< online update rule: 'p'assive-aggressive, 's'ubgradient descent */
+#define DEFAULT_C               1.0      /**< aggressiveness of passive-aggressive updates or learning rate of subgradient descent */
+
+/*
+ * Data structures
+ */
+
+/** node pruner data */
+struct SCIP_NodepruData
+{
+   char*              solfname;           /**< name of the solution file */
+   SCIP_SOL*          optsol;             /**< optimal solution */
+   char*              polfname;           /**< name of the initial policy model file */
+   char*              outpolfname;        /**< name of the file to write the updated policy to */
+   SCIP_POLICY*       policy;
+   SCIP_FEAT*         feat;
+   SCIP_Bool          checkopt;           /**< need to check node optimality? (don't need to if node selector is oracle, dagger or online) */
+   char               updaterule;         /**< online update rule: 'p'assive-aggressive, 's'ubgradient descent */
+   SCIP_Real          C;                  /**< aggressiveness or learning rate */
+   SCIP_Longint       nupdates;           /**< number of examples with positive loss */
+   SCIP_Real          sumloss;            /**< sum of the losses of the examples before the updates */
+   int                nprunes;            /**< number of nodes pruned */
+   int                nnodes;             /**< number of nodes checked */
+   int                nfalsepos;          /**< number of optimal nodes pruned */
+   int                nfalseneg;          /**< number of non-optimal nodes not pruned */
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
+   SCIP_EVENTHDLR*    trace;              /**< trace event handler with a trace file, or NULL */
+};
+
+void SCIPnodepruonlinePrintStatistics(
+   SCIP*                 scip,
+   SCIP_NODEPRU*         nodepru,
+   FILE*                 file
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(scip != NULL);
+   assert(nodepru != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Node pruner        :\n");
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  nodes pruned     : %d/%d\n", nodeprudata->nprunes, nodeprudata->nnodes);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  FP pruned        : %d/%d\n", nodeprudata->nfalsepos, nodeprudata->nnodes);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  FN pruned        : %d/%d\n", nodeprudata->nfalseneg, nodeprudata->nnodes);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  online updates   : %"SCIP_LONGINT_FORMAT"/%d\n", nodeprudata->nupdates, nodeprudata->nnodes);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  average loss     : %10.4f\n", nodeprudata->nnodes > 0 ? nodeprudata->sumloss / nodeprudata->nnodes : 0.0);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  pruning time     : %10.2f\n", SCIPnodepruGetTime(nodepru));
+}
+
+/** gets the pruning statistics of the node pruner in the current solve */
+void SCIPnodepruonlineGetStatistics(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   int*                  nprunes,            /**< pointer to store the number of nodes pruned */
+   int*                  nnodes,             /**< pointer to store the number of nodes checked */
+   int*                  nfalsepos,          /**< pointer to store the number of optimal nodes pruned */
+   int*                  nfalseneg           /**< pointer to store the number of non-optimal nodes not pruned */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   *nprunes = nodeprudata->nprunes;
+   *nnodes = nodeprudata->nnodes;
+   *nfalsepos = nodeprudata->nfalsepos;
+   *nfalseneg = nodeprudata->nfalseneg;
+}
+
+/** solving process initialization method of node pruner (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_NODEPRUINIT(nodepruInitOnline)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   const char* nodeselname;
+   assert(scip != NULL);
+   assert(nodepru != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   /* solfname should be set before including nodepruonline */
+   assert(nodeprudata->solfname != NULL);
+   nodeprudata->optsol = NULL;
+   SCIP_CALL( SCIPreadOptSol(scip, nodeprudata->solfname, &nodeprudata->optsol) );
+   assert(nodeprudata->optsol != NULL);
+
+   /* read the initial policy; without one, the weights are allocated by the first update */
+   SCIP_CALL( SCIPpolicyCreate(scip, &nodeprudata->policy) );
+   assert(nodeprudata->polfname != NULL);
+   if( nodeprudata->polfname[0] != '\0' )
+   {
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeprudata->polfname, &nodeprudata->policy) );
+   }
+
+   /* time the callbacks if the latency event handler is active */
+   nodeprudata->latency = SCIPeventhdlrlatencyFind(scip);
+
+   /* record the decisions if the search is traced */
+   nodeprudata->trace = SCIPeventhdlrtraceFind(scip);
+
+   /* create feat */
+   nodeprudata->feat = NULL;
+   SCIP_CALL( SCIPfeatCreate(scip, &nodeprudata->feat, SCIP_FEATNODEPRU_SIZE) );
+   assert(nodeprudata->feat != NULL);
+   SCIPfeatSetMaxDepth(nodeprudata->feat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+
+   nodeselname = SCIPnodeselGetName(SCIPgetNodesel(scip));
+   if( strcmp(nodeselname, "oracle") == 0 || strcmp(nodeselname, "dagger") == 0 || strcmp(nodeselname, "online") == 0 )
+      nodeprudata->checkopt = FALSE;
+   else
+      nodeprudata->checkopt = TRUE;
+
+   nodeprudata->nupdates = 0;
+   nodeprudata->sumloss = 0.0;
+   nodeprudata->nprunes = 0;
+   nodeprudata->nnodes = 0;
+   nodeprudata->nfalsepos = 0;
+   nodeprudata->nfalseneg = 0;
+
+   return SCIP_OKAY;
+}
+
+/** deinitialization method of node pruner (called before transformed problem is freed) */
+static
+SCIP_DECL_NODEPRUEXIT(nodepruExitOnline)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   assert(scip != NULL);
+   assert(nodepru != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+
+   assert(nodeprudata->optsol != NULL);
+   SCIP_CALL( SCIPfreeSolSelf(scip, &nodeprudata->optsol) );
+
+   assert(nodeprudata->feat != NULL);
+   SCIP_CALL( SCIPfeatFree(scip, &nodeprudata->feat) );
+
+   /* write the updated policy */
+   assert(nodeprudata->policy != NULL);
+   if( nodeprudata->outpolfname[0] != '\0' && nodeprudata->policy->weights != NULL )
+   {
+      SCIP_CALL( SCIPwriteLIBSVMPolicy(nodeprudata->policy, nodeprudata->outpolfname, "L2R_L1LOSS_SVC_DUAL") );
+   }
+   SCIP_CALL( SCIPpolicyFree(scip, &nodeprudata->policy) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of node pruner to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_NODEPRUFREE(nodepruFreeOnline)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   nodeprudata = SCIPnodepruGetData(nodepru);
+
+   assert(nodeprudata != NULL);
+
+   SCIPfreeBlockMemory(scip, &nodeprudata);
+
+   SCIPnodepruSetData(nodepru, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** node pruning method of node pruner */
+static
+SCIP_DECL_NODEPRUPRUNE(pruneNodeOnline)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   SCIP_Bool isoptimal;
+   SCIP_Real loss;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+   assert(scip != NULL);
+   assert(node != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   /* don't prune the root */
+   if( SCIPnodeGetDepth(node) == 0 )
+   {
+      *prune = FALSE;
+      return SCIP_OKAY;
+   }
+
+   SCIPcalcNodepruFeat(scip, node, nodeprudata->feat);
+   SCIPcalcNodeScore(node, nodeprudata->feat, nodeprudata->policy);
+   if( nodeprudata->checkopt )
+      SCIPnodeCheckOptimal(scip, node, nodeprudata->optsol);
+   isoptimal = SCIPnodeIsOptimal(node);
+
+   /* decide with the current policy */
+   if( SCIPsetIsGT(scip->set, SCIPnodeGetScore(node), 0) )
+   {
+      *prune = TRUE;
+      SCIPdebugMessage("pruning node: #%"SCIP_LONGINT_FORMAT"\n", SCIPnodeGetNumber(node));
+      nodeprudata->nprunes++;
+   }
+   else
+      *prune = FALSE;
+
+   nodeprudata->nnodes++;
+   if( isoptimal && *prune )
+      nodeprudata->nfalsepos++;
+   else if( (!isoptimal) && (!*prune) )
+      nodeprudata->nfalseneg++;
+
+   /* then learn from the label of the oracle */
+   SCIP_CALL( SCIPpolicyUpdate(scip, nodeprudata->policy, nodeprudata->feat, NULL, isoptimal ? -1 : 1,
+         nodeprudata->updaterule, nodeprudata->C, (SCIP_Longint)nodeprudata->nnodes, &loss) );
+   nodeprudata->sumloss += loss;
+   if( loss > 0.0 )
+      nodeprudata->nupdates++;
+
+   return SCIP_OKAY;
+}
+
+
+/** node pruning method of node pruner, timed by the latency event handler, traced by the probes and recorded by the
+ *  trace event handler
+ */
+static
+SCIP_DECL_NODEPRUPRUNE(nodepruPruneOnline)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   SCIP_Longint start;
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   start = nodeprudata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE) : 0;
+   SCIP_CALL( pruneNodeOnline(scip, nodepru, node, prune) );
+   if( nodeprudata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE, start);
+   if( nodeprudata->trace != NULL )
+   {
+      SCIP_CALL( SCIPeventhdlrtraceAddPrune(nodeprudata->trace, node, *prune) );
+   }
+
+   SCIP_PROBE_NODE_PRUNE(NODEPRU_NAME, node, *prune);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * node pruner specific interface methods
+ */
+
+/** creates the online node pruner and includes it in SCIP */
+SCIP_RETCODE SCIPincludeNodepruOnline(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   SCIP_NODEPRU* nodepru;
+
+   /* create online node pruner data */
+   SCIP_CALL( SCIPallocBlockMemory(scip, &nodeprudata) );
+
+   nodepru = NULL;
+   nodeprudata->latency = NULL;
+   nodeprudata->trace = NULL;
+   nodeprudata->optsol = NULL;
+   nodeprudata->solfname = NULL;
+   nodeprudata->polfname = NULL;
+   nodeprudata->outpolfname = NULL;
+
+   SCIP_CALL( SCIPincludeNodepruBasic(scip, &nodepru, NODEPRU_NAME, NODEPRU_DESC, NODEPRU_STDPRIORITY,
+          NODEPRU_MEMSAVEPRIORITY, nodepruPruneOnline, nodeprudata) );
+
+   assert(nodepru != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetNodepruCopy(scip, nodepru, NULL) );
+   SCIP_CALL( SCIPsetNodepruInit(scip, nodepru, nodepruInitOnline) );
+   SCIP_CALL( SCIPsetNodepruExit(scip, nodepru, nodepruExitOnline) );
+   SCIP_CALL( SCIPsetNodepruFree(scip, nodepru, nodepruFreeOnline) );
+
+   /* add online node pruner parameters */
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodepruning/"NODEPRU_NAME"/solfname",
+         "name of the optimal solution file",
+         &nodeprudata->solfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodepruning/"NODEPRU_NAME"/polfname",
+         "name of the initial policy model file (empty: start from zero)",
+         &nodeprudata->polfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodepruning/"NODEPRU_NAME"/outpolfname",
+         "name of the file to write the updated policy model to",
+         &nodeprudata->outpolfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddCharParam(scip,
+         "nodepruning/"NODEPRU_NAME"/updaterule",
+         "online update rule ('p'assive-aggressive, 's'ubgradient descent)",
+         &nodeprudata->updaterule, FALSE, DEFAULT_UPDATERULE, "ps", NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip,
+         "nodepruning/"NODEPRU_NAME"/C",
+         "aggressiveness of passive-aggressive updates or learning rate of subgradient descent",
+         &nodeprudata->C, FALSE, DEFAULT_C, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
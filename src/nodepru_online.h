@@ -0,0 +1,47 @@
+/**@file   nodepru_online.h
+ * @ingroup NODEPRUNERS
+ * @brief  node pruner which prunes nodes according to a policy and updates the policy online with the oracle
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_NODEPRU_ONLINE_H__
+#define __SCIP_NODEPRU_ONLINE_H__
+
+
+#include "scip/scip.h"
+#include "feat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the online node pruner and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeNodepruOnline(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+EXTERN
+void SCIPnodepruonlinePrintStatistics(
+   SCIP*                 scip,
+   SCIP_NODEPRU*         nodepru,
+   FILE*                 file
+   );
+
+/** gets the pruning statistics of the node pruner in the current solve */
+EXTERN
+void SCIPnodepruonlineGetStatistics(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   int*                  nprunes,            /**< pointer to store the number of nodes pruned */
+   int*                  nnodes,             /**< pointer to store the number of nodes checked */
+   int*                  nfalsepos,          /**< pointer to store the number of optimal nodes pruned */
+   int*                  nfalseneg           /**< pointer to store the number of non-optimal nodes not pruned */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
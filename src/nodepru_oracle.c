@@ -15,6 +15,10 @@
 #include "scip/sol.h"
 #include "scip/struct_set.h"
 #include "feat.h"
+#include "eventhdlr_latency.h"
+#include "eventhdlr_trace.h"
+#include "probes.h"
+#include "dataset.h"
 
 #define NODEPRU_NAME            "oracle"
 #define NODEPRU_DESC            "node pruner which always prunes non-optimal nodes"
@@ -37,6 +41,10 @@ struct SCIP_NodepruData
    SCIP_Bool          checkopt;           /**< need to check node optimality? (don't need to if node selector is oracle or dagger */
    FILE*              wfile;
    FILE*              trjfile;
+   SCIP_DATASET*      dataset;            /**< in-memory trajectory store, or NULL */
+   SCIP_Longint       trjstart;           /**< trajectory bytes when the solve started */
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
+   SCIP_EVENTHDLR*    trace;              /**< trace event handler with a trace file, or NULL */
 };
 
 /*
@@ -72,6 +80,7 @@ SCIP_DECL_NODEPRUINIT(nodepruInitOracle)
       nodeprudata->checkopt = TRUE;
 
    nodeprudata->trjfile = NULL;
+   nodeprudata->wfile = NULL;
    if( nodeprudata->trjfname != NULL )
    {
       char wfname[SCIP_MAXSTRLEN];
@@ -80,6 +89,13 @@ SCIP_DECL_NODEPRUINIT(nodepruInitOracle)
       nodeprudata->wfile = fopen(wfname, "a");
       nodeprudata->trjfile = fopen(nodeprudata->trjfname, "a");
    }
+   nodeprudata->trjstart = SCIPdatasetGetTrjBytes(nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->dataset);
+
+   /* time the callbacks if the latency event handler is active */
+   nodeprudata->latency = SCIPeventhdlrlatencyFind(scip);
+
+   /* record the decisions if the search is traced */
+   nodeprudata->trace = SCIPeventhdlrtraceFind(scip);
 
    /* create feat */
    nodeprudata->feat = NULL;
@@ -141,11 +157,12 @@ SCIP_DECL_NODEPRUFREE(nodepruFreeOracle)
 
 /** node pruning method of node pruner */
 static
-SCIP_DECL_NODEPRUPRUNE(nodepruPruneOracle)
+SCIP_DECL_NODEPRUPRUNE(pruneNodeOracle)
 {
    SCIP_NODEPRUDATA* nodeprudata;
    SCIP_SOL* optsol;
    SCIP_Bool isoptimal;
+   SCIP_Longint start;
 
    assert(nodepru != NULL);
    assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
@@ -177,12 +194,24 @@ SCIP_DECL_NODEPRUPRUNE(nodepruPruneOracle)
       }
 
 #ifndef SCIP_DEBUG
-      if( nodeprudata->trjfile != NULL )
+      if( nodeprudata->trjfile != NULL || nodeprudata->dataset != NULL )
       {
 #endif
          SCIPcalcNodepruFeat(scip, node, nodeprudata->feat);
          SCIPdebugMessage("node pruning feature of node #%"SCIP_LONGINT_FORMAT"\n", SCIPnodeGetNumber(node));
-         SCIPfeatLIBSVMPrint(scip, nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->feat, *prune ? 1 : -1);
+         start = nodeprudata->latency != NULL
+            ? SCIPeventhdlrlatencyStart(nodeprudata->latency, SCIP_LATENCYHOOK_TRJWRITE) : 0;
+#ifndef SCIP_DEBUG
+         if( nodeprudata->trjfile != NULL )
+#endif
+            SCIPfeatLIBSVMPrint(scip, nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->feat, *prune ? 1 : -1);
+         if( nodeprudata->dataset != NULL )
+         {
+            SCIP_CALL( SCIPdatasetAddFeat(nodeprudata->dataset, nodeprudata->feat, *prune ? 1 : -1) );
+         }
+         if( nodeprudata->latency != NULL )
+            SCIPeventhdlrlatencyAdd(nodeprudata->latency, SCIP_LATENCYHOOK_TRJWRITE, start);
+         SCIP_PROBE_TRJ_WRITE("nodepru/"NODEPRU_NAME, *prune ? 1 : -1, SCIPfeatGetSize(nodeprudata->feat));
       }
 #ifndef SCIP_DEBUG
    }
@@ -191,10 +220,70 @@ SCIP_DECL_NODEPRUPRUNE(nodepruPruneOracle)
    return SCIP_OKAY;
 }
 
+/** node pruning method of node pruner, timed by the latency event handler, traced by the probes and recorded by the
+ *  trace event handler
+ */
+static
+SCIP_DECL_NODEPRUPRUNE(nodepruPruneOracle)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   SCIP_Longint start;
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   start = nodeprudata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE) : 0;
+   SCIP_CALL( pruneNodeOracle(scip, nodepru, node, prune) );
+   if( nodeprudata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE, start);
+   if( nodeprudata->trace != NULL )
+   {
+      SCIP_CALL( SCIPeventhdlrtraceAddPrune(nodeprudata->trace, node, *prune) );
+   }
+
+   SCIP_PROBE_NODE_PRUNE(NODEPRU_NAME, node, *prune);
+
+   return SCIP_OKAY;
+}
+
 /*
  * node pruner specific interface methods
  */
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+SCIP_Longint SCIPnodepruoracleGetTrjBytes(
+   SCIP_NODEPRU*         nodepru             /**< node pruner */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   return SCIPdatasetGetTrjBytes(nodeprudata->trjfile, nodeprudata->wfile, nodeprudata->dataset)
+      - nodeprudata->trjstart;
+}
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+void SCIPnodepruoracleSetDataset(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   nodeprudata->dataset = dataset;
+}
+
 /** creates the uct node pruner and includes it in SCIP */
 SCIP_RETCODE SCIPincludeNodepruOracle(
    SCIP*                 scip                /**< SCIP data structure */
@@ -207,9 +296,12 @@ SCIP_RETCODE SCIPincludeNodepruOracle(
    SCIP_CALL( SCIPallocBlockMemory(scip, &nodeprudata) );
 
    nodepru = NULL;
+   nodeprudata->latency = NULL;
+   nodeprudata->trace = NULL;
    nodeprudata->optsol = NULL;
    nodeprudata->solfname = NULL;
    nodeprudata->trjfname = NULL;
+   nodeprudata->dataset = NULL;
 
    /* use SCIPincludeNodepruBasic() plus setter functions if you want to set callbacks one-by-one and your code should
     * compile independent of new callbacks being added in future SCIP versions
@@ -63,6 +63,7 @@
 
 
 #include "scip/scip.h"
+#include "struct_dataset.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +75,19 @@ SCIP_RETCODE SCIPincludeNodepruOracle(
    SCIP*                 scip                /**< SCIP data structure */
    );
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+extern
+SCIP_Longint SCIPnodepruoracleGetTrjBytes(
+   SCIP_NODEPRU*         nodepru             /**< node pruner */
+   );
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+extern
+void SCIPnodepruoracleSetDataset(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,10 @@
 #include "nodepru_oracle.h"
 #include "nodesel_oracle.h"
 #include "feat.h"
+#include "eventhdlr_latency.h"
+#include "eventhdlr_trace.h"
+#include "eventhdlr_treemem.h"
+#include "probes.h"
 #include "policy.h"
 #include "struct_policy.h"
 #include "scip/sol.h"
@@ -35,6 +39,7 @@
 #define NODEPRU_MEMSAVEPRIORITY 0
 
 #define DEFAULT_FILENAME        ""
+#define DEFAULT_FEATMASK        0        /**< bit mask of the features which are neither computed nor used */
 
 /*
  * Data structures
@@ -45,8 +50,13 @@ struct SCIP_NodepruData
 {
    char*              polfname;           /**< name of the solution file */
    SCIP_POLICY*       policy;
+   SCIP_POLICY*       inpolicy;           /**< policy to use instead of reading polfname, or NULL */
    SCIP_FEAT*         feat;
+   int                featmask;           /**< bit mask of the features which are neither computed nor used */
    int                nprunes;
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
+   SCIP_EVENTHDLR*    trace;              /**< trace event handler with a trace file, or NULL */
+   SCIP_EVENTHDLR*    treemem;            /**< active tree memory event handler, or NULL */
 };
 
 void SCIPnodeprupolicyPrintStatistics(
@@ -71,6 +81,21 @@ void SCIPnodeprupolicyPrintStatistics(
          "  pruning time     : %10.2f\n", SCIPnodepruGetTime(nodepru));
 }
 
+/** gets the number of nodes pruned in the current solve */
+int SCIPnodeprupolicyGetNPrunes(
+   SCIP_NODEPRU*         nodepru             /**< node pruner */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   return nodeprudata->nprunes;
+}
+
 /** solving process initialization method of node pruner (called when branch and bound process is about to begin) */
 static
 SCIP_DECL_NODEPRUINIT(nodepruInitPolicy)
@@ -82,17 +107,34 @@ SCIP_DECL_NODEPRUINIT(nodepruInitPolicy)
    nodeprudata = SCIPnodepruGetData(nodepru);
    assert(nodeprudata != NULL);
 
-   /* read policy */
+   /* read policy, unless it was handed over in memory */
    SCIP_CALL( SCIPpolicyCreate(scip, &nodeprudata->policy) );
-   assert(nodeprudata->polfname != NULL);
-   SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeprudata->polfname, &nodeprudata->policy) );
+   if( nodeprudata->inpolicy != NULL )
+   {
+      SCIP_CALL( SCIPpolicyCopy(scip, nodeprudata->inpolicy, nodeprudata->policy) );
+   }
+   else
+   {
+      assert(nodeprudata->polfname != NULL);
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeprudata->polfname, &nodeprudata->policy) );
+   }
    assert(nodeprudata->policy->weights != NULL);
   
+   /* time the callbacks if the latency event handler is active */
+   nodeprudata->latency = SCIPeventhdlrlatencyFind(scip);
+
+   /* record the decisions if the search is traced */
+   nodeprudata->trace = SCIPeventhdlrtraceFind(scip);
+
+   /* count the memory freed by the prunes if the tree memory is sampled */
+   nodeprudata->treemem = SCIPeventhdlrtreememFind(scip);
+
    /* create feat */
    nodeprudata->feat = NULL;
    SCIP_CALL( SCIPfeatCreate(scip, &nodeprudata->feat, SCIP_FEATNODEPRU_SIZE) );
    assert(nodeprudata->feat != NULL);
    SCIPfeatSetMaxDepth(nodeprudata->feat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+   SCIPfeatSetMask(nodeprudata->feat, (unsigned int)nodeprudata->featmask);
 
    nodeprudata->nprunes = 0;
  
@@ -136,7 +178,7 @@ SCIP_DECL_NODEPRUFREE(nodepruFreePolicy)
 
 /** node pruning method of node pruner */
 static
-SCIP_DECL_NODEPRUPRUNE(nodepruPrunePolicy)
+SCIP_DECL_NODEPRUPRUNE(pruneNodePolicy)
 {
    SCIP_NODEPRUDATA* nodeprudata;
 
@@ -177,10 +219,55 @@ SCIP_DECL_NODEPRUPRUNE(nodepruPrunePolicy)
 }
 
 
+/** node pruning method of node pruner, timed by the latency event handler, traced by the probes and recorded by the
+ *  trace event handler
+ */
+static
+SCIP_DECL_NODEPRUPRUNE(nodepruPrunePolicy)
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+   SCIP_Longint start;
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   start = nodeprudata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE) : 0;
+   SCIP_CALL( pruneNodePolicy(scip, nodepru, node, prune) );
+   if( nodeprudata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeprudata->latency, SCIP_LATENCYHOOK_PRUNE, start);
+   if( nodeprudata->trace != NULL )
+   {
+      SCIP_CALL( SCIPeventhdlrtraceAddPrune(nodeprudata->trace, node, *prune) );
+   }
+   if( nodeprudata->treemem != NULL && *prune )
+      SCIPeventhdlrtreememAddPrune(nodeprudata->treemem, node);
+
+   SCIP_PROBE_NODE_PRUNE(NODEPRU_NAME, node, *prune);
+
+   return SCIP_OKAY;
+}
+
 /*
  * node pruner specific interface methods
  */
 
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+void SCIPnodeprupolicySetPolicy(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   )
+{
+   SCIP_NODEPRUDATA* nodeprudata;
+
+   assert(nodepru != NULL);
+   assert(strcmp(SCIPnodepruGetName(nodepru), NODEPRU_NAME) == 0);
+
+   nodeprudata = SCIPnodepruGetData(nodepru);
+   assert(nodeprudata != NULL);
+
+   nodeprudata->inpolicy = policy;
+}
+
 /** creates the uct node pruner and includes it in SCIP */
 SCIP_RETCODE SCIPincludeNodepruPolicy(
    SCIP*                 scip                /**< SCIP data structure */
@@ -193,7 +280,11 @@ SCIP_RETCODE SCIPincludeNodepruPolicy(
    SCIP_CALL( SCIPallocBlockMemory(scip, &nodeprudata) );
 
    nodepru = NULL;
+   nodeprudata->latency = NULL;
+   nodeprudata->trace = NULL;
+   nodeprudata->treemem = NULL;
    nodeprudata->polfname = NULL;
+   nodeprudata->inpolicy = NULL;
 
    /* use SCIPincludeNodepruBasic() plus setter functions if you want to set callbacks one-by-one and your code should
     * compile independent of new callbacks being added in future SCIP versions
@@ -214,6 +305,10 @@ SCIP_RETCODE SCIPincludeNodepruPolicy(
          "nodepruning/"NODEPRU_NAME"/polfname",
          "name of the policy model file",
          &nodeprudata->polfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip,
+         "nodepruning/"NODEPRU_NAME"/featmask",
+         "bit mask of the features which are neither computed nor used by the policy (bit i: feature i of type_feat.h)",
+         &nodeprudata->featmask, FALSE, DEFAULT_FEATMASK, 0, (1 << SCIP_FEATNODEPRU_SIZE) - 1, NULL, NULL) );
 
    return SCIP_OKAY;
 }
@@ -23,6 +23,7 @@
 
 #include "scip/scip.h"
 #include "feat.h"
+#include "struct_policy.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +42,19 @@ void SCIPnodeprupolicyPrintStatistics(
    FILE*                 file
    );
 
+/** gets the number of nodes pruned in the current solve */
+EXTERN
+int SCIPnodeprupolicyGetNPrunes(
+   SCIP_NODEPRU*         nodepru             /**< node pruner */
+   );
+
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+EXTERN
+void SCIPnodeprupolicySetPolicy(
+   SCIP_NODEPRU*         nodepru,            /**< node pruner */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,10 +15,14 @@
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 #include <assert.h>
+#include <stdio.h>
 #include <string.h>
 #include "nodesel_dagger.h"
 #include "nodesel_oracle.h"
 #include "feat.h"
+#include "eventhdlr_latency.h"
+#include "probes.h"
+#include "dataset.h"
 #include "policy.h"
 #include "struct_policy.h"
 #include "scip/sol.h"
@@ -49,12 +53,25 @@ struct SCIP_NodeselData
    FILE*              trjfile;
    SCIP_FEAT*         feat;
    SCIP_FEAT*         optfeat;
+   SCIP_DATASET*      dataset;            /**< in-memory trajectory store, or NULL */
+   SCIP_Longint       trjstart;           /**< trajectory bytes when the solve started */
+   SCIP_POLICY*       inpolicy;           /**< policy to use instead of reading polfname, or NULL */
 #ifndef NDEBUG
    SCIP_Longint       optnodenumber;      /**< successively assigned number of the node */
 #endif
    SCIP_Bool          negate;
+   SCIP_Bool          hasopt;             /**< has an optimal node been found in the current solve? */
+   SCIP_Real          optscore;           /**< policy score of the last optimal node */
+   SCIP_Real          optlowerbound;      /**< lower bound of the last optimal node */
+   int                optdepth;           /**< depth of the last optimal node */
    int                nerrors;            /**< number of wrong ranking of a pair of nodes */
    int                ncomps;              /**< total number of comparisons */
+   char*              bucketfname;        /**< name of the file to append the statistics per depth bucket to */
+   int*               bucketnerrors;      /**< number of wrong rankings per depth bucket of the non-optimal node */
+   int*               bucketncomps;       /**< number of comparisons per depth bucket of the non-optimal node */
+   int                nbuckets;           /**< number of depth buckets */
+   int                maxdepth;           /**< maximum depth of the depth buckets */
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
 };
 
 void SCIPnodeseldaggerPrintStatistics(
@@ -64,6 +81,7 @@ void SCIPnodeseldaggerPrintStatistics(
    )
 {
    SCIP_NODESELDATA* nodeseldata;
+   int b;
 
    assert(scip != NULL);
    assert(nodesel != NULL);
@@ -77,6 +95,80 @@ void SCIPnodeseldaggerPrintStatistics(
          "  comp error rate  : %d/%d\n", nodeseldata->nerrors, nodeseldata->ncomps);
    SCIPmessageFPrintInfo(scip->messagehdlr, file,
          "  selection time   : %10.2f\n", SCIPnodeselGetTime(nodesel));
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  by depth bucket  :      comps     errors\n");
+   for( b = 0; b < nodeseldata->nbuckets; b++ )
+   {
+      int mindepth;
+      int lastdepth;
+
+      if( nodeseldata->bucketncomps[b] == 0 )
+         continue;
+      SCIPpolicyCalcBucketDepths(nodeseldata->policy, b, nodeseldata->maxdepth, &mindepth, &lastdepth);
+      SCIPmessageFPrintInfo(scip->messagehdlr, file,
+            "  %2d %5d-%-5d %c : %10d %10d\n", b, mindepth, lastdepth, b % 2 == SCIP_BOUNDTYPE_LOWER ? 'L' : 'U',
+            nodeseldata->bucketncomps[b], nodeseldata->bucketnerrors[b]);
+   }
+}
+
+/** gets the comparison statistics of the node selector in the current solve */
+void SCIPnodeseldaggerGetStatistics(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   int*                  nerrors,            /**< pointer to store the number of wrong rankings of an optimal node */
+   int*                  ncomps              /**< pointer to store the number of comparisons with an optimal node */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(nerrors != NULL);
+   assert(ncomps != NULL);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   *nerrors = nodeseldata->nerrors;
+   *ncomps = nodeseldata->ncomps;
+}
+
+/** appends the comparison statistics per depth bucket to a CSV file, one line per non-empty bucket, with a header if
+ *  the file is empty
+ */
+static
+SCIP_RETCODE nodeselWriteBuckets(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     nodeseldata,        /**< node selector data */
+   const char*           fname               /**< file name */
+   )
+{
+   FILE* file;
+   int b;
+
+   file = fopen(fname, "a");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   if( fseek(file, 0L, SEEK_END) == 0 && ftell(file) == 0 )
+      fprintf(file, "instance,bucket,mindepth,maxdepth,boundtype,ncomps,nerrors,errorrate\n");
+   for( b = 0; b < nodeseldata->nbuckets; b++ )
+   {
+      int mindepth;
+      int lastdepth;
+
+      if( nodeseldata->bucketncomps[b] == 0 )
+         continue;
+      SCIPpolicyCalcBucketDepths(nodeseldata->policy, b, nodeseldata->maxdepth, &mindepth, &lastdepth);
+      fprintf(file, "%s,%d,%d,%d,%s,%d,%d,%g\n", SCIPgetProbName(scip), b, mindepth, lastdepth,
+         b % 2 == SCIP_BOUNDTYPE_LOWER ? "lower" : "upper", nodeseldata->bucketncomps[b], nodeseldata->bucketnerrors[b],
+         (SCIP_Real)nodeseldata->bucketnerrors[b] / nodeseldata->bucketncomps[b]);
+   }
+   fclose(file);
+
+   return SCIP_OKAY;
 }
 
 /** solving process initialization method of node selector (called when branch and bound process is about to begin) */
@@ -99,15 +191,23 @@ SCIP_DECL_NODESELINIT(nodeselInitDagger)
    SCIP_CALL( SCIPprintSol(scip, nodeseldata->optsol, NULL, FALSE) );
 #endif
 
-   /* read policy */
+   /* read policy, unless it was handed over in memory */
    SCIP_CALL( SCIPpolicyCreate(scip, &nodeseldata->policy) );
-   assert(nodeseldata->polfname != NULL);
-   SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeseldata->polfname, &nodeseldata->policy) );
+   if( nodeseldata->inpolicy != NULL )
+   {
+      SCIP_CALL( SCIPpolicyCopy(scip, nodeseldata->inpolicy, nodeseldata->policy) );
+   }
+   else
+   {
+      assert(nodeseldata->polfname != NULL);
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeseldata->polfname, &nodeseldata->policy) );
+   }
    assert(nodeseldata->policy->weights != NULL);
 
    /* open trajectory file for writing */
    /* open in appending mode for writing training file from multiple problems */
    nodeseldata->trjfile = NULL;
+   nodeseldata->wfile = NULL;
    if( nodeseldata->trjfname != NULL )
    {
       char wfname[SCIP_MAXSTRLEN];
@@ -116,6 +216,10 @@ SCIP_DECL_NODESELINIT(nodeselInitDagger)
       nodeseldata->wfile = fopen(wfname, "a");
       nodeseldata->trjfile = fopen(nodeseldata->trjfname, "a");
    }
+   nodeseldata->trjstart = SCIPdatasetGetTrjBytes(nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->dataset);
+
+   /* time the callbacks if the latency event handler is active */
+   nodeseldata->latency = SCIPeventhdlrlatencyFind(scip);
 
    /* create feat */
    nodeseldata->feat = NULL;
@@ -133,10 +237,19 @@ SCIP_DECL_NODESELINIT(nodeselInitDagger)
    nodeseldata->optnodenumber = -1;
 #endif
    nodeseldata->negate = TRUE;
+   nodeseldata->hasopt = FALSE;
 
    nodeseldata->nerrors = 0;
    nodeseldata->ncomps = 0;
 
+   /* count the comparisons per depth bucket of the policy weights */
+   nodeseldata->maxdepth = SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip);
+   nodeseldata->nbuckets = SCIPpolicyCalcNBuckets(nodeseldata->policy, nodeseldata->maxdepth);
+   SCIP_CALL( SCIPallocBlockMemoryArray(scip, &nodeseldata->bucketnerrors, nodeseldata->nbuckets) );
+   SCIP_CALL( SCIPallocBlockMemoryArray(scip, &nodeseldata->bucketncomps, nodeseldata->nbuckets) );
+   BMSclearMemoryArray(nodeseldata->bucketnerrors, nodeseldata->nbuckets);
+   BMSclearMemoryArray(nodeseldata->bucketncomps, nodeseldata->nbuckets);
+
    return SCIP_OKAY;
 }
 
@@ -164,6 +277,15 @@ SCIP_DECL_NODESELEXIT(nodeselExitDagger)
    if( nodeseldata->optfeat != NULL )
       SCIP_CALL( SCIPfeatFree(scip, &nodeseldata->optfeat) );
 
+   /* the depths of the buckets are those of the policy */
+   if( nodeseldata->bucketfname != NULL && nodeseldata->bucketfname[0] != '\0' )
+   {
+      SCIP_CALL( nodeselWriteBuckets(scip, nodeseldata, nodeseldata->bucketfname) );
+   }
+   SCIPfreeBlockMemoryArray(scip, &nodeseldata->bucketncomps, nodeseldata->nbuckets);
+   SCIPfreeBlockMemoryArray(scip, &nodeseldata->bucketnerrors, nodeseldata->nbuckets);
+   nodeseldata->nbuckets = 0;
+
    assert(nodeseldata->policy != NULL);
    SCIP_CALL( SCIPpolicyFree(scip, &nodeseldata->policy) );
 
@@ -186,14 +308,110 @@ SCIP_DECL_NODESELFREE(nodeselFreeDagger)
    return SCIP_OKAY;
 }
 
+/** write the example (optfeat - feat) to the trajectory file and the dataset */
+static
+SCIP_RETCODE nodeselWriteExample(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     nodeseldata         /**< node selector data */
+   )
+{
+   SCIP_Longint start;
+
+   start = nodeseldata->latency != NULL
+      ? SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_TRJWRITE) : 0;
+   nodeseldata->negate ^= 1;
+   if( nodeseldata->trjfile != NULL )
+      SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
+   if( nodeseldata->dataset != NULL )
+   {
+      SCIP_CALL( SCIPdatasetAddFeatDiff(nodeseldata->dataset, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate) );
+   }
+   if( nodeseldata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_TRJWRITE, start);
+   SCIP_PROBE_TRJ_WRITE("nodesel/"NODESEL_NAME, nodeseldata->negate ? -1 : 1, SCIPfeatGetSize(nodeseldata->feat));
+
+   return SCIP_OKAY;
+}
+
+/** ranks two nodes as the node comparison does: by their policy score, then deeper first, then by their lower bound;
+ *  returns -1 if the first node is ranked first, +1 if the second one is, and 0 otherwise
+ */
+static
+int rankNodes(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real             score1,             /**< policy score of the first node */
+   int                   depth1,             /**< depth of the first node */
+   SCIP_Real             lowerbound1,        /**< lower bound of the first node */
+   SCIP_Real             score2,             /**< policy score of the second node */
+   int                   depth2,             /**< depth of the second node */
+   SCIP_Real             lowerbound2         /**< lower bound of the second node */
+   )
+{
+   if( SCIPisGT(scip, score1, score2) )
+      return -1;
+   if( SCIPisLT(scip, score1, score2) )
+      return +1;
+   if( depth1 > depth2 )
+      return -1;
+   if( depth1 < depth2 )
+      return +1;
+   if( SCIPisLT(scip, lowerbound1, lowerbound2) )
+      return -1;
+   if( SCIPisGT(scip, lowerbound1, lowerbound2) )
+      return +1;
+   return 0;
+}
+
+/** pairs the last optimal node with a node: counts whether the policy ranks the node before the optimal node, in the
+ *  depth bucket of the node, and writes the example if trajectories are collected (the features of the node must then
+ *  be in nodeseldata->feat)
+ */
+static
+SCIP_RETCODE nodeselAddPair(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     nodeseldata,        /**< node selector data */
+   SCIP_NODE*            node,               /**< non-optimal node of the pair */
+   SCIP_Bool             writeexample        /**< should the example be written? */
+   )
+{
+   if( nodeseldata->hasopt )
+   {
+      int bucket;
+
+      /* the bucket needs only the depth and the branching of the node, not its features */
+      bucket = SCIPpolicyCalcBucket(nodeseldata->policy, SCIPnodeGetDepth(node), nodeseldata->maxdepth,
+         SCIPfeatCalcNodeBoundtype(node));
+      assert(bucket >= 0 && bucket < nodeseldata->nbuckets);
+      nodeseldata->ncomps++;
+      nodeseldata->bucketncomps[bucket]++;
+      if( rankNodes(scip, nodeseldata->optscore, nodeseldata->optdepth, nodeseldata->optlowerbound,
+            SCIPnodeGetScore(node), SCIPnodeGetDepth(node), SCIPnodeGetLowerbound(node)) == +1 )
+      {
+         nodeseldata->nerrors++;
+         nodeseldata->bucketnerrors[bucket]++;
+      }
+   }
+
+   if( writeexample )
+   {
+#ifndef NDEBUG
+      SCIPdebugMessage("example  #%d #%d\n", (int)nodeseldata->optnodenumber, (int)SCIPnodeGetNumber(node));
+#endif
+      SCIP_CALL( nodeselWriteExample(scip, nodeseldata) );
+   }
+
+   return SCIP_OKAY;
+}
+
 /** node selection method of node selector */
 static
-SCIP_DECL_NODESELSELECT(nodeselSelectDagger)
+SCIP_DECL_NODESELSELECT(selectNodeDagger)
 {
    SCIP_NODESELDATA* nodeseldata;
    SCIP_NODE** leaves;
    SCIP_NODE** children;
    SCIP_NODE** siblings;
+   SCIP_Bool writeexample;
    int nleaves;
    int nsiblings;
    int nchildren;
@@ -211,15 +429,10 @@ SCIP_DECL_NODESELSELECT(nodeselSelectDagger)
    /* collect leaves, children and siblings data */
    SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
 
-   /* check newly created nodes */
+   /* check optimality of newly created nodes */
    optchild = -1;
    for( i = 0; i < nchildren; i++)
    {
-      /* compute score */
-      SCIPcalcNodeselFeat(scip, children[i], nodeseldata->feat);
-      SCIPcalcNodeScore(children[i], nodeseldata->feat, nodeseldata->policy);
-
-      /* check optimality */
       if( ! SCIPnodeIsOptchecked(children[i]) )
       {
          SCIPnodeCheckOptimal(scip, children[i], nodeseldata->optsol);
@@ -235,57 +448,44 @@ SCIP_DECL_NODESELSELECT(nodeselSelectDagger)
       }
    }
 
-   /* write examples */
-   if( nodeseldata->trjfile != NULL )
+   /* score the new optimal node first, so that the other children are paired with it */
+   writeexample = (nodeseldata->trjfile != NULL || nodeseldata->dataset != NULL);
+   if( optchild != -1 )
    {
-      if( optchild != -1 )
+      SCIPcalcNodeselFeat(scip, children[optchild], nodeseldata->optfeat);
+      SCIPcalcNodeScore(children[optchild], nodeseldata->optfeat, nodeseldata->policy);
+      nodeseldata->hasopt = TRUE;
+      nodeseldata->optscore = SCIPnodeGetScore(children[optchild]);
+      nodeseldata->optdepth = SCIPnodeGetDepth(children[optchild]);
+      nodeseldata->optlowerbound = SCIPnodeGetLowerbound(children[optchild]);
+   }
+   else
+      assert(!writeexample || nchildren == 0 || nodeseldata->optnodenumber != -1);
+
+   /* score the other children and pair them with the optimal node, reusing the features of the score */
+   for( i = 0; i < nchildren; i++ )
+   {
+      if( i == optchild )
+         continue;
+      SCIPcalcNodeselFeat(scip, children[i], nodeseldata->feat);
+      SCIPcalcNodeScore(children[i], nodeseldata->feat, nodeseldata->policy);
+      SCIP_CALL( nodeselAddPair(scip, nodeseldata, children[i], writeexample) );
+   }
+
+   /* a new optimal node is also ranked against the open nodes; their features are needed only for the examples */
+   if( optchild != -1 )
+   {
+      for( i = 0; i < nsiblings; i++ )
       {
-         /* new optimal node */
-         SCIPcalcNodeselFeat(scip, children[optchild], nodeseldata->optfeat);
-         for( i = 0; i < nchildren; i++)
-         {
-            if( i != optchild )
-            {
-               SCIPcalcNodeselFeat(scip, children[i], nodeseldata->feat);
-               nodeseldata->negate ^= 1;
-#ifndef NDEBUG
-               SCIPdebugMessage("example  #%d #%d\n", (int)nodeseldata->optnodenumber, (int)SCIPnodeGetNumber(children[i]));
-#endif
-               SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
-            }
-         }
-         for( i = 0; i < nsiblings; i++ )
-         {
+         if( writeexample )
             SCIPcalcNodeselFeat(scip, siblings[i], nodeseldata->feat);
-            nodeseldata->negate ^= 1;
-#ifndef NDEBUG
-            SCIPdebugMessage("example  #%d #%d\n", (int)nodeseldata->optnodenumber, (int)SCIPnodeGetNumber(siblings[i]));
-#endif
-            SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
-         }
-         for( i = 0; i < nleaves; i++ )
-         {
-            SCIPcalcNodeselFeat(scip, leaves[i], nodeseldata->feat);
-            nodeseldata->negate ^= 1;
-#ifndef NDEBUG
-            SCIPdebugMessage("example  #%d #%d\n", (int)nodeseldata->optnodenumber, (int)SCIPnodeGetNumber(leaves[i]));
-#endif
-            SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
-         }
+         SCIP_CALL( nodeselAddPair(scip, nodeseldata, siblings[i], writeexample) );
       }
-      else
+      for( i = 0; i < nleaves; i++ )
       {
-         /* children are not optimal */
-         assert(nchildren == 0 || (nchildren > 0 && nodeseldata->optnodenumber != -1));
-         for( i = 0; i < nchildren; i++ )
-         {
-            SCIPcalcNodeselFeat(scip, children[i], nodeseldata->feat);
-            nodeseldata->negate ^= 1;
-#ifndef NDEBUG
-            SCIPdebugMessage("example  #%d #%d\n", (int)nodeseldata->optnodenumber, (int)SCIPnodeGetNumber(children[i]));
-#endif
-            SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
-         }
+         if( writeexample )
+            SCIPcalcNodeselFeat(scip, leaves[i], nodeseldata->feat);
+         SCIP_CALL( nodeselAddPair(scip, nodeseldata, leaves[i], writeexample) );
       }
    }
 
@@ -296,14 +496,10 @@ SCIP_DECL_NODESELSELECT(nodeselSelectDagger)
 
 /** node comparison method of dagger node selector */
 static
-SCIP_DECL_NODESELCOMP(nodeselCompDagger)
+SCIP_DECL_NODESELCOMP(compareNodesDagger)
 {  /*lint --e{715}*/
    SCIP_Real score1;
    SCIP_Real score2;
-   SCIP_Bool isopt1;
-   SCIP_Bool isopt2;
-   SCIP_NODESELDATA* nodeseldata;
-   int result;
 
    assert(nodesel != NULL);
    assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
@@ -318,46 +514,50 @@ SCIP_DECL_NODESELCOMP(nodeselCompDagger)
    assert(score1 != 0);
    assert(score2 != 0);
 
-   if( SCIPisGT(scip, score1, score2) )
-      result = -1;
-   else if( SCIPisLT(scip, score1, score2) )
-      result = +1;
-   else
-   {
-      int depth1;
-      int depth2;
-
-      depth1 = SCIPnodeGetDepth(node1);
-      depth2 = SCIPnodeGetDepth(node2);
-      if( depth1 > depth2 )
-         result = -1;
-      else if( depth1 < depth2 )
-         result = +1;
-      else
-      {
-         SCIP_Real lowerbound1;
-         SCIP_Real lowerbound2;
-
-         lowerbound1 = SCIPnodeGetLowerbound(node1);
-         lowerbound2 = SCIPnodeGetLowerbound(node2);
-         if( SCIPisLT(scip, lowerbound1, lowerbound2) )
-            result = -1;
-         else if( SCIPisGT(scip, lowerbound1, lowerbound2) )
-            result = +1;
-         else
-            result = 0;
-      }
-   }
+   /* the ranking errors are counted when the optimal node is paired in selectNodeDagger(), not here */
+   return rankNodes(scip, score1, SCIPnodeGetDepth(node1), SCIPnodeGetLowerbound(node1),
+      score2, SCIPnodeGetDepth(node2), SCIPnodeGetLowerbound(node2));
+}
+
+/** node selection method of node selector, timed by the latency event handler and traced by the probes */
+static
+SCIP_DECL_NODESELSELECT(nodeselSelectDagger)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
 
    nodeseldata = SCIPnodeselGetData(nodesel);
    assert(nodeseldata != NULL);
-   isopt1 = SCIPnodeIsOptimal(node1);
-   isopt2 = SCIPnodeIsOptimal(node2);
-   if( (isopt1 && result == 1) || (isopt2 && result == -1) )
-      nodeseldata->nerrors++;
-   /* don't count the case when neither node is opt, in which case it will always be correct */
-   if( isopt1 || isopt2 )
-      nodeseldata->ncomps++;
+
+   SCIP_PROBE_CHILDREN(scip, NODESEL_NAME);
+
+   start = nodeseldata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT) : 0;
+   SCIP_CALL( selectNodeDagger(scip, nodesel, selnode) );
+   if( nodeseldata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT, start);
+
+   SCIP_PROBE_NODE_SELECT(NODESEL_NAME, *selnode);
+
+   return SCIP_OKAY;
+}
+
+/** node comparison method of node selector, timed by the latency event handler */
+static
+SCIP_DECL_NODESELCOMP(nodeselCompDagger)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+   int result;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   if( nodeseldata->latency == NULL )
+      return compareNodesDagger(scip, nodesel, node1, node2);
+
+   start = SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_COMP);
+   result = compareNodesDagger(scip, nodesel, node1, node2);
+   SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_COMP, start);
 
    return result;
 }
@@ -366,6 +566,57 @@ SCIP_DECL_NODESELCOMP(nodeselCompDagger)
  * node selector specific interface methods
  */
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+SCIP_Longint SCIPnodeseldaggerGetTrjBytes(
+   SCIP_NODESEL*         nodesel             /**< node selector */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   return SCIPdatasetGetTrjBytes(nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->dataset)
+      - nodeseldata->trjstart;
+}
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+void SCIPnodeseldaggerSetDataset(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   nodeseldata->dataset = dataset;
+}
+
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+void SCIPnodeseldaggerSetPolicy(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   nodeseldata->inpolicy = policy;
+}
+
 /** creates the uct node selector and includes it in SCIP */
 SCIP_RETCODE SCIPincludeNodeselDagger(
    SCIP*                 scip                /**< SCIP data structure */
@@ -378,10 +629,18 @@ SCIP_RETCODE SCIPincludeNodeselDagger(
    SCIP_CALL( SCIPallocBlockMemory(scip, &nodeseldata) );
 
    nodesel = NULL;
+   nodeseldata->latency = NULL;
    nodeseldata->optsol = NULL;
    nodeseldata->solfname = NULL;
    nodeseldata->trjfname = NULL;
    nodeseldata->polfname = NULL;
+   nodeseldata->dataset = NULL;
+   nodeseldata->inpolicy = NULL;
+   nodeseldata->bucketfname = NULL;
+   nodeseldata->bucketnerrors = NULL;
+   nodeseldata->bucketncomps = NULL;
+   nodeseldata->nbuckets = 0;
+   nodeseldata->maxdepth = 0;
 
    /* use SCIPincludeNodeselBasic() plus setter functions if you want to set callbacks one-by-one and your code should
     * compile independent of new callbacks being added in future SCIP versions
@@ -410,6 +669,10 @@ SCIP_RETCODE SCIPincludeNodeselDagger(
          "nodeselection/"NODESEL_NAME"/polfname",
          "name of the policy model file",
          &nodeseldata->polfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodeselection/"NODESEL_NAME"/bucketfname",
+         "name of the CSV file to append the comparisons and ranking errors per depth bucket to (empty: none)",
+         &nodeseldata->bucketfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
 
    return SCIP_OKAY;
 }
@@ -23,6 +23,8 @@
 
 #include "scip/scip.h"
 #include "feat.h"
+#include "struct_dataset.h"
+#include "struct_policy.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +36,26 @@ SCIP_RETCODE SCIPincludeNodeselDagger(
    SCIP*                 scip                /**< SCIP data structure */
    );
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+EXTERN
+SCIP_Longint SCIPnodeseldaggerGetTrjBytes(
+   SCIP_NODESEL*         nodesel             /**< node selector */
+   );
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+EXTERN
+void SCIPnodeseldaggerSetDataset(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   );
+
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+EXTERN
+void SCIPnodeseldaggerSetPolicy(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   );
+
 EXTERN
 void SCIPnodeseldaggerPrintStatistics(
    SCIP*                 scip,
@@ -41,6 +63,14 @@ void SCIPnodeseldaggerPrintStatistics(
    FILE*                 file
    );
 
+/** gets the comparison statistics of the node selector in the current solve */
+EXTERN
+void SCIPnodeseldaggerGetStatistics(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   int*                  nerrors,            /**< pointer to store the number of wrong rankings of an optimal node */
+   int*                  ncomps              /**< pointer to store the number of comparisons with an optimal node */
+   );
+
 #ifdef __cplusplus
 }
 #endif
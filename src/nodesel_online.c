@@ -0,0 +1,513 @@
+/**@file   nodesel_online.c
+ * @brief  node selector which selects nodes according to a policy and updates the policy online with the oracle
+ * @author He He
+ *
+ * The node selector ranks the open nodes by the score of the policy like the dagger node selector, but instead of
+ * writing the examples of the oracle to a trajectory file it updates the policy with each example immediately, so
+ * that the rest of the search already uses the updated policy. Scores of nodes that are already in the queue are
+ * not recomputed. The policy is read from polfname (or starts from zero if no file is given) and written to
+ * outpolfname when the solve ends.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+#include <assert.h>
+#include <string.h>
+#include "nodesel_online.h"
+#include "nodesel_oracle.h"
+#include "feat.h"
+#include "eventhdlr_latency.h"
+#include "probes.h"
+#include "policy.h"
+#include "struct_policy.h"
+#include "scip/sol.h"
+#include "scip/tree.h"
+#include "scip/struct_set.h"
+#include "scip/struct_scip.h"
+
+#define NODESEL_NAME            "online"
+#define NODESEL_DESC            "node selector which selects node according to a policy and updates it online with the oracle"
+#define NODESEL_STDPRIORITY     10
+#define NODESEL_MEMSAVEPRIORITY 0
+
+#define DEFAULT_FILENAME        ""
+#define DEFAULT_UPDATERULE      'p'      /**< online update rule: 'p'assive-aggressive, 's'ubgradient descent */
+#define DEFAULT_C               1.0      /**< aggressiveness of passive-aggressive updates or learning rate of subgradient descent */
+
+/*
+ * Data structures
+ */
+
+/** node selector data */
+struct SCIP_NodeselData
+{
+   char*              solfname;           /**< name of the solution file */
+   SCIP_SOL*          optsol;             /**< optimal solution */
+   char*              polfname;           /**< name of the initial policy model file */
+   char*              outpolfname;        /**< name of the file to write the updated policy to */
+   SCIP_POLICY*       policy;
+   SCIP_FEAT*         feat;
+   SCIP_FEAT*         optfeat;
+   SCIP_FEAT**        childfeats;         /**< features of the children of the focus node, kept until they are scored */
+   int                nchildfeats;        /**< number of allocated child features */
+   char               updaterule;         /**< online update rule: 'p'assive-aggressive, 's'ubgradient descent */
+   SCIP_Real          C;                  /**< aggressiveness or learning rate */
+   SCIP_Longint       nexamples;          /**< number of examples seen */
+   SCIP_Longint       nupdates;           /**< number of examples with positive loss */
+   SCIP_Real          sumloss;            /**< sum of the losses of the examples before the updates */
+   int                nerrors;            /**< number of wrong ranking of a pair of nodes */
+   int                ncomps;             /**< total number of comparisons */
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
+};
+
+void SCIPnodeselonlinePrintStatistics(
+   SCIP*                 scip,
+   SCIP_NODESEL*         nodesel,
+   FILE*                 file
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(scip != NULL);
+   assert(nodesel != NULL);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "Node selector      :\n");
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  comp error rate  : %d/%d\n", nodeseldata->nerrors, nodeseldata->ncomps);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  online updates   : %"SCIP_LONGINT_FORMAT"/%"SCIP_LONGINT_FORMAT"\n", nodeseldata->nupdates, nodeseldata->nexamples);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  average loss     : %10.4f\n", nodeseldata->nexamples > 0 ? nodeseldata->sumloss / nodeseldata->nexamples : 0.0);
+   SCIPmessageFPrintInfo(scip->messagehdlr, file,
+         "  selection time   : %10.2f\n", SCIPnodeselGetTime(nodesel));
+}
+
+/** gets the comparison statistics of the node selector in the current solve */
+void SCIPnodeselonlineGetStatistics(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   int*                  nerrors,            /**< pointer to store the number of wrong rankings of an optimal node */
+   int*                  ncomps              /**< pointer to store the number of comparisons with an optimal node */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(nerrors != NULL);
+   assert(ncomps != NULL);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   *nerrors = nodeseldata->nerrors;
+   *ncomps = nodeseldata->ncomps;
+}
+
+/** solving process initialization method of node selector (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_NODESELINIT(nodeselInitOnline)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   assert(scip != NULL);
+   assert(nodesel != NULL);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   /* solfname should be set before including nodeselonline */
+   assert(nodeseldata->solfname != NULL);
+   nodeseldata->optsol = NULL;
+   SCIP_CALL( SCIPreadOptSol(scip, nodeseldata->solfname, &nodeseldata->optsol) );
+   assert(nodeseldata->optsol != NULL);
+
+   /* read the initial policy; without one, the weights are allocated by the first update */
+   SCIP_CALL( SCIPpolicyCreate(scip, &nodeseldata->policy) );
+   assert(nodeseldata->polfname != NULL);
+   if( nodeseldata->polfname[0] != '\0' )
+   {
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeseldata->polfname, &nodeseldata->policy) );
+   }
+
+   /* time the callbacks if the latency event handler is active */
+   nodeseldata->latency = SCIPeventhdlrlatencyFind(scip);
+
+   /* create feat */
+   nodeseldata->feat = NULL;
+   SCIP_CALL( SCIPfeatCreate(scip, &nodeseldata->feat, SCIP_FEATNODESEL_SIZE) );
+   assert(nodeseldata->feat != NULL);
+   SCIPfeatSetMaxDepth(nodeseldata->feat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+
+   /* create optimal node feat */
+   nodeseldata->optfeat = NULL;
+   SCIP_CALL( SCIPfeatCreate(scip, &nodeseldata->optfeat, SCIP_FEATNODESEL_SIZE) );
+   assert(nodeseldata->optfeat != NULL);
+   SCIPfeatSetMaxDepth(nodeseldata->optfeat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+
+   nodeseldata->childfeats = NULL;
+   nodeseldata->nchildfeats = 0;
+   nodeseldata->nexamples = 0;
+   nodeseldata->nupdates = 0;
+   nodeseldata->sumloss = 0.0;
+   nodeseldata->nerrors = 0;
+   nodeseldata->ncomps = 0;
+
+   return SCIP_OKAY;
+}
+
+/** deinitialization method of node selector (called before transformed problem is freed) */
+static
+SCIP_DECL_NODESELEXIT(nodeselExitOnline)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   int i;
+
+   assert(scip != NULL);
+   assert(nodesel != NULL);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+
+   assert(nodeseldata->optsol != NULL);
+   SCIP_CALL( SCIPfreeSolSelf(scip, &nodeseldata->optsol) );
+
+   assert(nodeseldata->feat != NULL);
+   SCIP_CALL( SCIPfeatFree(scip, &nodeseldata->feat) );
+   if( nodeseldata->optfeat != NULL )
+      SCIP_CALL( SCIPfeatFree(scip, &nodeseldata->optfeat) );
+   for( i = 0; i < nodeseldata->nchildfeats; i++ )
+   {
+      SCIP_CALL( SCIPfeatFree(scip, &nodeseldata->childfeats[i]) );
+   }
+   SCIPfreeMemoryArrayNull(scip, &nodeseldata->childfeats);
+   nodeseldata->nchildfeats = 0;
+
+   /* write the updated policy */
+   assert(nodeseldata->policy != NULL);
+   if( nodeseldata->outpolfname[0] != '\0' && nodeseldata->policy->weights != NULL )
+   {
+      SCIP_CALL( SCIPwriteLIBSVMPolicy(nodeseldata->policy, nodeseldata->outpolfname, "L2R_L1LOSS_SVC_DUAL") );
+   }
+   SCIP_CALL( SCIPpolicyFree(scip, &nodeseldata->policy) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of node selector to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_NODESELFREE(nodeselFreeOnline)
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIPfreeBlockMemory(scip, &nodeseldata);
+
+   SCIPnodeselSetData(nodesel, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** update the policy on the example (optfeat - feat)
+ *
+ *  The example is weighted by the optimal node, as in the trajectory files; the order of the pair is not alternated,
+ *  since the online updates are symmetric in the label.
+ */
+static
+SCIP_RETCODE nodeselUpdatePolicy(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     nodeseldata,        /**< node selector data */
+   SCIP_FEAT*            feat                /**< features of the node that is not optimal */
+   )
+{
+   SCIP_Real loss;
+
+   nodeseldata->nexamples++;
+   SCIP_CALL( SCIPpolicyUpdate(scip, nodeseldata->policy, nodeseldata->optfeat, feat, 1,
+         nodeseldata->updaterule, nodeseldata->C, nodeseldata->nexamples, &loss) );
+
+   nodeseldata->sumloss += loss;
+   if( loss > 0.0 )
+      nodeseldata->nupdates++;
+
+   return SCIP_OKAY;
+}
+
+/** makes sure that there are features for nchildren children */
+static
+SCIP_RETCODE ensureChildFeats(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     nodeseldata,        /**< node selector data */
+   int                   nchildren           /**< number of children */
+   )
+{
+   int i;
+
+   if( nchildren <= nodeseldata->nchildfeats )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &nodeseldata->childfeats, nchildren) );
+   for( i = nodeseldata->nchildfeats; i < nchildren; i++ )
+   {
+      SCIP_CALL( SCIPfeatCreate(scip, &nodeseldata->childfeats[i], SCIP_FEATNODESEL_SIZE) );
+      SCIPfeatSetMaxDepth(nodeseldata->childfeats[i], SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+   }
+   nodeseldata->nchildfeats = nchildren;
+
+   return SCIP_OKAY;
+}
+
+/** node selection method of node selector */
+static
+SCIP_DECL_NODESELSELECT(selectNodeOnline)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_NODE** leaves;
+   SCIP_NODE** children;
+   SCIP_NODE** siblings;
+   int nleaves;
+   int nsiblings;
+   int nchildren;
+   int optchild;
+   int i;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+   assert(scip != NULL);
+   assert(selnode != NULL);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   /* collect leaves, children and siblings data */
+   SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
+
+   /* check optimality of newly created nodes */
+   optchild = -1;
+   for( i = 0; i < nchildren; i++)
+   {
+      if( ! SCIPnodeIsOptchecked(children[i]) )
+      {
+         SCIPnodeCheckOptimal(scip, children[i], nodeseldata->optsol);
+         SCIPnodeSetOptchecked(children[i]);
+      }
+      if( SCIPnodeIsOptimal(children[i]) )
+         optchild = i;
+   }
+
+   /* the features of the children are computed once, for the updates and for the scores */
+   SCIP_CALL( ensureChildFeats(scip, nodeseldata, nchildren) );
+   for( i = 0; i < nchildren; i++ )
+      SCIPcalcNodeselFeat(scip, children[i], nodeseldata->childfeats[i]);
+
+   /* learn from the examples of the oracle */
+   if( optchild != -1 )
+   {
+      SCIP_FEAT* tmp;
+
+      /* new optimal node: its features become the optimal ones */
+      tmp = nodeseldata->optfeat;
+      nodeseldata->optfeat = nodeseldata->childfeats[optchild];
+      nodeseldata->childfeats[optchild] = tmp;
+      for( i = 0; i < nchildren; i++)
+      {
+         if( i != optchild )
+         {
+            SCIP_CALL( nodeselUpdatePolicy(scip, nodeseldata, nodeseldata->childfeats[i]) );
+         }
+      }
+      for( i = 0; i < nsiblings; i++ )
+      {
+         SCIPcalcNodeselFeat(scip, siblings[i], nodeseldata->feat);
+         SCIP_CALL( nodeselUpdatePolicy(scip, nodeseldata, nodeseldata->feat) );
+      }
+      for( i = 0; i < nleaves; i++ )
+      {
+         SCIPcalcNodeselFeat(scip, leaves[i], nodeseldata->feat);
+         SCIP_CALL( nodeselUpdatePolicy(scip, nodeseldata, nodeseldata->feat) );
+      }
+   }
+   else
+   {
+      /* children are not optimal */
+      for( i = 0; i < nchildren; i++ )
+      {
+         SCIP_CALL( nodeselUpdatePolicy(scip, nodeseldata, nodeseldata->childfeats[i]) );
+      }
+   }
+
+   /* score the children with the updated policy */
+   for( i = 0; i < nchildren; i++)
+   {
+      SCIPcalcNodeScore(children[i], i == optchild ? nodeseldata->optfeat : nodeseldata->childfeats[i],
+         nodeseldata->policy);
+   }
+
+   *selnode = SCIPgetBestNode(scip);
+
+   return SCIP_OKAY;
+}
+
+/** node comparison method of online node selector */
+static
+SCIP_DECL_NODESELCOMP(compareNodesOnline)
+{  /*lint --e{715}*/
+   SCIP_Real score1;
+   SCIP_Real score2;
+   SCIP_Bool isopt1;
+   SCIP_Bool isopt2;
+   SCIP_NODESELDATA* nodeseldata;
+   int result;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+   assert(scip != NULL);
+
+   /* scores can be zero while the policy is still empty */
+   score1 = SCIPnodeGetScore(node1);
+   score2 = SCIPnodeGetScore(node2);
+
+   if( SCIPisGT(scip, score1, score2) )
+      result = -1;
+   else if( SCIPisLT(scip, score1, score2) )
+      result = +1;
+   else
+   {
+      int depth1;
+      int depth2;
+
+      depth1 = SCIPnodeGetDepth(node1);
+      depth2 = SCIPnodeGetDepth(node2);
+      if( depth1 > depth2 )
+         result = -1;
+      else if( depth1 < depth2 )
+         result = +1;
+      else
+      {
+         SCIP_Real lowerbound1;
+         SCIP_Real lowerbound2;
+
+         lowerbound1 = SCIPnodeGetLowerbound(node1);
+         lowerbound2 = SCIPnodeGetLowerbound(node2);
+         if( SCIPisLT(scip, lowerbound1, lowerbound2) )
+            result = -1;
+         else if( SCIPisGT(scip, lowerbound1, lowerbound2) )
+            result = +1;
+         else
+            result = 0;
+      }
+   }
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+   isopt1 = SCIPnodeIsOptimal(node1);
+   isopt2 = SCIPnodeIsOptimal(node2);
+   if( (isopt1 && result == 1) || (isopt2 && result == -1) )
+      nodeseldata->nerrors++;
+   if( isopt1 || isopt2 )
+      nodeseldata->ncomps++;
+
+   return result;
+}
+
+/** node selection method of node selector, timed by the latency event handler and traced by the probes */
+static
+SCIP_DECL_NODESELSELECT(nodeselSelectOnline)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIP_PROBE_CHILDREN(scip, NODESEL_NAME);
+
+   start = nodeseldata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT) : 0;
+   SCIP_CALL( selectNodeOnline(scip, nodesel, selnode) );
+   if( nodeseldata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT, start);
+
+   SCIP_PROBE_NODE_SELECT(NODESEL_NAME, *selnode);
+
+   return SCIP_OKAY;
+}
+
+/** node comparison method of node selector, timed by the latency event handler */
+static
+SCIP_DECL_NODESELCOMP(nodeselCompOnline)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+   int result;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   if( nodeseldata->latency == NULL )
+      return compareNodesOnline(scip, nodesel, node1, node2);
+
+   start = SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_COMP);
+   result = compareNodesOnline(scip, nodesel, node1, node2);
+   SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_COMP, start);
+
+   return result;
+}
+
+/*
+ * node selector specific interface methods
+ */
+
+/** creates the online node selector and includes it in SCIP */
+SCIP_RETCODE SCIPincludeNodeselOnline(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_NODESEL* nodesel;
+
+   /* create online node selector data */
+   SCIP_CALL( SCIPallocBlockMemory(scip, &nodeseldata) );
+
+   nodesel = NULL;
+   nodeseldata->latency = NULL;
+   nodeseldata->optsol = NULL;
+   nodeseldata->solfname = NULL;
+   nodeseldata->polfname = NULL;
+   nodeseldata->outpolfname = NULL;
+
+   SCIP_CALL( SCIPincludeNodeselBasic(scip, &nodesel, NODESEL_NAME, NODESEL_DESC, NODESEL_STDPRIORITY,
+          NODESEL_MEMSAVEPRIORITY, nodeselSelectOnline, nodeselCompOnline, nodeseldata) );
+
+   assert(nodesel != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetNodeselCopy(scip, nodesel, NULL) );
+   SCIP_CALL( SCIPsetNodeselInit(scip, nodesel, nodeselInitOnline) );
+   SCIP_CALL( SCIPsetNodeselExit(scip, nodesel, nodeselExitOnline) );
+   SCIP_CALL( SCIPsetNodeselFree(scip, nodesel, nodeselFreeOnline) );
+
+   /* add online node selector parameters */
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodeselection/"NODESEL_NAME"/solfname",
+         "name of the optimal solution file",
+         &nodeseldata->solfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodeselection/"NODESEL_NAME"/polfname",
+         "name of the initial policy model file (empty: start from zero)",
+         &nodeseldata->polfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip,
+         "nodeselection/"NODESEL_NAME"/outpolfname",
+         "name of the file to write the updated policy model to",
+         &nodeseldata->outpolfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddCharParam(scip,
+         "nodeselection/"NODESEL_NAME"/updaterule",
+         "online update rule ('p'assive-aggressive, 's'ubgradient descent)",
+         &nodeseldata->updaterule, FALSE, DEFAULT_UPDATERULE, "ps", NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip,
+         "nodeselection/"NODESEL_NAME"/C",
+         "aggressiveness of passive-aggressive updates or learning rate of subgradient descent",
+         &nodeseldata->C, FALSE, DEFAULT_C, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
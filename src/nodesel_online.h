@@ -0,0 +1,45 @@
+/**@file   nodesel_online.h
+ * @ingroup NODESELECTORS
+ * @brief  node selector which selects nodes according to a policy and updates the policy online with the oracle
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_NODESEL_ONLINE_H__
+#define __SCIP_NODESEL_ONLINE_H__
+
+
+#include "scip/scip.h"
+#include "feat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the online node selector and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeNodeselOnline(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+EXTERN
+void SCIPnodeselonlinePrintStatistics(
+   SCIP*                 scip,
+   SCIP_NODESEL*         nodesel,
+   FILE*                 file
+   );
+
+/** gets the comparison statistics of the node selector in the current solve */
+EXTERN
+void SCIPnodeselonlineGetStatistics(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   int*                  nerrors,            /**< pointer to store the number of wrong rankings of an optimal node */
+   int*                  ncomps              /**< pointer to store the number of comparisons with an optimal node */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
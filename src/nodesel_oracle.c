@@ -18,6 +18,10 @@
 #include <string.h>
 #include "nodesel_oracle.h"
 #include "feat.h"
+#include "eventhdlr_latency.h"
+#include "eventhdlr_trace.h"
+#include "probes.h"
+#include "dataset.h"
 #include "scip/sol.h"
 #include "scip/tree.h"
 #include "scip/struct_set.h"
@@ -44,10 +48,13 @@ struct SCIP_NodeselData
    FILE*              wfile;
    SCIP_FEAT*         feat;
    SCIP_FEAT*         optfeat;
+   SCIP_DATASET*      dataset;            /**< in-memory trajectory store, or NULL */
+   SCIP_Longint       trjstart;           /**< trajectory bytes when the solve started */
 #ifndef NDEBUG
    SCIP_Longint       optnodenumber;      /**< successively assigned number of the node */
 #endif
    SCIP_Bool          negate;
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
 };
 
 
@@ -55,6 +62,27 @@ struct SCIP_NodeselData
  * Local methods
  */
 
+/** passes the label of a node to the probes and, if the search is traced, to the trace event handler */
+static
+SCIP_RETCODE nodeRecordLabel(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODE*            node,               /**< the labeled node */
+   SCIP_Bool             isoptimal           /**< is the optimal solution in the subtree of the node? */
+   )
+{
+   SCIP_EVENTHDLR* trace;
+
+   SCIP_PROBE_ORACLE_LABEL(node, isoptimal);
+
+   trace = SCIPeventhdlrtraceFind(scip);
+   if( trace != NULL )
+   {
+      SCIP_CALL( SCIPeventhdlrtraceAddLabel(trace, node, isoptimal) );
+   }
+
+   return SCIP_OKAY;
+}
+
 /** check if the given node include the optimal solution */
 /* TODO: remove to ischecked */
 SCIP_RETCODE SCIPnodeCheckOptimal(
@@ -90,7 +118,10 @@ SCIP_RETCODE SCIPnodeCheckOptimal(
    parent = SCIPnodeGetParent(node);
    /* root is always optimal */
    if( SCIPnodeGetDepth(parent) > 0 && !SCIPnodeIsOptimal(parent) )
+   {
+      SCIP_CALL( nodeRecordLabel(scip, node, FALSE) );
       return SCIP_OKAY;
+   }
 
    branchvarssize = 1;
 
@@ -135,6 +166,7 @@ SCIP_RETCODE SCIPnodeCheckOptimal(
 
    if( isoptimal )
       SCIPnodeSetOptimal(node);
+   SCIP_CALL( nodeRecordLabel(scip, node, isoptimal) );
 
    return SCIP_OKAY;
 }
@@ -297,6 +329,33 @@ SCIP_RETCODE SCIPreadOptSol(
    }
 }
 
+/** write the example (optfeat - feat) to the trajectory file and the dataset */
+static
+SCIP_RETCODE nodeselWriteExample(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODESELDATA*     nodeseldata         /**< node selector data */
+   )
+{
+   SCIP_Longint start;
+
+   start = nodeseldata->latency != NULL
+      ? SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_TRJWRITE) : 0;
+   nodeseldata->negate ^= 1;
+#ifndef SCIP_DEBUG
+   if( nodeseldata->trjfile != NULL )
+#endif
+      SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
+   if( nodeseldata->dataset != NULL )
+   {
+      SCIP_CALL( SCIPdatasetAddFeatDiff(nodeseldata->dataset, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate) );
+   }
+   if( nodeseldata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_TRJWRITE, start);
+   SCIP_PROBE_TRJ_WRITE("nodesel/"NODESEL_NAME, nodeseldata->negate ? -1 : 1, SCIPfeatGetSize(nodeseldata->feat));
+
+   return SCIP_OKAY;
+}
+
 /*
  * Callback methods of node selector
  */
@@ -323,6 +382,7 @@ SCIP_DECL_NODESELINIT(nodeselInitOracle)
 #endif
 
    nodeseldata->trjfile = NULL;
+   nodeseldata->wfile = NULL;
    if( nodeseldata->trjfname != NULL )
    {
       char wfname[SCIP_MAXSTRLEN];
@@ -331,6 +391,10 @@ SCIP_DECL_NODESELINIT(nodeselInitOracle)
       nodeseldata->wfile = fopen(wfname, "a");
       nodeseldata->trjfile = fopen(nodeseldata->trjfname, "a");
    }
+   nodeseldata->trjstart = SCIPdatasetGetTrjBytes(nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->dataset);
+
+   /* time the callbacks if the latency event handler is active */
+   nodeseldata->latency = SCIPeventhdlrlatencyFind(scip);
 
    /* create feat */
    nodeseldata->feat = NULL;
@@ -411,7 +475,7 @@ SCIP_DECL_NODESELFREE(nodeselFreeOracle)
 
 /** node selection method of node selector */
 static
-SCIP_DECL_NODESELSELECT(nodeselSelectOracle)
+SCIP_DECL_NODESELSELECT(selectNodeOracle)
 {
    SCIP_NODESELDATA* nodeseldata;
    SCIP_NODE** leaves;
@@ -459,7 +523,7 @@ SCIP_DECL_NODESELSELECT(nodeselSelectOracle)
 
    /* write examples */
 #ifndef SCIP_DEBUG
-   if( nodeseldata->trjfile != NULL )
+   if( nodeseldata->trjfile != NULL || nodeseldata->dataset != NULL )
    {
 #endif
       SCIPdebugMessage("node selection feature\n");
@@ -472,21 +536,18 @@ SCIP_DECL_NODESELSELECT(nodeselSelectOracle)
             if( i != optchild )
             {
                SCIPcalcNodeselFeat(scip, children[i], nodeseldata->feat);
-               nodeseldata->negate ^= 1;
-               SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
+               SCIP_CALL( nodeselWriteExample(scip, nodeseldata) );
             }
          }
          for( i = 0; i < nsiblings; i++ )
          {
             SCIPcalcNodeselFeat(scip, siblings[i], nodeseldata->feat);
-            nodeseldata->negate ^= 1;
-            SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
+            SCIP_CALL( nodeselWriteExample(scip, nodeseldata) );
          }
          for( i = 0; i < nleaves; i++ )
          {
             SCIPcalcNodeselFeat(scip, leaves[i], nodeseldata->feat);
-            nodeseldata->negate ^= 1;
-            SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
+            SCIP_CALL( nodeselWriteExample(scip, nodeseldata) );
          }
       }
       else
@@ -496,8 +557,7 @@ SCIP_DECL_NODESELSELECT(nodeselSelectOracle)
          for( i = 0; i < nchildren; i++ )
          {
             SCIPcalcNodeselFeat(scip, children[i], nodeseldata->feat);
-            nodeseldata->negate ^= 1;
-            SCIPfeatDiffLIBSVMPrint(scip, nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->optfeat, nodeseldata->feat, 1, nodeseldata->negate);
+            SCIP_CALL( nodeselWriteExample(scip, nodeseldata) );
          }
       }
 #ifndef SCIP_DEBUG
@@ -513,7 +573,7 @@ SCIP_DECL_NODESELSELECT(nodeselSelectOracle)
 
 /** node comparison method of oracle node selector */
 static
-SCIP_DECL_NODESELCOMP(nodeselCompOracle)
+SCIP_DECL_NODESELCOMP(compareNodesOracle)
 {  /*lint --e{715}*/
    SCIP_Bool isoptimal1;
    SCIP_Bool isoptimal2;
@@ -567,10 +627,87 @@ SCIP_DECL_NODESELCOMP(nodeselCompOracle)
    }
 }
 
+/** node selection method of node selector, timed by the latency event handler and traced by the probes */
+static
+SCIP_DECL_NODESELSELECT(nodeselSelectOracle)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIP_PROBE_CHILDREN(scip, NODESEL_NAME);
+
+   start = nodeseldata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT) : 0;
+   SCIP_CALL( selectNodeOracle(scip, nodesel, selnode) );
+   if( nodeseldata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT, start);
+
+   SCIP_PROBE_NODE_SELECT(NODESEL_NAME, *selnode);
+
+   return SCIP_OKAY;
+}
+
+/** node comparison method of node selector, timed by the latency event handler */
+static
+SCIP_DECL_NODESELCOMP(nodeselCompOracle)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+   int result;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   if( nodeseldata->latency == NULL )
+      return compareNodesOracle(scip, nodesel, node1, node2);
+
+   start = SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_COMP);
+   result = compareNodesOracle(scip, nodesel, node1, node2);
+   SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_COMP, start);
+
+   return result;
+}
+
 /*
  * node selector specific interface methods
  */
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+SCIP_Longint SCIPnodeseloracleGetTrjBytes(
+   SCIP_NODESEL*         nodesel             /**< node selector */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   return SCIPdatasetGetTrjBytes(nodeseldata->trjfile, nodeseldata->wfile, nodeseldata->dataset)
+      - nodeseldata->trjstart;
+}
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+void SCIPnodeseloracleSetDataset(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   nodeseldata->dataset = dataset;
+}
+
 /** creates the uct node selector and includes it in SCIP */
 SCIP_RETCODE SCIPincludeNodeselOracle(
    SCIP*                 scip                /**< SCIP data structure */
@@ -583,6 +720,8 @@ SCIP_RETCODE SCIPincludeNodeselOracle(
    SCIP_CALL( SCIPallocBlockMemory(scip, &nodeseldata) );
 
    nodesel = NULL;
+   nodeseldata->latency = NULL;
+   nodeseldata->dataset = NULL;
 
    /* use SCIPincludeNodeselBasic() plus setter functions if you want to set callbacks one-by-one and your code should
     * compile independent of new callbacks being added in future SCIP versions
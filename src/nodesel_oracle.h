@@ -64,6 +64,7 @@
 
 #include "scip/scip.h"
 #include "feat.h"
+#include "struct_dataset.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +76,19 @@ SCIP_RETCODE SCIPincludeNodeselOracle(
    SCIP*                 scip                /**< SCIP data structure */
    );
 
+/** gets the bytes of the examples written to the trajectory file and the dataset in the current solve */
+EXTERN
+SCIP_Longint SCIPnodeseloracleGetTrjBytes(
+   SCIP_NODESEL*         nodesel             /**< node selector */
+   );
+
+/** sets the dataset to which the examples are added in addition to the trajectory file */
+EXTERN
+void SCIPnodeseloracleSetDataset(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_DATASET*         dataset             /**< dataset, or NULL */
+   );
+
 /** read the optimal solution (modified from readSol in reader_sol.c -- don't connect the solution with primal solutions) */
 EXTERN
 SCIP_RETCODE SCIPreadOptSol(
@@ -13,6 +13,8 @@
 #include "nodesel_policy.h"
 #include "nodesel_oracle.h"
 #include "feat.h"
+#include "eventhdlr_latency.h"
+#include "probes.h"
 #include "policy.h"
 #include "struct_policy.h"
 #include "scip/sol.h"
@@ -26,6 +28,7 @@
 #define NODESEL_MEMSAVEPRIORITY 0
 
 #define DEFAULT_FILENAME        ""
+#define DEFAULT_FEATMASK        0        /**< bit mask of the features which are neither computed nor used */
 
 /*
  * Data structures
@@ -36,7 +39,10 @@ struct SCIP_NodeselData
 {
    char*              polfname;           /**< name of the solution file */
    SCIP_POLICY*       policy;
+   SCIP_POLICY*       inpolicy;           /**< policy to use instead of reading polfname, or NULL */
    SCIP_FEAT*         feat;
+   int                featmask;           /**< bit mask of the features which are neither computed nor used */
+   SCIP_EVENTHDLR*    latency;            /**< active latency event handler, or NULL */
 };
 
 void SCIPnodeselpolicyPrintStatistics(
@@ -65,17 +71,28 @@ SCIP_DECL_NODESELINIT(nodeselInitPolicy)
    nodeseldata = SCIPnodeselGetData(nodesel);
    assert(nodeseldata != NULL);
 
-   /* read policy */
+   /* read policy, unless it was handed over in memory */
    SCIP_CALL( SCIPpolicyCreate(scip, &nodeseldata->policy) );
-   assert(nodeseldata->polfname != NULL);
-   SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeseldata->polfname, &nodeseldata->policy) );
+   if( nodeseldata->inpolicy != NULL )
+   {
+      SCIP_CALL( SCIPpolicyCopy(scip, nodeseldata->inpolicy, nodeseldata->policy) );
+   }
+   else
+   {
+      assert(nodeseldata->polfname != NULL);
+      SCIP_CALL( SCIPreadLIBSVMPolicy(scip, nodeseldata->polfname, &nodeseldata->policy) );
+   }
    assert(nodeseldata->policy->weights != NULL);
   
+   /* time the callbacks if the latency event handler is active */
+   nodeseldata->latency = SCIPeventhdlrlatencyFind(scip);
+
    /* create feat */
    nodeseldata->feat = NULL;
    SCIP_CALL( SCIPfeatCreate(scip, &nodeseldata->feat, SCIP_FEATNODESEL_SIZE) );
    assert(nodeseldata->feat != NULL);
    SCIPfeatSetMaxDepth(nodeseldata->feat, SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
+   SCIPfeatSetMask(nodeseldata->feat, (unsigned int)nodeseldata->featmask);
   
    return SCIP_OKAY;
 }
@@ -117,7 +134,7 @@ SCIP_DECL_NODESELFREE(nodeselFreePolicy)
 
 /** node selection method of node selector */
 static
-SCIP_DECL_NODESELSELECT(nodeselSelectPolicy)
+SCIP_DECL_NODESELSELECT(selectNodePolicy)
 {
    SCIP_NODESELDATA* nodeseldata;
    SCIP_NODE** children;
@@ -150,7 +167,7 @@ SCIP_DECL_NODESELSELECT(nodeselSelectPolicy)
 
 /** node comparison method of policy node selector */
 static
-SCIP_DECL_NODESELCOMP(nodeselCompPolicy)
+SCIP_DECL_NODESELCOMP(compareNodesPolicy)
 {  /*lint --e{715}*/
    SCIP_Real score1;
    SCIP_Real score2;
@@ -197,10 +214,70 @@ SCIP_DECL_NODESELCOMP(nodeselCompPolicy)
    }
 }
 
+/** node selection method of node selector, timed by the latency event handler and traced by the probes */
+static
+SCIP_DECL_NODESELSELECT(nodeselSelectPolicy)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   SCIP_PROBE_CHILDREN(scip, NODESEL_NAME);
+
+   start = nodeseldata->latency != NULL ? SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT) : 0;
+   SCIP_CALL( selectNodePolicy(scip, nodesel, selnode) );
+   if( nodeseldata->latency != NULL )
+      SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_SELECT, start);
+
+   SCIP_PROBE_NODE_SELECT(NODESEL_NAME, *selnode);
+
+   return SCIP_OKAY;
+}
+
+/** node comparison method of node selector, timed by the latency event handler */
+static
+SCIP_DECL_NODESELCOMP(nodeselCompPolicy)
+{
+   SCIP_NODESELDATA* nodeseldata;
+   SCIP_Longint start;
+   int result;
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   if( nodeseldata->latency == NULL )
+      return compareNodesPolicy(scip, nodesel, node1, node2);
+
+   start = SCIPeventhdlrlatencyStart(nodeseldata->latency, SCIP_LATENCYHOOK_COMP);
+   result = compareNodesPolicy(scip, nodesel, node1, node2);
+   SCIPeventhdlrlatencyAdd(nodeseldata->latency, SCIP_LATENCYHOOK_COMP, start);
+
+   return result;
+}
+
 /*
  * node selector specific interface methods
  */
 
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+void SCIPnodeselpolicySetPolicy(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   )
+{
+   SCIP_NODESELDATA* nodeseldata;
+
+   assert(nodesel != NULL);
+   assert(strcmp(SCIPnodeselGetName(nodesel), NODESEL_NAME) == 0);
+
+   nodeseldata = SCIPnodeselGetData(nodesel);
+   assert(nodeseldata != NULL);
+
+   nodeseldata->inpolicy = policy;
+}
+
 /** creates the uct node selector and includes it in SCIP */
 SCIP_RETCODE SCIPincludeNodeselPolicy(
    SCIP*                 scip                /**< SCIP data structure */
@@ -213,7 +290,9 @@ SCIP_RETCODE SCIPincludeNodeselPolicy(
    SCIP_CALL( SCIPallocBlockMemory(scip, &nodeseldata) );
 
    nodesel = NULL;
+   nodeseldata->latency = NULL;
    nodeseldata->polfname = NULL;
+   nodeseldata->inpolicy = NULL;
 
    /* use SCIPincludeNodeselBasic() plus setter functions if you want to set callbacks one-by-one and your code should
     * compile independent of new callbacks being added in future SCIP versions
@@ -234,6 +313,10 @@ SCIP_RETCODE SCIPincludeNodeselPolicy(
          "nodeselection/"NODESEL_NAME"/polfname",
          "name of the policy model file",
          &nodeseldata->polfname, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip,
+         "nodeselection/"NODESEL_NAME"/featmask",
+         "bit mask of the features which are neither computed nor used by the policy (bit i: feature i of type_feat.h)",
+         &nodeseldata->featmask, FALSE, DEFAULT_FEATMASK, 0, (1 << SCIP_FEATNODESEL_SIZE) - 1, NULL, NULL) );
 
    return SCIP_OKAY;
 }
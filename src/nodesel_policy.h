@@ -23,6 +23,7 @@
 
 #include "scip/scip.h"
 #include "feat.h"
+#include "struct_policy.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +42,13 @@ void SCIPnodeselpolicyPrintStatistics(
    FILE*                 file
    );
 
+/** sets the policy to use instead of reading the policy model file; the policy is copied when the solve starts */
+EXTERN
+void SCIPnodeselpolicySetPolicy(
+   SCIP_NODESEL*         nodesel,            /**< node selector */
+   SCIP_POLICY*          policy              /**< policy, or NULL to read the policy model file */
+   );
+
 #ifdef __cplusplus
 }
 #endif
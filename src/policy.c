@@ -5,12 +5,19 @@
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "scip/def.h"
 #include "feat.h"
 #include "struct_feat.h"
 #include "policy.h"
+#include "eventhdlr_effort.h"
+#include "eventhdlr_latency.h"
+#include "probes.h"
 
-#define HEADERSIZE_LIBSVM       6 
+#define DEPTHBUCKETS_KEY        "depth_buckets"   /**< header line of the quantile depth buckets of a policy */
 
 SCIP_RETCODE SCIPpolicyCreate(
    SCIP*              scip,
@@ -23,6 +30,9 @@ SCIP_RETCODE SCIPpolicyCreate(
    SCIP_CALL( SCIPallocBlockMemory(scip, policy) );
    (*policy)->weights = NULL;
    (*policy)->size = 0;
+   (*policy)->depthbounds = NULL;
+   (*policy)->depthbuckets = NULL;
+   (*policy)->ndepthbounds = 0;
 
    return SCIP_OKAY;
 }
@@ -34,21 +44,56 @@ SCIP_RETCODE SCIPpolicyFree(
 {
    assert(scip != NULL);
    assert(policy != NULL);
-   assert((*policy)->weights != NULL);
 
-   BMSfreeMemoryArray(&(*policy)->weights);
+   /* the weights of an online policy that was never updated are not allocated */
+   BMSfreeMemoryArrayNull(&(*policy)->weights);
+   SCIPpolicyFreeDepthBuckets(*policy);
    SCIPfreeBlockMemory(scip, policy);
 
    return SCIP_OKAY;
 }
 
+/** parses the bounds of the quantile depth buckets from their header line; returns the number of bounds or -1 if
+ *  they are not positive and increasing
+ */
+static
+int parseDepthBounds(
+   const char*        line,        /**< header line without the key */
+   int*               bounds,      /**< array to store the bounds */
+   int                maxbounds    /**< size of the array */
+   )
+{
+   int nbounds = 0;
+
+   for( ;; )
+   {
+      char* end;
+      long bound;
+
+      bound = strtol(line, &end, 10);
+      if( end == line )
+         break;
+      if( nbounds >= maxbounds || bound <= (nbounds == 0 ? 0 : bounds[nbounds - 1]) || bound > INT_MAX )
+         return -1;
+      bounds[nbounds++] = (int)bound;
+      line = end;
+   }
+
+   return nbounds;
+}
+
+/** read policy (model) in LIBSVM format; the header may hold the quantile depth buckets of the policy */
 SCIP_RETCODE SCIPreadLIBSVMPolicy(
    SCIP*              scip,
    char*              fname,
    SCIP_POLICY**      policy       
    )
 {
+   int bounds[SCIP_MAXSTRLEN / 2];
+   int nbounds = 0;
+   int nheaderlines = 0;
    int nlines = 0;
+   SCIP_Bool inheader = TRUE;
    int i;
    char buffer[SCIP_MAXSTRLEN];
 
@@ -60,13 +105,30 @@ SCIP_RETCODE SCIPreadLIBSVMPolicy(
       return SCIP_NOFILE;
    }
 
-   /* find out weight vector size */
+   /* find out weight vector size; the header ends with the line "w" */
    while( fgets(buffer, (int)sizeof(buffer), file) != NULL )
-      nlines++;
-   /* don't count libsvm model header */
-   assert(nlines >= HEADERSIZE_LIBSVM);
-   (*policy)->size = nlines - HEADERSIZE_LIBSVM;
+   {
+      if( !inheader )
+      {
+         nlines++;
+         continue;
+      }
+      nheaderlines++;
+      if( strncmp(buffer, DEPTHBUCKETS_KEY" ", sizeof(DEPTHBUCKETS_KEY)) == 0 )
+      {
+         nbounds = parseDepthBounds(buffer + sizeof(DEPTHBUCKETS_KEY), bounds, (int)(sizeof(bounds) / sizeof(*bounds)));
+         if( nbounds < 0 )
+         {
+            SCIPerrorMessage("invalid depth buckets in policy model <%s>\n", fname);
+            fclose(file);
+            return SCIP_READERROR;
+         }
+      }
+      else if( buffer[0] == 'w' && (buffer[1] == '\n' || buffer[1] == '\0') )
+         inheader = FALSE;
+   }
    fclose(file);
+   (*policy)->size = nlines;
    if( (*policy)->size == 0 )
    {
       SCIPerrorMessage("empty policy model\n");
@@ -74,11 +136,12 @@ SCIP_RETCODE SCIPreadLIBSVMPolicy(
    }
 
    SCIP_CALL( SCIPallocMemoryArray(scip, &(*policy)->weights, (*policy)->size) );
+   SCIP_CALL( SCIPpolicySetDepthBuckets(*policy, bounds, nbounds) );
 
    /* have to reopen to read weights */
    file = fopen(fname, "r");
    /* skip header */
-   for( i = 0; i < HEADERSIZE_LIBSVM; i++ )
+   for( i = 0; i < nheaderlines; i++ )
       fgets(buffer, (int)sizeof(buffer), file);
    for( i = 0; i < (*policy)->size; i++ )
       fscanf(file, "%"SCIP_REAL_FORMAT, &((*policy)->weights[i]));
@@ -91,6 +154,214 @@ SCIP_RETCODE SCIPreadLIBSVMPolicy(
    return SCIP_OKAY;
 }
 
+/** write policy (model) in LIBSVM format, such that it can be read by SCIPreadLIBSVMPolicy() */
+SCIP_RETCODE SCIPwriteLIBSVMPolicy(
+   SCIP_POLICY*       policy,
+   const char*        fname,
+   const char*        solvertype
+   )
+{
+   int i;
+   FILE* file;
+
+   assert(policy != NULL);
+   assert(policy->weights != NULL);
+
+   file = fopen(fname, "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   /* header of a two-class LIBLINEAR model without bias, followed by the quantile depth buckets if there are any */
+   fprintf(file, "solver_type %s\n", solvertype);
+   fprintf(file, "nr_class 2\n");
+   fprintf(file, "label 1 -1\n");
+   fprintf(file, "nr_feature %d\n", policy->size);
+   fprintf(file, "bias -1\n");
+   if( policy->ndepthbounds > 0 )
+   {
+      fprintf(file, DEPTHBUCKETS_KEY);
+      for( i = 0; i < policy->ndepthbounds; i++ )
+         fprintf(file, " %d", policy->depthbounds[i]);
+      fprintf(file, "\n");
+   }
+   fprintf(file, "w\n");
+   for( i = 0; i < policy->size; i++ )
+      fprintf(file, "%.16g \n", policy->weights[i]);
+
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** copy the weights and the depth buckets of a policy to another policy, replacing its weights */
+SCIP_RETCODE SCIPpolicyCopy(
+   SCIP*              scip,
+   SCIP_POLICY*       source,
+   SCIP_POLICY*       target
+   )
+{
+   assert(scip != NULL);
+   assert(source != NULL);
+   assert(target != NULL);
+
+   BMSfreeMemoryArrayNull(&target->weights);
+   target->size = source->size;
+   if( source->weights != NULL )
+   {
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &target->weights, source->weights, source->size) );
+   }
+   SCIP_CALL( SCIPpolicySetDepthBuckets(target, source->depthbounds, source->ndepthbounds) );
+
+   return SCIP_OKAY;
+}
+
+/** sets quantile depth buckets of the policy, replacing its depth buckets: a node is in depth bucket j if its depth is
+ *  at least bounds[j-1] (or j = 0) and less than bounds[j] (or j = nbounds); with nbounds = 0, the policy uses the ten
+ *  buckets of equal width of SCIPfeatCalcBucket()
+ *
+ *  The bucket of each depth below the last bound is looked up in a table, so that the offset of a node costs the same
+ *  as with buckets of equal width.
+ */
+SCIP_RETCODE SCIPpolicySetDepthBuckets(
+   SCIP_POLICY*       policy,
+   const int*         bounds,
+   int                nbounds
+   )
+{
+   int depth;
+   int j;
+
+   assert(policy != NULL);
+   assert(nbounds >= 0);
+   assert(nbounds == 0 || bounds != NULL);
+
+   SCIPpolicyFreeDepthBuckets(policy);
+   if( nbounds == 0 )
+      return SCIP_OKAY;
+
+   SCIP_ALLOC( BMSduplicateMemoryArray(&policy->depthbounds, bounds, nbounds) );
+   SCIP_ALLOC( BMSallocMemoryArray(&policy->depthbuckets, bounds[nbounds - 1]) );
+   policy->ndepthbounds = nbounds;
+
+   j = 0;
+   for( depth = 0; depth < bounds[nbounds - 1]; depth++ )
+   {
+      while( depth >= bounds[j] )
+      {
+         assert(j == 0 || bounds[j] > bounds[j - 1]);
+         j++;
+      }
+      policy->depthbuckets[depth] = j;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees the quantile depth buckets of the policy */
+void SCIPpolicyFreeDepthBuckets(
+   SCIP_POLICY*       policy
+   )
+{
+   assert(policy != NULL);
+
+   BMSfreeMemoryArrayNull(&policy->depthbounds);
+   BMSfreeMemoryArrayNull(&policy->depthbuckets);
+   policy->ndepthbounds = 0;
+}
+
+/** returns the bucket of a node with the given depth and bound type in the weight vector of the policy; the weights
+ *  of its features start at the feature size times the bucket
+ */
+int SCIPpolicyCalcBucket(
+   SCIP_POLICY*       policy,
+   int                depth,
+   int                maxdepth,
+   SCIP_BOUNDTYPE     boundtype
+   )
+{
+   int bucket;
+
+   assert(policy != NULL);
+   assert(depth >= 0);
+
+   if( policy->depthbounds == NULL )
+      return SCIPfeatCalcBucket(depth, maxdepth, boundtype);
+
+   bucket = depth < policy->depthbounds[policy->ndepthbounds - 1]
+      ? policy->depthbuckets[depth] : policy->ndepthbounds;
+
+   return 2 * bucket + (int)boundtype;
+}
+
+/** returns the number of buckets of the policy for a problem with the given maximum depth */
+int SCIPpolicyCalcNBuckets(
+   SCIP_POLICY*       policy,
+   int                maxdepth
+   )
+{
+   assert(policy != NULL);
+
+   if( policy->depthbounds == NULL )
+      return SCIPfeatCalcNBuckets(maxdepth);
+
+   return 2 * (policy->ndepthbounds + 1);
+}
+
+/** gets the smallest and the largest depth of the nodes in a bucket of the policy */
+void SCIPpolicyCalcBucketDepths(
+   SCIP_POLICY*       policy,
+   int                bucket,
+   int                maxdepth,
+   int*               mindepth,
+   int*               lastdepth
+   )
+{
+   int j;
+
+   assert(policy != NULL);
+   assert(bucket >= 0);
+   assert(mindepth != NULL);
+   assert(lastdepth != NULL);
+
+   if( policy->depthbounds == NULL )
+   {
+      SCIPfeatCalcBucketDepths(bucket, maxdepth, mindepth, lastdepth);
+      return;
+   }
+
+   j = bucket / 2;
+   assert(j <= policy->ndepthbounds);
+   *mindepth = j == 0 ? 0 : policy->depthbounds[j - 1];
+   *lastdepth = j < policy->ndepthbounds ? policy->depthbounds[j] - 1 : MAX(maxdepth, *mindepth);
+}
+
+/** returns the bucket of the node of the features in the weight vector of the policy */
+int SCIPpolicyGetBucket(
+   SCIP_POLICY*       policy,
+   SCIP_FEAT*         feat
+   )
+{
+   assert(policy != NULL);
+   assert(feat != NULL);
+
+   return SCIPpolicyCalcBucket(policy, feat->depth, feat->maxdepth, feat->boundtype);
+}
+
+/** returns the offset of the weights of the features in the weight vector of the policy */
+int SCIPpolicyGetOffset(
+   SCIP_POLICY*       policy,
+   SCIP_FEAT*         feat
+   )
+{
+   assert(feat != NULL);
+
+   return feat->size * SCIPpolicyGetBucket(policy, feat);
+}
+
 /** calculate score of a node given its feature and the policy weight vector */
 void SCIPcalcNodeScore(
    SCIP_NODE*         node,
@@ -98,11 +369,12 @@ void SCIPcalcNodeScore(
    SCIP_POLICY*       policy
    )
 {
-   int offset = SCIPfeatGetOffset(feat);
+   int offset = SCIPpolicyGetOffset(policy, feat);
    int i;
    SCIP_Real score = 0;
    SCIP_Real* weights = policy->weights;
    SCIP_Real* featvals = SCIPfeatGetVals(feat);
+   SCIP_Longint start = feat->latency != NULL ? SCIPeventhdlrlatencyStart(feat->latency, SCIP_LATENCYHOOK_SCORE) : 0;
 
    if( (offset + SCIPfeatGetSize(feat)) > policy->size )
       score = 0;
@@ -112,7 +384,113 @@ void SCIPcalcNodeScore(
          score += featvals[i] * weights[i+offset];
    }
 
+   if( feat->effort != NULL )
+      SCIPeventhdlreffortAddScore(feat->effort, SCIPfeatGetSize(feat));
+
    SCIPnodeSetScore(node, score);
+   SCIP_PROBE_NODE_SCORE(node, score);
+
+   if( feat->latency != NULL )
+      SCIPeventhdlrlatencyAdd(feat->latency, SCIP_LATENCYHOOK_SCORE, start);
+
    SCIPdebugMessage("score of node  #%"SCIP_LONGINT_FORMAT": %f\n", SCIPnodeGetNumber(node), SCIPnodeGetScore(node));
 }
 
+/** online update of the policy on the example (feat1 - feat2) with the given label, or (feat1) if feat2 is NULL
+ *
+ *  The update minimizes the hinge loss of the example weighted by SCIPfeatGetWeight(feat1), either by a
+ *  passive-aggressive step (PA-I with aggressiveness C) or by a subgradient step with learning rate C/sqrt(t).
+ *  The weight vector grows if the depth of the example is beyond the policy.
+ */
+SCIP_RETCODE SCIPpolicyUpdate(
+   SCIP*              scip,
+   SCIP_POLICY*       policy,
+   SCIP_FEAT*         feat1,
+   SCIP_FEAT*         feat2,
+   int                label,
+   char               rule,
+   SCIP_Real          C,
+   SCIP_Longint       t,
+   SCIP_Real*         loss
+   )
+{
+   SCIP_Real* vals1;
+   SCIP_Real* vals2;
+   SCIP_Real margin = 0;
+   SCIP_Real sqnorm = 0;
+   SCIP_Real weight;
+   SCIP_Real tau;
+   int offset1;
+   int offset2;
+   int size;
+   int i;
+
+   assert(scip != NULL);
+   assert(policy != NULL);
+   assert(feat1 != NULL);
+   assert(feat2 == NULL || feat2->size == feat1->size);
+   assert(rule == 'p' || rule == 's');
+   assert(loss != NULL);
+
+   size = SCIPfeatGetSize(feat1);
+   vals1 = SCIPfeatGetVals(feat1);
+   vals2 = feat2 != NULL ? SCIPfeatGetVals(feat2) : NULL;
+   offset1 = SCIPpolicyGetOffset(policy, feat1);
+   offset2 = feat2 != NULL ? SCIPpolicyGetOffset(policy, feat2) : offset1;
+
+   if( MAX(offset1, offset2) + size > policy->size )
+   {
+      int newsize = MAX(offset1, offset2) + size;
+
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &policy->weights, newsize) );
+      for( i = policy->size; i < newsize; i++ )
+         policy->weights[i] = 0.0;
+      policy->size = newsize;
+   }
+
+   for( i = 0; i < size; i++ )
+   {
+      margin += policy->weights[offset1 + i] * vals1[i];
+      if( vals2 != NULL )
+         margin -= policy->weights[offset2 + i] * vals2[i];
+   }
+   margin *= label;
+   if( feat1->effort != NULL )
+      SCIPeventhdlreffortAddScore(feat1->effort, vals2 != NULL ? 2 * size : size);
+
+   if( vals2 != NULL && offset1 == offset2 )
+   {
+      for( i = 0; i < size; i++ )
+         sqnorm += (vals1[i] - vals2[i]) * (vals1[i] - vals2[i]);
+   }
+   else
+   {
+      for( i = 0; i < size; i++ )
+      {
+         sqnorm += vals1[i] * vals1[i];
+         if( vals2 != NULL )
+            sqnorm += vals2[i] * vals2[i];
+      }
+   }
+
+   *loss = MAX(1.0 - margin, 0.0);
+   if( *loss == 0.0 || sqnorm == 0.0 )
+      return SCIP_OKAY;
+
+   weight = SCIPfeatGetWeight(feat1);
+   if( rule == 'p' )
+      tau = MIN(C * weight, *loss / sqnorm);
+   else
+      tau = C * weight / sqrt((SCIP_Real)MAX(t, 1));
+
+   for( i = 0; i < size; i++ )
+   {
+      policy->weights[offset1 + i] += tau * label * vals1[i];
+      if( vals2 != NULL )
+         policy->weights[offset2 + i] -= tau * label * vals2[i];
+   }
+   if( feat1->effort != NULL )
+      SCIPeventhdlreffortAddScore(feat1->effort, vals2 != NULL ? 2 * size : size);
+
+   return SCIP_OKAY;
+}
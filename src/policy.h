@@ -36,6 +36,81 @@ SCIP_RETCODE SCIPreadLIBSVMPolicy(
    SCIP_POLICY**      policy
    );
 
+/** write policy (model) in LIBSVM format */
+extern
+SCIP_RETCODE SCIPwriteLIBSVMPolicy(
+   SCIP_POLICY*       policy,
+   const char*        fname,
+   const char*        solvertype
+   );
+
+/** copy the weights of a policy to another policy, replacing its weights */
+extern
+SCIP_RETCODE SCIPpolicyCopy(
+   SCIP*              scip,
+   SCIP_POLICY*       source,
+   SCIP_POLICY*       target
+   );
+
+/** sets quantile depth buckets of the policy, replacing its depth buckets: a node is in depth bucket j if its depth is
+ *  at least bounds[j-1] (or j = 0) and less than bounds[j] (or j = nbounds); with nbounds = 0, the policy uses the ten
+ *  buckets of equal width of SCIPfeatCalcBucket()
+ */
+extern
+SCIP_RETCODE SCIPpolicySetDepthBuckets(
+   SCIP_POLICY*       policy,
+   const int*         bounds,
+   int                nbounds
+   );
+
+/** frees the quantile depth buckets of the policy */
+extern
+void SCIPpolicyFreeDepthBuckets(
+   SCIP_POLICY*       policy
+   );
+
+/** returns the bucket of a node with the given depth and bound type in the weight vector of the policy; the weights
+ *  of its features start at the feature size times the bucket
+ */
+extern
+int SCIPpolicyCalcBucket(
+   SCIP_POLICY*       policy,
+   int                depth,
+   int                maxdepth,
+   SCIP_BOUNDTYPE     boundtype
+   );
+
+/** returns the number of buckets of the policy for a problem with the given maximum depth */
+extern
+int SCIPpolicyCalcNBuckets(
+   SCIP_POLICY*       policy,
+   int                maxdepth
+   );
+
+/** gets the smallest and the largest depth of the nodes in a bucket of the policy */
+extern
+void SCIPpolicyCalcBucketDepths(
+   SCIP_POLICY*       policy,
+   int                bucket,
+   int                maxdepth,
+   int*               mindepth,
+   int*               lastdepth
+   );
+
+/** returns the bucket of the node of the features in the weight vector of the policy */
+extern
+int SCIPpolicyGetBucket(
+   SCIP_POLICY*       policy,
+   SCIP_FEAT*         feat
+   );
+
+/** returns the offset of the weights of the features in the weight vector of the policy */
+extern
+int SCIPpolicyGetOffset(
+   SCIP_POLICY*       policy,
+   SCIP_FEAT*         feat
+   );
+
 /** calculate score of a node given its feature and the policy weight vector */
 extern
 void SCIPcalcNodeScore(
@@ -44,6 +119,20 @@ void SCIPcalcNodeScore(
    SCIP_POLICY*       policy
    );
 
+/** online update of the policy on the example (feat1 - feat2) with the given label, or (feat1) if feat2 is NULL */
+extern
+SCIP_RETCODE SCIPpolicyUpdate(
+   SCIP*              scip,
+   SCIP_POLICY*       policy,
+   SCIP_FEAT*         feat1,
+   SCIP_FEAT*         feat2,
+   int                label,
+   char               rule,
+   SCIP_Real          C,
+   SCIP_Longint       t,
+   SCIP_Real*         loss
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,211 @@
+/**@file   pool.c
+ * @brief  pool of worker threads that run independent jobs
+ * @author He He
+ *
+ * Each worker owns a double-ended queue of jobs, filled largest-first (longest processing time first). The owner takes
+ * jobs from the front, idle workers steal from the back of the fullest queue, so that the long jobs start early and the
+ * short ones fill the gaps at the end.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <pthread.h>
+#include "scip/def.h"
+#include "pool.h"
+
+/** double-ended queue of the jobs of a worker */
+struct PoolDeque
+{
+   int*                 jobs;               /**< jobs of the worker, by decreasing cost */
+   int                  head;               /**< position of the next job of the owner */
+   int                  tail;               /**< position after the last job, taken by thieves */
+   pthread_mutex_t      lock;               /**< lock of head and tail */
+};
+typedef struct PoolDeque POOLDEQUE;
+
+/** shared data of the workers */
+struct Pool
+{
+   POOLDEQUE*           deques;             /**< queue of each worker */
+   int                  nworkers;           /**< number of workers */
+   SCIP_POOLJOB         jobfunc;            /**< function running a job */
+   void*                data;               /**< data passed to the job function */
+   SCIP_RETCODE*        retcodes;           /**< return code of each job */
+};
+typedef struct Pool POOL;
+
+/** argument of a worker thread */
+struct PoolWorker
+{
+   POOL*                pool;               /**< shared data */
+   int                  id;                 /**< number of the worker */
+};
+typedef struct PoolWorker POOLWORKER;
+
+/** takes the next job of a worker from its own queue or steals one; returns -1 if no job is left */
+static
+int takeJob(
+   POOL*                pool,
+   int                  id
+   )
+{
+   POOLDEQUE* own = &pool->deques[id];
+   int job = -1;
+
+   pthread_mutex_lock(&own->lock);
+   if( own->head < own->tail )
+      job = own->jobs[own->head++];
+   pthread_mutex_unlock(&own->lock);
+
+   while( job == -1 )
+   {
+      int victim = -1;
+      int maxleft = 0;
+      int k;
+
+      /* the sizes may change before the victim is locked again, then the search is repeated */
+      for( k = 0; k < pool->nworkers; k++ )
+      {
+         int left;
+
+         if( k == id )
+            continue;
+         pthread_mutex_lock(&pool->deques[k].lock);
+         left = pool->deques[k].tail - pool->deques[k].head;
+         pthread_mutex_unlock(&pool->deques[k].lock);
+
+         if( left > maxleft )
+         {
+            victim = k;
+            maxleft = left;
+         }
+      }
+      if( victim == -1 )
+         break;
+
+      pthread_mutex_lock(&pool->deques[victim].lock);
+      if( pool->deques[victim].head < pool->deques[victim].tail )
+         job = pool->deques[victim].jobs[--pool->deques[victim].tail];
+      pthread_mutex_unlock(&pool->deques[victim].lock);
+   }
+
+   return job;
+}
+
+/** runs jobs until none is left */
+static
+void* poolWorker(
+   void*                arg
+   )
+{
+   POOLWORKER* worker = (POOLWORKER*)arg;
+   POOL* pool = worker->pool;
+   int job;
+
+   while( (job = takeJob(pool, worker->id)) != -1 )
+      pool->retcodes[job] = pool->jobfunc(pool->data, job, worker->id);
+
+   return NULL;
+}
+
+/** runs the jobs on nworkers threads (the calling thread is worker 0) */
+SCIP_RETCODE SCIPpoolRun(
+   SCIP_Real*           costs,
+   int                  njobs,
+   int                  nworkers,
+   SCIP_POOLJOB         jobfunc,
+   void*                data,
+   SCIP_RETCODE*        retcodes
+   )
+{
+   POOL pool;
+   POOLWORKER* workers;
+   pthread_t* threads;
+   SCIP_Bool* started;
+   SCIP_RETCODE retcode;
+   int* order;
+   int j;
+   int k;
+
+   assert(njobs >= 0);
+   assert(nworkers >= 1);
+   assert(jobfunc != NULL);
+
+   if( njobs == 0 )
+      return SCIP_OKAY;
+   nworkers = MIN(nworkers, njobs);
+
+   SCIP_ALLOC( BMSallocMemoryArray(&order, njobs) );
+   for( j = 0; j < njobs; j++ )
+      order[j] = j;
+   if( costs != NULL )
+   {
+      SCIP_Real* sortedcosts;
+
+      SCIP_ALLOC( BMSduplicateMemoryArray(&sortedcosts, costs, njobs) );
+      SCIPsortDownRealInt(sortedcosts, order, njobs);
+      BMSfreeMemoryArray(&sortedcosts);
+   }
+
+   pool.nworkers = nworkers;
+   pool.jobfunc = jobfunc;
+   pool.data = data;
+   SCIP_ALLOC( BMSallocMemoryArray(&pool.retcodes, njobs) );
+   SCIP_ALLOC( BMSallocMemoryArray(&pool.deques, nworkers) );
+   SCIP_ALLOC( BMSallocMemoryArray(&workers, nworkers) );
+   SCIP_ALLOC( BMSallocMemoryArray(&threads, nworkers) );
+   SCIP_ALLOC( BMSallocMemoryArray(&started, nworkers) );
+
+   /* deal the jobs round-robin, so that each queue starts with one of the largest jobs */
+   for( k = 0; k < nworkers; k++ )
+   {
+      SCIP_ALLOC( BMSallocMemoryArray(&pool.deques[k].jobs, njobs / nworkers + 1) );
+      pool.deques[k].head = 0;
+      pool.deques[k].tail = 0;
+      pthread_mutex_init(&pool.deques[k].lock, NULL);
+      workers[k].pool = &pool;
+      workers[k].id = k;
+   }
+   for( j = 0; j < njobs; j++ )
+   {
+      POOLDEQUE* deque = &pool.deques[j % nworkers];
+      deque->jobs[deque->tail++] = order[j];
+   }
+
+   started[0] = FALSE;
+   for( k = 1; k < nworkers; k++ )
+      started[k] = (pthread_create(&threads[k], NULL, poolWorker, &workers[k]) == 0);
+
+   /* the calling thread also works; the queues of threads that could not be started are stolen */
+   (void) poolWorker(&workers[0]);
+
+   for( k = 1; k < nworkers; k++ )
+   {
+      if( started[k] )
+         pthread_join(threads[k], NULL);
+   }
+
+   retcode = SCIP_OKAY;
+   for( j = 0; j < njobs; j++ )
+   {
+      if( retcodes != NULL )
+         retcodes[j] = pool.retcodes[j];
+      if( retcode == SCIP_OKAY && pool.retcodes[j] != SCIP_OKAY )
+         retcode = pool.retcodes[j];
+   }
+
+   for( k = 0; k < nworkers; k++ )
+   {
+      pthread_mutex_destroy(&pool.deques[k].lock);
+      BMSfreeMemoryArray(&pool.deques[k].jobs);
+   }
+   BMSfreeMemoryArray(&started);
+   BMSfreeMemoryArray(&threads);
+   BMSfreeMemoryArray(&workers);
+   BMSfreeMemoryArray(&pool.deques);
+   BMSfreeMemoryArray(&pool.retcodes);
+   BMSfreeMemoryArray(&order);
+
+   return retcode;
+}
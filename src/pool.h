@@ -0,0 +1,42 @@
+/**@file   pool.h
+ * @brief  pool of worker threads that run independent jobs
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_POOL_H__
+#define __SCIP_POOL_H__
+
+#include "scip/def.h"
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** job of the pool: runs job number job on worker number worker */
+typedef SCIP_RETCODE (*SCIP_POOLJOB)(void* data, int job, int worker);
+
+/** runs the jobs on nworkers threads (the calling thread is worker 0)
+ *
+ *  The jobs are sorted by decreasing predicted cost and dealt round-robin to one double-ended queue per worker. A worker
+ *  takes the jobs from the front of its own queue; when it is empty, it steals from the back of the queue with the most
+ *  jobs left. Jobs must not depend on each other. The return code of each job is stored in retcodes (if not NULL); the
+ *  first error in job order is returned.
+ */
+extern
+SCIP_RETCODE SCIPpoolRun(
+   SCIP_Real*           costs,              /**< predicted cost of each job, or NULL to run them in order */
+   int                  njobs,              /**< number of jobs */
+   int                  nworkers,           /**< number of workers */
+   SCIP_POOLJOB         jobfunc,            /**< function running a job */
+   void*                data,               /**< data passed to the job function */
+   SCIP_RETCODE*        retcodes            /**< array to store the return code of each job, or NULL */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/**@file   probes.h
+ * @brief  static tracepoints (USDT) of the node selection and pruning plugins
+ * @author He He
+ *
+ * The probes are compiled in only if WITH_SDT is defined (make SDT=true), which needs <sys/sdt.h> from SystemTap.
+ * Otherwise they expand to nothing, so their arguments are not even evaluated. A compiled-in probe is a single nop in
+ * the binary until a tracer attaches to it, but its arguments are evaluated on every pass; SCIP_PROBE_CHILDREN() also
+ * fetches the children of the focus node and loops over them on every selection, attached or not. The probes have no
+ * semaphores, so that perf probe, which does not set them, sees every event. Tracers attach e.g. with
+ *
+ *    bpftrace -e 'usdt:bin/scipdagger:scipdagger:node__prune { @[str(arg0), arg3] = count(); }'
+ *    perf probe -x bin/scipdagger sdt_scipdagger:node__select
+ *
+ * The probes of provider scipdagger and their arguments are:
+ * - node__create(plugin, number, depth, lowerbound): a child of the focus node is seen by a node selector
+ * - node__score(number, depth, score): a policy has scored a node (SCIPcalcNodeScore())
+ * - node__select(plugin, number, depth, lowerbound): a node selector has selected a node (number -1 if none)
+ * - node__prune(plugin, number, depth, prune): a node pruner has decided on a node
+ * - oracle__label(number, depth, isoptimal): the oracle has labeled a node (SCIPnodeCheckOptimal())
+ * - trj__write(plugin, label, nfeatures): an example has been written to the trajectory file or the dataset
+ *
+ * plugin is the name of the plugin as a C string, prefixed by nodesel/ or nodepru/ for trj__write.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PROBES_H__
+#define __SCIP_PROBES_H__
+
+#ifdef WITH_SDT
+
+#include <sys/sdt.h>
+
+#include "scip/scip.h"
+
+#define SCIP_PROBE_NODE_CREATE(plugin, node)                                                                     \
+   DTRACE_PROBE4(scipdagger, node__create, plugin, SCIPnodeGetNumber(node), SCIPnodeGetDepth(node),               \
+      SCIPnodeGetLowerbound(node))
+
+/** fires node__create for all children of the focus node; the children are created by branching, so the first time
+ *  a plugin sees them is when the next node is selected (the loop runs whether or not a tracer is attached)
+ */
+#define SCIP_PROBE_CHILDREN(scip, plugin)                                                                        \
+   do                                                                                                            \
+   {                                                                                                             \
+      SCIP_NODE** probechildren_;                                                                                \
+      int nprobechildren_;                                                                                       \
+      int probei_;                                                                                               \
+      if( SCIPgetChildren(scip, &probechildren_, &nprobechildren_) == SCIP_OKAY )                                \
+      {                                                                                                          \
+         for( probei_ = 0; probei_ < nprobechildren_; probei_++ )                                                \
+            SCIP_PROBE_NODE_CREATE(plugin, probechildren_[probei_]);                                             \
+      }                                                                                                          \
+   }                                                                                                             \
+   while( FALSE )
+
+#define SCIP_PROBE_NODE_SCORE(node, score)                                                                       \
+   DTRACE_PROBE3(scipdagger, node__score, SCIPnodeGetNumber(node), SCIPnodeGetDepth(node), score)
+
+#define SCIP_PROBE_NODE_SELECT(plugin, node)                                                                     \
+   DTRACE_PROBE4(scipdagger, node__select, plugin, (node) == NULL ? -1LL : (long long)SCIPnodeGetNumber(node),   \
+      (node) == NULL ? -1 : SCIPnodeGetDepth(node), (node) == NULL ? 0.0 : SCIPnodeGetLowerbound(node))
+
+#define SCIP_PROBE_NODE_PRUNE(plugin, node, prune)                                                               \
+   DTRACE_PROBE4(scipdagger, node__prune, plugin, SCIPnodeGetNumber(node), SCIPnodeGetDepth(node), (int)(prune))
+
+#define SCIP_PROBE_ORACLE_LABEL(node, isoptimal)                                                                 \
+   DTRACE_PROBE3(scipdagger, oracle__label, SCIPnodeGetNumber(node), SCIPnodeGetDepth(node), (int)(isoptimal))
+
+#define SCIP_PROBE_TRJ_WRITE(plugin, label, nfeatures)                                                           \
+   DTRACE_PROBE3(scipdagger, trj__write, plugin, (int)(label), (int)(nfeatures))
+
+#else
+
+#define SCIP_PROBE_NODE_CREATE(plugin, node)            do {} while( FALSE )
+#define SCIP_PROBE_CHILDREN(scip, plugin)               do {} while( FALSE )
+#define SCIP_PROBE_NODE_SCORE(node, score)              do {} while( FALSE )
+#define SCIP_PROBE_NODE_SELECT(plugin, node)            do {} while( FALSE )
+#define SCIP_PROBE_NODE_PRUNE(plugin, node, prune)      do {} while( FALSE )
+#define SCIP_PROBE_ORACLE_LABEL(node, isoptimal)        do {} while( FALSE )
+#define SCIP_PROBE_TRJ_WRITE(plugin, label, nfeatures)  do {} while( FALSE )
+
+#endif
+
+#endif
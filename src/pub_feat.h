@@ -54,6 +54,15 @@ void SCIPfeatSetNConstrs(
    int           nconstrs 
    );
 
+/** sets the features which are neither computed nor used: bit i of the mask masks the feature with index i, e.g.
+ *  SCIP_FEATNODESEL_GAP; the masked features are zero
+ */
+EXTERN
+void SCIPfeatSetMask(
+   SCIP_FEAT*    feat,
+   unsigned int  mask
+   );
+
 
 #ifdef NDEBUG
 
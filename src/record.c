@@ -0,0 +1,402 @@
+/**@file   record.c
+ * @brief  methods for machine-readable per-instance result records
+ * @author He He
+ *
+ * A record holds what the evaluation scripts used to grep from the SCIP log (status, nodes, time, bounds and gap)
+ * together with the effort in work units and the statistics of the node selector and pruner. Records are written one per line, either as CSV
+ * with a header line or as JSON objects; values that are infinite or not available are left empty (CSV) or null
+ * (JSON). A paired record additionally holds the result of a default SCIP solve of the same problem under the limits
+ * measured in the policy solve.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "record.h"
+#include "nodesel_dagger.h"
+#include "nodesel_online.h"
+#include "nodepru_dagger.h"
+#include "nodepru_policy.h"
+#include "nodepru_online.h"
+#include "eventhdlr_effort.h"
+
+/** returns the name of a solution status */
+static
+const char* statusName(
+   SCIP_STATUS           status              /**< solution status */
+   )
+{
+   switch( status )
+   {
+   case SCIP_STATUS_USERINTERRUPT:
+      return "userinterrupt";
+   case SCIP_STATUS_NODELIMIT:
+      return "nodelimit";
+   case SCIP_STATUS_TOTALNODELIMIT:
+      return "totalnodelimit";
+   case SCIP_STATUS_STALLNODELIMIT:
+      return "stallnodelimit";
+   case SCIP_STATUS_TIMELIMIT:
+      return "timelimit";
+   case SCIP_STATUS_MEMLIMIT:
+      return "memlimit";
+   case SCIP_STATUS_GAPLIMIT:
+      return "gaplimit";
+   case SCIP_STATUS_SOLLIMIT:
+      return "sollimit";
+   case SCIP_STATUS_BESTSOLLIMIT:
+      return "bestsollimit";
+   case SCIP_STATUS_OPTIMAL:
+      return "optimal";
+   case SCIP_STATUS_INFEASIBLE:
+      return "infeasible";
+   case SCIP_STATUS_UNBOUNDED:
+      return "unbounded";
+   case SCIP_STATUS_INFORUNBD:
+      return "inforunbd";
+   default:
+      return "unknown";
+   }
+}
+
+/** returns the value, or SCIP_INVALID if it is infinite */
+static
+SCIP_Real finiteReal(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real             val                 /**< value */
+   )
+{
+   return SCIPisInfinity(scip, REALABS(val)) ? SCIP_INVALID : val;
+}
+
+/** writes a string field, quoted and escaped in JSON and quoted in CSV if it contains a separator */
+static
+void writeString(
+   FILE*                 file,               /**< output file */
+   const char*           name,               /**< field name */
+   const char*           val,                /**< value */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   const char* c;
+
+   if( format == SCIP_RECORDFORMAT_JSON )
+   {
+      fprintf(file, "\"%s\": \"", name);
+      for( c = val; *c != '\0'; c++ )
+      {
+         if( *c == '"' || *c == '\\' )
+            fputc('\\', file);
+         fputc(*c, file);
+      }
+      fputc('"', file);
+   }
+   else if( strpbrk(val, ",\"\n") != NULL )
+   {
+      fputc('"', file);
+      for( c = val; *c != '\0'; c++ )
+      {
+         if( *c == '"' )
+            fputc('"', file);
+         fputc(*c, file);
+      }
+      fputc('"', file);
+   }
+   else
+      fputs(val, file);
+}
+
+/** writes a real field; SCIP_INVALID is written as missing value */
+static
+void writeReal(
+   FILE*                 file,               /**< output file */
+   const char*           name,               /**< field name */
+   SCIP_Real             val,                /**< value */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   if( format == SCIP_RECORDFORMAT_JSON )
+      fprintf(file, "\"%s\": ", name);
+   if( val != SCIP_INVALID ) /*lint !e777*/
+      fprintf(file, "%.16g", val);
+   else if( format == SCIP_RECORDFORMAT_JSON )
+      fprintf(file, "null");
+}
+
+/** writes an integer field; negative values are written as missing value */
+static
+void writeInt(
+   FILE*                 file,               /**< output file */
+   const char*           name,               /**< field name */
+   SCIP_Longint          val,                /**< value */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   if( format == SCIP_RECORDFORMAT_JSON )
+      fprintf(file, "\"%s\": ", name);
+   if( val >= 0 )
+      fprintf(file, "%"SCIP_LONGINT_FORMAT, val);
+   else if( format == SCIP_RECORDFORMAT_JSON )
+      fprintf(file, "null");
+}
+
+/** fills the record of a problem that was not solved: only the instance is set, from the problem file name */
+void SCIPrecordSetNotSolved(
+   SCIP_RECORD*          record,             /**< record to fill */
+   const char*           filename            /**< problem file name */
+   )
+{
+   char tmpfilename[SCIP_MAXSTRLEN];
+   char* name;
+
+   assert(record != NULL);
+   assert(filename != NULL);
+
+   /* the instance is the file name without directory and extensions, as the .sol and .log files are named */
+   (void) SCIPsnprintf(tmpfilename, SCIP_MAXSTRLEN, "%s", filename);
+   SCIPsplitFilename(tmpfilename, NULL, &name, NULL, NULL);
+   (void) SCIPsnprintf(record->instance, SCIP_RECORD_MAXNAMELEN, "%s", name);
+
+   record->solved = FALSE;
+   record->status = SCIP_STATUS_UNKNOWN;
+   record->nnodes = -1;
+   record->time = SCIP_INVALID;
+   record->effort = SCIP_INVALID;
+   record->effortlimit = FALSE;
+   record->primalbound = SCIP_INVALID;
+   record->dualbound = SCIP_INVALID;
+   record->gap = SCIP_INVALID;
+   record->nodeseltime = SCIP_INVALID;
+   record->nerrors = -1;
+   record->ncomps = -1;
+   record->nodeprutime = SCIP_INVALID;
+   record->nprunes = -1;
+   record->nprunechecks = -1;
+   record->nfalsepos = -1;
+   record->nfalseneg = -1;
+   record->nodeselname[0] = '\0';
+   record->nodepruname[0] = '\0';
+}
+
+/** fills the record with the result of the last solve and the statistics of the node selector and pruner;
+ *  if the problem was not solved, only the instance and plugin names are set
+ */
+void SCIPrecordCollect(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< problem file name */
+   SCIP_RECORD*          record              /**< record to fill */
+   )
+{
+   SCIP_NODESEL* nodesel;
+   SCIP_NODEPRU* nodepru;
+   SCIP_EVENTHDLR* effort;
+
+   assert(scip != NULL);
+   assert(filename != NULL);
+   assert(record != NULL);
+
+   SCIPrecordSetNotSolved(record, filename);
+   record->solved = (SCIPgetStage(scip) >= SCIP_STAGE_SOLVING);
+
+   nodesel = SCIPgetNodesel(scip);
+   if( nodesel != NULL )
+      (void) SCIPsnprintf(record->nodeselname, SCIP_RECORD_MAXNAMELEN, "%s", SCIPnodeselGetName(nodesel));
+   nodepru = SCIPgetNodepru(scip);
+   if( nodepru != NULL )
+      (void) SCIPsnprintf(record->nodepruname, SCIP_RECORD_MAXNAMELEN, "%s", SCIPnodepruGetName(nodepru));
+
+   if( !record->solved )
+      return;
+
+   record->status = SCIPgetStatus(scip);
+   record->nnodes = SCIPgetNNodes(scip);
+   record->time = SCIPgetSolvingTime(scip);
+   record->primalbound = finiteReal(scip, SCIPgetPrimalbound(scip));
+   record->dualbound = finiteReal(scip, SCIPgetDualbound(scip));
+   record->gap = finiteReal(scip, SCIPgetGap(scip));
+
+   effort = SCIPfindEventhdlr(scip, "effort");
+   if( effort != NULL )
+   {
+      record->effort = SCIPeventhdlreffortGetEffort(scip, effort);
+      record->effortlimit = SCIPeventhdlreffortIsLimitReached(effort);
+   }
+
+   if( nodesel != NULL )
+   {
+      record->nodeseltime = SCIPnodeselGetTime(nodesel);
+      if( strcmp(record->nodeselname, "dagger") == 0 )
+         SCIPnodeseldaggerGetStatistics(nodesel, &record->nerrors, &record->ncomps);
+      else if( strcmp(record->nodeselname, "online") == 0 )
+         SCIPnodeselonlineGetStatistics(nodesel, &record->nerrors, &record->ncomps);
+   }
+
+   if( nodepru != NULL )
+   {
+      record->nodeprutime = SCIPnodepruGetTime(nodepru);
+      if( strcmp(record->nodepruname, "policy") == 0 )
+         record->nprunes = SCIPnodeprupolicyGetNPrunes(nodepru);
+      else if( strcmp(record->nodepruname, "dagger") == 0 )
+         SCIPnodeprudaggerGetStatistics(nodepru, &record->nprunes, &record->nprunechecks, &record->nfalsepos,
+            &record->nfalseneg);
+      else if( strcmp(record->nodepruname, "online") == 0 )
+         SCIPnodepruonlineGetStatistics(nodepru, &record->nprunes, &record->nprunechecks, &record->nfalsepos,
+            &record->nfalseneg);
+   }
+}
+
+/** names of the fields after the instance name, in the order of writeFields() */
+static const char* fieldnames[] = {"status", "nodes", "time", "effort", "primalbound", "dualbound", "gap", "nodesel",
+   "nodeseltime", "nerrors", "ncomps", "errorrate", "nodepru", "nodeprutime", "nprunes", "nprunechecks", "nfalsepos",
+   "nfalseneg"};
+
+/** writes the fields of a record after the instance name */
+static
+void writeFields(
+   FILE*                 file,               /**< output file */
+   SCIP_RECORD*          record,             /**< record to write */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   const char* sep;
+
+   sep = (format == SCIP_RECORDFORMAT_JSON ? ", " : ",");
+
+   /* in CSV the fields continue the line, in JSON they start an object */
+   if( format == SCIP_RECORDFORMAT_CSV )
+      fputs(sep, file);
+   if( !record->solved )
+      writeString(file, fieldnames[0], "notsolved", format);
+   else if( record->effortlimit && record->status == SCIP_STATUS_USERINTERRUPT )
+      writeString(file, fieldnames[0], "effortlimit", format);
+   else
+      writeString(file, fieldnames[0], statusName(record->status), format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[1], record->nnodes, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[2], record->time, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[3], record->effort, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[4], record->primalbound, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[5], record->dualbound, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[6], record->gap, format);
+   fputs(sep, file);
+   writeString(file, fieldnames[7], record->nodeselname, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[8], record->nodeseltime, format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[9], record->nerrors, format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[10], record->ncomps, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[11], record->ncomps > 0 ? (SCIP_Real)record->nerrors / record->ncomps : SCIP_INVALID,
+      format);
+   fputs(sep, file);
+   writeString(file, fieldnames[12], record->nodepruname, format);
+   fputs(sep, file);
+   writeReal(file, fieldnames[13], record->nodeprutime, format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[14], record->nprunes, format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[15], record->nprunechecks, format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[16], record->nfalsepos, format);
+   fputs(sep, file);
+   writeInt(file, fieldnames[17], record->nfalseneg, format);
+}
+
+/** writes the header line of the format (CSV only); the fields of a paired record are prefixed with policy_ and
+ *  baseline_
+ */
+void SCIPrecordWriteHeader(
+   FILE*                 file,               /**< output file */
+   SCIP_Bool             paired,             /**< are the records paired with a baseline solve? */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   int nfields = (int)(sizeof(fieldnames) / sizeof(fieldnames[0]));
+   int i;
+
+   assert(file != NULL);
+
+   if( format != SCIP_RECORDFORMAT_CSV )
+      return;
+
+   fprintf(file, "instance");
+   for( i = 0; i < nfields; i++ )
+      fprintf(file, paired ? ",policy_%s" : ",%s", fieldnames[i]);
+   if( paired )
+   {
+      for( i = 0; i < nfields; i++ )
+         fprintf(file, ",baseline_%s", fieldnames[i]);
+   }
+   fputc('\n', file);
+}
+
+/** writes one record as one line; a paired record holds the fields of the policy solve and of the baseline solve,
+ *  as "policy" and "baseline" objects in JSON
+ */
+void SCIPrecordWrite(
+   FILE*                 file,               /**< output file */
+   SCIP_RECORD*          record,             /**< record to write */
+   SCIP_RECORD*          baseline,           /**< record of the baseline solve of the same problem, or NULL */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   assert(file != NULL);
+   assert(record != NULL);
+
+   if( format == SCIP_RECORDFORMAT_JSON )
+      fputc('{', file);
+   writeString(file, "instance", record->instance, format);
+   if( format == SCIP_RECORDFORMAT_JSON && baseline != NULL )
+      fputs(", \"policy\": {", file);
+   else if( format == SCIP_RECORDFORMAT_JSON )
+      fputs(", ", file);
+   writeFields(file, record, format);
+   if( baseline != NULL )
+   {
+      if( format == SCIP_RECORDFORMAT_JSON )
+         fputs("}, \"baseline\": {", file);
+      writeFields(file, baseline, format);
+      if( format == SCIP_RECORDFORMAT_JSON )
+         fputc('}', file);
+   }
+   if( format == SCIP_RECORDFORMAT_JSON )
+      fputc('}', file);
+   fputc('\n', file);
+}
+
+/** appends one record to a file; the CSV header is written first if the file is new or empty */
+SCIP_RETCODE SCIPrecordAppend(
+   const char*           fname,              /**< file name */
+   SCIP_RECORD*          record,             /**< record to write */
+   SCIP_RECORD*          baseline,           /**< record of the baseline solve of the same problem, or NULL */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   )
+{
+   FILE* file;
+
+   assert(fname != NULL);
+   assert(record != NULL);
+
+   file = fopen(fname, "a");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   if( fseek(file, 0L, SEEK_END) == 0 && ftell(file) == 0 )
+      SCIPrecordWriteHeader(file, baseline != NULL, format);
+   SCIPrecordWrite(file, record, baseline, format);
+   fclose(file);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,72 @@
+/**@file   record.h
+ * @brief  methods for machine-readable per-instance result records
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_RECORD_H__
+#define __SCIP_RECORD_H__
+
+#include <stdio.h>
+
+#include "scip/def.h"
+#include "scip/scip.h"
+#include "struct_record.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** fills the record of a problem that was not solved: only the instance is set, from the problem file name */
+extern
+void SCIPrecordSetNotSolved(
+   SCIP_RECORD*          record,             /**< record to fill */
+   const char*           filename            /**< problem file name */
+   );
+
+/** fills the record with the result of the last solve and the statistics of the node selector and pruner;
+ *  if the problem was not solved, only the instance and plugin names are set
+ */
+extern
+void SCIPrecordCollect(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< problem file name */
+   SCIP_RECORD*          record              /**< record to fill */
+   );
+
+/** writes the header line of the format (CSV only); the fields of a paired record are prefixed with policy_ and
+ *  baseline_
+ */
+extern
+void SCIPrecordWriteHeader(
+   FILE*                 file,               /**< output file */
+   SCIP_Bool             paired,             /**< are the records paired with a baseline solve? */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   );
+
+/** writes one record as one line; a paired record holds the fields of the policy solve and of the baseline solve,
+ *  as "policy" and "baseline" objects in JSON
+ */
+extern
+void SCIPrecordWrite(
+   FILE*                 file,               /**< output file */
+   SCIP_RECORD*          record,             /**< record to write */
+   SCIP_RECORD*          baseline,           /**< record of the baseline solve of the same problem, or NULL */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   );
+
+/** appends one record to a file; the CSV header is written first if the file is new or empty */
+extern
+SCIP_RETCODE SCIPrecordAppend(
+   const char*           fname,              /**< file name */
+   SCIP_RECORD*          record,             /**< record to write */
+   SCIP_RECORD*          baseline,           /**< record of the baseline solve of the same problem, or NULL */
+   SCIP_RECORDFORMAT     format              /**< format of the records */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,731 @@
+/**@file   replay.c
+ * @brief  methods for the replay of recorded branch-and-bound trees
+ * @author He He
+ *
+ * Evaluating a policy by solving all problems again takes hours, most of it in the LP solves. A trace written by the
+ * trace event handler (eventhdlr_trace.c) with features contains the tree of a solve: the bounds of each node, its
+ * children, the solutions found at it, the labels of the oracle and the node selection and pruning features computed
+ * when the node was created. The replay simulates the search of another policy on this tree without any LP: the
+ * open node with the best score is explored next, nodes are pruned by bound with the incumbent of the simulation and
+ * by the pruning policy if their score is above a threshold, and an explored node adds the children it had in the
+ * recorded solve. A node that was not solved in the recorded solve is a leaf of the simulation and counted as
+ * unknown; the more complete the recorded tree (no node pruner, no node limit), the fewer unknown nodes.
+ *
+ * Without node selection scores the nodes are selected in the recorded order, which isolates the effect of a pruning
+ * policy. The scores of a policy are computed once per tree, so a sweep over pruning thresholds costs one simulation
+ * per threshold, which is linear in the number of explored nodes up to the heap operations.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <string.h>
+#include "scip/def.h"
+#include "feat.h"
+#include "policy.h"
+#include "eventhdlr_trace.h"
+#include "replay.h"
+
+#define REPLAY_MINSIZE          1024
+#define REPLAY_EPS              1e-09     /**< tolerance of the comparisons of scores and bounds */
+
+/* minimal lengths of the records of a trace file, see eventhdlr_trace.c */
+#define REPLAY_LENNODE          54
+#define REPLAY_LENFOCUS         25
+#define REPLAY_LENSOLVED        27
+#define REPLAY_LENINCUMBENT     33
+#define REPLAY_LENLABEL         10
+#define REPLAY_LENFEAT          23
+
+/** ensures that there are slots for num nodes */
+static
+SCIP_RETCODE replayEnsureNodes(
+   SCIP_REPLAY*         replay,
+   int                  num
+   )
+{
+   assert(replay != NULL);
+
+   if( num > replay->nodessize )
+   {
+      int newsize = MAX(2 * replay->nodessize, num);
+      newsize = MAX(newsize, REPLAY_MINSIZE);
+
+      SCIP_ALLOC( BMSreallocMemoryArray(&replay->nodes, newsize) );
+      replay->nodessize = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** ensures that the index covers the given node number */
+static
+SCIP_RETCODE replayEnsureIndex(
+   SCIP_REPLAY*         replay,
+   SCIP_Longint         number
+   )
+{
+   assert(replay != NULL);
+   assert(number >= 0);
+
+   if( number >= INT_MAX / 2 )
+   {
+      SCIPerrorMessage("node number %"SCIP_LONGINT_FORMAT" is too large\n", number);
+      return SCIP_READERROR;
+   }
+
+   if( (int)number >= replay->indexsize )
+   {
+      int newsize = MAX(2 * replay->indexsize, (int)number + 1);
+      int i;
+
+      newsize = MAX(newsize, REPLAY_MINSIZE);
+      SCIP_ALLOC( BMSreallocMemoryArray(&replay->index, newsize) );
+      for( i = replay->indexsize; i < newsize; i++ )
+         replay->index[i] = -1;
+      replay->indexsize = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** ensures that there are slots for the feature values of num nodes */
+static
+SCIP_RETCODE replayEnsureFeats(
+   SCIP_Real**          vals,
+   int*                 size,
+   int                  featsize,
+   int                  num
+   )
+{
+   assert(vals != NULL);
+   assert(size != NULL);
+
+   if( num > *size )
+   {
+      int newsize = MAX(2 * *size, num);
+      newsize = MAX(newsize, REPLAY_MINSIZE);
+
+      SCIP_ALLOC( BMSreallocMemoryArray(vals, (size_t)newsize * featsize) );
+      *size = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** returns the index of the node with the given number, or -1 */
+static
+int replayFindNode(
+   SCIP_REPLAY*         replay,
+   SCIP_Longint         number
+   )
+{
+   assert(replay != NULL);
+
+   if( number < 0 || number >= replay->indexsize )
+      return -1;
+   return replay->index[number];
+}
+
+/** copies a value out of a record and advances the position */
+static
+void replayGet(
+   const unsigned char* data,
+   int*                 pos,
+   void*                val,
+   int                  size
+   )
+{
+   memcpy(val, &data[*pos], (size_t)size);
+   *pos += size;
+}
+
+/** adds a node of a NODE record */
+static
+SCIP_RETCODE replayAddNode(
+   SCIP_REPLAY*         replay,
+   const unsigned char* data
+   )
+{
+   SCIP_REPLAYNODE* node;
+   SCIP_Longint number;
+   SCIP_Longint parent;
+   SCIP_Real lowerbound;
+   SCIP_Real estimate;
+   SCIP_Real bound;
+   int nbranchings;
+   int varindex;
+   int depth;
+   int pos;
+
+   assert(replay != NULL);
+   assert(data != NULL);
+
+   pos = 1;
+   replayGet(data, &pos, &number, sizeof(number));
+   replayGet(data, &pos, &parent, sizeof(parent));
+   replayGet(data, &pos, &depth, sizeof(depth));
+   replayGet(data, &pos, &lowerbound, sizeof(lowerbound));
+   replayGet(data, &pos, &estimate, sizeof(estimate));
+   replayGet(data, &pos, &nbranchings, sizeof(nbranchings));
+   replayGet(data, &pos, &varindex, sizeof(varindex));
+   replayGet(data, &pos, &bound, sizeof(bound));
+
+   if( number < 0 || replayFindNode(replay, number) != -1 || (parent == -1) != (replay->nnodes == 0)
+      || (parent != -1 && replayFindNode(replay, parent) == -1) )
+   {
+      SCIPerrorMessage("invalid node %"SCIP_LONGINT_FORMAT" with parent %"SCIP_LONGINT_FORMAT"\n", number, parent);
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( replayEnsureNodes(replay, replay->nnodes + 1) );
+   SCIP_CALL( replayEnsureIndex(replay, number) );
+
+   node = &replay->nodes[replay->nnodes];
+   node->lowerbound = lowerbound;
+   node->incumbent = SCIP_DEFAULT_INFINITY;
+   node->number = number;
+   node->parent = parent == -1 ? -1 : replayFindNode(replay, parent);
+   node->depth = depth;
+   node->firstchild = 0;
+   node->nchildren = 0;
+   node->order = -1;
+   node->selfeat = -1;
+   node->prufeat = -1;
+   node->boundtype = (SCIP_BOUNDTYPE)data[pos];
+   node->result = -1;
+   node->label = -1;
+
+   replay->index[number] = replay->nnodes;
+   replay->nnodes++;
+
+   return SCIP_OKAY;
+}
+
+/** stores the feature values of a FEAT record */
+static
+SCIP_RETCODE replayAddFeat(
+   SCIP_REPLAY*         replay,
+   const unsigned char* data,
+   unsigned int         length
+   )
+{
+   SCIP_REPLAYNODE* node;
+   SCIP_Longint number;
+   int kind;
+   int depth;
+   int maxdepth;
+   int size;
+   int pos;
+
+   assert(replay != NULL);
+   assert(data != NULL);
+
+   pos = 1;
+   replayGet(data, &pos, &number, sizeof(number));
+   kind = data[pos++];
+   replayGet(data, &pos, &depth, sizeof(depth));
+   replayGet(data, &pos, &maxdepth, sizeof(maxdepth));
+   pos++;
+   replayGet(data, &pos, &size, sizeof(size));
+
+   if( replayFindNode(replay, number) == -1 || kind < 0 || kind > 1 || size <= 0
+      || length != (unsigned int)pos + (unsigned int)size * sizeof(SCIP_Real)
+      || (kind == 0 && replay->selsize != 0 && replay->selsize != size)
+      || (kind == 1 && replay->prusize != 0 && replay->prusize != size)
+      || (replay->maxdepth != 0 && replay->maxdepth != maxdepth) )
+   {
+      SCIPerrorMessage("invalid features of node %"SCIP_LONGINT_FORMAT"\n", number);
+      return SCIP_READERROR;
+   }
+
+   node = &replay->nodes[replayFindNode(replay, number)];
+   replay->maxdepth = maxdepth;
+   if( kind == 0 )
+   {
+      replay->selsize = size;
+      SCIP_CALL( replayEnsureFeats(&replay->selvals, &replay->selfeatssize, size, replay->nselfeats + 1) );
+      memcpy(&replay->selvals[(size_t)replay->nselfeats * size], &data[pos], (size_t)size * sizeof(SCIP_Real));
+      node->selfeat = replay->nselfeats++;
+   }
+   else
+   {
+      replay->prusize = size;
+      SCIP_CALL( replayEnsureFeats(&replay->pruvals, &replay->prufeatssize, size, replay->nprufeats + 1) );
+      memcpy(&replay->pruvals[(size_t)replay->nprufeats * size], &data[pos], (size_t)size * sizeof(SCIP_Real));
+      node->prufeat = replay->nprufeats++;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** processes a record of a trace file; records of unknown type are skipped */
+static
+SCIP_RETCODE replayAddRecord(
+   SCIP_REPLAY*         replay,
+   const unsigned char* data,
+   unsigned int         length
+   )
+{
+   SCIP_Longint number;
+   int idx;
+   int pos;
+
+   assert(replay != NULL);
+   assert(data != NULL);
+   assert(length >= 1);
+
+   pos = 1;
+   switch( data[0] )
+   {
+   case SCIP_TRACERECORD_NODE:
+      if( length < REPLAY_LENNODE )
+         break;
+      return replayAddNode(replay, data);
+
+   case SCIP_TRACERECORD_FOCUS:
+   {
+      SCIP_Longint order;
+
+      if( length < REPLAY_LENFOCUS )
+         break;
+      replayGet(data, &pos, &number, sizeof(number));
+      replayGet(data, &pos, &order, sizeof(order));
+      idx = replayFindNode(replay, number);
+      if( idx == -1 )
+         break;
+      replay->nodes[idx].order = (int)order;
+      return SCIP_OKAY;
+   }
+
+   case SCIP_TRACERECORD_SOLVED:
+      if( length < REPLAY_LENSOLVED )
+         break;
+      replayGet(data, &pos, &number, sizeof(number));
+      idx = replayFindNode(replay, number);
+      if( idx == -1 || data[pos] > 2 )
+         break;
+      replay->nodes[idx].result = (signed char)data[pos];
+      return SCIP_OKAY;
+
+   case SCIP_TRACERECORD_INCUMBENT:
+   {
+      SCIP_Real objective;
+      SCIP_Real time;
+      SCIP_Real transobjective;
+
+      if( length < REPLAY_LENINCUMBENT )
+         break;
+      replayGet(data, &pos, &number, sizeof(number));
+      replayGet(data, &pos, &objective, sizeof(objective));
+      replayGet(data, &pos, &time, sizeof(time));
+      replayGet(data, &pos, &transobjective, sizeof(transobjective));
+
+      /* solutions found before the root is selected are known to every policy */
+      idx = replayFindNode(replay, number);
+      if( idx == -1 )
+         replay->initincumbent = MIN(replay->initincumbent, transobjective);
+      else
+         replay->nodes[idx].incumbent = MIN(replay->nodes[idx].incumbent, transobjective);
+      replay->optobj = MIN(replay->optobj, transobjective);
+      return SCIP_OKAY;
+   }
+
+   case SCIP_TRACERECORD_LABEL:
+      if( length < REPLAY_LENLABEL )
+         break;
+      replayGet(data, &pos, &number, sizeof(number));
+      idx = replayFindNode(replay, number);
+      if( idx == -1 )
+         break;
+      replay->nodes[idx].label = data[pos] ? 1 : 0;
+      replay->haslabels = TRUE;
+      return SCIP_OKAY;
+
+   case SCIP_TRACERECORD_FEAT:
+      if( length < REPLAY_LENFEAT )
+         break;
+      return replayAddFeat(replay, data, length);
+
+   default:
+      return SCIP_OKAY;
+   }
+
+   SCIPerrorMessage("invalid trace record of type %d\n", (int)data[0]);
+   return SCIP_READERROR;
+}
+
+/** sorts the children of each node into the children array */
+static
+SCIP_RETCODE replayLinkChildren(
+   SCIP_REPLAY*         replay
+   )
+{
+   int* nlinked;
+   int pos;
+   int i;
+
+   assert(replay != NULL);
+
+   for( i = 1; i < replay->nnodes; i++ )
+      replay->nodes[replay->nodes[i].parent].nchildren++;
+
+   pos = 0;
+   for( i = 0; i < replay->nnodes; i++ )
+   {
+      replay->nodes[i].firstchild = pos;
+      pos += replay->nodes[i].nchildren;
+   }
+
+   SCIP_ALLOC( BMSallocMemoryArray(&replay->children, MAX(pos, 1)) );
+   SCIP_ALLOC( BMSallocClearMemoryArray(&nlinked, replay->nnodes) );
+   for( i = 1; i < replay->nnodes; i++ )
+   {
+      SCIP_REPLAYNODE* parent = &replay->nodes[replay->nodes[i].parent];
+
+      replay->children[parent->firstchild + nlinked[replay->nodes[i].parent]++] = i;
+   }
+   BMSfreeMemoryArray(&nlinked);
+
+   return SCIP_OKAY;
+}
+
+/** returns whether node i is explored before node j */
+static
+SCIP_Bool replayIsBefore(
+   SCIP_REPLAY*         replay,
+   SCIP_Real*           selscores,
+   int                  i,
+   int                  j
+   )
+{
+   SCIP_REPLAYNODE* node1 = &replay->nodes[i];
+   SCIP_REPLAYNODE* node2 = &replay->nodes[j];
+
+   /* the comparison of the node selection policy plugins */
+   if( selscores != NULL )
+   {
+      if( selscores[i] > selscores[j] + REPLAY_EPS )
+         return TRUE;
+      if( selscores[i] < selscores[j] - REPLAY_EPS )
+         return FALSE;
+      if( node1->depth != node2->depth )
+         return node1->depth > node2->depth;
+   }
+   /* the recorded order; the nodes that were never selected come last */
+   else if( node1->order != node2->order )
+   {
+      if( node1->order == -1 || node2->order == -1 )
+         return node2->order == -1;
+      return node1->order < node2->order;
+   }
+
+   if( node1->lowerbound < node2->lowerbound - REPLAY_EPS )
+      return TRUE;
+   if( node1->lowerbound > node2->lowerbound + REPLAY_EPS )
+      return FALSE;
+   return i < j;
+}
+
+/** adds a node to the heap of open nodes */
+static
+void replayHeapPush(
+   SCIP_REPLAY*         replay,
+   SCIP_Real*           selscores,
+   int*                 heap,
+   int*                 nheap,
+   int                  node
+   )
+{
+   int pos = (*nheap)++;
+
+   while( pos > 0 && replayIsBefore(replay, selscores, node, heap[(pos - 1) / 2]) )
+   {
+      heap[pos] = heap[(pos - 1) / 2];
+      pos = (pos - 1) / 2;
+   }
+   heap[pos] = node;
+}
+
+/** removes and returns the first node of the heap of open nodes */
+static
+int replayHeapPop(
+   SCIP_REPLAY*         replay,
+   SCIP_Real*           selscores,
+   int*                 heap,
+   int*                 nheap
+   )
+{
+   int first;
+   int last;
+   int pos;
+
+   assert(*nheap > 0);
+
+   first = heap[0];
+   last = heap[--(*nheap)];
+   pos = 0;
+   while( 2 * pos + 1 < *nheap )
+   {
+      int child = 2 * pos + 1;
+
+      if( child + 1 < *nheap && replayIsBefore(replay, selscores, heap[child + 1], heap[child]) )
+         child++;
+      if( !replayIsBefore(replay, selscores, heap[child], last) )
+         break;
+      heap[pos] = heap[child];
+      pos = child;
+   }
+   heap[pos] = last;
+
+   return first;
+}
+
+/** returns whether a value is at least the incumbent, up to the tolerance */
+static
+SCIP_Bool replayIsGE(
+   SCIP_Real            val,
+   SCIP_Real            incumbent
+   )
+{
+   return incumbent < SCIP_DEFAULT_INFINITY && val >= incumbent - REPLAY_EPS * MAX(1.0, REALABS(incumbent));
+}
+
+/** reads the tree of a trace file written by the trace event handler */
+SCIP_RETCODE SCIPreplayCreate(
+   SCIP_REPLAY**        replay,
+   const char*          fname
+   )
+{
+   char magic[SCIP_TRACE_MAGICLEN];
+   unsigned char* data;
+   unsigned int datasize;
+   unsigned int length;
+   SCIP_RETCODE retcode;
+   FILE* file;
+
+   assert(replay != NULL);
+   assert(fname != NULL);
+
+   file = fopen(fname, "rb");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for reading\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_NOFILE;
+   }
+
+   if( fread(magic, sizeof(char), SCIP_TRACE_MAGICLEN, file) != SCIP_TRACE_MAGICLEN
+      || strncmp(magic, SCIP_TRACE_MAGIC, SCIP_TRACE_MAGICLEN) != 0 )
+   {
+      SCIPerrorMessage("file <%s> is not a trace file\n", fname);
+      fclose(file);
+      return SCIP_READERROR;
+   }
+
+   SCIP_ALLOC( BMSallocClearMemory(replay) );
+   (*replay)->initincumbent = SCIP_DEFAULT_INFINITY;
+   (*replay)->optobj = SCIP_DEFAULT_INFINITY;
+
+   datasize = 0;
+   data = NULL;
+   retcode = SCIP_OKAY;
+   while( retcode == SCIP_OKAY && fread(&length, sizeof(length), 1, file) == 1 )
+   {
+      if( length == 0 )
+      {
+         retcode = SCIP_READERROR;
+         break;
+      }
+      if( length > datasize )
+      {
+         datasize = MAX(length, 2 * datasize);
+         SCIP_ALLOC( BMSreallocMemoryArray(&data, datasize) );
+      }
+      if( fread(data, 1, (size_t)length, file) != (size_t)length )
+      {
+         /* a trace of a solve that was killed ends with a partial record */
+         SCIPwarningMessage(NULL, "trace file <%s> ends with a partial record\n", fname);
+         break;
+      }
+      retcode = replayAddRecord(*replay, data, length);
+   }
+   BMSfreeMemoryArrayNull(&data);
+   fclose(file);
+
+   if( retcode == SCIP_OKAY && (*replay)->nnodes == 0 )
+   {
+      SCIPerrorMessage("trace file <%s> contains no nodes\n", fname);
+      retcode = SCIP_READERROR;
+   }
+   if( retcode == SCIP_OKAY )
+      retcode = replayLinkChildren(*replay);
+
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPerrorMessage("error reading trace file <%s>\n", fname);
+      SCIP_CALL( SCIPreplayFree(replay) );
+      return retcode;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees a recorded tree */
+SCIP_RETCODE SCIPreplayFree(
+   SCIP_REPLAY**        replay
+   )
+{
+   assert(replay != NULL);
+   assert(*replay != NULL);
+
+   BMSfreeMemoryArrayNull(&(*replay)->nodes);
+   BMSfreeMemoryArrayNull(&(*replay)->children);
+   BMSfreeMemoryArrayNull(&(*replay)->index);
+   BMSfreeMemoryArrayNull(&(*replay)->selvals);
+   BMSfreeMemoryArrayNull(&(*replay)->pruvals);
+   BMSfreeMemory(replay);
+
+   return SCIP_OKAY;
+}
+
+/** returns the number of nodes of the recorded tree */
+int SCIPreplayGetNNodes(
+   SCIP_REPLAY*         replay
+   )
+{
+   assert(replay != NULL);
+
+   return replay->nnodes;
+}
+
+/** returns whether the nodes of the recorded tree have node selection (kind 0) or pruning (kind 1) features */
+SCIP_Bool SCIPreplayHasFeatures(
+   SCIP_REPLAY*         replay,
+   int                  kind
+   )
+{
+   assert(replay != NULL);
+
+   return kind == 0 ? replay->nselfeats > 0 : replay->nprufeats > 0;
+}
+
+/** computes the scores of all nodes by a node selection (kind 0) or pruning (kind 1) policy, like
+ *  SCIPcalcNodeScore(); nodes without features get score 0
+ */
+void SCIPreplayCalcScores(
+   SCIP_REPLAY*         replay,
+   SCIP_POLICY*         policy,
+   int                  kind,
+   SCIP_Real*           scores
+   )
+{
+   int size;
+   int i;
+
+   assert(replay != NULL);
+   assert(policy != NULL);
+   assert(scores != NULL);
+
+   size = kind == 0 ? replay->selsize : replay->prusize;
+   for( i = 0; i < replay->nnodes; i++ )
+   {
+      SCIP_REPLAYNODE* node = &replay->nodes[i];
+      SCIP_Real* vals;
+      int pos;
+      int offset;
+      int j;
+
+      scores[i] = 0.0;
+      pos = kind == 0 ? node->selfeat : node->prufeat;
+      if( pos == -1 )
+         continue;
+
+      vals = kind == 0 ? &replay->selvals[(size_t)pos * size] : &replay->pruvals[(size_t)pos * size];
+      offset = size * SCIPpolicyCalcBucket(policy, node->depth, replay->maxdepth, node->boundtype);
+      if( offset + size > policy->size )
+         continue;
+      for( j = 0; j < size; j++ )
+         scores[i] += vals[j] * policy->weights[j + offset];
+   }
+}
+
+/** simulates the search of the recorded tree by a node selection and pruning policy
+ *
+ *  The open node that is first by the node selection scores (higher score, then deeper, then lower bound, like the
+ *  node selection policy plugins), or by the recorded order if selscores is NULL, is explored next. Nodes other than
+ *  the root are pruned if their pruning score is above the threshold (if pruscores is not NULL).
+ */
+SCIP_RETCODE SCIPreplayRun(
+   SCIP_REPLAY*         replay,
+   SCIP_Real*           selscores,
+   SCIP_Real*           pruscores,
+   SCIP_Real            threshold,
+   SCIP_Longint         nodelimit,
+   SCIP_REPLAYRESULT*   result
+   )
+{
+   SCIP_Real incumbent;
+   int* heap;
+   int nheap;
+
+   assert(replay != NULL);
+   assert(replay->nnodes > 0);
+   assert(result != NULL);
+
+   SCIP_ALLOC( BMSallocMemoryArray(&heap, replay->nnodes) );
+
+   incumbent = replay->initincumbent;
+   result->nnodes = 0;
+   result->nboundpruned = 0;
+   result->npolicypruned = 0;
+   result->nunknown = 0;
+   result->optnode = -1;
+   result->optpruned = FALSE;
+   if( replay->optobj < SCIP_DEFAULT_INFINITY && replayIsGE(replay->optobj, incumbent) )
+      result->optnode = 0;
+
+   nheap = 0;
+   replayHeapPush(replay, selscores, heap, &nheap, 0);
+   while( nheap > 0 && (nodelimit < 0 || result->nnodes < nodelimit) )
+   {
+      SCIP_REPLAYNODE* node;
+      int i;
+
+      i = replayHeapPop(replay, selscores, heap, &nheap);
+      node = &replay->nodes[i];
+
+      if( replayIsGE(node->lowerbound, incumbent) )
+      {
+         result->nboundpruned++;
+         continue;
+      }
+      if( pruscores != NULL && node->depth > 0 && pruscores[i] > threshold )
+      {
+         result->npolicypruned++;
+         if( node->label == 1 )
+            result->optpruned = TRUE;
+         continue;
+      }
+
+      result->nnodes++;
+      if( node->result == -1 )
+         result->nunknown++;
+
+      if( node->incumbent < incumbent )
+      {
+         incumbent = node->incumbent;
+         if( result->optnode == -1 && replayIsGE(replay->optobj, incumbent) )
+            result->optnode = result->nnodes;
+      }
+
+      for( i = node->firstchild; i < node->firstchild + node->nchildren; i++ )
+         replayHeapPush(replay, selscores, heap, &nheap, replay->children[i]);
+   }
+   result->bestobj = incumbent;
+
+   BMSfreeMemoryArray(&heap);
+
+   return SCIP_OKAY;
+}
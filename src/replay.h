@@ -0,0 +1,72 @@
+/**@file   replay.h
+ * @brief  internal methods for the replay of recorded branch-and-bound trees
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_REPLAY_H__
+#define __SCIP_REPLAY_H__
+
+#include "scip/def.h"
+#include "scip/scip.h"
+#include "struct_policy.h"
+#include "struct_replay.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** reads the tree of a trace file written by the trace event handler */
+extern
+SCIP_RETCODE SCIPreplayCreate(
+   SCIP_REPLAY**        replay,
+   const char*          fname
+   );
+
+/** frees a recorded tree */
+extern
+SCIP_RETCODE SCIPreplayFree(
+   SCIP_REPLAY**        replay
+   );
+
+/** returns the number of nodes of the recorded tree */
+extern
+int SCIPreplayGetNNodes(
+   SCIP_REPLAY*         replay
+   );
+
+/** returns whether the nodes of the recorded tree have node selection (kind 0) or pruning (kind 1) features */
+extern
+SCIP_Bool SCIPreplayHasFeatures(
+   SCIP_REPLAY*         replay,
+   int                  kind
+   );
+
+/** computes the scores of all nodes by a node selection (kind 0) or pruning (kind 1) policy, like
+ *  SCIPcalcNodeScore(); nodes without features get score 0
+ */
+extern
+void SCIPreplayCalcScores(
+   SCIP_REPLAY*         replay,
+   SCIP_POLICY*         policy,
+   int                  kind,
+   SCIP_Real*           scores
+   );
+
+/** simulates the search of the recorded tree by a node selection and pruning policy */
+extern
+SCIP_RETCODE SCIPreplayRun(
+   SCIP_REPLAY*         replay,
+   SCIP_Real*           selscores,
+   SCIP_Real*           pruscores,
+   SCIP_Real            threshold,
+   SCIP_Longint         nodelimit,
+   SCIP_REPLAYRESULT*   result
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
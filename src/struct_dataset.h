@@ -0,0 +1,46 @@
+/**@file   struct_dataset.h
+ * @brief  data structures for trajectory datasets
+ * @author He He
+ *
+ *  This file defines the in-memory store of the examples written by the oracle and dagger plugins.
+ *
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_STRUCT_DATASET_H__
+#define __SCIP_STRUCT_DATASET_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scip/def.h"
+#include "scip/type_lp.h"
+
+/** trajectory examples
+ * Each example consists of one block (node pruner) or two blocks (node selector, feat1 - feat2) of raw feature values.
+ * The depth information of each block is kept, such that the feature index offset is only resolved at training time.
+ */
+struct SCIP_Dataset
+{
+   SCIP_Real*     vals;                /**< feature values, featsize values per block */
+   int*           depths;              /**< depth of the node of each block */
+   int*           maxdepths;           /**< maximum depth of the B&B tree of each block */
+   SCIP_BOUNDTYPE* boundtypes;         /**< bound type of the branching of each block */
+   int*           blockbegs;           /**< index of the first block of each example (nexamples+1 entries) */
+   int*           labels;              /**< label of each example */
+   SCIP_Real*     weights;             /**< weight of each example */
+   int            featsize;            /**< number of feature values per block */
+   int            nexamples;           /**< number of examples */
+   int            examplessize;        /**< available slots for examples */
+   int            nblocks;             /**< number of blocks */
+   int            blockssize;          /**< available slots for blocks */
+};
+typedef struct SCIP_Dataset SCIP_DATASET;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 #include "scip/def.h"
+#include "scip/type_event.h"
 
 /** Features for node selector and pruner
  * Feature values are normalized accordingly.
@@ -32,6 +33,10 @@ struct SCIP_Feat
    int            depth;
    SCIP_BOUNDTYPE boundtype;
    int            size;
+   unsigned int   mask;                /**< bit i is set if feature i is neither computed nor used (kept at zero) */
+   int            nmasked;             /**< number of masked features */
+   SCIP_EVENTHDLR* effort;             /**< effort event handler counting the computed values, or NULL */
+   SCIP_EVENTHDLR* latency;            /**< active latency event handler timing the computations, or NULL */
 };
 
 #ifdef __cplusplus
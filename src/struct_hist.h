@@ -0,0 +1,40 @@
+/**@file   struct_hist.h
+ * @brief  data structures for latency histograms
+ * @author He He
+ *
+ *  A histogram counts values (latencies in nanoseconds) in log-linear buckets: each power of two is split into
+ *  2^SCIP_HIST_SUBBITS buckets of equal width, so that every bucket is at most 1/2^SCIP_HIST_SUBBITS of its values
+ *  wide, from single nanoseconds to hours, in a fixed array.
+ *
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_STRUCT_HIST_H__
+#define __SCIP_STRUCT_HIST_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scip/def.h"
+
+#define SCIP_HIST_SUBBITS           4    /**< log2 of the number of buckets per power of two */
+#define SCIP_HIST_NBUCKETS          ((64 - SCIP_HIST_SUBBITS + 1) << SCIP_HIST_SUBBITS) /**< buckets up to 2^63 */
+
+/** latency histogram with call count */
+struct SCIP_Hist
+{
+   SCIP_Longint   counts[SCIP_HIST_NBUCKETS]; /**< number of values in each bucket */
+   SCIP_Longint   count;               /**< number of values */
+   SCIP_Longint   total;               /**< sum of the values */
+   SCIP_Longint   min;                 /**< smallest value, or -1 if there is none */
+   SCIP_Longint   max;                 /**< largest value, or -1 if there is none */
+};
+typedef struct SCIP_Hist SCIP_HIST;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
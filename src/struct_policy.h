@@ -22,6 +22,10 @@ struct SCIP_Policy
 {
    SCIP_Real*     weights;
    int            size;
+   int*           depthbounds;         /**< smallest depth of each quantile depth bucket but the first (increasing), or
+                                        *   NULL for ten buckets of equal width (SCIPfeatCalcBucket()) */
+   int*           depthbuckets;        /**< quantile depth bucket of each depth below the last bound */
+   int            ndepthbounds;        /**< number of depth bounds, i.e., number of quantile depth buckets minus one */
 };
 typedef struct SCIP_Policy SCIP_POLICY;
 
@@ -0,0 +1,64 @@
+/**@file   struct_record.h
+ * @brief  data structures for per-instance result records
+ * @author He He
+ *
+ *  This file defines the machine-readable record of one solve, which replaces parsing the SCIP log for the
+ *  evaluation scripts.
+ *
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_STRUCT_RECORD_H__
+#define __SCIP_STRUCT_RECORD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scip/def.h"
+#include "scip/type_stat.h"
+
+#define SCIP_RECORD_MAXNAMELEN      256
+
+/** format of the result records */
+enum SCIP_RecordFormat
+{
+   SCIP_RECORDFORMAT_CSV                 = 0,  /**< comma separated values with a header line */
+   SCIP_RECORDFORMAT_JSON                = 1   /**< one JSON object per line */
+};
+typedef enum SCIP_RecordFormat SCIP_RECORDFORMAT;
+
+/** result of one solve
+ * Real values that are infinite or not available are SCIP_INVALID, counts that are not available are -1.
+ */
+struct SCIP_Record
+{
+   char           instance[SCIP_RECORD_MAXNAMELEN]; /**< problem name (file name without directory and extensions) */
+   char           nodeselname[SCIP_RECORD_MAXNAMELEN]; /**< name of the node selector in use */
+   char           nodepruname[SCIP_RECORD_MAXNAMELEN]; /**< name of the node pruner in use, or empty */
+   SCIP_STATUS    status;              /**< solution status */
+   SCIP_Longint   nnodes;              /**< number of processed nodes */
+   SCIP_Real      time;                /**< solving time in seconds */
+   SCIP_Real      effort;              /**< effort in deterministic work units, see eventhdlr_effort.c */
+   SCIP_Real      primalbound;         /**< primal bound */
+   SCIP_Real      dualbound;           /**< dual bound */
+   SCIP_Real      gap;                 /**< gap between the primal and the dual bound */
+   SCIP_Real      nodeseltime;         /**< time spent in the node selector */
+   int            nerrors;             /**< number of wrong rankings of an optimal node by the node selector */
+   int            ncomps;              /**< number of comparisons of the node selector with an optimal node */
+   SCIP_Real      nodeprutime;         /**< time spent in the node pruner */
+   int            nprunes;             /**< number of nodes pruned */
+   int            nprunechecks;        /**< number of nodes checked by the node pruner */
+   int            nfalsepos;           /**< number of optimal nodes pruned */
+   int            nfalseneg;           /**< number of non-optimal nodes not pruned */
+   SCIP_Bool      effortlimit;         /**< was the solve interrupted by the effort limit? */
+   SCIP_Bool      solved;              /**< was the problem read and solved? */
+};
+typedef struct SCIP_Record SCIP_RECORD;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
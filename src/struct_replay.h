@@ -0,0 +1,84 @@
+/**@file   struct_replay.h
+ * @brief  data structures for the replay of recorded branch-and-bound trees
+ * @author He He
+ *
+ *  This file defines the tree read from a trace of eventhdlr_trace.c and the result of replaying a policy on it.
+ *
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_STRUCT_REPLAY_H__
+#define __SCIP_STRUCT_REPLAY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scip/def.h"
+#include "scip/type_lp.h"
+
+/** node of a recorded tree */
+struct SCIP_ReplayNode
+{
+   SCIP_Real      lowerbound;          /**< lower bound of the node when it was created */
+   SCIP_Real      incumbent;           /**< best objective (transformed) of the solutions found at the node, or
+                                        *   SCIP_DEFAULT_INFINITY */
+   SCIP_Longint   number;              /**< number of the node in the recorded solve */
+   int            parent;              /**< index of the parent, or -1 for the root */
+   int            depth;               /**< depth of the node */
+   int            firstchild;          /**< position of the first child in the children array */
+   int            nchildren;           /**< number of children, 0 if the node was not branched */
+   int            order;               /**< position of the node in the recorded selection order, or -1 */
+   int            selfeat;             /**< position of the node selection features in selvals, or -1 */
+   int            prufeat;             /**< position of the node pruning features in pruvals, or -1 */
+   SCIP_BOUNDTYPE boundtype;           /**< bound type of the branching of the node */
+   signed char    result;              /**< recorded result: 0 feasible, 1 infeasible, 2 branched, -1 not solved */
+   signed char    label;               /**< label of the oracle: 1 optimal, 0 not optimal, -1 unknown */
+};
+typedef struct SCIP_ReplayNode SCIP_REPLAYNODE;
+
+/** recorded tree */
+struct SCIP_Replay
+{
+   SCIP_REPLAYNODE* nodes;             /**< nodes in the order of creation, the root first */
+   int*           children;            /**< indices of the children of the nodes, see firstchild */
+   int*           index;               /**< index of the node with a given number, or -1 */
+   SCIP_Real*     selvals;             /**< node selection feature values, selsize values per node */
+   SCIP_Real*     pruvals;             /**< node pruning feature values, prusize values per node */
+   SCIP_Real      initincumbent;       /**< best objective of the solutions found before the search, or
+                                        *   SCIP_DEFAULT_INFINITY */
+   SCIP_Real      optobj;              /**< best objective found in the recorded solve, or SCIP_DEFAULT_INFINITY */
+   int            nnodes;              /**< number of nodes */
+   int            nodessize;           /**< available slots for nodes */
+   int            indexsize;           /**< available slots in the index */
+   int            selsize;             /**< number of node selection feature values per node, 0 if none */
+   int            prusize;             /**< number of node pruning feature values per node, 0 if none */
+   int            nselfeats;           /**< number of nodes with node selection features */
+   int            nprufeats;           /**< number of nodes with node pruning features */
+   int            selfeatssize;        /**< available slots for node selection features */
+   int            prufeatssize;        /**< available slots for node pruning features */
+   int            maxdepth;            /**< maximum depth of the features */
+   SCIP_Bool      haslabels;           /**< does the trace contain labels of the oracle? */
+};
+typedef struct SCIP_Replay SCIP_REPLAY;
+
+/** result of replaying a node selection and pruning policy on a recorded tree */
+struct SCIP_ReplayResult
+{
+   SCIP_Real      bestobj;             /**< best objective found, or SCIP_DEFAULT_INFINITY */
+   SCIP_Longint   nnodes;              /**< number of explored nodes */
+   SCIP_Longint   nboundpruned;        /**< number of nodes pruned by bound */
+   SCIP_Longint   npolicypruned;       /**< number of nodes pruned by the pruning policy */
+   SCIP_Longint   nunknown;            /**< number of explored nodes that were not solved in the recorded solve */
+   SCIP_Longint   optnode;             /**< number of explored nodes when the best recorded objective was found, or
+                                        *   -1 if it was not found */
+   SCIP_Bool      optpruned;           /**< has a node labeled optimal been pruned by the pruning policy? */
+};
+typedef struct SCIP_ReplayResult SCIP_REPLAYRESULT;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+/**@file   struct_train.h
+ * @brief  data structures for training linear policies
+ * @author He He
+ *
+ *  This file defines the parameters and the sparse training problem of the built-in policy trainer.
+ *
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_STRUCT_TRAIN_H__
+#define __SCIP_STRUCT_TRAIN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scip/def.h"
+#include "struct_policy.h"
+
+/** solver of the trainer; the numbers are those of the LIBLINEAR -s option */
+enum SCIP_TrainSolver
+{
+   SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL  = 1,  /**< L2-regularized L2-loss SVM (dual) */
+   SCIP_TRAINSOLVER_L2R_L1LOSS_SVC_DUAL  = 3,  /**< L2-regularized L1-loss SVM (dual) */
+   SCIP_TRAINSOLVER_L2R_LR_DUAL          = 7   /**< L2-regularized logistic regression (dual) */
+};
+typedef enum SCIP_TrainSolver SCIP_TRAINSOLVER;
+
+/** optimization method of the trainer */
+enum SCIP_TrainMethod
+{
+   SCIP_TRAINMETHOD_DCD                  = 0,  /**< dual coordinate descent (parallel over a partition of the examples) */
+   SCIP_TRAINMETHOD_SGD                  = 1   /**< stochastic gradient descent on the primal (Hogwild if not deterministic) */
+};
+typedef enum SCIP_TrainMethod SCIP_TRAINMETHOD;
+
+/** parameters of the trainer */
+struct SCIP_TrainParam
+{
+   SCIP_TRAINSOLVER  solver;           /**< solver to use */
+   SCIP_TRAINMETHOD  method;           /**< optimization method */
+   SCIP_Real         C;                /**< cost of constraint violation */
+   SCIP_Real         weightpos;        /**< cost multiplier of examples with label +1 (LIBLINEAR -w1) */
+   SCIP_Real         weightneg;        /**< cost multiplier of examples with label -1 (LIBLINEAR -w-1) */
+   SCIP_Real         eps;              /**< tolerance of the stopping criterion */
+   int               maxiter;          /**< maximum number of outer iterations */
+   int               nepochs;          /**< number of passes over the examples of stochastic gradient descent */
+   int               nthreads;         /**< number of threads */
+   SCIP_Bool         deterministic;    /**< should threads work on local copies of the weight vector that are merged
+                                        *   in a fixed order (otherwise the shared vector is updated lock-free)? needs
+                                        *   more passes when there are fewer depth buckets than threads */
+   unsigned int      randseed;         /**< seed for shuffling the examples */
+};
+typedef struct SCIP_TrainParam SCIP_TRAINPARAM;
+
+/** training problem: examples expanded to sparse rows in the feature space of the policy */
+struct SCIP_TrainProb
+{
+   int*              rowbegs;          /**< index of the first nonzero of each row (nrows+1 entries) */
+   int*              colidx;           /**< column (feature) index of each nonzero */
+   SCIP_Real*        vals;             /**< value of each nonzero */
+   int*              labels;           /**< label of each row, +1 or -1 */
+   SCIP_Real*        weights;          /**< instance weight of each row */
+   int               nrows;            /**< number of rows */
+   int               ncols;            /**< number of columns, i.e., size of the weight vector */
+   int               nnonzeros;        /**< number of nonzeros */
+   int               blocksize;        /**< number of columns of a depth bucket, by which the parallel solvers group
+                                        *   the rows */
+   int               first;            /**< index of the example of the first row in the dataset */
+};
+typedef struct SCIP_TrainProb SCIP_TRAINPROB;
+
+/** dual state of a trained policy, kept between DAgger iterations to warm-start the trainer */
+struct SCIP_TrainState
+{
+   SCIP_Real*        alpha;            /**< dual variable of each example of the dataset (for logistic regression the
+                                        *   variable alpha_i, its complement is C_i - alpha_i) */
+   SCIP_Real*        weights;          /**< weight vector sum_i alpha_i y_i x_i */
+   int               nexamples;        /**< number of examples with a dual variable */
+   int               nweights;         /**< size of the weight vector */
+   SCIP_TRAINSOLVER  solver;           /**< solver the dual variables belong to */
+};
+typedef struct SCIP_TrainState SCIP_TRAINSTATE;
+
+/** point of a hyperparameter grid search with its trained policy and held-out scores */
+struct SCIP_TrainGridPoint
+{
+   SCIP_Real         C;                /**< cost of constraint violation */
+   SCIP_Real         weightpos;        /**< cost multiplier of examples with label +1 */
+   SCIP_Real         weightneg;        /**< cost multiplier of examples with label -1 */
+   SCIP_POLICY       policy;           /**< trained policy (weights are NULL until trained) */
+   SCIP_Real         accuracy;         /**< fraction of held-out rows classified correctly */
+   SCIP_Real         accpos;           /**< fraction of held-out rows with label +1 classified correctly */
+   SCIP_Real         accneg;           /**< fraction of held-out rows with label -1 classified correctly */
+   SCIP_RETCODE      retcode;          /**< return code of the training */
+};
+typedef struct SCIP_TrainGridPoint SCIP_TRAINGRIDPOINT;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
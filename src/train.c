@@ -0,0 +1,2056 @@
+/**@file   train.c
+ * @brief  methods for training linear policies
+ * @author He He
+ *
+ * The solvers follow the dual coordinate descent methods of LIBLINEAR (with instance weights as in LIBLINEAR-weights):
+ *
+ * C.-J. Hsieh, K.-W. Chang, C.-J. Lin, S. S. Keerthi and S. Sundararajan
+ * A Dual Coordinate Descent Method for Large-scale Linear SVM (2008)
+ *
+ * H.-F. Yu, F.-L. Huang and C.-J. Lin
+ * Dual Coordinate Descent Methods for Logistic Regression and Maximum Entropy Models (2011)
+ *
+ * The cost of example i is C * W_i * w_{y_i}, where W_i is the example weight and w_{y_i} the class weight.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "scip/def.h"
+#include "feat.h"
+#include "dataset.h"
+#include "policy.h"
+#include "train.h"
+
+#define DEFAULT_SOLVER          SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL
+#define DEFAULT_C               1.0
+#define DEFAULT_EPS             0.1
+#define DEFAULT_MAXITER         1000
+#define DEFAULT_NEPOCHS         20
+#define DEFAULT_NTHREADS        1
+#define DEFAULT_RANDSEED        0
+
+#define LR_MAXINNERITER         100
+
+#define TRAINSTATE_MAGIC        "SCIPTST1"
+#define TRAINSTATE_MAGICLEN     8
+
+/** set the trainer parameters to the defaults of LIBLINEAR */
+void SCIPtrainparamSetDefault(
+   SCIP_TRAINPARAM*     param
+   )
+{
+   assert(param != NULL);
+
+   param->solver = DEFAULT_SOLVER;
+   param->method = SCIP_TRAINMETHOD_DCD;
+   param->C = DEFAULT_C;
+   param->weightpos = 1.0;
+   param->weightneg = 1.0;
+   param->eps = DEFAULT_EPS;
+   param->maxiter = DEFAULT_MAXITER;
+   param->nepochs = DEFAULT_NEPOCHS;
+   param->nthreads = DEFAULT_NTHREADS;
+   param->deterministic = TRUE;
+   param->randseed = DEFAULT_RANDSEED;
+}
+
+/** returns the LIBLINEAR name of the solver */
+const char* SCIPtrainsolverGetName(
+   SCIP_TRAINSOLVER     solver
+   )
+{
+   switch( solver )
+   {
+   case SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL:
+      return "L2R_L2LOSS_SVC_DUAL";
+   case SCIP_TRAINSOLVER_L2R_L1LOSS_SVC_DUAL:
+      return "L2R_L1LOSS_SVC_DUAL";
+   case SCIP_TRAINSOLVER_L2R_LR_DUAL:
+      return "L2R_LR_DUAL";
+   default:
+      return "unknown";
+   }
+}
+
+/** expand the examples in [first, last) of the dataset to a training problem; the columns of each block start at
+ *  the feature size times its depth bucket in the layout policy
+ */
+SCIP_RETCODE SCIPtrainprobCreate(
+   SCIP_TRAINPROB**     prob,
+   SCIP_DATASET*        dataset,
+   int                  first,
+   int                  last,
+   SCIP_POLICY*         layout              /**< policy with the depth buckets, or NULL for equal width */
+   )
+{
+   int featsize;
+   int nnonzeros;
+   int nrows;
+   int e;
+   int i;
+
+   assert(prob != NULL);
+   assert(dataset != NULL);
+   assert(0 <= first && first <= last && last <= dataset->nexamples);
+
+   featsize = dataset->featsize;
+   nrows = last - first;
+   /* upper bound on the number of nonzeros */
+   nnonzeros = (dataset->blockbegs[last] - dataset->blockbegs[first]) * featsize;
+
+   SCIP_ALLOC( BMSallocMemory(prob) );
+   SCIP_ALLOC( BMSallocMemoryArray(&(*prob)->rowbegs, nrows + 1) );
+   SCIP_ALLOC( BMSallocMemoryArray(&(*prob)->colidx, MAX(nnonzeros, 1)) );
+   SCIP_ALLOC( BMSallocMemoryArray(&(*prob)->vals, MAX(nnonzeros, 1)) );
+   SCIP_ALLOC( BMSallocMemoryArray(&(*prob)->labels, MAX(nrows, 1)) );
+   SCIP_ALLOC( BMSallocMemoryArray(&(*prob)->weights, MAX(nrows, 1)) );
+   (*prob)->nrows = nrows;
+   (*prob)->ncols = 0;
+   (*prob)->blocksize = featsize;
+   (*prob)->first = first;
+
+   nnonzeros = 0;
+   for( e = first; e < last; e++ )
+   {
+      int row = e - first;
+      int beg = dataset->blockbegs[e];
+      int nblocks = dataset->blockbegs[e + 1] - beg;
+      int offsets[2];
+      int order[2];
+      int b;
+
+      (*prob)->rowbegs[row] = nnonzeros;
+      (*prob)->labels[row] = dataset->labels[e] > 0 ? 1 : -1;
+      (*prob)->weights[row] = dataset->weights[e];
+
+      assert(nblocks == 1 || nblocks == 2);
+      for( b = 0; b < nblocks; b++ )
+      {
+         if( layout != NULL )
+            offsets[b] = featsize * SCIPpolicyCalcBucket(layout, dataset->depths[beg + b], dataset->maxdepths[beg + b],
+               dataset->boundtypes[beg + b]);
+         else
+            offsets[b] = SCIPfeatCalcOffset(featsize, dataset->depths[beg + b], dataset->maxdepths[beg + b],
+               dataset->boundtypes[beg + b]);
+         (*prob)->ncols = MAX((*prob)->ncols, offsets[b] + featsize);
+      }
+
+      if( nblocks == 2 && offsets[0] == offsets[1] )
+      {
+         SCIP_Real* vals1 = &dataset->vals[(size_t)beg * featsize];
+         SCIP_Real* vals2 = &dataset->vals[(size_t)(beg + 1) * featsize];
+
+         for( i = 0; i < featsize; i++ )
+         {
+            if( vals1[i] != vals2[i] )
+            {
+               (*prob)->colidx[nnonzeros] = offsets[0] + i;
+               (*prob)->vals[nnonzeros] = vals1[i] - vals2[i];
+               nnonzeros++;
+            }
+         }
+      }
+      else
+      {
+         /* keep the column indices sorted; the second block enters negated */
+         order[0] = 0;
+         order[1] = 1;
+         if( nblocks == 2 && offsets[1] < offsets[0] )
+         {
+            order[0] = 1;
+            order[1] = 0;
+         }
+         for( b = 0; b < nblocks; b++ )
+         {
+            SCIP_Real* vals = &dataset->vals[(size_t)(beg + order[b]) * featsize];
+            SCIP_Real sign = order[b] == 0 ? 1.0 : -1.0;
+
+            for( i = 0; i < featsize; i++ )
+            {
+               if( vals[i] != 0.0 )
+               {
+                  (*prob)->colidx[nnonzeros] = offsets[order[b]] + i;
+                  (*prob)->vals[nnonzeros] = sign * vals[i];
+                  nnonzeros++;
+               }
+            }
+         }
+      }
+   }
+   (*prob)->rowbegs[nrows] = nnonzeros;
+   (*prob)->nnonzeros = nnonzeros;
+
+   return SCIP_OKAY;
+}
+
+/** free training problem */
+SCIP_RETCODE SCIPtrainprobFree(
+   SCIP_TRAINPROB**     prob
+   )
+{
+   assert(prob != NULL);
+   assert(*prob != NULL);
+
+   BMSfreeMemoryArray(&(*prob)->rowbegs);
+   BMSfreeMemoryArray(&(*prob)->colidx);
+   BMSfreeMemoryArray(&(*prob)->vals);
+   BMSfreeMemoryArray(&(*prob)->labels);
+   BMSfreeMemoryArray(&(*prob)->weights);
+   BMSfreeMemory(prob);
+
+   return SCIP_OKAY;
+}
+
+/** returns the inner product of the weight vector and a row */
+static
+SCIP_Real rowDot(
+   SCIP_TRAINPROB*      prob,
+   SCIP_Real*           w,
+   int                  row
+   )
+{
+   SCIP_Real dot = 0;
+   int k;
+
+   for( k = prob->rowbegs[row]; k < prob->rowbegs[row + 1]; k++ )
+      dot += w[prob->colidx[k]] * prob->vals[k];
+
+   return dot;
+}
+
+/** adds a multiple of a row to the weight vector */
+static
+void rowAxpy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_Real*           w,
+   int                  row,
+   SCIP_Real            scale
+   )
+{
+   int k;
+
+   for( k = prob->rowbegs[row]; k < prob->rowbegs[row + 1]; k++ )
+      w[prob->colidx[k]] += scale * prob->vals[k];
+}
+
+/** returns the squared norm of a row */
+static
+SCIP_Real rowSqnorm(
+   SCIP_TRAINPROB*      prob,
+   int                  row
+   )
+{
+   SCIP_Real sqnorm = 0;
+   int k;
+
+   for( k = prob->rowbegs[row]; k < prob->rowbegs[row + 1]; k++ )
+      sqnorm += prob->vals[k] * prob->vals[k];
+
+   return sqnorm;
+}
+
+/** returns the cost of a row */
+static
+SCIP_Real rowCost(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   int                  row
+   )
+{
+   return param->C * prob->weights[row] * (prob->labels[row] > 0 ? param->weightpos : param->weightneg);
+}
+
+/** reports that a dual coordinate descent solver stopped at the iteration limit before reaching the tolerance */
+static
+void warnMaxIter(
+   SCIP_TRAINPARAM*     param
+   )
+{
+   printf("WARNING: reaching max number of iterations %d, the policy is not converged to eps=%g\n", param->maxiter,
+      param->eps);
+}
+
+/** dual coordinate descent for L2-regularized L1- and L2-loss SVM (solve_l2r_l1l2_svc of LIBLINEAR) */
+static
+SCIP_RETCODE solveL2rL1L2Svc(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_Real*           alpha,
+   SCIP_Real*           w
+   )
+{
+   SCIP_Real* QD;
+   SCIP_Real* upperbound;
+   SCIP_Real* diag;
+   int* index;
+   SCIP_Real PGmaxold = SCIP_REAL_MAX;
+   SCIP_Real PGminold = -SCIP_REAL_MAX;
+   SCIP_Bool l2loss;
+   unsigned int randseed;
+   int activesize;
+   int iter;
+   int l;
+   int i;
+   int s;
+
+   l = prob->nrows;
+   l2loss = (param->solver == SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL);
+   randseed = param->randseed;
+
+   SCIP_ALLOC( BMSallocMemoryArray(&QD, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&upperbound, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&diag, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&index, l) );
+
+   for( i = 0; i < l; i++ )
+   {
+      SCIP_Real cost = rowCost(prob, param, i);
+
+      /* L1 loss: box constraint 0 <= alpha <= C; L2 loss: diagonal 1/(2C) and no upper bound */
+      upperbound[i] = l2loss ? SCIP_REAL_MAX : cost;
+      diag[i] = l2loss ? 0.5 / cost : 0.0;
+      QD[i] = diag[i] + rowSqnorm(prob, i);
+      index[i] = i;
+   }
+
+   activesize = l;
+   for( iter = 0; iter < param->maxiter; iter++ )
+   {
+      SCIP_Real PGmaxnew = -SCIP_REAL_MAX;
+      SCIP_Real PGminnew = SCIP_REAL_MAX;
+
+      for( i = 0; i < activesize; i++ )
+      {
+         int j = SCIPgetRandomInt(i, activesize - 1, &randseed);
+         int tmp = index[i];
+         index[i] = index[j];
+         index[j] = tmp;
+      }
+
+      for( s = 0; s < activesize; s++ )
+      {
+         SCIP_Real G;
+         SCIP_Real PG;
+         SCIP_Real yi;
+         SCIP_Real C;
+
+         i = index[s];
+         yi = (SCIP_Real)prob->labels[i];
+         C = upperbound[i];
+
+         G = yi * rowDot(prob, w, i) - 1 + alpha[i] * diag[i];
+
+         PG = 0;
+         if( alpha[i] == 0 )
+         {
+            if( G > PGmaxold )
+            {
+               /* shrink */
+               activesize--;
+               index[s] = index[activesize];
+               index[activesize] = i;
+               s--;
+               continue;
+            }
+            else if( G < 0 )
+               PG = G;
+         }
+         else if( alpha[i] == C )
+         {
+            if( G < PGminold )
+            {
+               activesize--;
+               index[s] = index[activesize];
+               index[activesize] = i;
+               s--;
+               continue;
+            }
+            else if( G > 0 )
+               PG = G;
+         }
+         else
+            PG = G;
+
+         PGmaxnew = MAX(PGmaxnew, PG);
+         PGminnew = MIN(PGminnew, PG);
+
+         if( REALABS(PG) > 1.0e-12 )
+         {
+            SCIP_Real alphaold = alpha[i];
+
+            alpha[i] = MIN(MAX(alpha[i] - G / QD[i], 0.0), C);
+            rowAxpy(prob, w, i, (alpha[i] - alphaold) * yi);
+         }
+      }
+
+      if( PGmaxnew - PGminnew <= param->eps )
+      {
+         if( activesize == l )
+            break;
+
+         /* check the shrunken variables once more */
+         activesize = l;
+         PGmaxold = SCIP_REAL_MAX;
+         PGminold = -SCIP_REAL_MAX;
+         continue;
+      }
+
+      PGmaxold = PGmaxnew;
+      PGminold = PGminnew;
+      if( PGmaxold <= 0 )
+         PGmaxold = SCIP_REAL_MAX;
+      if( PGminold >= 0 )
+         PGminold = -SCIP_REAL_MAX;
+   }
+
+   if( iter >= param->maxiter )
+      warnMaxIter(param);
+
+   BMSfreeMemoryArray(&index);
+   BMSfreeMemoryArray(&diag);
+   BMSfreeMemoryArray(&upperbound);
+   BMSfreeMemoryArray(&QD);
+
+   return SCIP_OKAY;
+}
+
+/** dual coordinate descent for L2-regularized logistic regression (solve_l2r_lr_dual of LIBLINEAR) */
+static
+SCIP_RETCODE solveL2rLrDual(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_Real*           alpha,
+   SCIP_Real*           w
+   )
+{
+   SCIP_Real* xTx;
+   SCIP_Real* upperbound;
+   int* index;
+   SCIP_Real innereps = 1.0e-2;
+   SCIP_Real innerepsmin = MIN(1.0e-8, param->eps);
+   unsigned int randseed;
+   int iter;
+   int l;
+   int i;
+   int s;
+
+   l = prob->nrows;
+   randseed = param->randseed;
+
+   SCIP_ALLOC( BMSallocMemoryArray(&xTx, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&upperbound, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&index, l) );
+
+   for( i = 0; i < l; i++ )
+   {
+      upperbound[i] = rowCost(prob, param, i);
+      xTx[i] = rowSqnorm(prob, i);
+      index[i] = i;
+   }
+
+   for( iter = 0; iter < param->maxiter; iter++ )
+   {
+      SCIP_Real Gmax = 0;
+      int newtoniter = 0;
+
+      for( i = 0; i < l; i++ )
+      {
+         int j = SCIPgetRandomInt(i, l - 1, &randseed);
+         int tmp = index[i];
+         index[i] = index[j];
+         index[j] = tmp;
+      }
+
+      for( s = 0; s < l; s++ )
+      {
+         SCIP_Real yi;
+         SCIP_Real C;
+         SCIP_Real a;
+         SCIP_Real b;
+         SCIP_Real alphaold;
+         SCIP_Real z;
+         SCIP_Real gp;
+         SCIP_Real sign;
+         int ind1;
+         int ind2;
+         int inneriter;
+
+         i = index[s];
+         yi = (SCIP_Real)prob->labels[i];
+         C = upperbound[i];
+         a = xTx[i];
+         b = yi * rowDot(prob, w, i);
+
+         /* decide to minimize g_1(z) or g_2(z) */
+         ind1 = 2*i;
+         ind2 = 2*i+1;
+         sign = 1;
+         if( 0.5 * a * (alpha[ind2] - alpha[ind1]) + b < 0 )
+         {
+            ind1 = 2*i+1;
+            ind2 = 2*i;
+            sign = -1;
+         }
+
+         alphaold = alpha[ind1];
+         z = alphaold;
+         if( C - z < 0.5 * C )
+            z = 0.1 * z;
+         gp = a * (z - alphaold) + sign * b + log(z / (C - z));
+         Gmax = MAX(Gmax, REALABS(gp));
+
+         /* Newton method on the sub-problem */
+         for( inneriter = 0; inneriter <= LR_MAXINNERITER; inneriter++ )
+         {
+            SCIP_Real gpp;
+            SCIP_Real tmpz;
+
+            if( REALABS(gp) < innereps )
+               break;
+            gpp = a + C / (C - z) / z;
+            tmpz = z - gp / gpp;
+            if( tmpz <= 0 )
+               z *= 0.1;
+            else
+               z = tmpz;
+            gp = a * (z - alphaold) + sign * b + log(z / (C - z));
+            newtoniter++;
+         }
+
+         if( inneriter > 0 )
+         {
+            alpha[ind1] = z;
+            alpha[ind2] = C - z;
+            rowAxpy(prob, w, i, sign * (z - alphaold) * yi);
+         }
+      }
+
+      if( Gmax < param->eps )
+         break;
+
+      if( newtoniter <= l / 10 )
+         innereps = MAX(innerepsmin, 0.1 * innereps);
+   }
+
+   if( iter >= param->maxiter )
+      warnMaxIter(param);
+
+   BMSfreeMemoryArray(&index);
+   BMSfreeMemoryArray(&upperbound);
+   BMSfreeMemoryArray(&xTx);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * parallel solvers
+ *
+ * The examples are split once into one part per thread, grouped by the depth bucket of their columns: rows of
+ * different buckets have no common columns, so the threads only interfere on the buckets that are cut. In each round
+ * the rows of every part are shuffled. The threads are started once per solve and wait for the rounds in a team.
+ *
+ * With a deterministic trainer every thread works on a local copy of the weight vector from the start of the round and
+ * the changes are added in the order of the threads. Coordinate descent scales the sum of the changes by the step that
+ * minimizes the dual objective along it, which is the full step unless the threads share columns; stochastic gradient
+ * descent adds the changes every SGD_ROUNDROWS rows per thread. The result is reproducible for a given number of
+ * threads. Otherwise all threads update the shared weight vector without locks (PASSCoDe-Wild and Hogwild), which
+ * needs fewer passes when most examples are in few buckets, but is not reproducible.
+ */
+
+#define SGD_ROUNDROWS           64           /**< rows per thread between two merges of deterministic SGD */
+#define LINESEARCH_MAXITER      50           /**< maximum number of Newton steps of the line search of LR */
+
+struct TrainTeam;
+
+/** work of one thread of the parallel solvers */
+struct TrainWork
+{
+   SCIP_TRAINPROB*      prob;               /**< training problem */
+   SCIP_TRAINPARAM*     param;              /**< trainer parameters */
+   struct TrainTeam*    team;               /**< team of the thread */
+   int*                 rows;               /**< rows handled by the thread in this round */
+   int                  nrows;              /**< number of rows handled by the thread in this round */
+   SCIP_Real*           w;                  /**< weight vector read and updated by the thread (shared or local) */
+   SCIP_Real*           alpha;              /**< dual variables, shared (each row belongs to one thread) */
+   SCIP_Real*           xTx;                /**< squared norms of the rows */
+   SCIP_Real*           diag;               /**< diagonal of the dual Hessian (L2-loss SVM) */
+   SCIP_Real*           upperbound;         /**< upper bounds of the dual variables */
+   SCIP_Bool*           shrunk;             /**< marks the rows removed from the active set in this round (SVM) */
+   SCIP_Real*           colscale;           /**< regularization of a column per update (SGD) */
+   SCIP_Real            PGmaxold;           /**< maximum projected gradient of the previous round (SVM) */
+   SCIP_Real            PGminold;           /**< minimum projected gradient of the previous round (SVM) */
+   SCIP_Real            innereps;           /**< tolerance of the Newton method (logistic regression) */
+   SCIP_Real            eta0;               /**< initial learning rate (SGD) */
+   SCIP_Real            lambda;             /**< regularization per example (SGD) */
+   SCIP_Longint         t;                  /**< number of updates done by all threads before this part (SGD) */
+   int                  nthreads;           /**< number of threads */
+   SCIP_Real            PGmax;              /**< maximum projected gradient of this round (SVM) */
+   SCIP_Real            PGmin;              /**< minimum projected gradient of this round (SVM) */
+   SCIP_Real            Gmax;               /**< maximum gradient of this round (logistic regression) */
+   int                  newtoniter;         /**< number of Newton steps of this round (logistic regression) */
+};
+typedef struct TrainWork TRAINWORK;
+
+/** team of threads that run the rounds of a parallel solver; part 0 of each round is done by the calling thread */
+struct TrainTeam
+{
+   TRAINWORK*           works;              /**< work of each part */
+   int                  nworks;             /**< number of parts */
+   pthread_t*           threads;            /**< thread of each part but the first */
+   SCIP_Bool*           started;            /**< was the thread of a part started? */
+   void*                (*pass)(void*);     /**< pass of the current round */
+   int                  round;              /**< number of the current round */
+   int                  npending;           /**< number of started threads that did not finish the current round */
+   SCIP_Bool            stop;               /**< should the threads exit? */
+   pthread_mutex_t      lock;               /**< lock of the round data */
+   pthread_cond_t       start;              /**< signals a new round or the stop */
+   pthread_cond_t       done;               /**< signals that all started threads finished the round */
+};
+typedef struct TrainTeam TRAINTEAM;
+
+/** one pass of dual coordinate descent for the SVM solvers over the rows of a thread */
+static
+void* workSvcPass(
+   void*                arg
+   )
+{
+   TRAINWORK* work = (TRAINWORK*)arg;
+   SCIP_TRAINPROB* prob = work->prob;
+   int s;
+
+   work->PGmax = -SCIP_REAL_MAX;
+   work->PGmin = SCIP_REAL_MAX;
+   work->Gmax = 0;
+   work->newtoniter = 0;
+
+   for( s = 0; s < work->nrows; s++ )
+   {
+      SCIP_Real G;
+      SCIP_Real PG;
+      SCIP_Real yi;
+      SCIP_Real C;
+      int i;
+
+      i = work->rows[s];
+      yi = (SCIP_Real)prob->labels[i];
+      C = work->upperbound[i];
+
+      G = yi * rowDot(prob, work->w, i) - 1 + work->alpha[i] * work->diag[i];
+
+      /* shrink as in the sequential solver; the rows are removed from the active set after the round */
+      PG = G;
+      if( work->alpha[i] == 0 )
+      {
+         if( G > work->PGmaxold )
+         {
+            work->shrunk[i] = TRUE;
+            continue;
+         }
+         PG = MIN(G, 0.0);
+      }
+      else if( work->alpha[i] == C )
+      {
+         if( G < work->PGminold )
+         {
+            work->shrunk[i] = TRUE;
+            continue;
+         }
+         PG = MAX(G, 0.0);
+      }
+
+      work->PGmax = MAX(work->PGmax, PG);
+      work->PGmin = MIN(work->PGmin, PG);
+
+      if( REALABS(PG) > 1.0e-12 )
+      {
+         SCIP_Real alphaold = work->alpha[i];
+
+         work->alpha[i] = MIN(MAX(alphaold - G / (work->xTx[i] + work->diag[i]), 0.0), C);
+         rowAxpy(prob, work->w, i, (work->alpha[i] - alphaold) * yi);
+      }
+   }
+
+   return NULL;
+}
+
+/** one pass of dual coordinate descent for logistic regression over the rows of a thread */
+static
+void* workLrPass(
+   void*                arg
+   )
+{
+   TRAINWORK* work = (TRAINWORK*)arg;
+   SCIP_TRAINPROB* prob = work->prob;
+   SCIP_Real* alpha = work->alpha;
+   int s;
+
+   work->PGmax = -SCIP_REAL_MAX;
+   work->PGmin = SCIP_REAL_MAX;
+   work->Gmax = 0;
+   work->newtoniter = 0;
+
+   for( s = 0; s < work->nrows; s++ )
+   {
+      SCIP_Real yi;
+      SCIP_Real C;
+      SCIP_Real a;
+      SCIP_Real b;
+      SCIP_Real alphaold;
+      SCIP_Real z;
+      SCIP_Real gp;
+      SCIP_Real sign;
+      int ind1;
+      int ind2;
+      int inneriter;
+      int i;
+
+      i = work->rows[s];
+      yi = (SCIP_Real)prob->labels[i];
+      C = work->upperbound[i];
+      a = work->xTx[i];
+      b = yi * rowDot(prob, work->w, i);
+
+      ind1 = 2*i;
+      ind2 = 2*i+1;
+      sign = 1;
+      if( 0.5 * a * (alpha[ind2] - alpha[ind1]) + b < 0 )
+      {
+         ind1 = 2*i+1;
+         ind2 = 2*i;
+         sign = -1;
+      }
+
+      alphaold = alpha[ind1];
+      z = alphaold;
+      if( C - z < 0.5 * C )
+         z = 0.1 * z;
+      gp = a * (z - alphaold) + sign * b + log(z / (C - z));
+      work->Gmax = MAX(work->Gmax, REALABS(gp));
+
+      for( inneriter = 0; inneriter <= LR_MAXINNERITER; inneriter++ )
+      {
+         SCIP_Real gpp;
+         SCIP_Real tmpz;
+
+         if( REALABS(gp) < work->innereps )
+            break;
+         gpp = a + C / (C - z) / z;
+         tmpz = z - gp / gpp;
+         if( tmpz <= 0 )
+            z *= 0.1;
+         else
+            z = tmpz;
+         gp = a * (z - alphaold) + sign * b + log(z / (C - z));
+         work->newtoniter++;
+      }
+
+      if( inneriter > 0 )
+      {
+         alpha[ind1] = z;
+         alpha[ind2] = C - z;
+         rowAxpy(prob, work->w, i, sign * (z - alphaold) * yi);
+      }
+   }
+
+   return NULL;
+}
+
+/** one pass of stochastic gradient descent over the rows of a thread */
+static
+void* workSgdPass(
+   void*                arg
+   )
+{
+   TRAINWORK* work = (TRAINWORK*)arg;
+   SCIP_TRAINPROB* prob = work->prob;
+   SCIP_TRAINSOLVER solver = work->param->solver;
+   SCIP_Longint t = work->t;
+   int s;
+
+   for( s = 0; s < work->nrows; s++ )
+   {
+      SCIP_Real eta;
+      SCIP_Real yi;
+      SCIP_Real margin;
+      SCIP_Real dloss;
+      int i;
+      int k;
+
+      i = work->rows[s];
+      yi = (SCIP_Real)prob->labels[i];
+      margin = yi * rowDot(prob, work->w, i);
+
+      /* derivative of the loss with respect to the margin */
+      if( solver == SCIP_TRAINSOLVER_L2R_LR_DUAL )
+         dloss = -1.0 / (1.0 + exp(margin));
+      else if( margin >= 1.0 )
+         dloss = 0.0;
+      else if( solver == SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL )
+         dloss = -2.0 * (1.0 - margin);
+      else
+         dloss = -1.0;
+      dloss *= work->upperbound[i];
+
+      eta = work->eta0 / (1.0 + work->eta0 * work->lambda * t);
+      t += work->nthreads;
+
+      /* the regularization is spread over the updates of the rows that contain a column */
+      for( k = prob->rowbegs[i]; k < prob->rowbegs[i + 1]; k++ )
+      {
+         int j = prob->colidx[k];
+         SCIP_Real shrink = MAX(1.0 - eta * work->colscale[j], 0.0);
+
+         work->w[j] = shrink * work->w[j] - eta * dloss * yi * prob->vals[k];
+      }
+   }
+
+   return NULL;
+}
+
+/** runs the rounds of a team thread until the team is stopped */
+static
+void* teamWorker(
+   void*                arg
+   )
+{
+   TRAINWORK* work = (TRAINWORK*)arg;
+   TRAINTEAM* team = work->team;
+   int round = 0;
+
+   for( ;; )
+   {
+      void* (*pass)(void*);
+
+      pthread_mutex_lock(&team->lock);
+      while( team->round == round && !team->stop )
+         pthread_cond_wait(&team->start, &team->lock);
+      if( team->stop )
+      {
+         pthread_mutex_unlock(&team->lock);
+         break;
+      }
+      round = team->round;
+      pass = team->pass;
+      pthread_mutex_unlock(&team->lock);
+
+      (void) pass(work);
+
+      pthread_mutex_lock(&team->lock);
+      team->npending--;
+      if( team->npending == 0 )
+         pthread_cond_signal(&team->done);
+      pthread_mutex_unlock(&team->lock);
+   }
+
+   return NULL;
+}
+
+/** starts one thread for each part but the first; parts whose thread cannot be started are done by the caller */
+static
+SCIP_RETCODE startTeam(
+   TRAINTEAM*           team,
+   TRAINWORK*           works,
+   int                  nworks
+   )
+{
+   int k;
+
+   team->works = works;
+   team->nworks = nworks;
+   team->pass = NULL;
+   team->round = 0;
+   team->npending = 0;
+   team->stop = FALSE;
+   SCIP_ALLOC( BMSallocMemoryArray(&team->threads, nworks) );
+   SCIP_ALLOC( BMSallocMemoryArray(&team->started, nworks) );
+   pthread_mutex_init(&team->lock, NULL);
+   pthread_cond_init(&team->start, NULL);
+   pthread_cond_init(&team->done, NULL);
+
+   team->started[0] = FALSE;
+   for( k = 0; k < nworks; k++ )
+      works[k].team = team;
+   for( k = 1; k < nworks; k++ )
+      team->started[k] = (pthread_create(&team->threads[k], NULL, teamWorker, &works[k]) == 0);
+
+   return SCIP_OKAY;
+}
+
+/** runs one pass on the work of each part and waits until all parts are done */
+static
+void runTeam(
+   TRAINTEAM*           team,
+   void*                (*pass)(void*)
+   )
+{
+   int k;
+
+   pthread_mutex_lock(&team->lock);
+   team->pass = pass;
+   team->npending = 0;
+   for( k = 1; k < team->nworks; k++ )
+   {
+      if( team->started[k] )
+         team->npending++;
+   }
+   team->round++;
+   pthread_cond_broadcast(&team->start);
+   pthread_mutex_unlock(&team->lock);
+
+   (void) pass(&team->works[0]);
+   for( k = 1; k < team->nworks; k++ )
+   {
+      if( !team->started[k] )
+         (void) pass(&team->works[k]);
+   }
+
+   pthread_mutex_lock(&team->lock);
+   while( team->npending > 0 )
+      pthread_cond_wait(&team->done, &team->lock);
+   pthread_mutex_unlock(&team->lock);
+}
+
+/** stops and joins the threads of the team */
+static
+void stopTeam(
+   TRAINTEAM*           team
+   )
+{
+   int k;
+
+   pthread_mutex_lock(&team->lock);
+   team->stop = TRUE;
+   pthread_cond_broadcast(&team->start);
+   pthread_mutex_unlock(&team->lock);
+
+   for( k = 1; k < team->nworks; k++ )
+   {
+      if( team->started[k] )
+         pthread_join(team->threads[k], NULL);
+   }
+
+   pthread_cond_destroy(&team->done);
+   pthread_cond_destroy(&team->start);
+   pthread_mutex_destroy(&team->lock);
+   BMSfreeMemoryArray(&team->started);
+   BMSfreeMemoryArray(&team->threads);
+}
+
+/** splits the rows into one part per thread: the rows are sorted by the depth bucket of their first column and cut
+ *  into parts of about equally many nonzeros; a cut is moved to the nearest end of a bucket if this changes the parts
+ *  by at most half of their size, so that the parts share no columns when there are enough equally large buckets
+ */
+static
+SCIP_RETCODE partitionRows(
+   SCIP_TRAINPROB*      prob,
+   int                  nparts,
+   int*                 index,
+   int*                 partbegs
+   )
+{
+   SCIP_Longint* nnzbefore;
+   int* bucketbegs;
+   int nbuckets;
+   int blocksize;
+   int b;
+   int i;
+   int k;
+
+   blocksize = MAX(prob->blocksize, 1);
+   nbuckets = (prob->ncols + blocksize - 1) / blocksize + 1;
+   SCIP_ALLOC( BMSallocClearMemoryArray(&bucketbegs, nbuckets + 1) );
+   SCIP_ALLOC( BMSallocMemoryArray(&nnzbefore, prob->nrows + 1) );
+
+   /* counting sort by bucket; empty rows are in the last bucket */
+   for( i = 0; i < prob->nrows; i++ )
+   {
+      b = prob->rowbegs[i] < prob->rowbegs[i + 1] ? prob->colidx[prob->rowbegs[i]] / blocksize : nbuckets - 1;
+      bucketbegs[b + 1]++;
+   }
+   for( b = 0; b < nbuckets; b++ )
+      bucketbegs[b + 1] += bucketbegs[b];
+   for( i = 0; i < prob->nrows; i++ )
+   {
+      b = prob->rowbegs[i] < prob->rowbegs[i + 1] ? prob->colidx[prob->rowbegs[i]] / blocksize : nbuckets - 1;
+      index[bucketbegs[b]++] = i;
+   }
+
+   /* now bucketbegs[b] is the end of bucket b */
+   nnzbefore[0] = 0;
+   for( i = 0; i < prob->nrows; i++ )
+      nnzbefore[i + 1] = nnzbefore[i] + prob->rowbegs[index[i] + 1] - prob->rowbegs[index[i]];
+
+   partbegs[0] = 0;
+   partbegs[nparts] = prob->nrows;
+   i = 0;
+   b = 0;
+   for( k = 1; k < nparts; k++ )
+   {
+      SCIP_Longint target = nnzbefore[prob->nrows] * k / nparts;
+      SCIP_Longint slack = nnzbefore[prob->nrows] / (2 * nparts);
+
+      /* first row with at least the target of nonzeros before it, and the end of a bucket nearest to it */
+      while( i < prob->nrows && nnzbefore[i] < target )
+         i++;
+      while( b < nbuckets - 1 && nnzbefore[bucketbegs[b + 1]] <= target )
+         b++;
+      if( b < nbuckets - 1 && nnzbefore[bucketbegs[b + 1]] - target < target - nnzbefore[bucketbegs[b]] )
+         b++;
+
+      if( REALABS((SCIP_Real)(nnzbefore[bucketbegs[b]] - target)) <= (SCIP_Real)slack )
+         partbegs[k] = MAX(bucketbegs[b], partbegs[k - 1]);
+      else
+         partbegs[k] = MAX(i, partbegs[k - 1]);
+   }
+
+   BMSfreeMemoryArray(&nnzbefore);
+   BMSfreeMemoryArray(&bucketbegs);
+
+   return SCIP_OKAY;
+}
+
+/** shuffles the first rows of each part and hands them to the thread of the part */
+static
+void shuffleParts(
+   TRAINWORK*           works,
+   int                  nworks,
+   int*                 index,
+   int*                 partbegs,
+   int*                 partsizes,
+   unsigned int*        randseed
+   )
+{
+   int i;
+   int k;
+
+   for( k = 0; k < nworks; k++ )
+   {
+      int* rows = &index[partbegs[k]];
+
+      for( i = 0; i < partsizes[k]; i++ )
+      {
+         int j = SCIPgetRandomInt(i, partsizes[k] - 1, randseed);
+         int tmp = rows[i];
+         rows[i] = rows[j];
+         rows[j] = tmp;
+      }
+      works[k].rows = rows;
+      works[k].nrows = partsizes[k];
+   }
+}
+
+/** allocates the local weight vectors of a deterministic trainer */
+static
+SCIP_RETCODE createLocalVectors(
+   TRAINWORK*           works,
+   int                  nworks,
+   int                  ncols
+   )
+{
+   int k;
+
+   for( k = 0; k < nworks; k++ )
+   {
+      SCIP_ALLOC( BMSallocMemoryArray(&works[k].w, ncols) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees the local weight vectors of a deterministic trainer */
+static
+void freeLocalVectors(
+   TRAINWORK*           works,
+   int                  nworks
+   )
+{
+   int k;
+
+   for( k = nworks - 1; k >= 0; k-- )
+      BMSfreeMemoryArray(&works[k].w);
+}
+
+/** sums the changes of the local weight vectors from the weight vector in the order of the threads */
+static
+void sumLocalChanges(
+   TRAINWORK*           works,
+   int                  nworks,
+   int                  ncols,
+   SCIP_Real*           w,
+   SCIP_Real*           dw
+   )
+{
+   int j;
+   int k;
+
+   BMSclearMemoryArray(dw, ncols);
+   for( k = 0; k < nworks; k++ )
+   {
+      for( j = 0; j < ncols; j++ )
+         dw[j] += works[k].w[j] - w[j];
+   }
+}
+
+/** returns the step in [0,1] that minimizes the dual objective from (alphaold, w) along the changes (alpha - alphaold,
+ *  dw) of a round
+ *
+ *  For the SVM solvers the objective 1/2 |w|^2 + sum_i (diag_i/2 alpha_i^2 - alpha_i) is quadratic along the changes.
+ *  For logistic regression, alpha[2i] + alpha[2i+1] = C_i and the objective 1/2 |w|^2 + sum_i (alpha[2i] log alpha[2i]
+ *  + alpha[2i+1] log alpha[2i+1]) is minimized by Newton's method safeguarded by bisection; both end points are in the
+ *  interior of the domain.
+ */
+static
+SCIP_Real calcDualStep(
+   SCIP_TRAINPARAM*     param,
+   int                  l,
+   int                  ncols,
+   SCIP_Real*           alphaold,
+   SCIP_Real*           alpha,
+   SCIP_Real*           diag,
+   SCIP_Real*           upperbound,
+   SCIP_Real*           w,
+   SCIP_Real*           dw
+   )
+{
+   SCIP_Real wdw = 0;
+   SCIP_Real dwdw = 0;
+   SCIP_Real lo;
+   SCIP_Real hi;
+   SCIP_Real step;
+   int iter;
+   int i;
+   int j;
+
+   for( j = 0; j < ncols; j++ )
+   {
+      wdw += w[j] * dw[j];
+      dwdw += dw[j] * dw[j];
+   }
+
+   if( param->solver != SCIP_TRAINSOLVER_L2R_LR_DUAL )
+   {
+      SCIP_Real grad = wdw;
+      SCIP_Real curv = dwdw;
+
+      for( i = 0; i < l; i++ )
+      {
+         SCIP_Real d = alpha[i] - alphaold[i];
+
+         grad += d * (diag[i] * alphaold[i] - 1);
+         curv += diag[i] * d * d;
+      }
+      if( curv <= 0 || grad >= 0 )
+         return curv <= 0 ? 1.0 : 0.0;
+
+      return MIN(-grad / curv, 1.0);
+   }
+
+   lo = 0.0;
+   hi = 1.0;
+   step = 1.0;
+   for( iter = 0; iter < LINESEARCH_MAXITER; iter++ )
+   {
+      SCIP_Real grad = wdw + step * dwdw;
+      SCIP_Real curv = dwdw;
+      SCIP_Real newstep;
+
+      for( i = 0; i < l; i++ )
+      {
+         SCIP_Real d = alpha[2*i] - alphaold[2*i];
+         SCIP_Real a;
+
+         if( d == 0 )
+            continue;
+         a = alphaold[2*i] + step * d;
+         grad += d * (log(a) - log(upperbound[i] - a));
+         curv += d * d * (1.0 / a + 1.0 / (upperbound[i] - a));
+      }
+
+      /* the full step is taken if the objective still decreases at its end */
+      if( iter == 0 && grad <= 0 )
+         return 1.0;
+      if( grad > 0 )
+         hi = step;
+      else
+         lo = step;
+
+      newstep = curv > 0 ? step - grad / curv : lo;
+      if( newstep <= lo || newstep >= hi )
+         newstep = 0.5 * (lo + hi);
+      if( REALABS(newstep - step) <= 1.0e-8 * step )
+         return newstep;
+      step = newstep;
+   }
+
+   return step;
+}
+
+/** parallel dual coordinate descent for all solvers */
+static
+SCIP_RETCODE solveParallelDcd(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_Real*           alpha,
+   SCIP_Real*           w
+   )
+{
+   TRAINTEAM team;
+   TRAINWORK* works;
+   SCIP_Real* xTx;
+   SCIP_Real* diag;
+   SCIP_Real* upperbound;
+   SCIP_Real* alphaold = NULL;
+   SCIP_Real* dw = NULL;
+   SCIP_Bool* shrunk;
+   int* index;
+   int* partbegs;
+   int* partsizes;
+   SCIP_Real PGmaxold = SCIP_REAL_MAX;
+   SCIP_Real PGminold = -SCIP_REAL_MAX;
+   SCIP_Real innereps = 1.0e-2;
+   SCIP_Real innerepsmin = MIN(1.0e-8, param->eps);
+   SCIP_Bool lr;
+   SCIP_Bool l2loss;
+   unsigned int randseed;
+   int activesize;
+   int nalpha;
+   int nworks;
+   int ncols;
+   int iter;
+   int l;
+   int i;
+   int k;
+
+   l = prob->nrows;
+   ncols = prob->ncols;
+   lr = (param->solver == SCIP_TRAINSOLVER_L2R_LR_DUAL);
+   l2loss = (param->solver == SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL);
+   randseed = param->randseed;
+   nworks = MIN(param->nthreads, l);
+   nalpha = lr ? 2 * l : l;
+
+   SCIP_ALLOC( BMSallocMemoryArray(&xTx, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&diag, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&upperbound, l) );
+   SCIP_ALLOC( BMSallocClearMemoryArray(&shrunk, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&index, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&works, nworks) );
+   SCIP_ALLOC( BMSallocMemoryArray(&partbegs, nworks + 1) );
+   SCIP_ALLOC( BMSallocMemoryArray(&partsizes, nworks) );
+
+   for( i = 0; i < l; i++ )
+   {
+      SCIP_Real cost = rowCost(prob, param, i);
+
+      xTx[i] = rowSqnorm(prob, i);
+      if( lr )
+      {
+         upperbound[i] = cost;
+         diag[i] = 0.0;
+      }
+      else
+      {
+         upperbound[i] = l2loss ? SCIP_REAL_MAX : cost;
+         diag[i] = l2loss ? 0.5 / cost : 0.0;
+      }
+   }
+
+   for( k = 0; k < nworks; k++ )
+   {
+      works[k].prob = prob;
+      works[k].param = param;
+      works[k].w = w;
+      works[k].alpha = alpha;
+      works[k].xTx = xTx;
+      works[k].diag = diag;
+      works[k].upperbound = upperbound;
+      works[k].shrunk = shrunk;
+      works[k].colscale = NULL;
+      works[k].nthreads = nworks;
+   }
+   if( param->deterministic )
+   {
+      SCIP_CALL( createLocalVectors(works, nworks, ncols) );
+      SCIP_ALLOC( BMSallocMemoryArray(&alphaold, nalpha) );
+      SCIP_ALLOC( BMSallocMemoryArray(&dw, ncols) );
+   }
+   SCIP_CALL( partitionRows(prob, nworks, index, partbegs) );
+   SCIP_CALL( startTeam(&team, works, nworks) );
+
+   for( k = 0; k < nworks; k++ )
+      partsizes[k] = partbegs[k + 1] - partbegs[k];
+   for( iter = 0; iter < param->maxiter; iter++ )
+   {
+      SCIP_Real PGmax = -SCIP_REAL_MAX;
+      SCIP_Real PGmin = SCIP_REAL_MAX;
+      SCIP_Real Gmax = 0;
+      int newtoniter = 0;
+      int s;
+
+      shuffleParts(works, nworks, index, partbegs, partsizes, &randseed);
+      for( k = 0; k < nworks; k++ )
+      {
+         works[k].PGmaxold = PGmaxold;
+         works[k].PGminold = PGminold;
+         works[k].innereps = innereps;
+         if( param->deterministic )
+            BMScopyMemoryArray(works[k].w, w, ncols);
+      }
+      if( param->deterministic )
+         BMScopyMemoryArray(alphaold, alpha, nalpha);
+
+      runTeam(&team, lr ? workLrPass : workSvcPass);
+
+      /* take the step along the changes of all threads that minimizes the dual objective */
+      if( param->deterministic )
+      {
+         SCIP_Real step;
+         int j;
+
+         sumLocalChanges(works, nworks, ncols, w, dw);
+         step = calcDualStep(param, l, ncols, alphaold, alpha, diag, upperbound, w, dw);
+         for( j = 0; j < ncols; j++ )
+            w[j] += step * dw[j];
+         if( step < 1.0 )
+         {
+            for( i = 0; i < l; i++ )
+            {
+               if( lr )
+               {
+                  alpha[2*i] = alphaold[2*i] + step * (alpha[2*i] - alphaold[2*i]);
+                  alpha[2*i+1] = upperbound[i] - alpha[2*i];
+               }
+               else
+                  alpha[i] = alphaold[i] + step * (alpha[i] - alphaold[i]);
+            }
+         }
+      }
+
+      for( k = 0; k < nworks; k++ )
+      {
+         PGmax = MAX(PGmax, works[k].PGmax);
+         PGmin = MIN(PGmin, works[k].PGmin);
+         Gmax = MAX(Gmax, works[k].Gmax);
+         newtoniter += works[k].newtoniter;
+      }
+
+      if( lr )
+      {
+         if( Gmax < param->eps )
+            break;
+         if( newtoniter <= l / 10 )
+            innereps = MAX(innerepsmin, 0.1 * innereps);
+         continue;
+      }
+
+      /* move the shrunken rows of each part behind its active ones */
+      activesize = 0;
+      for( k = 0; k < nworks; k++ )
+      {
+         int* rows = &index[partbegs[k]];
+
+         i = 0;
+         for( s = 0; s < partsizes[k]; s++ )
+         {
+            if( !shrunk[rows[s]] )
+            {
+               int tmp = rows[i];
+               rows[i] = rows[s];
+               rows[s] = tmp;
+               i++;
+            }
+         }
+         partsizes[k] = i;
+         activesize += i;
+      }
+
+      if( PGmax - PGmin <= param->eps )
+      {
+         if( activesize == l )
+            break;
+
+         /* check the shrunken rows once more */
+         for( k = 0; k < nworks; k++ )
+            partsizes[k] = partbegs[k + 1] - partbegs[k];
+         BMSclearMemoryArray(shrunk, l);
+         PGmaxold = SCIP_REAL_MAX;
+         PGminold = -SCIP_REAL_MAX;
+         continue;
+      }
+
+      PGmaxold = PGmax;
+      PGminold = PGmin;
+      if( PGmaxold <= 0 )
+         PGmaxold = SCIP_REAL_MAX;
+      if( PGminold >= 0 )
+         PGminold = -SCIP_REAL_MAX;
+   }
+
+   if( iter >= param->maxiter )
+      warnMaxIter(param);
+
+   stopTeam(&team);
+   if( param->deterministic )
+   {
+      BMSfreeMemoryArray(&dw);
+      BMSfreeMemoryArray(&alphaold);
+      freeLocalVectors(works, nworks);
+   }
+   BMSfreeMemoryArray(&partsizes);
+   BMSfreeMemoryArray(&partbegs);
+   BMSfreeMemoryArray(&works);
+   BMSfreeMemoryArray(&index);
+   BMSfreeMemoryArray(&shrunk);
+   BMSfreeMemoryArray(&upperbound);
+   BMSfreeMemoryArray(&diag);
+   BMSfreeMemoryArray(&xTx);
+
+   return SCIP_OKAY;
+}
+
+/** stochastic gradient descent on the primal problem min 1/2 |w|^2 + sum_i C_i loss(y_i w^T x_i) */
+static
+SCIP_RETCODE solveSgd(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_Real*           w
+   )
+{
+   TRAINTEAM team;
+   TRAINWORK* works;
+   SCIP_Real* upperbound;
+   SCIP_Real* colscale;
+   SCIP_Real* dw = NULL;
+   int* index;
+   int* partbegs;
+   int* partsizes;
+   SCIP_Real maxcost = 0;
+   SCIP_Real maxsqnorm = 0;
+   SCIP_Real eta0;
+   SCIP_Bool merge;
+   int maxpartnrows;
+   unsigned int randseed;
+   int roundrows;
+   int nworks;
+   int ncols;
+   int epoch;
+   int l;
+   int i;
+   int j;
+   int k;
+
+   l = prob->nrows;
+   ncols = prob->ncols;
+   randseed = param->randseed;
+   nworks = MIN(param->nthreads, l);
+   merge = (param->deterministic && nworks > 1);
+
+   SCIP_ALLOC( BMSallocMemoryArray(&upperbound, l) );
+   SCIP_ALLOC( BMSallocClearMemoryArray(&colscale, ncols) );
+   SCIP_ALLOC( BMSallocMemoryArray(&index, l) );
+   SCIP_ALLOC( BMSallocMemoryArray(&works, nworks) );
+   SCIP_ALLOC( BMSallocMemoryArray(&partbegs, nworks + 1) );
+   SCIP_ALLOC( BMSallocMemoryArray(&partsizes, nworks) );
+
+   for( i = 0; i < l; i++ )
+   {
+      upperbound[i] = rowCost(prob, param, i);
+      maxcost = MAX(maxcost, upperbound[i]);
+      maxsqnorm = MAX(maxsqnorm, rowSqnorm(prob, i));
+   }
+
+   /* the regularization 1/(2l) |w|^2 per example is applied to column j in the fraction nrows(j)/l of the updates */
+   for( k = 0; k < prob->nnonzeros; k++ )
+      colscale[prob->colidx[k]] += 1.0;
+   for( j = 0; j < ncols; j++ )
+   {
+      if( colscale[j] > 0 )
+         colscale[j] = 1.0 / colscale[j];
+   }
+
+   /* the first steps must not overshoot the loss of the largest example */
+   eta0 = 1.0 / MAX(maxcost * maxsqnorm, 1.0e-12);
+
+   for( k = 0; k < nworks; k++ )
+   {
+      works[k].prob = prob;
+      works[k].param = param;
+      works[k].w = w;
+      works[k].upperbound = upperbound;
+      works[k].colscale = colscale;
+      works[k].eta0 = eta0;
+      works[k].lambda = 1.0 / l;
+      works[k].nthreads = nworks;
+   }
+   if( merge )
+   {
+      SCIP_CALL( createLocalVectors(works, nworks, ncols) );
+      SCIP_ALLOC( BMSallocMemoryArray(&dw, ncols) );
+   }
+   SCIP_CALL( partitionRows(prob, nworks, index, partbegs) );
+   SCIP_CALL( startTeam(&team, works, nworks) );
+
+   maxpartnrows = 0;
+   for( k = 0; k < nworks; k++ )
+   {
+      partsizes[k] = partbegs[k + 1] - partbegs[k];
+      maxpartnrows = MAX(maxpartnrows, partsizes[k]);
+   }
+
+   /* the local vectors are merged often, so that they do not drift apart on the rows of their part */
+   roundrows = merge ? SGD_ROUNDROWS : l;
+
+   for( epoch = 0; epoch < param->nepochs; epoch++ )
+   {
+      int pos;
+
+      shuffleParts(works, nworks, index, partbegs, partsizes, &randseed);
+
+      for( pos = 0; pos < maxpartnrows; pos += roundrows )
+      {
+         for( k = 0; k < nworks; k++ )
+         {
+            works[k].rows = &index[partbegs[k] + MIN(pos, partsizes[k])];
+            works[k].nrows = MAX(MIN(roundrows, partsizes[k] - pos), 0);
+            works[k].t = (SCIP_Longint)epoch * l + (SCIP_Longint)pos * nworks + k;
+            if( merge )
+               BMScopyMemoryArray(works[k].w, w, ncols);
+         }
+
+         runTeam(&team, workSgdPass);
+
+         /* add the changes of the threads, as if their updates had been done on the shared vector */
+         if( merge )
+         {
+            sumLocalChanges(works, nworks, ncols, w, dw);
+            for( j = 0; j < ncols; j++ )
+               w[j] += dw[j];
+         }
+      }
+   }
+
+   stopTeam(&team);
+   if( merge )
+   {
+      BMSfreeMemoryArray(&dw);
+      freeLocalVectors(works, nworks);
+   }
+   BMSfreeMemoryArray(&partsizes);
+   BMSfreeMemoryArray(&partbegs);
+   BMSfreeMemoryArray(&works);
+   BMSfreeMemoryArray(&index);
+   BMSfreeMemoryArray(&colscale);
+   BMSfreeMemoryArray(&upperbound);
+
+   return SCIP_OKAY;
+}
+
+/** create an empty dual state */
+SCIP_RETCODE SCIPtrainstateCreate(
+   SCIP_TRAINSTATE**    state
+   )
+{
+   assert(state != NULL);
+
+   SCIP_ALLOC( BMSallocMemory(state) );
+   (*state)->alpha = NULL;
+   (*state)->weights = NULL;
+   (*state)->nexamples = 0;
+   (*state)->nweights = 0;
+   (*state)->solver = DEFAULT_SOLVER;
+
+   return SCIP_OKAY;
+}
+
+/** free dual state */
+SCIP_RETCODE SCIPtrainstateFree(
+   SCIP_TRAINSTATE**    state
+   )
+{
+   assert(state != NULL);
+   assert(*state != NULL);
+
+   BMSfreeMemoryArrayNull(&(*state)->weights);
+   BMSfreeMemoryArrayNull(&(*state)->alpha);
+   BMSfreeMemory(state);
+
+   return SCIP_OKAY;
+}
+
+/** read a dual state written by SCIPtrainstateWrite() */
+SCIP_RETCODE SCIPtrainstateRead(
+   SCIP_TRAINSTATE*     state,
+   const char*          fname
+   )
+{
+   FILE* file;
+   char magic[TRAINSTATE_MAGICLEN];
+   int solver;
+   int nexamples;
+   int nweights;
+
+   assert(state != NULL);
+   assert(fname != NULL);
+
+   file = fopen(fname, "rb");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for reading\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_NOFILE;
+   }
+
+   if( fread(magic, sizeof(char), TRAINSTATE_MAGICLEN, file) != TRAINSTATE_MAGICLEN
+      || strncmp(magic, TRAINSTATE_MAGIC, TRAINSTATE_MAGICLEN) != 0
+      || fread(&solver, sizeof(int), 1, file) != 1
+      || fread(&nexamples, sizeof(int), 1, file) != 1
+      || fread(&nweights, sizeof(int), 1, file) != 1
+      || nexamples < 0 || nweights < 0 )
+   {
+      SCIPerrorMessage("file <%s> is not a trainer state file\n", fname);
+      fclose(file);
+      return SCIP_READERROR;
+   }
+
+   BMSfreeMemoryArrayNull(&state->alpha);
+   BMSfreeMemoryArrayNull(&state->weights);
+   SCIP_ALLOC( BMSallocMemoryArray(&state->alpha, MAX(nexamples, 1)) );
+   SCIP_ALLOC( BMSallocMemoryArray(&state->weights, MAX(nweights, 1)) );
+   state->solver = (SCIP_TRAINSOLVER)solver;
+   state->nexamples = nexamples;
+   state->nweights = nweights;
+
+   if( fread(state->alpha, sizeof(SCIP_Real), (size_t)nexamples, file) != (size_t)nexamples
+      || fread(state->weights, sizeof(SCIP_Real), (size_t)nweights, file) != (size_t)nweights )
+   {
+      SCIPerrorMessage("unexpected end of trainer state file <%s>\n", fname);
+      state->nexamples = 0;
+      state->nweights = 0;
+      fclose(file);
+      return SCIP_READERROR;
+   }
+
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** write the dual state to a binary file */
+SCIP_RETCODE SCIPtrainstateWrite(
+   SCIP_TRAINSTATE*     state,
+   const char*          fname
+   )
+{
+   FILE* file;
+   int solver;
+
+   assert(state != NULL);
+   assert(fname != NULL);
+
+   file = fopen(fname, "wb");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for writing\n", fname);
+      SCIPprintSysError(fname);
+      return SCIP_FILECREATEERROR;
+   }
+
+   solver = (int)state->solver;
+   fwrite(TRAINSTATE_MAGIC, sizeof(char), TRAINSTATE_MAGICLEN, file);
+   fwrite(&solver, sizeof(int), 1, file);
+   fwrite(&state->nexamples, sizeof(int), 1, file);
+   fwrite(&state->nweights, sizeof(int), 1, file);
+   fwrite(state->alpha, sizeof(SCIP_Real), (size_t)state->nexamples, file);
+   fwrite(state->weights, sizeof(SCIP_Real), (size_t)state->nweights, file);
+
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** initializes the dual variables and the weight vector, from the dual state if given */
+static
+void initDual(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_TRAINSTATE*     state,
+   SCIP_Real*           alpha,
+   SCIP_Real*           w
+   )
+{
+   SCIP_Bool lr;
+   SCIP_Bool l2loss;
+   SCIP_Bool fixedrows;
+   int i;
+
+   lr = (param->solver == SCIP_TRAINSOLVER_L2R_LR_DUAL);
+   l2loss = (param->solver == SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL);
+
+   /* the examples before the problem keep their dual variables; their part of w is taken from the state */
+   fixedrows = (state != NULL && prob->first > 0);
+   if( fixedrows )
+      BMScopyMemoryArray(w, state->weights, state->nweights);
+
+   for( i = 0; i < prob->nrows; i++ )
+   {
+      SCIP_Real cost = rowCost(prob, param, i);
+      SCIP_Real lb;
+      SCIP_Real ub;
+      SCIP_Real a;
+      SCIP_Real delta;
+      int e = prob->first + i;
+
+      /* logistic regression needs strictly interior dual variables */
+      lb = lr ? MIN(0.001 * cost, 1.0e-8) : 0.0;
+      ub = lr ? cost - lb : (l2loss ? SCIP_REAL_MAX : cost);
+
+      a = lb;
+      delta = lb;
+      if( state != NULL && e < state->nexamples )
+      {
+         a = MIN(MAX(state->alpha[e], lb), ub);
+         delta = fixedrows ? a - state->alpha[e] : a;
+      }
+
+      if( lr )
+      {
+         alpha[2*i] = a;
+         alpha[2*i+1] = cost - a;
+      }
+      else
+         alpha[i] = a;
+
+      if( delta != 0.0 )
+         rowAxpy(prob, w, i, prob->labels[i] * delta);
+   }
+}
+
+/** stores the dual variables and the weight vector in the dual state */
+static
+SCIP_RETCODE storeDual(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_TRAINSTATE*     state,
+   SCIP_Real*           alpha,
+   SCIP_Real*           w,
+   int                  nweights
+   )
+{
+   SCIP_Bool lr;
+   int nexamples;
+   int i;
+
+   lr = (param->solver == SCIP_TRAINSOLVER_L2R_LR_DUAL);
+   nexamples = MAX(state->nexamples, prob->first + prob->nrows);
+
+   SCIP_ALLOC( BMSreallocMemoryArray(&state->alpha, nexamples) );
+   for( i = state->nexamples; i < prob->first; i++ )
+      state->alpha[i] = 0.0;
+   for( i = 0; i < prob->nrows; i++ )
+      state->alpha[prob->first + i] = lr ? alpha[2*i] : alpha[i];
+   state->nexamples = nexamples;
+
+   SCIP_ALLOC( BMSreallocMemoryArray(&state->weights, nweights) );
+   BMScopyMemoryArray(state->weights, w, nweights);
+   state->nweights = nweights;
+   state->solver = param->solver;
+
+   return SCIP_OKAY;
+}
+
+/** train a linear policy on the training problem; the weight vector of the policy is replaced */
+SCIP_RETCODE SCIPtrainPolicy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_TRAINSTATE*     state,
+   SCIP_POLICY*         policy
+   )
+{
+   SCIP_Real* alpha;
+   SCIP_Real* w;
+   int nweights;
+
+   assert(prob != NULL);
+   assert(param != NULL);
+   assert(policy != NULL);
+   assert(param->C > 0);
+   assert(param->nthreads >= 1);
+
+   if( prob->nrows == 0 || prob->ncols == 0 )
+   {
+      SCIPerrorMessage("empty training problem\n");
+      return SCIP_INVALIDDATA;
+   }
+
+   if( param->solver != SCIP_TRAINSOLVER_L2R_L2LOSS_SVC_DUAL && param->solver != SCIP_TRAINSOLVER_L2R_L1LOSS_SVC_DUAL
+      && param->solver != SCIP_TRAINSOLVER_L2R_LR_DUAL )
+   {
+      SCIPerrorMessage("unknown solver type %d\n", (int)param->solver);
+      return SCIP_INVALIDDATA;
+   }
+
+   /* dual variables of another solver are useless */
+   if( state != NULL && state->solver != param->solver )
+   {
+      state->nexamples = 0;
+      state->nweights = 0;
+   }
+
+   nweights = prob->ncols;
+   if( state != NULL )
+      nweights = MAX(nweights, state->nweights);
+   SCIP_ALLOC( BMSallocClearMemoryArray(&w, nweights) );
+
+   if( param->method == SCIP_TRAINMETHOD_SGD )
+   {
+      /* the primal method only continues from the weight vector */
+      if( state != NULL )
+         BMScopyMemoryArray(w, state->weights, state->nweights);
+      SCIP_CALL( solveSgd(prob, param, w) );
+      if( state != NULL )
+      {
+         SCIP_ALLOC( BMSreallocMemoryArray(&state->weights, nweights) );
+         BMScopyMemoryArray(state->weights, w, nweights);
+         state->nweights = nweights;
+         state->nexamples = 0;
+         state->solver = param->solver;
+      }
+   }
+   else
+   {
+      /* alpha[2i] and alpha[2i+1] of logistic regression are the dual variable of row i and its complement */
+      SCIP_ALLOC( BMSallocMemoryArray(&alpha, param->solver == SCIP_TRAINSOLVER_L2R_LR_DUAL ? 2 * prob->nrows
+            : prob->nrows) );
+      initDual(prob, param, state, alpha, w);
+
+      if( param->nthreads > 1 )
+      {
+         SCIP_CALL( solveParallelDcd(prob, param, alpha, w) );
+      }
+      else if( param->solver == SCIP_TRAINSOLVER_L2R_LR_DUAL )
+      {
+         SCIP_CALL( solveL2rLrDual(prob, param, alpha, w) );
+      }
+      else
+      {
+         SCIP_CALL( solveL2rL1L2Svc(prob, param, alpha, w) );
+      }
+
+      if( state != NULL )
+      {
+         SCIP_CALL( storeDual(prob, param, state, alpha, w, nweights) );
+      }
+      BMSfreeMemoryArray(&alpha);
+   }
+
+   BMSfreeMemoryArrayNull(&policy->weights);
+   policy->weights = w;
+   policy->size = nweights;
+
+   return SCIP_OKAY;
+}
+
+/** returns the fraction of rows of the training problem that the policy classifies correctly */
+SCIP_Real SCIPtrainprobGetAccuracy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_POLICY*         policy
+   )
+{
+   int ncorrect = 0;
+   int row;
+   int k;
+
+   assert(prob != NULL);
+   assert(policy != NULL);
+
+   if( prob->nrows == 0 )
+      return 1.0;
+
+   for( row = 0; row < prob->nrows; row++ )
+   {
+      SCIP_Real score = 0;
+      int predicted;
+
+      /* features beyond the policy size have weight zero */
+      for( k = prob->rowbegs[row]; k < prob->rowbegs[row + 1]; k++ )
+      {
+         if( prob->colidx[k] < policy->size )
+            score += policy->weights[prob->colidx[k]] * prob->vals[k];
+      }
+
+      /* LIBLINEAR predicts the first label (+1) if the decision value is positive */
+      predicted = score > 0 ? 1 : -1;
+      if( predicted == prob->labels[row] )
+         ncorrect++;
+   }
+
+   return (SCIP_Real)ncorrect / prob->nrows;
+}
+
+/** computes the fraction of rows of each class of the training problem that the policy classifies correctly */
+void SCIPtrainprobGetClassAccuracy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_POLICY*         policy,
+   SCIP_Real*           accpos,
+   SCIP_Real*           accneg
+   )
+{
+   int ncorrect[2] = {0, 0};
+   int nrows[2] = {0, 0};
+   int row;
+   int k;
+
+   assert(prob != NULL);
+   assert(policy != NULL);
+   assert(accpos != NULL);
+   assert(accneg != NULL);
+
+   for( row = 0; row < prob->nrows; row++ )
+   {
+      SCIP_Real score = 0;
+      int c;
+
+      for( k = prob->rowbegs[row]; k < prob->rowbegs[row + 1]; k++ )
+      {
+         if( prob->colidx[k] < policy->size )
+            score += policy->weights[prob->colidx[k]] * prob->vals[k];
+      }
+
+      c = prob->labels[row] > 0 ? 0 : 1;
+      nrows[c]++;
+      if( (score > 0 ? 1 : -1) == prob->labels[row] )
+         ncorrect[c]++;
+   }
+
+   *accpos = nrows[0] > 0 ? (SCIP_Real)ncorrect[0] / nrows[0] : 1.0;
+   *accneg = nrows[1] > 0 ? (SCIP_Real)ncorrect[1] / nrows[1] : 1.0;
+}
+
+/** shared data of the threads of a grid search */
+struct GridWork
+{
+   SCIP_TRAINPROB*      prob;               /**< training problem */
+   SCIP_TRAINPROB*      heldout;            /**< held-out problem, or NULL */
+   SCIP_TRAINPARAM*     param;              /**< parameters of all points */
+   SCIP_TRAINGRIDPOINT* points;             /**< points of the grid */
+   int                  npoints;            /**< number of points */
+   int                  next;               /**< next point to train */
+   pthread_mutex_t      lock;               /**< lock of next */
+};
+typedef struct GridWork GRIDWORK;
+
+/** trains the points of the grid until none is left */
+static
+void* gridWorker(
+   void*                arg
+   )
+{
+   GRIDWORK* work = (GRIDWORK*)arg;
+
+   for( ;; )
+   {
+      SCIP_TRAINGRIDPOINT* point;
+      SCIP_TRAINPARAM param;
+      int p;
+
+      pthread_mutex_lock(&work->lock);
+      p = work->next++;
+      pthread_mutex_unlock(&work->lock);
+      if( p >= work->npoints )
+         break;
+
+      point = &work->points[p];
+      param = *work->param;
+      param.C = point->C;
+      param.weightpos = point->weightpos;
+      param.weightneg = point->weightneg;
+
+      point->retcode = SCIPtrainPolicy(work->prob, &param, NULL, &point->policy);
+      if( point->retcode == SCIP_OKAY && work->heldout != NULL )
+      {
+         point->accuracy = SCIPtrainprobGetAccuracy(work->heldout, &point->policy);
+         SCIPtrainprobGetClassAccuracy(work->heldout, &point->policy, &point->accpos, &point->accneg);
+      }
+   }
+
+   return NULL;
+}
+
+/** trains a policy for each point of a hyperparameter grid and scores it on the held-out problem */
+SCIP_RETCODE SCIPtrainGridSearch(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPROB*      heldout,
+   SCIP_TRAINPARAM*     param,
+   SCIP_TRAINGRIDPOINT* points,
+   int                  npoints,
+   int                  nthreads
+   )
+{
+   SCIP_TRAINPARAM pointparam;
+   GRIDWORK work;
+   pthread_t* threads;
+   SCIP_Bool* started;
+   int nworkers;
+   int p;
+   int k;
+
+   assert(prob != NULL);
+   assert(param != NULL);
+   assert(points != NULL);
+   assert(nthreads >= 1);
+
+   for( p = 0; p < npoints; p++ )
+   {
+      points[p].accuracy = 0.0;
+      points[p].accpos = 0.0;
+      points[p].accneg = 0.0;
+      points[p].retcode = SCIP_OKAY;
+   }
+
+   pointparam = *param;
+#ifdef NPARASCIP
+   /* the block memory of SCIP is not thread-safe, so the calling thread trains the points one after another, each with
+    * all threads: the threads of the parallel solvers do not allocate
+    */
+   nworkers = 1;
+   pointparam.nthreads = nthreads;
+#else
+   /* threads that are left over from the points train the points in parallel */
+   nworkers = MIN(nthreads, npoints);
+   pointparam.nthreads = MAX(1, nthreads / MAX(npoints, 1));
+#endif
+
+   work.prob = prob;
+   work.heldout = heldout;
+   work.param = &pointparam;
+   work.points = points;
+   work.npoints = npoints;
+   work.next = 0;
+   pthread_mutex_init(&work.lock, NULL);
+
+   SCIP_ALLOC( BMSallocMemoryArray(&threads, MAX(nworkers, 1)) );
+   SCIP_ALLOC( BMSallocMemoryArray(&started, MAX(nworkers, 1)) );
+
+   for( k = 1; k < nworkers; k++ )
+      started[k] = (pthread_create(&threads[k], NULL, gridWorker, &work) == 0);
+
+   /* the calling thread also trains; it picks up the points of threads that could not be started */
+   (void) gridWorker(&work);
+
+   for( k = 1; k < nworkers; k++ )
+   {
+      if( started[k] )
+         pthread_join(threads[k], NULL);
+   }
+
+   BMSfreeMemoryArray(&started);
+   BMSfreeMemoryArray(&threads);
+   pthread_mutex_destroy(&work.lock);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,132 @@
+/**@file   train.h
+ * @brief  internal methods for training linear policies
+ * @author He He
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_TRAIN_H__
+#define __SCIP_TRAIN_H__
+
+#include "scip/def.h"
+#include "scip/scip.h"
+#include "struct_train.h"
+#include "struct_dataset.h"
+#include "struct_policy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** set the trainer parameters to the defaults of LIBLINEAR */
+extern
+void SCIPtrainparamSetDefault(
+   SCIP_TRAINPARAM*     param
+   );
+
+/** returns the LIBLINEAR name of the solver */
+extern
+const char* SCIPtrainsolverGetName(
+   SCIP_TRAINSOLVER     solver
+   );
+
+/** expand the examples in [first, last) of the dataset to a training problem; the columns of each block start at
+ *  the feature size times its depth bucket in the layout policy
+ */
+extern
+SCIP_RETCODE SCIPtrainprobCreate(
+   SCIP_TRAINPROB**     prob,
+   SCIP_DATASET*        dataset,
+   int                  first,
+   int                  last,
+   SCIP_POLICY*         layout              /**< policy with the depth buckets, or NULL for equal width */
+   );
+
+/** free training problem */
+extern
+SCIP_RETCODE SCIPtrainprobFree(
+   SCIP_TRAINPROB**     prob
+   );
+
+/** create an empty dual state */
+extern
+SCIP_RETCODE SCIPtrainstateCreate(
+   SCIP_TRAINSTATE**    state
+   );
+
+/** free dual state */
+extern
+SCIP_RETCODE SCIPtrainstateFree(
+   SCIP_TRAINSTATE**    state
+   );
+
+/** read a dual state written by SCIPtrainstateWrite() */
+extern
+SCIP_RETCODE SCIPtrainstateRead(
+   SCIP_TRAINSTATE*     state,
+   const char*          fname
+   );
+
+/** write the dual state to a binary file */
+extern
+SCIP_RETCODE SCIPtrainstateWrite(
+   SCIP_TRAINSTATE*     state,
+   const char*          fname
+   );
+
+/** train a linear policy on the training problem; the weight vector of the policy is replaced
+ *
+ *  If a dual state of the same solver is given, the dual variables of the rows are initialized from it (projected
+ *  onto the bounds of the current costs). If the problem does not start at the first example of the dataset, the
+ *  examples before it keep their dual variables and the weight vector of the state is used for their part, so that
+ *  only the new examples are optimized. The state is updated with the result.
+ */
+extern
+SCIP_RETCODE SCIPtrainPolicy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPARAM*     param,
+   SCIP_TRAINSTATE*     state,
+   SCIP_POLICY*         policy
+   );
+
+/** returns the fraction of rows of the training problem that the policy classifies correctly */
+extern
+SCIP_Real SCIPtrainprobGetAccuracy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_POLICY*         policy
+   );
+
+/** computes the fraction of rows of each class of the training problem that the policy classifies correctly; a class
+ *  without rows counts as fully correct
+ */
+extern
+void SCIPtrainprobGetClassAccuracy(
+   SCIP_TRAINPROB*      prob,
+   SCIP_POLICY*         policy,
+   SCIP_Real*           accpos,
+   SCIP_Real*           accneg
+   );
+
+/** trains a policy for each point of a hyperparameter grid on the same training problem and scores it on the held-out
+ *  problem (if given)
+ *
+ *  The points are distributed over the threads dynamically; each point is trained serially unless there are more
+ *  threads than points. Without PARASCIP the points are trained one after another, each with all threads. The other
+ *  parameters are taken from param. The training problem is only read, so all threads
+ *  share it. Errors of single points are stored in the retcode of the point.
+ */
+extern
+SCIP_RETCODE SCIPtrainGridSearch(
+   SCIP_TRAINPROB*      prob,
+   SCIP_TRAINPROB*      heldout,
+   SCIP_TRAINPARAM*     param,
+   SCIP_TRAINGRIDPOINT* points,
+   int                  npoints,
+   int                  nthreads
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif